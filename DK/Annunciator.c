@@ -0,0 +1,161 @@
+/**
+ * @file     Annunciator.c
+ * @brief    指示灯/蜂鸣器提示引擎实现
+ * @details  提示表为常量，放在flash中；运行状态只有当前提示、步骤和剩余时间：
+ *          - 请求为每个提示一个字节，写入是原子的，主循环和中断同时设置不会互相覆盖
+ *          - 切换提示时从第一步开始，避免从上一个提示的中间接着播放
+ *          - 常亮的提示只有一步，循环时输出不变，不会重复写引脚
+ *          烟雾报警音型参考火灾报警常用的三声一组（T3）节奏
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Annunciator.h"
+#include <stddef.h>
+
+/**
+ * @brief 音调（Hz）
+ */
+#define ANNUN_TONE_HIGH 2700 /**< 高音（压电蜂鸣片常见谐振频率附近） */
+#define ANNUN_TONE_MID  1500 /**< 中音 */
+#define ANNUN_TONE_LOW  1000 /**< 低音 */
+
+#define ANNUN_ARRAY_LEN(a) ((uint8_t)(sizeof(a) / sizeof((a)[0])))
+
+/* 步骤表：{指示灯, 音调, 毫秒} */
+static const AnnunStep_t annun_empty[] = {
+    {ANNUN_LED_GREEN, 0, 1000},
+};
+static const AnnunStep_t annun_some[] = {
+    {ANNUN_LED_YELLOW, 0, 1000},
+};
+static const AnnunStep_t annun_full[] = {
+    {ANNUN_LED_RED, ANNUN_TONE_MID, 100},
+    {ANNUN_LED_RED, 0, 100},
+    {ANNUN_LED_RED, ANNUN_TONE_MID, 100},
+    {ANNUN_LED_RED, 0, 2700},
+};
+static const AnnunStep_t annun_prealert[] = {
+    {ANNUN_LED_YELLOW | ANNUN_LED_RED, 0, 500},
+    {ANNUN_LED_YELLOW, 0, 500},
+};
+static const AnnunStep_t annun_cleanup[] = {
+    {ANNUN_LED_RED, ANNUN_TONE_LOW, 600},
+    {ANNUN_LED_RED, 0, 1400},
+};
+static const AnnunStep_t annun_smoke[] = {
+    {ANNUN_LED_RED, ANNUN_TONE_HIGH, 500},
+    {0, 0, 500},
+    {ANNUN_LED_RED, ANNUN_TONE_HIGH, 500},
+    {0, 0, 500},
+    {ANNUN_LED_RED, ANNUN_TONE_HIGH, 500},
+    {0, 0, 1500},
+};
+
+/* 提示表，按编号排列 */
+static const AnnunPattern_t annun_patterns[ANNUN_ID_NUM] = {
+    [ANNUN_ID_EMPTY]    = {"empty", 0, ANNUN_ARRAY_LEN(annun_empty), annun_empty},
+    [ANNUN_ID_SOME]     = {"some", 0, ANNUN_ARRAY_LEN(annun_some), annun_some},
+    [ANNUN_ID_FULL]     = {"full", 1, ANNUN_ARRAY_LEN(annun_full), annun_full},
+    [ANNUN_ID_PREALERT] = {"prealert", 2, ANNUN_ARRAY_LEN(annun_prealert), annun_prealert},
+    [ANNUN_ID_CLEANUP]  = {"cleanup", 3, ANNUN_ARRAY_LEN(annun_cleanup), annun_cleanup},
+    [ANNUN_ID_SMOKE]    = {"smoke", 4, ANNUN_ARRAY_LEN(annun_smoke), annun_smoke},
+};
+
+static const AnnunHw_t *annun_hw;                /**< 硬件函数表，NULL表示未初始化 */
+static volatile uint8_t annun_req[ANNUN_ID_NUM]; /**< 提示请求 */
+static uint8_t annun_cur = ANNUN_ID_NONE;        /**< 正在播放的提示 */
+static uint8_t annun_step;                       /**< 当前步骤 */
+static uint16_t annun_left;                      /**< 当前步骤剩余时间（毫秒） */
+static uint8_t annun_leds;                       /**< 已输出的指示灯 */
+static uint16_t annun_tone;                      /**< 已输出的音调 */
+
+// 函数：选出优先级最高的请求
+static uint8_t Annun_Select(void)
+{
+    uint8_t id, best = ANNUN_ID_NONE;
+
+    for (id = 0; id < ANNUN_ID_NUM; id++) {
+        if (annun_req[id] && (best == ANNUN_ID_NONE || annun_patterns[id].priority > annun_patterns[best].priority)) {
+            best = id;
+        }
+    }
+    return best;
+}
+
+// 函数：输出有变化时写硬件
+static void Annun_Output(uint8_t leds, uint16_t tone)
+{
+    if (leds != annun_leds) {
+        annun_hw->leds(leds ^ annun_leds, leds);
+        annun_leds = leds;
+    }
+    if (tone != annun_tone) {
+        annun_hw->tone(tone);
+        annun_tone = tone;
+    }
+}
+
+void Annun_Init(const AnnunHw_t *hw)
+{
+    annun_cur  = ANNUN_ID_NONE;
+    annun_leds = 0;
+    annun_tone = 0;
+    hw->leds(ANNUN_LED_GREEN | ANNUN_LED_YELLOW | ANNUN_LED_RED, 0);
+    hw->tone(0);
+    annun_hw = hw; // 最后设置，之前定时器中断中的Annun_Tick直接返回
+}
+
+void Annun_Set(uint8_t id, uint8_t on)
+{
+    if (id < ANNUN_ID_NUM) annun_req[id] = on;
+}
+
+void Annun_SetAll(uint16_t mask)
+{
+    uint8_t id;
+
+    for (id = 0; id < ANNUN_ID_NUM; id++) {
+        annun_req[id] = (mask >> id) & 1;
+    }
+}
+
+void Annun_Tick(void)
+{
+    const AnnunPattern_t *p;
+    uint8_t id;
+
+    if (annun_hw == NULL) return;
+
+    id = Annun_Select();
+    if (id != annun_cur) { // 切换提示，从第一步开始
+        annun_cur  = id;
+        annun_step = 0;
+        if (id == ANNUN_ID_NONE) {
+            Annun_Output(0, 0);
+            return;
+        }
+        annun_left = annun_patterns[id].steps[0].ms;
+    } else if (id == ANNUN_ID_NONE) {
+        return;
+    } else if (--annun_left == 0) { // 下一步，循环播放
+        p          = &annun_patterns[id];
+        annun_step = (annun_step + 1 < p->count) ? annun_step + 1 : 0;
+        annun_left = p->steps[annun_step].ms;
+    }
+
+    p = &annun_patterns[id];
+    Annun_Output(p->steps[annun_step].leds, p->steps[annun_step].tone_hz);
+}
+
+uint8_t Annun_GetCurrent(void)
+{
+    return annun_cur;
+}
+
+const AnnunPattern_t *Annun_GetPattern(uint8_t id)
+{
+    if (id >= ANNUN_ID_NUM) return NULL;
+    return &annun_patterns[id];
+}
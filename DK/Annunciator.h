@@ -0,0 +1,129 @@
+/**
+ * @file     Annunciator.h
+ * @brief    指示灯/蜂鸣器提示引擎头文件
+ * @details  把"亮哪个灯、怎么响"从应用代码中移到常量提示表里：
+ *          - 每种提示（报警、状态）是一个循环播放的步骤表：指示灯组合、音调频率、持续时间
+ *          - 应用只声明当前有哪些提示，由引擎按表中的优先级选出一个播放
+ *            （烟雾报警 > 清理超时 > 烟雾预警 > 已满 > 状态灯）
+ *          - 由定时器中断每1ms调用Annun_Tick推进，主循环不必按节奏调用
+ *          - 输出状态缓存，指示灯只写变化的引脚，音调只在变化时设置
+ *          提示请求按字节存放，主循环和中断（如烟雾看门狗）都可直接设置，不需要关中断
+ *          本模块不依赖硬件，输出通过AnnunHw_t函数表接入
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __ANNUNCIATOR_H
+#define __ANNUNCIATOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief 提示编号（即请求位的位号）
+ */
+#define ANNUN_ID_EMPTY    0 /**< 空：绿灯 */
+#define ANNUN_ID_SOME     1 /**< 有垃圾：黄灯 */
+#define ANNUN_ID_FULL     2 /**< 已满：红灯，每3秒两声短鸣 */
+#define ANNUN_ID_PREALERT 3 /**< 烟雾预警：黄灯，红灯慢闪，不鸣响 */
+#define ANNUN_ID_CLEANUP  4 /**< 清理超时：红灯，每2秒一声低音长鸣 */
+#define ANNUN_ID_SMOKE    5 /**< 烟雾报警：高音三声一组，红灯随鸣响闪烁 */
+#define ANNUN_ID_NUM      6
+#define ANNUN_ID_NONE     0xFF /**< 没有提示 */
+
+#define ANNUN_BIT(id) (1U << (id)) /**< 提示请求位，Annun_SetAll的参数按位组合 */
+
+/**
+ * @brief 指示灯，步骤表和输出函数的leds参数按位组合
+ */
+#define ANNUN_LED_GREEN  0x01 /**< 绿灯 LED1 */
+#define ANNUN_LED_YELLOW 0x02 /**< 黄灯 LED2 */
+#define ANNUN_LED_RED    0x04 /**< 红灯 LED_Sys */
+
+/**
+ * @brief 提示步骤
+ */
+typedef struct
+{
+    uint8_t leds;     /**< 点亮的指示灯 ANNUN_LED_x 组合 */
+    uint16_t tone_hz; /**< 蜂鸣器音调（Hz），0为静音 */
+    uint16_t ms;      /**< 持续时间（毫秒），不能为0 */
+} AnnunStep_t;
+
+/**
+ * @brief 提示：步骤表循环播放
+ */
+typedef struct
+{
+    const char *name;         /**< 名称 */
+    uint8_t priority;         /**< 优先级，数值大的优先，相同时编号小的优先 */
+    uint8_t count;            /**< 步骤数 */
+    const AnnunStep_t *steps; /**< 步骤表 */
+} AnnunPattern_t;
+
+/**
+ * @brief 硬件函数表
+ * @note  由Annun_Tick调用，运行在定时器中断中
+ */
+typedef struct
+{
+    /**
+     * @brief 输出指示灯，只需写changed中的灯
+     * @param changed 状态变化的指示灯
+     * @param leds    点亮的指示灯
+     */
+    void (*leds)(uint8_t changed, uint8_t leds);
+    /**
+     * @brief 设置蜂鸣器音调，0为静音
+     */
+    void (*tone)(uint16_t hz);
+} AnnunHw_t;
+
+/**
+ * @brief  初始化并关闭所有输出
+ * @details 初始化前Annun_Tick不做任何事，已设置的请求保留
+ * @param  hw 硬件函数表
+ * @return 无
+ */
+void Annun_Init(const AnnunHw_t *hw);
+
+/**
+ * @brief  设置或取消一个提示请求
+ * @note   可在中断中调用
+ * @param  id 提示编号 ANNUN_ID_x
+ * @param  on 1请求，0取消
+ * @return 无
+ */
+void Annun_Set(uint8_t id, uint8_t on);
+
+/**
+ * @brief  一次设置全部提示请求
+ * @param  mask ANNUN_BIT(id) 组合，未包含的提示取消
+ * @return 无
+ */
+void Annun_SetAll(uint16_t mask);
+
+/**
+ * @brief  推进播放，每1ms调用一次（定时器中断）
+ * @details 选出优先级最高的请求：与正在播放的不同时从第一步开始播放，相同时按步骤持续时间推进；
+ *          输出与上次不同时才调用硬件函数
+ * @param  无
+ * @return 无
+ */
+void Annun_Tick(void);
+
+/**
+ * @brief  获取正在播放的提示
+ * @param  无
+ * @return 提示编号，没有时为ANNUN_ID_NONE
+ */
+uint8_t Annun_GetCurrent(void);
+
+/**
+ * @brief  获取提示信息
+ * @param  id 提示编号
+ * @return 提示，编号无效返回NULL
+ */
+const AnnunPattern_t *Annun_GetPattern(uint8_t id);
+
+#endif /* __ANNUNCIATOR_H */
@@ -155,7 +155,7 @@ void BT_SendDataPacket(uint8_t count, uint8_t uvLevel, float humi, float temp)
  * @param  无
  * @return 无
  */
-void USART2_IRQHandler(void)
+RAMFUNC void USART2_IRQHandler(void)
 {
     // 静态变量，用于记录接收状态
     static uint8_t RxState = 0;
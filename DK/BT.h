@@ -10,7 +10,7 @@
 #ifndef __BT_H
 #define __BT_H
 
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
 #include "DHT11.h"
 #include <stdint.h>
 
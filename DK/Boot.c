@@ -0,0 +1,97 @@
+/**
+ * @file     Boot.c
+ * @brief    启动流程调度与启动计时实现
+ * @details  步骤状态用位图表示（已启动/已完成），每轮按表中顺序扫描一遍：
+ *          - 依赖只能指向前面的步骤，不会出现循环等待
+ *          - 稳定时间用DWT周期数比较，不占用定时器
+ *          - 标记表满后不再记录，不影响调度
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Boot.h"
+#include "Delay.h"
+#include <stddef.h>
+
+static uint32_t boot_base;                    /**< 计时起点（DWT周期数） */
+static BootMark_t boot_marks[BOOT_MAX_MARKS]; /**< 标记表 */
+static uint8_t boot_mark_count;               /**< 已记录的标记数 */
+
+// 函数：自计时起点的周期数
+static uint32_t Boot_Cycles(void)
+{
+    return DELAY_DWT_CYCCNT - boot_base;
+}
+
+// 函数：追加一个标记
+static void Boot_AddMark(const char *name, uint32_t start_cyc, uint32_t done_cyc)
+{
+    BootMark_t *m;
+
+    if (boot_mark_count >= BOOT_MAX_MARKS) return;
+    m           = &boot_marks[boot_mark_count++];
+    m->name     = name;
+    m->start_us = start_cyc / Delay_CyclesPerUs;
+    m->done_us  = done_cyc / Delay_CyclesPerUs;
+}
+
+void Boot_Begin(void)
+{
+    boot_base       = DELAY_DWT_CYCCNT;
+    boot_mark_count = 0;
+}
+
+void Boot_Run(const BootStep_t *steps, uint8_t n)
+{
+    uint32_t started = 0, done = 0, all, bit, now;
+    uint32_t start_cyc[BOOT_MAX_STEPS];
+    uint8_t i;
+
+    if (n > BOOT_MAX_STEPS) n = BOOT_MAX_STEPS;
+    all = (n >= 32) ? 0xFFFFFFFFUL : ((1UL << n) - 1);
+
+    while (done != all) {
+        for (i = 0; i < n; i++) {
+            bit = 1UL << i;
+            if (done & bit) continue;
+
+            if (!(started & bit)) {
+                if (steps[i].deps & (bit - 1) & ~done) continue; // 前序步骤未完成
+                start_cyc[i] = Boot_Cycles();
+                if (steps[i].start != NULL) steps[i].start();
+                started |= bit;
+            }
+
+            now = Boot_Cycles();
+            if (now - start_cyc[i] < steps[i].settle_us * Delay_CyclesPerUs) continue; // 仍在稳定
+            if (steps[i].poll != NULL && !steps[i].poll()) continue;                   // 硬件未完成
+
+            done |= bit;
+            Boot_AddMark(steps[i].name, start_cyc[i], Boot_Cycles());
+        }
+    }
+}
+
+void Boot_Mark(const char *name)
+{
+    uint32_t now = Boot_Cycles();
+
+    Boot_AddMark(name, now, now);
+}
+
+uint32_t Boot_Now_us(void)
+{
+    return Boot_Cycles() / Delay_CyclesPerUs;
+}
+
+uint8_t Boot_GetMarkCount(void)
+{
+    return boot_mark_count;
+}
+
+const BootMark_t *Boot_GetMark(uint8_t i)
+{
+    if (i >= boot_mark_count) return NULL;
+    return &boot_marks[i];
+}
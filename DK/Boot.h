@@ -0,0 +1,100 @@
+/**
+ * @file     Boot.h
+ * @brief    启动流程调度与启动计时头文件
+ * @details  把初始化拆成带依赖关系的步骤表，由Boot_Run调度：
+ *          - 每个步骤声明依赖的前序步骤和启动后的最短稳定时间
+ *          - 依赖满足即启动，等待稳定或硬件完成期间继续启动其他步骤，不原地空转
+ *          - 需要轮询硬件状态的步骤（如ADC校准）提供poll函数，完成返回1
+ *          - 每个步骤的启动/完成时刻和Boot_Mark记录的阶段标记可通过串口3 "boot" 命令查看
+ *          计时使用DWT周期计数器，起点为Boot_Begin（Delay_Init之后），开机约59秒内有效
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __BOOT_H
+#define __BOOT_H
+
+#include <stdint.h>
+
+/**
+ * @brief 容量配置
+ */
+#define BOOT_MAX_STEPS 24 /**< 步骤表最多步骤数 */
+#define BOOT_MAX_MARKS 32 /**< 最多记录的标记数（步骤和阶段标记合计） */
+
+/**
+ * @brief 依赖位：依赖步骤表中第i个步骤，只能依赖排在前面的步骤
+ */
+#define BOOT_DEP(i) (1UL << (i))
+
+/**
+ * @brief 启动步骤（通常定义为const数组）
+ */
+typedef struct
+{
+    const char *name;      /**< 步骤名称 */
+    void (*start)(void);   /**< 启动函数，不应阻塞，可为NULL（只等待稳定时间） */
+    uint8_t (*poll)(void); /**< 完成检查（可选），稳定时间过后调用，完成返回1 */
+    uint32_t deps;         /**< 依赖的步骤 BOOT_DEP(i) 组合 */
+    uint32_t settle_us;    /**< 启动后至少经过此时间才算完成（微秒） */
+} BootStep_t;
+
+/**
+ * @brief 启动标记
+ */
+typedef struct
+{
+    const char *name;  /**< 步骤名称或阶段名称 */
+    uint32_t start_us; /**< 开始时刻（微秒，自Boot_Begin起） */
+    uint32_t done_us;  /**< 完成时刻（微秒），阶段标记与开始时刻相同 */
+} BootMark_t;
+
+/**
+ * @brief  设置启动计时起点，清空标记
+ * @note   需在Delay_Init之后调用
+ * @param  无
+ * @return 无
+ */
+void Boot_Begin(void);
+
+/**
+ * @brief  按依赖关系运行步骤表，全部完成后返回
+ * @details 按表中顺序扫描：依赖都已完成的步骤立即启动，
+ *          已启动的步骤在稳定时间过后且poll返回1（或无poll）时完成；
+ *          表中靠前的步骤优先启动
+ * @param  steps 步骤表
+ * @param  n     步骤数，最多BOOT_MAX_STEPS
+ * @return 无
+ */
+void Boot_Run(const BootStep_t *steps, uint8_t n);
+
+/**
+ * @brief  记录一个阶段标记（如应用就绪、首次响应）
+ * @param  name 阶段名称，需在整个运行期间有效
+ * @return 无
+ */
+void Boot_Mark(const char *name);
+
+/**
+ * @brief  获取自启动计时起点的时间
+ * @param  无
+ * @return 微秒
+ */
+uint32_t Boot_Now_us(void);
+
+/**
+ * @brief  获取已记录的标记数
+ * @param  无
+ * @return 标记数
+ */
+uint8_t Boot_GetMarkCount(void);
+
+/**
+ * @brief  获取一个标记
+ * @param  i 标记序号，按记录顺序
+ * @return 标记，序号无效返回NULL
+ */
+const BootMark_t *Boot_GetMark(uint8_t i);
+
+#endif /* __BOOT_H */
@@ -4,13 +4,19 @@
  * @details  实现蜂鸣器的基本控制功能，包括：
  *          - 初始化
  *          - 开启/关闭控制
+ *          - 音调（无源蜂鸣器方波）
  * @author   DikiFive
- * @date     2025-04-30
- * @version  v1.0
+ * @date     2026-10-19
+ * @version  v1.1
  */
 
 #include "Buzzer.h"
 
+#if BUZZER_PASSIVE
+static uint16_t buzzer_half;  /**< 方波半周期（节拍数），0为静音 */
+static uint16_t buzzer_count; /**< 当前半周期已过的节拍数 */
+#endif
+
 /**
  * @brief  蜂鸣器初始化
  * @details 完成以下配置：
@@ -57,3 +63,46 @@ void Buzzer_OFF(void)
 {
     GPIO_SetBits(Buzzer_GPIO_Port, Buzzer_Pin); // 高电平关闭
 }
+
+/**
+ * @brief  设置音调
+ * @details 无源蜂鸣器换算为半周期节拍数，翻转由Buzzer_Tick完成；有源蜂鸣器只开关
+ * @param  hz 频率（Hz），0为静音
+ * @return 无
+ */
+void Buzzer_Tone(uint16_t hz)
+{
+#if BUZZER_PASSIVE
+    buzzer_count = 0; // 先清计数再写半周期，Buzzer_Tick在两次写之间打断也不会越界
+    buzzer_half  = (hz != 0) ? (uint16_t)(BUZZER_TICK_HZ / 2 / hz) : 0;
+    if (buzzer_half == 0) Buzzer_OFF(); // 静音时停在关闭电平
+#else
+    if (hz != 0) {
+        Buzzer_ON();
+    } else {
+        Buzzer_OFF();
+    }
+#endif
+}
+
+/**
+ * @brief  音调节拍
+ * @details 每个半周期翻转一次引脚，与TIM4中断一起放在SRAM中运行
+ * @param  无
+ * @return 无
+ */
+RAMFUNC void Buzzer_Tick(void)
+{
+#if BUZZER_PASSIVE
+    if (buzzer_half == 0) return;
+    if (++buzzer_count >= buzzer_half) {
+        buzzer_count = 0;
+        // 直接写BSRR/BRR，不调用flash中的库函数
+        if (Buzzer_GPIO_Port->ODR & Buzzer_Pin) {
+            Buzzer_GPIO_Port->BRR = Buzzer_Pin;
+        } else {
+            Buzzer_GPIO_Port->BSRR = Buzzer_Pin;
+        }
+    }
+#endif
+}
@@ -2,15 +2,17 @@
  * @file     Buzzer.h
  * @brief    蜂鸣器驱动程序头文件
  * @details  定义了蜂鸣器控制相关的宏和函数接口
+ *          PC14没有定时器通道，无源蜂鸣器的音调由TIM4节拍中断（10us）翻转引脚产生方波，
+ *          半周期取整到10us（2.7kHz实际约2.78kHz）
  * @author   DikiFive
- * @date     2025-04-30
- * @version  v1.0
+ * @date     2026-10-19
+ * @version  v1.1
  */
 
 #ifndef __BUZZER_H
 #define __BUZZER_H
 
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
 
 /**
  * @brief 蜂鸣器硬件连接定义
@@ -20,6 +22,13 @@
 #define Buzzer_GPIO_Port GPIOC                /**< 蜂鸣器所在的GPIO端口 */
 #define Buzzer_GPIO_CLK  RCC_APB2Periph_GPIOC /**< 蜂鸣器GPIO端口时钟 */
 
+/**
+ * @brief 蜂鸣器类型
+ * @note  0：有源蜂鸣器（低电平鸣响），音调只决定开关；1：无源蜂鸣器，按音调输出方波
+ */
+#define BUZZER_PASSIVE 0
+#define BUZZER_TICK_HZ 100000 /**< Buzzer_Tick调用频率（TIM4节拍） */
+
 /**
  * @brief  初始化蜂鸣器
  * @details 配置GPIO和默认状态
@@ -44,4 +53,21 @@ void Buzzer_ON(void);
  */
 void Buzzer_OFF(void);
 
+/**
+ * @brief  设置音调
+ * @details 无源蜂鸣器时由Buzzer_Tick按半周期翻转引脚；有源蜂鸣器时hz非0即打开
+ * @note   只在比TIM4优先级低的中断（提示引擎在SysTick中调用）或主循环中调用，
+ *         两个16位变量按顺序写入，不需要关中断
+ * @param  hz 频率（Hz），0为静音
+ * @return 无
+ */
+void Buzzer_Tone(uint16_t hz);
+
+/**
+ * @brief  音调节拍，由TIM4中断每10us调用
+ * @param  无
+ * @return 无
+ */
+void Buzzer_Tick(void);
+
 #endif // __BUZZER_H
@@ -1,4 +1,4 @@
-#include "common.h"
+#include "Common.h"
 #include "stm32f10x.h"
 #include <stdarg.h>
 
@@ -0,0 +1,297 @@
+/**
+ * @file     Compactor.c
+ * @brief    垃圾压缩机控制实现
+ * @details  每1ms的处理：
+ *          - 读电流和限位，更新关盖计时、压缩间隔和热量
+ *          - 按状态决定电机输出，输出只在变化时写硬件
+ *          热量单位为"占空比%·毫秒"：驱动时每毫秒加上占空比，每毫秒减去duty_limit，
+ *          上限为burst_ms满功率运行的热量；压下中达到上限时结束本次压下，降到一半以下才允许下次启动，
+ *          收回不受热量限制，避免压板停在桶内
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Compactor.h"
+#include <stddef.h>
+
+static const CompactorHw_t *comp_hw;     /**< 硬件函数表，NULL表示未初始化 */
+static CompactorConfig_t comp_cfg;       /**< 控制参数 */
+static volatile uint8_t comp_full;       /**< 输入：已满 */
+static volatile uint8_t comp_lid_closed; /**< 输入：盖子已关闭 */
+static volatile uint8_t comp_presence;   /**< 输入：有人靠近 */
+static volatile uint8_t comp_abort;      /**< 请求：中止 */
+static volatile uint16_t comp_run_ms;    /**< 请求：手动启动，剩余有效时间（毫秒），0为无请求 */
+static volatile uint8_t comp_reset;      /**< 请求：清除故障 */
+static uint8_t comp_state;               /**< 状态 COMP_ST_x */
+static uint8_t comp_result;              /**< 上次结束原因 COMP_END_x */
+static uint8_t comp_tries;               /**< 本次满溢已压缩次数 */
+static int8_t comp_speed;                /**< 已输出的电机速度 */
+static uint32_t comp_state_ms;           /**< 进入当前状态的时间 */
+static uint32_t comp_since_ms;           /**< 距上次压缩结束的时间 */
+static uint16_t comp_lid_ms;             /**< 盖子连续关闭的时间 */
+static uint16_t comp_stall_ms;           /**< 电流连续超限的时间 */
+static uint16_t comp_peak_ma;            /**< 本次压下的峰值电流 */
+static uint32_t comp_heat;               /**< 热量（%·毫秒） */
+static uint32_t comp_cycles;             /**< 完成的压缩次数 */
+
+// 函数：输出有变化时写硬件，驱动时累加热量
+static void Compactor_Drive(int8_t speed)
+{
+    if (speed != comp_speed) {
+        comp_hw->drive(speed);
+        comp_speed = speed;
+    }
+    comp_heat += (speed < 0) ? -speed : speed;
+}
+
+// 函数：软启动，从start_duty按时间线性增加到duty
+static uint8_t Compactor_Ramp(uint8_t duty)
+{
+    if (duty <= comp_cfg.start_duty || comp_state_ms >= comp_cfg.ramp_ms) return duty;
+    return (uint8_t)(comp_cfg.start_duty + (uint32_t)(duty - comp_cfg.start_duty) * comp_state_ms / comp_cfg.ramp_ms);
+}
+
+// 函数：切换状态
+static void Compactor_Enter(uint8_t state)
+{
+    comp_state    = state;
+    comp_state_ms = 0;
+    comp_stall_ms = 0;
+}
+
+// 函数：结束压下，停机后收回
+static void Compactor_EndPress(uint8_t result)
+{
+    comp_result = result;
+    Compactor_Drive(0);
+    Compactor_Enter(COMP_ST_PAUSE);
+}
+
+// 函数：故障停机
+static void Compactor_Fault(uint8_t result)
+{
+    comp_result = result;
+    Compactor_Drive(0);
+    Compactor_Enter(COMP_ST_FAULT);
+}
+
+// 函数：判断能否启动压下
+static uint8_t Compactor_CanStart(void)
+{
+    if (comp_lid_ms < comp_cfg.lid_settle_ms || comp_presence) return 0;
+    if (comp_heat > (uint32_t)comp_cfg.burst_ms * 50) return 0; // 热量降到上限的一半以下
+    if (comp_run_ms) return 1;
+    return comp_cfg.enable && comp_full && comp_tries < comp_cfg.max_tries && comp_since_ms >= comp_cfg.interval_ms;
+}
+
+void Compactor_DefaultConfig(CompactorConfig_t *cfg)
+{
+    cfg->press_max_ms  = COMP_PRESS_MAX_MS;
+    cfg->return_max_ms = COMP_RETURN_MAX_MS;
+    cfg->interval_ms   = COMP_INTERVAL_MS;
+    cfg->burst_ms      = COMP_BURST_MS;
+    cfg->ramp_ms       = COMP_RAMP_MS;
+    cfg->blank_ms      = COMP_BLANK_MS;
+    cfg->stall_ms      = COMP_STALL_MS;
+    cfg->pause_ms      = COMP_PAUSE_MS;
+    cfg->lid_settle_ms = COMP_LID_SETTLE_MS;
+    cfg->stall_ma      = COMP_STALL_MA;
+    cfg->start_duty    = COMP_START_DUTY;
+    cfg->press_duty    = COMP_PRESS_DUTY;
+    cfg->return_duty   = COMP_RETURN_DUTY;
+    cfg->duty_limit    = COMP_DUTY_LIMIT;
+    cfg->max_tries     = COMP_MAX_TRIES;
+    cfg->enable        = 1;
+}
+
+void Compactor_Init(const CompactorHw_t *hw, const CompactorConfig_t *cfg)
+{
+    if (cfg == NULL) {
+        Compactor_DefaultConfig(&comp_cfg);
+    } else {
+        comp_cfg = *cfg;
+    }
+
+    comp_result   = COMP_END_NONE;
+    comp_tries    = 0;
+    comp_since_ms = comp_cfg.interval_ms; // 上电后可立即压缩
+    comp_lid_ms   = 0;
+    comp_heat     = 0;
+    comp_cycles   = 0;
+    comp_abort    = 0;
+    comp_run_ms   = 0;
+    comp_reset    = 0;
+    comp_speed    = 0;
+    hw->drive(0);
+    Compactor_Enter((hw->home == NULL || hw->home()) ? COMP_ST_IDLE : COMP_ST_PAUSE); // 不在原位时先收回
+    comp_hw = hw; // 最后设置，之前定时器中断中的Compactor_Tick直接返回
+}
+
+void Compactor_SetConfig(const CompactorConfig_t *cfg)
+{
+    comp_cfg = *cfg;
+}
+
+void Compactor_SetInputs(uint8_t full, uint8_t lid_closed, uint8_t presence)
+{
+    comp_full       = full;
+    comp_lid_closed = lid_closed;
+    comp_presence   = presence;
+}
+
+void Compactor_Abort(void)
+{
+    comp_abort = 1;
+}
+
+void Compactor_Run(void)
+{
+    if (comp_state == COMP_ST_IDLE) comp_run_ms = COMP_RUN_HOLD_MS;
+}
+
+void Compactor_Reset(void)
+{
+    if (comp_state == COMP_ST_FAULT) comp_reset = 1;
+}
+
+void Compactor_Tick(void)
+{
+    uint16_t ma = 0;
+    uint8_t at_end, at_home, stalled;
+    uint32_t heat_max;
+
+    if (comp_hw == NULL) return;
+
+    /* 输入 */
+    if (comp_hw->current_ma != NULL) ma = comp_hw->current_ma();
+    at_end  = comp_hw->end_stop != NULL && comp_hw->end_stop();
+    at_home = comp_hw->home != NULL && comp_hw->home();
+    if (!comp_lid_closed) {
+        comp_lid_ms = 0;
+    } else if (comp_lid_ms < 0xFFFF) {
+        comp_lid_ms++;
+    }
+    if (comp_state_ms < UINT32_MAX) comp_state_ms++;
+
+    /* 堵转：启动电流屏蔽时间后电流持续超限 */
+    if (comp_state_ms > comp_cfg.blank_ms && ma >= comp_cfg.stall_ma) {
+        if (comp_stall_ms < 0xFFFF) comp_stall_ms++;
+    } else {
+        comp_stall_ms = 0;
+    }
+    stalled = comp_stall_ms >= comp_cfg.stall_ms;
+
+    /* 散热 */
+    comp_heat = (comp_heat > comp_cfg.duty_limit) ? comp_heat - comp_cfg.duty_limit : 0;
+    heat_max  = comp_cfg.burst_ms * 100;
+
+    switch (comp_state) {
+        case COMP_ST_IDLE:
+            if (comp_abort) { // 中止同时取消等待中的手动启动
+                comp_abort  = 0;
+                comp_run_ms = 0;
+            }
+            if (!comp_full) comp_tries = 0; // 满溢解除（已清理或压实后不再满）
+            if (comp_since_ms < UINT32_MAX) comp_since_ms++;
+            if (Compactor_CanStart()) {
+                if (!comp_run_ms) comp_tries++;
+                comp_run_ms  = 0;
+                comp_peak_ma = 0;
+                Compactor_Enter(COMP_ST_PRESS);
+                Compactor_Drive((int8_t)Compactor_Ramp(comp_cfg.press_duty));
+            } else if (comp_run_ms) {
+                comp_run_ms--; // 有效时间内启动条件未满足，请求作废
+            }
+            break;
+
+        case COMP_ST_PRESS:
+            if (ma > comp_peak_ma) comp_peak_ma = ma;
+            if (comp_abort || comp_presence || !comp_lid_closed) {
+                comp_abort = 0;
+                Compactor_EndPress(COMP_END_ABORT);
+            } else if (at_end) {
+                Compactor_EndPress(COMP_END_LIMIT);
+            } else if (stalled) {
+                Compactor_EndPress(COMP_END_STALL);
+            } else if (comp_state_ms >= comp_cfg.press_max_ms) {
+                Compactor_EndPress(COMP_END_TIMEOUT);
+            } else if (comp_heat >= heat_max) {
+                Compactor_EndPress(COMP_END_THERMAL);
+            } else {
+                Compactor_Drive((int8_t)Compactor_Ramp(comp_cfg.press_duty));
+            }
+            break;
+
+        case COMP_ST_PAUSE: // 盖子打开时停在此处，关闭后再收回
+            comp_abort = 0;
+            Compactor_Drive(0);
+            if (comp_state_ms >= comp_cfg.pause_ms && comp_lid_closed) {
+                Compactor_Enter(COMP_ST_RETURN);
+                Compactor_Drive(-(int8_t)Compactor_Ramp(comp_cfg.return_duty));
+            }
+            break;
+
+        case COMP_ST_RETURN:
+            comp_abort = 0;
+            if (!comp_lid_closed) {
+                Compactor_Drive(0);
+                Compactor_Enter(COMP_ST_PAUSE);
+            } else if (at_home || (comp_hw->home == NULL && (stalled || comp_state_ms >= comp_cfg.return_max_ms))) {
+                Compactor_Drive(0);
+                Compactor_Enter(COMP_ST_IDLE);
+                comp_since_ms = 0;
+                comp_cycles++;
+            } else if (stalled) {
+                Compactor_Fault(COMP_END_JAM);
+            } else if (comp_state_ms >= comp_cfg.return_max_ms) {
+                Compactor_Fault(COMP_END_LOST);
+            } else {
+                Compactor_Drive(-(int8_t)Compactor_Ramp(comp_cfg.return_duty));
+            }
+            break;
+
+        default: // 故障：电机停止，清除后收回
+            comp_abort  = 0;
+            comp_run_ms = 0;
+            Compactor_Drive(0);
+            if (comp_reset) {
+                comp_reset = 0;
+                Compactor_Enter(at_home ? COMP_ST_IDLE : COMP_ST_PAUSE);
+            }
+            break;
+    }
+}
+
+uint8_t Compactor_LidAllowed(void)
+{
+    return comp_state == COMP_ST_IDLE || comp_state == COMP_ST_FAULT;
+}
+
+uint8_t Compactor_GetState(void)
+{
+    return comp_state;
+}
+
+uint8_t Compactor_GetResult(void)
+{
+    return comp_result;
+}
+
+uint32_t Compactor_GetCycles(void)
+{
+    return comp_cycles;
+}
+
+uint8_t Compactor_GetHeat(void)
+{
+    uint32_t heat_max = comp_cfg.burst_ms * 100;
+
+    if (heat_max < 100 || comp_heat >= heat_max) return 100;
+    return (uint8_t)(comp_heat / (heat_max / 100));
+}
+
+uint16_t Compactor_GetPeak(void)
+{
+    return comp_peak_ma;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file     Compactor.h
+ * @brief    垃圾压缩机控制头文件
+ * @details  垃圾桶满时用直流电机带动压板压实垃圾，一次压缩的过程：
+ *          - 启动条件：已满、盖子关闭超过lid_settle_ms、没有人靠近、距上次压缩超过interval_ms、电机热量已降下来
+ *          - 压下：占空比从start_duty软启动到press_duty，到底限位或堵转（电流超限持续stall_ms）时结束
+ *          - 换向停顿pause_ms后收回：软启动到return_duty，到原位限位时完成
+ *          - 压下过程中有人靠近、盖子打开或超时/过热，立即停机并收回；盖子打开时停机等待
+ *          - 收回堵转或超时为故障，停机锁定，由Compactor_Reset清除
+ *          - 热量按驱动占空比累加、按duty_limit散热，限制电机长期占空比
+ *          由定时器中断每1ms调用Compactor_Tick推进，没有阻塞延时；
+ *          输入由主循环设置（每项一个字节，不需要关中断）
+ *          本模块不依赖硬件，电机和检测输入通过CompactorHw_t函数表接入
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __COMPACTOR_H
+#define __COMPACTOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief 状态
+ */
+#define COMP_ST_IDLE   0 /**< 压板在原位，等待启动 */
+#define COMP_ST_PRESS  1 /**< 压下 */
+#define COMP_ST_PAUSE  2 /**< 换向停顿（盖子打开时在此等待） */
+#define COMP_ST_RETURN 3 /**< 收回 */
+#define COMP_ST_FAULT  4 /**< 故障，电机停止，等待Compactor_Reset */
+
+/**
+ * @brief 压下结束原因/故障原因
+ */
+#define COMP_END_NONE    0 /**< 尚未压缩 */
+#define COMP_END_LIMIT   1 /**< 到底限位 */
+#define COMP_END_STALL   2 /**< 堵转（垃圾已压实） */
+#define COMP_END_TIMEOUT 3 /**< 压下超时 */
+#define COMP_END_ABORT   4 /**< 有人靠近或盖子打开，中止 */
+#define COMP_END_THERMAL 5 /**< 电机过热 */
+#define COMP_END_JAM     6 /**< 故障：收回时堵转 */
+#define COMP_END_LOST    7 /**< 故障：收回超时未到原位 */
+
+/**
+ * @brief 默认参数
+ */
+#define COMP_PRESS_MAX_MS  15000 /**< 压下最长时间（毫秒） */
+#define COMP_RETURN_MAX_MS 15000 /**< 收回最长时间（毫秒） */
+#define COMP_INTERVAL_MS   60000 /**< 两次压缩的最短间隔，等待满溢估计更新（毫秒） */
+#define COMP_BURST_MS      60000 /**< 满功率连续运行此时间达到热量上限（毫秒） */
+#define COMP_RAMP_MS       500   /**< 软启动时间（毫秒） */
+#define COMP_BLANK_MS      300   /**< 启动后不判断堵转的时间，避开启动电流（毫秒） */
+#define COMP_STALL_MS      100   /**< 电流超限持续此时间判定为堵转（毫秒） */
+#define COMP_PAUSE_MS      300   /**< 换向停顿（毫秒） */
+#define COMP_LID_SETTLE_MS 2000  /**< 盖子关闭后等待此时间再启动（毫秒） */
+#define COMP_STALL_MA      1500  /**< 堵转电流（毫安） */
+#define COMP_START_DUTY    20    /**< 软启动初始占空比（%） */
+#define COMP_PRESS_DUTY    100   /**< 压下占空比（%） */
+#define COMP_RETURN_DUTY   70    /**< 收回占空比（%） */
+#define COMP_DUTY_LIMIT    25    /**< 长期占空比上限（%），即散热速率 */
+#define COMP_MAX_TRIES     2     /**< 一次满溢最多连续压缩的次数，满溢解除后清零 */
+#define COMP_RUN_HOLD_MS   5000  /**< 手动启动请求的有效时间，长于盖子关闭等待时间（毫秒） */
+
+/**
+ * @brief 控制参数
+ */
+typedef struct
+{
+    uint32_t press_max_ms;  /**< 压下最长时间 */
+    uint32_t return_max_ms; /**< 收回最长时间 */
+    uint32_t interval_ms;   /**< 两次压缩的最短间隔 */
+    uint32_t burst_ms;      /**< 满功率连续运行达到热量上限的时间 */
+    uint16_t ramp_ms;       /**< 软启动时间 */
+    uint16_t blank_ms;      /**< 启动电流屏蔽时间 */
+    uint16_t stall_ms;      /**< 堵转判定时间 */
+    uint16_t pause_ms;      /**< 换向停顿 */
+    uint16_t lid_settle_ms; /**< 关盖后等待时间 */
+    uint16_t stall_ma;      /**< 堵转电流（毫安） */
+    uint8_t start_duty;     /**< 软启动初始占空比 */
+    uint8_t press_duty;     /**< 压下占空比 */
+    uint8_t return_duty;    /**< 收回占空比 */
+    uint8_t duty_limit;     /**< 长期占空比上限 */
+    uint8_t max_tries;      /**< 一次满溢最多压缩次数 */
+    uint8_t enable;         /**< 满溢自动压缩，0时只能手动启动 */
+} CompactorConfig_t;
+
+/**
+ * @brief 硬件函数表
+ * @note  由Compactor_Tick调用，运行在定时器中断中；检测输入可为NULL
+ */
+typedef struct
+{
+    /**
+     * @brief 驱动电机
+     * @param speed 正值压下，负值收回，0停止，绝对值为占空比（%）
+     */
+    void (*drive)(int8_t speed);
+    /**
+     * @brief 电机电流（毫安），NULL时不判断堵转
+     */
+    uint16_t (*current_ma)(void);
+    /**
+     * @brief 到底限位，1为触发；NULL时压下靠堵转或超时结束
+     */
+    uint8_t (*end_stop)(void);
+    /**
+     * @brief 原位限位，1为触发；NULL时收回堵转或超时即视为到原位
+     */
+    uint8_t (*home)(void);
+} CompactorHw_t;
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Compactor_DefaultConfig(CompactorConfig_t *cfg);
+
+/**
+ * @brief  初始化，电机停止
+ * @details 初始化前Compactor_Tick不做任何事；压板不在原位时先收回
+ * @param  hw  硬件函数表
+ * @param  cfg 控制参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Compactor_Init(const CompactorHw_t *hw, const CompactorConfig_t *cfg);
+
+/**
+ * @brief  修改控制参数
+ * @note   调用期间应关中断，避免Compactor_Tick读到一半修改的参数
+ * @param  cfg 控制参数
+ * @return 无
+ */
+void Compactor_SetConfig(const CompactorConfig_t *cfg);
+
+/**
+ * @brief  设置输入（主循环调用）
+ * @param  full       垃圾桶已满，请求压缩
+ * @param  lid_closed 盖子已关闭
+ * @param  presence   有人靠近（盖子已打开或即将打开）
+ * @return 无
+ */
+void Compactor_SetInputs(uint8_t full, uint8_t lid_closed, uint8_t presence);
+
+/**
+ * @brief  中止压缩：压下中立即停机并收回，原位时取消等待中的手动启动，其他状态无影响
+ * @note   可在中断中调用
+ * @param  无
+ * @return 无
+ */
+void Compactor_Abort(void);
+
+/**
+ * @brief  手动启动一次压缩
+ * @details 只在压板位于原位时有效；不受enable、次数和间隔限制，仍等待盖子关闭、无人靠近和热量降低后启动。
+ *         请求只保留COMP_RUN_HOLD_MS：期间启动条件未满足则作废，不会在很久以后意外启动；
+ *         Compactor_Abort（开盖、有人靠近）立即取消请求
+ * @param  无
+ * @return 无
+ */
+void Compactor_Run(void);
+
+/**
+ * @brief  清除故障，压板不在原位时先收回
+ * @details 只在故障状态有效
+ * @param  无
+ * @return 无
+ */
+void Compactor_Reset(void);
+
+/**
+ * @brief  推进状态机，每1ms调用一次（定时器中断）
+ * @param  无
+ * @return 无
+ */
+void Compactor_Tick(void);
+
+/**
+ * @brief  是否允许开盖（压板在原位或已故障停机）
+ * @param  无
+ * @return 1：允许
+ */
+uint8_t Compactor_LidAllowed(void);
+
+/**
+ * @brief  获取状态
+ * @param  无
+ * @return COMP_ST_x
+ */
+uint8_t Compactor_GetState(void);
+
+/**
+ * @brief  获取上次压下的结束原因或故障原因
+ * @param  无
+ * @return COMP_END_x
+ */
+uint8_t Compactor_GetResult(void);
+
+/**
+ * @brief  获取完成的压缩次数
+ * @param  无
+ * @return 次数
+ */
+uint32_t Compactor_GetCycles(void);
+
+/**
+ * @brief  获取电机热量
+ * @param  无
+ * @return 热量上限的百分比
+ */
+uint8_t Compactor_GetHeat(void);
+
+/**
+ * @brief  获取上次压下的峰值电流
+ * @param  无
+ * @return 电流（毫安）
+ */
+uint16_t Compactor_GetPeak(void);
+
+#endif /* __COMPACTOR_H */
@@ -0,0 +1,333 @@
+/**
+ * @file     Config.c
+ * @brief    运行参数配置存储
+ * @details  Flash记录格式（32位字）：
+ *          - [0] 标识(低16位) | 版本(高16位)
+ *          - [1] 序号，每次保存加1，加载时取序号较大的有效记录
+ *          - [2] 参数个数n
+ *          - [3..3+n-1] 参数值
+ *          - [3+n] CRC32（硬件CRC单元，覆盖前面所有字）
+ *          两页交替写入：保存时总是擦写较旧的一页，
+ *          写入过程中掉电时另一页的记录仍然完整可用
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Config.h"
+#include "stm32f10x.h"
+#include "UART3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONFIG_REC_WORDS (3 + CFG_NUM + 1) /**< 本版本记录长度（字） */
+#define CONFIG_PAGE_NONE 0xFF
+
+/**
+ * @brief 参数描述表
+ */
+static const ConfigDesc_t config_desc[CFG_NUM] = {
+    [CFG_SMOKE_PPM]      = {"smoke_ppm", CFG_TYPE_U16, 50, 5000, 300},
+    [CFG_CLEANUP_S]      = {"cleanup_s", CFG_TYPE_U32, 10, 86400, 180},
+    [CFG_CLOSE_CM]       = {"close_cm", CFG_TYPE_U8, 5, 200, 25},
+    [CFG_CLOSE_DELAY_MS] = {"close_delay_ms", CFG_TYPE_U16, 0, 30000, 1000},
+    [CFG_OPEN_CONF]      = {"open_conf", CFG_TYPE_U8, 30, 100, 60},
+    [CFG_MQ2_R0_X100]    = {"mq2_r0_x100", CFG_TYPE_U16, 100, 10000, 980},
+    [CFG_BIN_EMPTY_MM]   = {"bin_empty_mm", CFG_TYPE_U16, 100, 1900, 600}, // 不超过满溢测距通道量程
+    [CFG_BIN_FULL_MM]    = {"bin_full_mm", CFG_TYPE_U16, 20, 1800, 100},
+    [CFG_MB_ADDR]        = {"mb_addr", CFG_TYPE_U8, 0, 247, 0},
+    [CFG_MB_BAUD]        = {"mb_baud", CFG_TYPE_U32, 1200, 115200, 9600},
+    [CFG_FAN_PPM]        = {"fan_ppm", CFG_TYPE_U16, 5, 2000, 40},
+    [CFG_FAN_TEMP]       = {"fan_temp", CFG_TYPE_U8, 0, 60, 30},
+    [CFG_FAN_QUIET_PCT]  = {"fan_quiet_pct", CFG_TYPE_U8, 0, 100, 40},
+    [CFG_QUIET_START]    = {"quiet_start", CFG_TYPE_U8, 0, 23, 22},
+    [CFG_QUIET_END]      = {"quiet_end", CFG_TYPE_U8, 0, 23, 7},
+    [CFG_COMP_EN]        = {"comp_en", CFG_TYPE_U8, 0, 1, 0}, // 默认关闭，确认限位和电流检测接线后再开启
+    [CFG_COMP_STALL_MA]  = {"comp_stall_ma", CFG_TYPE_U16, 100, 10000, 1500},
+};
+
+uint32_t Config_Values[CFG_NUM];
+
+static uint8_t config_page    = CONFIG_PAGE_NONE; /**< 当前有效记录所在页：0-A，1-B */
+static uint32_t config_seq    = 0;                /**< 当前有效记录的序号 */
+static uint16_t config_gen    = 0;                /**< 参数修改计数 */
+static uint32_t config_rec[CONFIG_REC_WORDS];     /**< 保存时的记录缓冲 */
+static Config_CmdHook_t config_cmd_hook = NULL;   /**< 扩展命令处理函数 */
+
+/**
+ * @brief  页编号转地址
+ */
+static uint32_t Config_PageAddr(uint8_t page)
+{
+    return page ? CONFIG_FLASH_PAGE_B : CONFIG_FLASH_PAGE_A;
+}
+
+/**
+ * @brief  计算CRC32（硬件CRC单元）
+ * @param  buf   数据
+ * @param  words 字数
+ * @return CRC32
+ */
+static uint32_t Config_Crc(const uint32_t *buf, uint32_t words)
+{
+    CRC_ResetDR();
+    return CRC_CalcBlockCRC((uint32_t *)buf, words);
+}
+
+/**
+ * @brief  检查一页中的记录
+ * @param  page 页编号
+ * @param  seq  输出记录序号
+ * @return 记录中的参数个数，0表示无效记录
+ */
+static uint16_t Config_CheckPage(uint8_t page, uint32_t *seq)
+{
+    const uint32_t *rec = (const uint32_t *)Config_PageAddr(page);
+    uint32_t n;
+
+    if ((rec[0] & 0xFFFF) != CONFIG_FLASH_MAGIC || (rec[0] >> 16) != CONFIG_FLASH_VERSION) {
+        return 0;
+    }
+    n = rec[2];
+    if (n == 0 || n > 240) { // 一页1KB最多容纳约250个参数
+        return 0;
+    }
+    if (Config_Crc(rec, 3 + n) != rec[3 + n]) {
+        return 0;
+    }
+    *seq = rec[1];
+    return (uint16_t)n;
+}
+
+/**
+ * @brief  检查参数值是否在范围内
+ */
+static uint8_t Config_InRange(uint8_t id, uint32_t value)
+{
+    return value >= config_desc[id].min && value <= config_desc[id].max;
+}
+
+/**
+ * @brief  配置初始化
+ * @param  无
+ * @return 无
+ */
+void Config_Init(void)
+{
+    uint32_t seq_a = 0, seq_b = 0;
+    uint16_t n_a, n_b, n;
+    const uint32_t *rec;
+    uint8_t i;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    Config_Reset();
+
+    n_a = Config_CheckPage(0, &seq_a);
+    n_b = Config_CheckPage(1, &seq_b);
+    if (n_a && (!n_b || (int32_t)(seq_a - seq_b) > 0)) {
+        config_page = 0;
+        config_seq  = seq_a;
+        n           = n_a;
+    } else if (n_b) {
+        config_page = 1;
+        config_seq  = seq_b;
+        n           = n_b;
+    } else {
+        config_page = CONFIG_PAGE_NONE;
+        config_seq  = 0;
+        return; // 没有保存过，使用默认值
+    }
+
+    rec = (const uint32_t *)Config_PageAddr(config_page);
+    for (i = 0; i < CFG_NUM && i < n; i++) {
+        if (Config_InRange(i, rec[3 + i])) {
+            Config_Values[i] = rec[3 + i];
+        }
+    }
+}
+
+/**
+ * @brief  设置参数值
+ * @param  id    参数编号
+ * @param  value 参数值
+ * @return 0：成功，1：编号错误，2：超出范围
+ */
+uint8_t Config_Set(uint8_t id, uint32_t value)
+{
+    if (id >= CFG_NUM) return 1;
+    if (!Config_InRange(id, value)) return 2;
+
+    Config_Values[id] = value;
+    config_gen++;
+    return 0;
+}
+
+/**
+ * @brief  把当前参数写入Flash
+ * @param  无
+ * @return 0：成功，1：失败
+ */
+uint8_t Config_Save(void)
+{
+    uint8_t page  = (config_page == 0) ? 1 : 0; // 写入另一页
+    uint32_t addr = Config_PageAddr(page);
+    uint32_t seq;
+    uint8_t i;
+    FLASH_Status status;
+
+    config_rec[0] = CONFIG_FLASH_MAGIC | ((uint32_t)CONFIG_FLASH_VERSION << 16);
+    config_rec[1] = config_seq + 1;
+    config_rec[2] = CFG_NUM;
+    for (i = 0; i < CFG_NUM; i++) {
+        config_rec[3 + i] = Config_Values[i];
+    }
+    config_rec[CONFIG_REC_WORDS - 1] = Config_Crc(config_rec, CONFIG_REC_WORDS - 1);
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+    status = FLASH_ErasePage(addr);
+    for (i = 0; i < CONFIG_REC_WORDS && status == FLASH_COMPLETE; i++) {
+        status = FLASH_ProgramWord(addr + 4 * i, config_rec[i]);
+    }
+    FLASH_Lock();
+
+    if (status != FLASH_COMPLETE || Config_CheckPage(page, &seq) != CFG_NUM) {
+        return 1;
+    }
+    config_page = page;
+    config_seq  = seq;
+    return 0;
+}
+
+/**
+ * @brief  恢复全部参数为默认值
+ * @param  无
+ * @return 无
+ */
+void Config_Reset(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < CFG_NUM; i++) {
+        Config_Values[i] = config_desc[i].def;
+    }
+    config_gen++;
+}
+
+/**
+ * @brief  获取参数修改计数
+ * @return 修改计数
+ */
+uint16_t Config_GetGeneration(void)
+{
+    return config_gen;
+}
+
+/**
+ * @brief  按名称查找参数
+ * @param  key 参数名称
+ * @return 参数编号，未找到返回CFG_NUM
+ */
+uint8_t Config_Find(const char *key)
+{
+    uint8_t i;
+
+    for (i = 0; i < CFG_NUM; i++) {
+        if (strcmp(key, config_desc[i].key) == 0) break;
+    }
+    return i;
+}
+
+/**
+ * @brief  获取参数描述
+ * @param  id 参数编号
+ * @return 参数描述
+ */
+const ConfigDesc_t *Config_GetDesc(uint8_t id)
+{
+    return (id < CFG_NUM) ? &config_desc[id] : NULL;
+}
+
+/**
+ * @brief  输出一个参数
+ * @param  id   参数编号
+ * @param  full 1：同时输出范围和默认值
+ */
+static void Config_Print(uint8_t id, uint8_t full)
+{
+    const ConfigDesc_t *d = &config_desc[id];
+    char line[80];
+
+    if (full) {
+        sprintf(line, "%s=%lu [%lu..%lu] def=%lu\r\n", d->key, (unsigned long)Config_Values[id],
+                (unsigned long)d->min, (unsigned long)d->max, (unsigned long)d->def);
+    } else {
+        sprintf(line, "%s=%lu\r\n", d->key, (unsigned long)Config_Values[id]);
+    }
+    UART3_SendString(line);
+}
+
+/**
+ * @brief  处理串口3收到的配置命令
+ * @param  无
+ * @return 无
+ */
+void Config_Poll(void)
+{
+    char line[UART3_RX_BUFFER_SIZE + 1];
+    char *cmd, *rest, *key, *arg, *end;
+    uint8_t id, i;
+    uint32_t value;
+
+    if (UART3_ReadLine(line, sizeof(line)) == 0) return;
+
+    cmd = strtok(line, " \t");
+    if (cmd == NULL) return;
+    rest = strtok(NULL, ""); // 命令之后的全部内容，参数在各命令中再拆分，扩展命令自行解析
+
+    if (strcmp(cmd, "list") == 0) {
+        for (i = 0; i < CFG_NUM; i++) {
+            Config_Print(i, 1);
+        }
+    } else if (strcmp(cmd, "get") == 0) {
+        key = (rest != NULL) ? strtok(rest, " \t") : NULL;
+        id  = (key != NULL) ? Config_Find(key) : CFG_NUM;
+        if (id < CFG_NUM) {
+            Config_Print(id, 0);
+        } else {
+            UART3_SendString("ERR key\r\n");
+        }
+    } else if (strcmp(cmd, "set") == 0) {
+        key = (rest != NULL) ? strtok(rest, " \t") : NULL;
+        arg = (key != NULL) ? strtok(NULL, " \t") : NULL;
+        id  = (key != NULL) ? Config_Find(key) : CFG_NUM;
+        if (id >= CFG_NUM || arg == NULL) {
+            UART3_SendString("ERR key\r\n");
+            return;
+        }
+        value = strtoul(arg, &end, 0);
+        if (*end != '\0' || Config_Set(id, value) != 0) {
+            UART3_SendString("ERR range\r\n");
+            return;
+        }
+        Config_Print(id, 0);
+    } else if (strcmp(cmd, "save") == 0) {
+        UART3_SendString(Config_Save() == 0 ? "OK\r\n" : "ERR flash\r\n");
+    } else if (strcmp(cmd, "reset") == 0) {
+        Config_Reset();
+        UART3_SendString("OK\r\n");
+    } else if (config_cmd_hook == NULL || config_cmd_hook(cmd, rest) != 0) {
+        UART3_SendString("ERR cmd\r\n");
+    }
+}
+
+/**
+ * @brief  注册扩展命令处理函数
+ * @param  hook 处理函数
+ * @return 无
+ */
+void Config_SetCmdHook(Config_CmdHook_t hook)
+{
+    config_cmd_hook = hook;
+}
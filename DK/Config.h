@@ -0,0 +1,162 @@
+/**
+ * @file     Config.h
+ * @brief    运行参数配置存储头文件
+ * @details  提供可在线调整并掉电保存的运行参数：
+ *          - 参数由常量描述表定义：名称、类型、范围、默认值
+ *          - 参数值缓存在RAM中，热路径通过CFG()宏O(1)读取
+ *          - 保存到Flash最后两页，双缓冲交替写入，带版本号、序号和CRC
+ *          - 串口3命令：get/set/list/save/reset
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#include <stdint.h>
+
+/**
+ * @brief 参数编号
+ * @note  新参数只能追加在末尾（CFG_NUM之前），
+ *        旧版本保存的数据按编号加载，新增参数取默认值
+ */
+#define CFG_SMOKE_PPM      0 /**< 烟雾绝对报警阈值下限（PPM） */
+#define CFG_CLEANUP_S      1 /**< 清理超时时间（秒） */
+#define CFG_CLOSE_CM       2 /**< 开盖距离（厘米） */
+#define CFG_CLOSE_DELAY_MS 3 /**< 关盖延迟（毫秒） */
+#define CFG_OPEN_CONF      4 /**< 接近检测开盖置信度（替代原连续触发次数） */
+#define CFG_MQ2_R0_X100    5 /**< MQ2洁净空气电阻R0（0.01kΩ） */
+#define CFG_BIN_EMPTY_MM   6 /**< 满溢测距：传感器到桶底距离（毫米） */
+#define CFG_BIN_FULL_MM    7 /**< 满溢测距：传感器到满溢线距离（毫米） */
+#define CFG_MB_ADDR        8 /**< Modbus从站地址，0表示串口3为命令行（重启生效） */
+#define CFG_MB_BAUD        9 /**< Modbus波特率（重启生效） */
+#define CFG_FAN_PPM        10 /**< 排风扇：超出烟雾基线开始通风的浓度（PPM） */
+#define CFG_FAN_TEMP       11 /**< 排风扇：开始通风的温度（℃） */
+#define CFG_FAN_QUIET_PCT  12 /**< 排风扇：静音时段最大占空比（%） */
+#define CFG_QUIET_START    13 /**< 静音时段开始（时） */
+#define CFG_QUIET_END      14 /**< 静音时段结束（时，不含），与开始相同表示不使用 */
+#define CFG_COMP_EN        15 /**< 垃圾压缩：满溢时自动压缩（0/1） */
+#define CFG_COMP_STALL_MA  16 /**< 垃圾压缩：堵转电流（毫安） */
+#define CFG_NUM            17
+
+/**
+ * @brief 参数类型
+ */
+#define CFG_TYPE_U8  0
+#define CFG_TYPE_U16 1
+#define CFG_TYPE_U32 2
+
+/**
+ * @brief Flash存储位置（STM32F103C8，64KB，每页1KB）
+ */
+#define CONFIG_FLASH_PAGE_A  0x0800F800UL /**< 倒数第二页 */
+#define CONFIG_FLASH_PAGE_B  0x0800FC00UL /**< 最后一页 */
+#define CONFIG_FLASH_MAGIC   0xC0F1       /**< 记录标识 */
+#define CONFIG_FLASH_VERSION 1            /**< 记录格式版本，格式变化时加1 */
+
+/**
+ * @brief 参数描述
+ */
+typedef struct
+{
+    const char *key; /**< 参数名称（串口命令中使用） */
+    uint8_t type;    /**< 参数类型 CFG_TYPE_x */
+    uint32_t min;    /**< 最小值 */
+    uint32_t max;    /**< 最大值 */
+    uint32_t def;    /**< 默认值 */
+} ConfigDesc_t;
+
+/**
+ * @brief 参数值缓存，仅通过CFG()读取
+ */
+extern uint32_t Config_Values[CFG_NUM];
+
+/**
+ * @brief 读取参数值（O(1)）
+ */
+#define CFG(id) (Config_Values[(id)])
+
+/**
+ * @brief  配置初始化
+ * @details 从Flash加载序号最新且校验通过的记录，无有效记录时使用默认值；
+ *          超出范围的参数值恢复为默认值
+ * @param  无
+ * @return 无
+ */
+void Config_Init(void);
+
+/**
+ * @brief  设置参数值（仅修改RAM，需save后才掉电保存）
+ * @param  id    参数编号
+ * @param  value 参数值
+ * @return 0：成功，1：编号错误，2：超出范围
+ */
+uint8_t Config_Set(uint8_t id, uint32_t value);
+
+/**
+ * @brief  把当前参数写入Flash
+ * @details 写入较旧的一页，写入期间CPU暂停取指约20ms
+ * @param  无
+ * @return 0：成功，1：Flash写入或校验失败
+ */
+uint8_t Config_Save(void);
+
+/**
+ * @brief  恢复全部参数为默认值（仅修改RAM）
+ * @param  无
+ * @return 无
+ */
+void Config_Reset(void);
+
+/**
+ * @brief  获取参数修改计数
+ * @details 每次参数被修改时加1，使用者据此判断是否需要重新应用参数
+ * @return 修改计数
+ */
+uint16_t Config_GetGeneration(void);
+
+/**
+ * @brief  按名称查找参数
+ * @param  key 参数名称
+ * @return 参数编号，未找到返回CFG_NUM
+ */
+uint8_t Config_Find(const char *key);
+
+/**
+ * @brief  获取参数描述
+ * @param  id 参数编号
+ * @return 参数描述，编号错误返回NULL
+ */
+const ConfigDesc_t *Config_GetDesc(uint8_t id);
+
+/**
+ * @brief  处理串口3收到的配置命令
+ * @details 在主循环中调用，每次最多处理一行命令：
+ *          - get <key>          读取参数
+ *          - set <key> <value>  修改参数
+ *          - list               列出全部参数及范围
+ *          - save               保存到Flash
+ *          - reset              恢复默认值
+ *          其他命令交给Config_SetCmdHook注册的扩展处理函数
+ * @param  无
+ * @return 无
+ */
+void Config_Poll(void);
+
+/**
+ * @brief 扩展命令处理函数类型
+ * @param  cmd  命令
+ * @param  args 命令之后的参数字符串，可为NULL
+ * @return 0：已处理，1：未识别
+ */
+typedef uint8_t (*Config_CmdHook_t)(char *cmd, char *args);
+
+/**
+ * @brief  注册扩展命令处理函数
+ * @param  hook 处理函数，NULL表示不处理其他命令
+ * @return 无
+ */
+void Config_SetCmdHook(Config_CmdHook_t hook);
+
+#endif /* __CONFIG_H */
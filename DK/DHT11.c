@@ -1,239 +1,259 @@
 /**
  * @file     DHT11.c
  * @brief    DHT11温湿度传感器驱动程序
- * @details  实现DHT11的通信协议和数据读取功能。DHT11使用单总线通信，
- *          需要严格的时序控制。完整的通信过程包括：
- *          1. 主机发送起始信号
- *          2. DHT11响应
- *          3. DHT11连续发送40位数据
- *          4. 数据校验
+ * @details  实现DHT11的异步采集。DHT11使用单总线通信，完整的通信过程包括：
+ *          1. 主机发送起始信号：由TIM1比较通道1定时18ms低电平
+ *          2. DHT11响应：释放总线后由TIM1_CH4下降沿输入捕获
+ *          3. DHT11连续发送40位数据：每个下降沿时刻经DMA写入缓冲区
+ *          4. DMA传输完成中断中按相邻下降沿间隔解码并校验
+ *          整个过程不占用CPU等待，比较通道1同时作为硬超时，
+ *          传感器缺失或数据不全时以DHT11_ERR_TIMEOUT结束
  * @author   DikiFive
  * @date     2025-04-30
- * @version  v1.0
+ * @version  v2.0
  */
 
-#include "dht11.h"
+#include "DHT11.h"
 
-/* 延时函数配置，可根据需要切换不同的延时实现方式 */
-
-#define DHT11_DELAY_US(us) Delay_us(us)
-#define DHT11_DELAY_MS(ms) Delay_ms(ms)
+/** @brief 下降沿捕获时刻（TIM1计数值，1us分辨率） */
+static uint16_t dht11_edges[DHT11_EDGE_NUM];
+/** @brief 最近一次解码得到的数据 */
+static DHT11_Data_TypeDef dht11_result;
+/** @brief 异步采集状态 */
+static volatile uint8_t dht11_state = DHT11_STATE_IDLE;
+/** @brief 最近一次采集的错误码 */
+static volatile uint8_t dht11_error = DHT11_ERR_NONE;
 
 /**
- * @brief  DHT11引脚配置函数（内部使用）
+ * @brief  停止输入捕获和DMA（内部使用）
  */
-static void DHT11_GPIO_Config(void);
+static void DHT11_StopCapture(void)
+{
+    TIM_ITConfig(DHT11_TIM, TIM_IT_CC1, DISABLE);
+    TIM_CCxCmd(DHT11_TIM, TIM_Channel_4, TIM_CCx_Disable);
+    TIM_DMACmd(DHT11_TIM, TIM_DMA_CC4, DISABLE);
+    DMA_Cmd(DHT11_DMA_CHANNEL, DISABLE);
+    DHT11_H; // 释放总线
+}
 
 /**
- * @brief  将DHT11数据引脚配置为上拉输入模式（内部使用）
+ * @brief  解码40位数据（内部使用）
+ * @details 第0个下降沿为响应低电平开始，第1~40个为各数据位开始，
+ *          第41个为结束低电平开始。每位周期 = 50us低电平 + 26~28us或70us高电平，
+ *          即约77us为'0'，约120us为'1'
+ * @return 错误码
  */
-static void DHT11_Mode_IPU(void);
+static uint8_t DHT11_Decode(void)
+{
+    uint8_t bytes[5] = {0};
+    uint8_t i;
+    uint16_t width;
 
-/**
- * @brief  将DHT11数据引脚配置为推挽输出模式（内部使用）
- */
-static void DHT11_Mode_Out_PP(void);
+    /* 响应信号：80us低 + 80us高 */
+    width = dht11_edges[1] - dht11_edges[0];
+    if (width < 120 || width > 220) return DHT11_ERR_FRAME;
 
-/**
- * @brief  从DHT11读取一个字节（内部使用）
- * @return 读取到的字节数据
- * @note   按照DHT11的通信协议，每bit数据的时间编码：
- *         - 26-28us的高电平表示数据'0'
- *         - 70us的高电平表示数据'1'
- */
-static uint8_t DHT11_ReadByte(void);
+    for (i = 0; i < 40; i++) {
+        width = dht11_edges[i + 2] - dht11_edges[i + 1];
+        if (width < 60 || width > 160) return DHT11_ERR_FRAME;
+
+        bytes[i >> 3] <<= 1;
+        if (width > DHT11_BIT1_MIN_US) bytes[i >> 3] |= 0x01; // MSB先行
+    }
+
+    dht11_result.humi_int  = bytes[0];
+    dht11_result.humi_deci = bytes[1];
+    dht11_result.temp_int  = bytes[2];
+    dht11_result.temp_deci = bytes[3];
+    dht11_result.check_sum = bytes[4];
+
+    if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) return DHT11_ERR_CHECKSUM;
+    return DHT11_ERR_NONE;
+}
 
 /**
  * @brief  DHT11初始化
  * @details 完成以下配置：
- *         1. 配置DHT11的数据引脚
- *         2. 设置引脚为推挽输出模式
- *         3. 发送初始电平
+ *         1. PA11配置为开漏输出并释放总线
+ *         2. TIM1：1MHz自由运行计数，通道1为定时比较，通道4为下降沿输入捕获
+ *         3. DMA1通道4：TIM1->CCR4 → dht11_edges，传输完成中断
+ *         4. 配置TIM1比较中断和DMA中断优先级
  * @param  无
  * @return 无
  */
 void DHT11_Init(void)
 {
-    DHT11_GPIO_Config();
+    /*开启时钟*/
+    DHT11_SCK_APBxClock_FUN(DHT11_GPIO_CLK | DHT11_TIM_CLK, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    /*GPIO初始化：开漏输出，外部上拉*/
+    GPIO_InitTypeDef GPIO_InitStructure;
+    GPIO_InitStructure.GPIO_Pin   = DHT11_GPIO_PIN;
+    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_OD;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStructure);
+    DHT11_H;
 
-    DHT11_H; // 拉高GPIOB10
+    /*时基单元初始化：1MHz，自由运行*/
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    TIM_TimeBaseInitStructure.TIM_ClockDivision     = TIM_CKD_DIV1;
+    TIM_TimeBaseInitStructure.TIM_CounterMode       = TIM_CounterMode_Up;
+    TIM_TimeBaseInitStructure.TIM_Period            = 0xFFFF;
+    TIM_TimeBaseInitStructure.TIM_Prescaler         = 72 - 1;
+    TIM_TimeBaseInitStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(DHT11_TIM, &TIM_TimeBaseInitStructure);
+
+    /*通道1：定时比较，不输出到引脚*/
+    TIM_OCInitTypeDef TIM_OCInitStructure;
+    TIM_OCStructInit(&TIM_OCInitStructure);
+    TIM_OCInitStructure.TIM_OCMode      = TIM_OCMode_Timing;
+    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Disable;
+    TIM_OC1Init(DHT11_TIM, &TIM_OCInitStructure);
+
+    /*通道4：下降沿输入捕获，轻度滤波*/
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+    TIM_ICInitStructure.TIM_Channel     = TIM_Channel_4;
+    TIM_ICInitStructure.TIM_ICPolarity  = TIM_ICPolarity_Falling;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter    = 0x3;
+    TIM_ICInit(DHT11_TIM, &TIM_ICInitStructure);
+    TIM_CCxCmd(DHT11_TIM, TIM_Channel_4, TIM_CCx_Disable);
+
+    /*DMA初始化：CCR4 → dht11_edges*/
+    DMA_InitTypeDef DMA_InitStructure;
+    DMA_DeInit(DHT11_DMA_CHANNEL);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&DHT11_TIM->CCR4;
+    DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)dht11_edges;
+    DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize         = DHT11_EDGE_NUM;
+    DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode               = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority           = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;
+    DMA_Init(DHT11_DMA_CHANNEL, &DMA_InitStructure);
+    DMA_ITConfig(DHT11_DMA_CHANNEL, DMA_IT_TC, ENABLE);
+
+    /*NVIC中断优先级配置*/
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
+    NVIC_InitTypeDef NVIC_InitStructure;
+    NVIC_InitStructure.NVIC_IRQChannel                   = TIM1_CC_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelCmd                = ENABLE;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 2;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    /*使能定时器*/
+    TIM_Cmd(DHT11_TIM, ENABLE);
+    dht11_state = DHT11_STATE_IDLE;
 }
 
 /**
- * @brief  配置DHT11用到的GPIO引脚
- * @details 配置过程：
- *         1. 使能GPIO时钟
- *         2. 配置GPIO为推挽输出模式
- *         3. 设置GPIO速度为50MHz
+ * @brief  启动一次异步采集
+ * @details 拉低总线并设置18ms后的比较中断，随即返回
  * @param  无
- * @return 无
+ * @return 0：已启动，1：忙
  */
-static void DHT11_GPIO_Config(void)
+uint8_t DHT11_StartAsync(void)
 {
-    /*定义一个GPIO_InitTypeDef类型的结构体*/
-    GPIO_InitTypeDef GPIO_InitStructure;
-
-    /*开启DHT11_Dout_GPIO_PORT的外设时钟*/
-    DHT11_SCK_APBxClock_FUN(DHT11_GPIO_CLK, ENABLE);
+    if (dht11_state != DHT11_STATE_IDLE) return 1;
 
-    /*选择要控制的DHT11_Dout_GPIO_PORT引脚*/
-    GPIO_InitStructure.GPIO_Pin = DHT11_GPIO_PIN;
+    dht11_error = DHT11_ERR_NONE;
+    dht11_state = DHT11_STATE_START;
+    DHT11_L; // 主机拉低
 
-    /*设置引脚模式为通用推挽输出*/
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
-
-    /*设置引脚速率为50MHz */
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-
-    /*调用库函数，初始化DHT11_Dout_GPIO_PORT*/
-    GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStructure);
+    TIM_SetCompare1(DHT11_TIM, (uint16_t)(TIM_GetCounter(DHT11_TIM) + DHT11_START_US));
+    TIM_ClearITPendingBit(DHT11_TIM, TIM_IT_CC1);
+    TIM_ITConfig(DHT11_TIM, TIM_IT_CC1, ENABLE);
+    return 0;
 }
 
 /**
- * @brief  将DHT11数据线配置为上拉输入模式
- * @details 用于接收DHT11发送的数据时，
- *         需要将数据线切换为输入模式
- * @param  无
- * @return 无
+ * @brief  获取异步采集状态
+ * @return DHT11_STATE_x
  */
-static void DHT11_Mode_IPU(void)
+uint8_t DHT11_GetState(void)
 {
-    GPIO_InitTypeDef GPIO_InitStructure;
-
-    /*选择要控制的DHT11_Dout_GPIO_PORT引脚*/
-    GPIO_InitStructure.GPIO_Pin = DHT11_GPIO_PIN;
-
-    /*设置引脚模式为浮空输入模式*/
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
-
-    /*调用库函数，初始化DHT11_Dout_GPIO_PORT*/
-    GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStructure);
+    return dht11_state;
 }
 
 /**
- * @brief  将DHT11数据线配置为推挽输出模式
- * @details 用于主机发送起始信号时，
- *         需要将数据线切换为输出模式
- * @param  无
- * @return 无
+ * @brief  取走异步采集结果
+ * @param  DHT11_Data 输出温湿度数据
+ * @return 错误码，空闲或采集中调用时返回DHT11_ERR_TIMEOUT且不改变状态
  */
-static void DHT11_Mode_Out_PP(void)
+uint8_t DHT11_GetResult(DHT11_Data_TypeDef *DHT11_Data)
 {
-    GPIO_InitTypeDef GPIO_InitStructure;
-
-    /*选择要控制的DHT11_Dout_GPIO_PORT引脚*/
-    GPIO_InitStructure.GPIO_Pin = DHT11_GPIO_PIN;
-
-    /*设置引脚模式为通用推挽输出*/
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
-
-    /*设置引脚速率为50MHz */
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    uint8_t err;
+
+    if (dht11_state == DHT11_STATE_DONE) {
+        err = DHT11_ERR_NONE;
+    } else if (dht11_state == DHT11_STATE_ERROR) {
+        err = dht11_error;
+    } else {
+        return DHT11_ERR_TIMEOUT; // 空闲或采集中，没有可取的结果
+    }
 
-    /*调用库函数，初始化DHT11_Dout_GPIO_PORT*/
-    GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStructure);
+    *DHT11_Data = dht11_result;
+    dht11_state = DHT11_STATE_IDLE;
+    return err;
 }
 
 /**
- * @brief  从DHT11读取一个字节
- * @details 按照DHT11的通信协议读取8位数据：
- *         1. 每位数据以50us低电平开始
- *         2. 接着是26-28us或70us的高电平，表示0或1
- *         3. 按照MSB（最高位）先行的顺序接收
- * @return 读取到的字节数据
+ * @brief  TIM1捕获比较中断服务函数
+ * @details 通道1比较事件：
+ *         - 起始阶段：18ms到，先开启捕获再释放总线，并设置帧超时
+ *         - 捕获阶段：帧超时到，DMA仍未收满，判定为超时
+ * @note   此函数会被硬件自动调用
  */
-static uint8_t DHT11_ReadByte(void)
+void TIM1_CC_IRQHandler(void)
 {
-    uint8_t i, temp = 0;
-
-    for (i = 0; i < 8; i++) {
-        /*每bit以50us低电平标置开始，轮询直到从机发出 的50us 低电平 结束*/
-        while (DHT11_IN() == Bit_RESET);
-
-        /*DHT11 以26~28us的高电平表示“0”，以70us高电平表示“1”，
-         *通过检测 x us后的电平即可区别这两个状 ，x 即下面的延时
-         */
-        DHT11_DELAY_US(40); // 延时x us 这个延时需要大于数据0持续的时间即可
-
-        if (DHT11_IN() == Bit_SET) /* x us后仍为高电平表示数据“1” */
-        {
-            /* 等待数据1的高电平结束 */
-            while (DHT11_IN() == Bit_SET);
-
-            temp |= (uint8_t)(0x01 << (7 - i)); // 把第7-i位置1，MSB先行
-        } else                                  // x us后为低电平表示数据“0”
-        {
-            temp &= (uint8_t)~(0x01 << (7 - i)); // 把第7-i位置0，MSB先行
+    if (TIM_GetITStatus(DHT11_TIM, TIM_IT_CC1) == SET) {
+        TIM_ClearITPendingBit(DHT11_TIM, TIM_IT_CC1);
+
+        if (dht11_state == DHT11_STATE_START) {
+            /* 准备DMA并开启下降沿捕获 */
+            DMA_Cmd(DHT11_DMA_CHANNEL, DISABLE);
+            DMA_SetCurrDataCounter(DHT11_DMA_CHANNEL, DHT11_EDGE_NUM);
+            DMA_ClearITPendingBit(DMA1_IT_GL4);
+            DMA_Cmd(DHT11_DMA_CHANNEL, ENABLE);
+            TIM_ClearFlag(DHT11_TIM, TIM_FLAG_CC4);
+            TIM_DMACmd(DHT11_TIM, TIM_DMA_CC4, ENABLE);
+            TIM_CCxCmd(DHT11_TIM, TIM_Channel_4, TIM_CCx_Enable);
+
+            DHT11_H; // 释放总线，等待从机响应
+            TIM_SetCompare1(DHT11_TIM, (uint16_t)(TIM_GetCounter(DHT11_TIM) + DHT11_FRAME_TIMEOUT_US));
+            dht11_state = DHT11_STATE_CAPTURE;
+        } else if (dht11_state == DHT11_STATE_CAPTURE) {
+            DHT11_StopCapture();
+            dht11_error = DHT11_ERR_TIMEOUT;
+            dht11_state = DHT11_STATE_ERROR;
+        } else {
+            TIM_ITConfig(DHT11_TIM, TIM_IT_CC1, DISABLE);
         }
     }
-
-    return temp;
 }
 
 /**
- * @brief  从DHT11读取温湿度数据
- * @details 完整的数据传输过程：
- *         1. 主机发送起始信号（拉低18ms，再拉高30us）
- *         2. 等待DHT11响应（低80us，高80us）
- *         3. 接收40位数据：
- *            - 8位湿度整数
- *            - 8位湿度小数
- *            - 8位温度整数
- *            - 8位温度小数
- *            - 8位校验和
- * @param  DHT11_Data 存储读取到的温湿度数据
- * @return 操作结果：
- *         - SUCCESS: 读取成功
- *         - ERROR: 读取失败
+ * @brief  DMA1通道4中断服务函数
+ * @details 42个下降沿全部捕获完成，停止捕获并解码
+ * @note   此函数会被硬件自动调用
  */
-uint8_t DHT11_Read_TempAndHumidity(DHT11_Data_TypeDef *DHT11_Data)
+void DMA1_Channel4_IRQHandler(void)
 {
-    /*输出模式*/
-    DHT11_Mode_Out_PP();
-    /*主机拉低*/
-    DHT11_L;
-    /*延时18ms*/
-    DHT11_DELAY_MS(18);
-
-    /*总线拉高 主机延时30us*/
-    DHT11_H;
-
-    DHT11_DELAY_US(30); // 延时30us
-
-    /*主机设为输入 判断从机响应信号*/
-    DHT11_Mode_IPU();
-
-    /*判断从机是否有低电平响应信号 如不响应则跳出，响应则向下运行*/
-    if (DHT11_IN() == Bit_RESET) {
-        /*轮询直到从机发出 的80us 低电平 响应信号结束*/
-        while (DHT11_IN() == Bit_RESET);
-
-        /*轮询直到从机发出的 80us 高电平 标置信号结束*/
-        while (DHT11_IN() == Bit_SET);
-
-        /*开始接收数据*/
-        DHT11_Data->humi_int = DHT11_ReadByte();
-
-        DHT11_Data->humi_deci = DHT11_ReadByte();
+    if (DMA_GetITStatus(DMA1_IT_TC4) == SET) {
+        DMA_ClearITPendingBit(DMA1_IT_GL4);
 
-        DHT11_Data->temp_int = DHT11_ReadByte();
-
-        DHT11_Data->temp_deci = DHT11_ReadByte();
-
-        DHT11_Data->check_sum = DHT11_ReadByte();
-
-        /*读取结束，引脚改为输出模式*/
-        DHT11_Mode_Out_PP();
-        /*主机拉高*/
-        DHT11_H;
-
-        /*检查读取的数据是否正确*/
-        if (DHT11_Data->check_sum == DHT11_Data->humi_int + DHT11_Data->humi_deci + DHT11_Data->temp_int + DHT11_Data->temp_deci)
-            return SUCCESS;
-        else
-            return ERROR;
+        if (dht11_state == DHT11_STATE_CAPTURE) {
+            DHT11_StopCapture();
+            dht11_error = DHT11_Decode();
+            dht11_state = (dht11_error == DHT11_ERR_NONE) ? DHT11_STATE_DONE : DHT11_STATE_ERROR;
+        }
     }
-
-    else
-        return ERROR;
 }
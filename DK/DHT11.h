@@ -4,16 +4,18 @@
  * @details  定义了DHT11相关的：
  *          - 数据结构
  *          - 硬件连接配置
+ *          - 异步采集状态
  *          - 功能函数接口
  * @author   DikiFive
  * @date     2025-04-30
- * @version  v1.0
+ * @version  v2.0
  */
 
 #ifndef __DHT11_H
 #define __DHT11_H
 
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
+#include "FastGPIO.h"
 
 /**
  * @brief   DHT11测量数据结构体
@@ -31,34 +33,78 @@ typedef struct
 
 /**
  * @brief DHT11硬件连接定义
- * @note  修改这些宏定义可以改变DHT11的连接引脚
+ * @note  数据线接PA11（TIM1_CH4），由TIM1输入捕获+DMA1通道4接收。
+ *        原PB0与底部红外传感器冲突，且TIM3已被PWM占用
  */
-#define DHT11_SCK_APBxClock_FUN RCC_APB2PeriphClockCmd  /**< GPIO时钟使能函数 */
-#define DHT11_GPIO_CLK          RCC_APB2Periph_GPIOB    /**< GPIO时钟 */
-#define DHT11_GPIO_PORT         GPIOB                    /**< GPIO端口 */
-#define DHT11_GPIO_PIN          GPIO_Pin_0               /**< GPIO引脚 */
+#define DHT11_SCK_APBxClock_FUN RCC_APB2PeriphClockCmd /**< GPIO时钟使能函数 */
+#define DHT11_GPIO_CLK          RCC_APB2Periph_GPIOA   /**< GPIO时钟 */
+#define DHT11_GPIO_PORT         GPIOA                  /**< GPIO端口 */
+#define DHT11_GPIO_PIN          GPIO_Pin_11            /**< GPIO引脚 */
+#define DHT11_PIN               FGPIO(GPIOA, 11)       /**< 快速GPIO引脚描述，与上面的端口/引脚一致 */
+#define DHT11_TIM               TIM1                   /**< 起始脉冲定时与输入捕获定时器 */
+#define DHT11_TIM_CLK           RCC_APB2Periph_TIM1    /**< 定时器时钟 */
+#define DHT11_DMA_CHANNEL       DMA1_Channel4          /**< TIM1_CH4对应的DMA通道 */
+
+/**
+ * @brief DHT11时序参数（单位：微秒，定时器计数频率1MHz）
+ */
+#define DHT11_START_US          18000 /**< 主机起始低电平时间 */
+#define DHT11_FRAME_TIMEOUT_US  6000  /**< 释放总线后等待完整40位数据的最长时间 */
+#define DHT11_EDGE_NUM          42    /**< 一帧的下降沿数：响应1个+数据40个+结束1个 */
+#define DHT11_BIT1_MIN_US       100   /**< 一位周期（50us低+高电平）大于此值判为'1' */
 
 /**
  * @brief DHT11输入输出控制宏
- * @note  用于控制DHT11数据线的电平和读取数据
+ * @note  引脚配置为开漏输出：写1即释放总线，输入捕获与IDR仍可读取引脚电平，
+ *        收发切换无需重新调用GPIO_Init
+ */
+#define DHT11_L                 (DHT11_GPIO_PORT->BRR = DHT11_GPIO_PIN)                          /**< 输出低电平 */
+#define DHT11_H                 (DHT11_GPIO_PORT->BSRR = DHT11_GPIO_PIN)                         /**< 释放总线 */
+#define DHT11_IN()              FGPIO_BB_IN(DHT11_PIN)                                           /**< 读取引脚电平（位带） */
+
+/**
+ * @brief DHT11异步采集状态
  */
-#define DHT11_L                 GPIO_ResetBits(DHT11_GPIO_PORT, DHT11_GPIO_PIN) /**< 输出低电平 */
-#define DHT11_H                 GPIO_SetBits(DHT11_GPIO_PORT, DHT11_GPIO_PIN)   /**< 输出高电平 */
-#define DHT11_IN()             GPIO_ReadInputDataBit(DHT11_GPIO_PORT, DHT11_GPIO_PIN) /**< 读取引脚电平 */
+#define DHT11_STATE_IDLE        0 /**< 空闲，可启动新的采集 */
+#define DHT11_STATE_START       1 /**< 正在发送起始低电平 */
+#define DHT11_STATE_CAPTURE     2 /**< 正在捕获数据位 */
+#define DHT11_STATE_DONE        3 /**< 采集成功，等待取走结果 */
+#define DHT11_STATE_ERROR       4 /**< 采集失败，等待取走结果 */
+
+/**
+ * @brief DHT11错误码
+ */
+#define DHT11_ERR_NONE          0 /**< 无错误 */
+#define DHT11_ERR_TIMEOUT       1 /**< 传感器无响应或数据未收全 */
+#define DHT11_ERR_FRAME         2 /**< 响应或位宽度不符合协议 */
+#define DHT11_ERR_CHECKSUM      3 /**< 校验和错误 */
 
 /**
  * @brief  DHT11初始化函数
+ * @details 配置开漏引脚、TIM1时基和DMA通道
  * @return 无
  */
 void DHT11_Init(void);
 
 /**
- * @brief  读取DHT11的温湿度数据
- * @param  DHT11_Data 指向存储测量数据的结构体的指针
- * @return 操作结果
- *         - SUCCESS: 读取成功
- *         - ERROR: 读取失败
+ * @brief  启动一次异步采集
+ * @details 立即返回，起始脉冲、数据捕获和解码均在中断中完成
+ * @return 0：已启动，1：上一次采集尚未结束或结果未取走
+ */
+uint8_t DHT11_StartAsync(void);
+
+/**
+ * @brief  获取异步采集状态
+ * @return DHT11_STATE_x
+ */
+uint8_t DHT11_GetState(void);
+
+/**
+ * @brief  取走异步采集结果
+ * @details 取走后状态回到空闲
+ * @param  DHT11_Data 输出温湿度数据（仅成功时有效）
+ * @return 错误码DHT11_ERR_x，DHT11_ERR_NONE表示成功
  */
-uint8_t DHT11_Read_TempAndHumidity(DHT11_Data_TypeDef *DHT11_Data);
+uint8_t DHT11_GetResult(DHT11_Data_TypeDef *DHT11_Data);
 
 #endif /* __DHT11_H */
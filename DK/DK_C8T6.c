@@ -1,265 +1,905 @@
 #include "DK_C8T6.h"
-
-/*  */
-#define SMOKE_THRESHOLD_PPM 300  // Ũȱֵ(PPM)
-#define CLEANUP_TIMEOUT_S   10   // ʱʱ(3)
-#define WINDOW_SIZE         5    // ƽڴС
-#define TRIGGER_THRESHOLD   3    // ֵ
-#define CLOSE_DISTANCE      50   // ͰǴ򿪾()
-#define CLOSE_DELAY_MS      1000 // Ͱǹرӳʱ()
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* 壨ɵConfig.cͨ3޸ģ */
+#define SONAR_PERIOD_MS    60 // ӽڣHC-SR04С60ms
+#define MIRROR_TX_RESERVE  64 // ʾڴ3ͻΪֽ
+
+/* ModbusĴӳ䣬readme */
+#define MB_IR_STATUS       0   // ״̬λbit0 bit1 bit2 bit3Ԥ bit4ʱ bit5Ԥ bit6ѹ
+#define MB_IR_TRASH        1   // Ͱ״̬ 0- 1- 2-
+#define MB_IR_FILL_PM      2   // ǧֱ
+#define MB_IR_FILL_CONF    3   // Ŷ
+#define MB_IR_FILL_RATE    4   // ʣ0.1%/Сʱзţ
+#define MB_IR_FILL_TTF     5   // Ԥװʣʱ䣨ӣ0xFFFF޷Ԥ
+#define MB_IR_SMOKE_PPM    6   // Ũ
+#define MB_IR_SMOKE_LEVEL  7   // ȼ
+#define MB_IR_LID_MM       8   // ӽƽ루ף
+#define MB_IR_FILL_MM      9   // 루ף0Ϊ޻ز
+#define MB_IR_TEMP         10  // ¶ȣ0.1棬зţ
+#define MB_IR_HUMI         11  // ʪȣ0.1%RH
+#define MB_IR_LID_OPENS    12  // Ǵ32λǰռ2Ĵ
+#define MB_IR_UPTIME       14  // ʱ䣨룬32λ
+#define MB_IR_SINCE_CLEAN  16  // ϴ룬32λ
+#define MB_IR_MB_FRAMES    18  // յЧ16λ
+#define MB_IR_MB_CRC_ERR   19  // CRC֡16λ
+#define MB_IR_MB_EXCEPT    20  // 쳣Ӧ16λ
+#define MB_IR_FAN_DUTY     21  // ŷռձȣ%
+#define MB_IR_COMP_STATE   22  // ѹ״ֽ̬ڣϴνԭ򣨸ֽڣ
+#define MB_IR_COMP_CYCLES  23  // ɵѹ16λ
+#define MB_IR_NUM          24
+#define MB_HR_CMD          100 // Ĵд1Flashд2ָĬϲ
+#define MB_CMD_SAVE        1
+#define MB_CMD_RESET       2
 
 /* ȫֱ */
-static uint32_t last_cleanup_time   = 0; // ϴʱ(ϵͳ)
-static uint8_t trash_status         = 0; // Ͱ״̬: 0-, 1-, 2-
-static uint8_t display_needs_update = 1; // OLEDʾ±־
-static uint8_t time_overflow        = 0; // ʱ־
-static uint8_t smoke_alert_active   = 0; // ־
-static uint8_t cleanup_alert_active = 0; // ʱ־
+static TrashBin_t bin;              // Ͱ߼״̬TrashBin.c
+static uint16_t bin_cfg_gen    = 0; // ӦõͰĲ޸ļ
+static uint16_t dht11_last_seq = 0; // У׼DHT11
+static uint8_t dht11_seq_valid = 0; // dht11_last_seqǷЧŴ0ʼ0ʾû
+static uint8_t mb_save_pending = 0; // Modbus󱣴Ӧִ
+static Vent_t vent;                 // ŷͨƣVentilation.h
+static uint16_t vent_cfg_gen   = 0; // ӦõͨƵĲ޸ļ
+static uint16_t comp_cfg_gen   = 0; // ӦõѹĲ޸ļ
+static uint8_t lid_servo_open  = 0; // Ѵ򿪸
+
+/* ѹӲûλػʱӦΪNULLCompactor.h */
+static const CompactorHw_t comp_hw = {
+    Motor_SetSpeed,
+#if MOTOR_SENSE_EN
+    Motor_GetCurrent,
+#else
+    NULL,
+#endif
+#if MOTOR_LIMIT_EN
+    Motor_AtEnd,
+    Motor_AtHome,
+#else
+    NULL,
+    NULL,
+#endif
+};
+
+/* ʾ񣺴3 "mirror on" ҳֱ뷢ĻݣOledMirror.h */
+static Mirror_t mirror;
+static uint8_t mirror_on = 0;
+static uint8_t mirror_buf[MIRROR_FRAME_MAX];
+
+/* ModbusվַΪ0ʱ3ģʽ */
+static uint8_t MB_Read(void *ctx, uint8_t table, uint16_t reg, uint16_t *value);
+static uint8_t MB_Write(void *ctx, uint16_t reg, const uint8_t *data, uint16_t count);
+static Modbus_Slave_t mb_slave = {0, NULL, MB_Read, MB_Write, 0, 0, 0};
+static uint8_t mb_req[MODBUS_FRAME_MAX];
+static uint8_t mb_rsp[MODBUS_FRAME_MAX];
+
+/* ɼ䣺ѸķԼͳһΪ ֵ+־ */
+static uint8_t Acquire_Sonar(int32_t *value, uint8_t *quality)
+{
+    int16_t mm = sonar_mm();
+    *value     = mm;
+    *quality   = (mm == 0) ? SENSOR_Q_TIMEOUT : SENSOR_Q_OK; // sonar_mmʱ0
+    return SENSOR_ACQ_DONE;
+}
+
+// ӽ⹲òߣֻڸӹرաһνӽൽǰʱִ
+static uint8_t Acquire_Fill(int32_t *value, uint8_t *quality)
+{
+    SensorSample_t lid;
+    int16_t mm;
+
+    SensorHub_Read(SENSOR_ID_SONAR, &lid);
+    if (bin.lid_is_open || (lid.quality & SENSOR_Q_NODATA) ||
+        (uint32_t)(system_runtime_ms - lid.timestamp) + HC_SR04_FILL_WORST_MS > SONAR_PERIOD_MS) {
+        return SENSOR_ACQ_DEFER;
+    }
 
-/* ر */
-static uint8_t distance_readings[WINDOW_SIZE]; // 洢Ĳֵ
-static uint8_t reading_index         = 0;      // ǰ洢λ
-static uint8_t trigger_count         = 0;      // 
-static uint32_t lid_close_time       = 0;      // ͰԤرʱ
-static uint8_t lid_closing_scheduled = 0;      // ͰǷڵȴر
+    mm       = HC_SR04_Measure(HC_SR04_CH_FILL);
+    *value   = mm;
+    *quality = (mm == 0) ? SENSOR_Q_TIMEOUT : SENSOR_Q_OK;
+    return SENSOR_ACQ_DONE;
+}
 
-// 㻬ƽ
-static uint8_t calculate_average_distance(void)
+static uint8_t Acquire_Smoke(int32_t *value, uint8_t *quality)
 {
-    uint32_t sum = 0;
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        sum += distance_readings[i];
+    uint16_t ppm;
+
+    if (!MQ2_PollPPM(system_runtime_ms, &ppm)) return SENSOR_ACQ_BUSY; // ÿ5msһADCѭ
+    *value   = ppm;
+    *quality = (ppm <= 1 || ppm >= 9999) ? SENSOR_Q_RANGE : SENSOR_Q_OK; // 1/9999Ϊǯλֵ
+    return SENSOR_ACQ_DONE;
+}
+
+static uint8_t Acquire_IRBottom(int32_t *value, uint8_t *quality)
+{
+    *value   = Sensor_GetValue();
+    *quality = SENSOR_Q_OK;
+    return SENSOR_ACQ_DONE;
+}
+
+static uint8_t Acquire_IRTop(int32_t *value, uint8_t *quality)
+{
+    *value   = Sensor_GetValue2();
+    *quality = SENSOR_Q_OK;
+    return SENSOR_ACQ_DONE;
+}
+
+static uint8_t Acquire_DHT11(int32_t *value, uint8_t *quality)
+{
+    DHT11_Data_TypeDef data;
+    int16_t temp_x10;
+    uint8_t err;
+
+    switch (DHT11_GetState()) {
+        case DHT11_STATE_IDLE: // УµĲɼ
+            DHT11_StartAsync();
+            return SENSOR_ACQ_BUSY;
+        case DHT11_STATE_START: // ʼݲ
+        case DHT11_STATE_CAPTURE:
+            return SENSOR_ACQ_BUSY;
+        default:
+            break;
     }
-    return sum / WINDOW_SIZE;
+
+    err      = DHT11_GetResult(&data);
+    temp_x10 = data.temp_int * 10 + (data.temp_deci & 0x7F);
+    if (data.temp_deci & 0x80) temp_x10 = -temp_x10; // СֽλΪ¶ȱ־
+    *value   = SENSOR_DHT11_PACK(temp_x10, data.humi_int * 10 + data.humi_deci);
+    *quality = (err == DHT11_ERR_NONE)       ? SENSOR_Q_OK
+               : (err == DHT11_ERR_TIMEOUT) ? SENSOR_Q_TIMEOUT
+                                            : SENSOR_Q_CHECKSUM;
+    return SENSOR_ACQ_DONE;
 }
 
-void HandleUltrasonicSensor(void)
+static const SensorDesc_t sonar_desc     = {"sonar", SONAR_PERIOD_MS, SENSOR_BUS_SONAR, Acquire_Sonar};
+static const SensorDesc_t fill_desc      = {"fill", 1000, SENSOR_BUS_SONAR, Acquire_Fill};
+static const SensorDesc_t smoke_desc     = {"smoke", 500, SENSOR_BUS_ADC, Acquire_Smoke};  // MQ2ÿβԼ50ms첽
+static const SensorDesc_t ir_bottom_desc = {"ir_bottom", 20, SENSOR_BUS_GPIO, Acquire_IRBottom};
+static const SensorDesc_t ir_top_desc    = {"ir_top", 20, SENSOR_BUS_GPIO, Acquire_IRTop};
+static const SensorDesc_t dht11_desc     = {"dht11", 2000, SENSOR_BUS_ONEWIRE, Acquire_DHT11}; // DHT11βɼټ1s
+
+// עд
+static void RegisterSensors(void)
 {
-    uint8_t raw_distance = sonar_mm(); // ȡԭʼֵ
+    SensorHub_Init();
+    SensorHub_Register(SENSOR_ID_SONAR, &sonar_desc);
+    SensorHub_Register(SENSOR_ID_SMOKE, &smoke_desc);
+    SensorHub_Register(SENSOR_ID_IR_BOTTOM, &ir_bottom_desc);
+    SensorHub_Register(SENSOR_ID_IR_TOP, &ir_top_desc);
+    SensorHub_Register(SENSOR_ID_DHT11, &dht11_desc);
+    SensorHub_Register(SENSOR_ID_FILL, &fill_desc);
+}
+
+void PollSensors(void)
+{
+    SensorSample_t th;
 
-    // µԭʼݴ뻬
-    distance_readings[reading_index] = raw_distance;
-    reading_index                    = (reading_index + 1) % WINDOW_SIZE; // ʵѭ洢
+    SensorHub_Poll(system_runtime_ms);
 
-    // 㻬ƽ
-    uint8_t avg_distance = calculate_average_distance();
+    if (bin_cfg_gen != Config_GetGeneration()) { // ޸
+        TrashBin_ApplyConfig(&bin);
+        bin_cfg_gen = Config_GetGeneration();
+    }
 
-    // ʹƽ߼жϣ
-    if (avg_distance < CLOSE_DISTANCE) { // 
-        if (trigger_count < TRIGGER_THRESHOLD) {
+    // ʪȸʱУ׼
+    if (SensorHub_Read(SENSOR_ID_DHT11, &th) == SENSOR_Q_OK && (!dht11_seq_valid || th.seq != dht11_last_seq)) {
+        dht11_last_seq  = th.seq;
+        dht11_seq_valid = 1;
+        RangeCal_Update(SENSOR_DHT11_TEMP(th.value), SENSOR_DHT11_HUMI(th.value));
+    }
+}
 
-            trigger_count++;
+/* ͰӲ󶨣SensorHubִΪLEDͷ */
+static uint8_t Bin_Read(void *ctx, uint8_t id, SensorSample_t *out)
+{
+    (void)ctx;
+    return SensorHub_Read(id, out);
+}
+
+// 硢Ӻͽӽ״̬ѹ
+static void Comp_UpdateInputs(void)
+{
+    Compactor_SetInputs(bin.trash_status == TRASHBIN_FULL, !lid_servo_open, bin.lid_is_open);
+}
+
+// /رͰǣѹ岻ԭλʱǲֹѹظǷ
+static uint8_t Lid_Set(uint8_t open)
+{
+    if (open && !lid_servo_open) {
+        Compactor_SetInputs(bin.trash_status == TRASHBIN_FULL, 0, 1); // ֹѹټ״̬
+        if (!Compactor_LidAllowed()) {
+            Compactor_Abort(); // ջغٿǣӽʱٴ
+            Comp_UpdateInputs();
+            return 0;
+        }
+    }
+    Servo_SetAngle(open ? 75.0f : 0.0f); // /رͰ
+    lid_servo_open = open;
+    Comp_UpdateInputs();
+    return open;
+}
+
+static uint8_t Bin_Lid(void *ctx, uint8_t open)
+{
+    uint8_t was_open = lid_servo_open;
+    uint8_t is_open;
+
+    (void)ctx;
+    is_open = Lid_Set(open);
+    if (is_open && !was_open) Voice_Play(VOICE_ID_LID_OPEN);
+    return is_open;
+}
+
+static void Bin_Indicate(void *ctx, uint16_t alarms)
+{
+    static uint16_t last_alarms = 0;
+    uint16_t raised             = alarms & ~last_alarms;
+
+    (void)ctx;
+    Annun_SetAll(alarms); // ֻSysTickжеAnnun_Tickڱ仯ʱд
+
+    // ճʱʾһΣȼȥд
+    if (raised & ANNUN_BIT(ANNUN_ID_SMOKE)) Voice_Play(VOICE_ID_SMOKE);
+    if (raised & ANNUN_BIT(ANNUN_ID_CLEANUP)) Voice_Play(VOICE_ID_CLEANUP);
+    if (raised & ANNUN_BIT(ANNUN_ID_FULL)) Voice_Play(VOICE_ID_FULL);
+    last_alarms = alarms;
+}
+
+/* ʾSysTickжеãֻд仯ָʾ */
+static void Ind_Leds(uint8_t changed, uint8_t leds)
+{
+    if (changed & ANNUN_LED_GREEN) {
+        if (leds & ANNUN_LED_GREEN) {
+            LED1_ON(); // ̵
+        } else {
+            LED1_OFF();
+        }
+    }
+    if (changed & ANNUN_LED_YELLOW) {
+        if (leds & ANNUN_LED_YELLOW) {
+            LED2_ON(); // Ƶ
+        } else {
+            LED2_OFF();
         }
-        // ֻﵽֵŴ򿪸
-        if (trigger_count >= TRIGGER_THRESHOLD) {
-            Servo_SetAngle(75.0f);     // Ͱ
-            lid_closing_scheduled = 0; // ȡѼƻĹظ
+    }
+    if (changed & ANNUN_LED_RED) {
+        if (leds & ANNUN_LED_RED) {
+            LED_Sys_ON(); // 
+        } else {
+            LED_Sys_OFF();
         }
+    }
+}
+
+static const AnnunHw_t ind_hw = {Ind_Leds, Buzzer_Tone};
+
+/* ʾ֡д봮1ͻ */
+#if USART1_BUSY_EN
+static const VoiceHw_t voice_hw = {USART1_Write, USART1_PlayerBusy};
+#else
+static const VoiceHw_t voice_hw = {USART1_Write, NULL};
+#endif
+
+static void Bin_Record(void *ctx, uint8_t series, uint16_t value)
+{
+    (void)ctx;
+    TS_Add(series, value);
+}
+
+static uint8_t Bin_AwdTripped(void *ctx, uint32_t *trip_ms)
+{
+    (void)ctx;
+    return MQ2_AWD_Tripped(trip_ms);
+}
+
+static uint8_t Bin_AwdRearm(void *ctx)
+{
+    (void)ctx;
+    return MQ2_AWD_Rearm();
+}
+
+static void Bin_AwdSet(void *ctx, uint16_t ppm)
+{
+    (void)ctx;
+    MQ2_AWD_SetThreshold(ppm); // ǰR0»ADCֵ
+}
+
+static const TrashBinHw_t bin_hw = {Bin_Read, Bin_Lid, Bin_Indicate, Bin_Record, Bin_AwdTripped, Bin_AwdRearm, Bin_AwdSet, MQ2_SAMPLE_MS};
+
+void HandleUltrasonicSensor(void)
+{
+    static uint8_t lid_ready = 0;
+
+    TrashBin_HandleLid(&bin, system_runtime_ms);
+    Comp_UpdateInputs(); // ˿ʱ֪ͨѹ
+    if (!lid_ready && (bin.seq_valid & (1 << SENSOR_ID_SONAR))) { // һӽѴӦ
+        lid_ready = 1;
+        Boot_Mark("lid");
+    }
+}
+
+// ȡһModbusĴ32λֵ֡ռĴ
+static uint16_t MB_InputReg(uint16_t reg)
+{
+    SensorSample_t s;
+    uint32_t v32;
+
+    switch (reg) {
+        case MB_IR_STATUS:
+            return (bin.lid_is_open ? 0x01 : 0) | (bin.trash_status == TRASHBIN_FULL ? 0x02 : 0) |
+                   (bin.smoke_alert ? 0x04 : 0) | (bin.smoke_prealert ? 0x08 : 0) | (bin.cleanup_alert ? 0x10 : 0) |
+                   (Smoke_GetLevel(&bin.smoke) == SMOKE_LEVEL_WARMUP ? 0x20 : 0) |
+                   (Compactor_GetState() == COMP_ST_FAULT ? 0x40 : 0);
+        case MB_IR_TRASH: return bin.trash_status;
+        case MB_IR_FILL_PM: return Fill_GetPermille(&bin.fill);
+        case MB_IR_FILL_CONF: return Fill_GetConfidence(&bin.fill);
+        case MB_IR_FILL_RATE: return (uint16_t)Fill_GetRate(&bin.fill);
+        case MB_IR_FILL_TTF: return bin.ttf_min;
+        case MB_IR_SMOKE_PPM:
+            SensorHub_Read(SENSOR_ID_SMOKE, &s);
+            return (uint16_t)s.value;
+        case MB_IR_SMOKE_LEVEL: return Smoke_GetLevel(&bin.smoke);
+        case MB_IR_LID_MM: return TrashBin_GetLidDistance(&bin);
+        case MB_IR_FILL_MM:
+            SensorHub_Read(SENSOR_ID_FILL, &s);
+            return (s.quality & (SENSOR_Q_NODATA | SENSOR_Q_TIMEOUT)) ? 0 : (uint16_t)s.value;
+        case MB_IR_TEMP:
+        case MB_IR_HUMI:
+            SensorHub_Read(SENSOR_ID_DHT11, &s);
+            return (reg == MB_IR_TEMP) ? (uint16_t)SENSOR_DHT11_TEMP(s.value) : SENSOR_DHT11_HUMI(s.value);
+        case MB_IR_MB_FRAMES: return (uint16_t)mb_slave.frames;
+        case MB_IR_MB_CRC_ERR: return (uint16_t)mb_slave.crc_errors;
+        case MB_IR_MB_EXCEPT: return (uint16_t)mb_slave.exceptions;
+        case MB_IR_FAN_DUTY: return Vent_GetDuty(&vent);
+        case MB_IR_COMP_STATE: return Compactor_GetState() | ((uint16_t)Compactor_GetResult() << 8);
+        case MB_IR_COMP_CYCLES: return (uint16_t)Compactor_GetCycles();
+        default: break;
+    }
+
+    if (reg < MB_IR_UPTIME) {
+        v32 = bin.lid_open_count;
+    } else if (reg < MB_IR_SINCE_CLEAN) {
+        v32 = system_runtime_s;
     } else {
-        if (trigger_count >= TRIGGER_THRESHOLD) { // ֮ǰǴ״̬
-            if (!lid_closing_scheduled) {
-                // ӳٹرʱ
-                lid_close_time        = system_runtime_ms + CLOSE_DELAY_MS;
-                lid_closing_scheduled = 1;
-            }
+        v32 = TrashBin_TimeSinceCleanup(&bin, system_runtime_s);
+    }
+    return (reg & 1) ? (uint16_t)v32 : (uint16_t)(v32 >> 16);
+}
+
+// ModbusĴصּĴ2n/2n+1Ϊnĸ/
+static uint8_t MB_Read(void *ctx, uint8_t table, uint16_t reg, uint16_t *value)
+{
+    (void)ctx;
+    if (table == MODBUS_TABLE_INPUT) {
+        if (reg >= MB_IR_NUM) return MODBUS_EX_ILLEGAL_ADDR;
+        *value = MB_InputReg(reg);
+    } else if (reg < CFG_NUM * 2) {
+        *value = (reg & 1) ? (uint16_t)CFG(reg / 2) : (uint16_t)(CFG(reg / 2) >> 16);
+    } else if (reg == MB_HR_CMD) {
+        *value = 0;
+    } else {
+        return MODBUS_EX_ILLEGAL_ADDR;
+    }
+    return MODBUS_EX_NONE;
+}
+
+// ModbusдּĴصֻдһʱһֱֲ䣬ȫͨ޸
+static uint8_t MB_Write(void *ctx, uint16_t reg, const uint8_t *data, uint16_t count)
+{
+    uint32_t values[CFG_NUM];
+    const ConfigDesc_t *d;
+    uint16_t i, r;
+    uint8_t id;
+
+    (void)ctx;
+    if (reg == MB_HR_CMD && count == 1) {
+        switch (MODBUS_GET16(data)) {
+            case MB_CMD_SAVE:
+                mb_save_pending = 1; // FlashдͣȡָӦִ
+                return MODBUS_EX_NONE;
+            case MB_CMD_RESET:
+                Config_Reset();
+                return MODBUS_EX_NONE;
+            default:
+                return MODBUS_EX_ILLEGAL_VALUE;
+        }
+    }
+    if ((uint32_t)reg + count > CFG_NUM * 2) return MODBUS_EX_ILLEGAL_ADDR;
+
+    for (id = 0; id < CFG_NUM; id++) {
+        values[id] = CFG(id);
+    }
+    for (i = 0; i < count; i++) {
+        r  = reg + i;
+        id = (uint8_t)(r / 2);
+        if (r & 1) {
+            values[id] = (values[id] & 0xFFFF0000UL) | MODBUS_GET16(&data[i * 2]);
+        } else {
+            values[id] = (values[id] & 0x0000FFFFUL) | ((uint32_t)MODBUS_GET16(&data[i * 2]) << 16);
         }
-        trigger_count = 0; // ô
     }
+    for (id = reg / 2; id <= (reg + count - 1) / 2; id++) {
+        d = Config_GetDesc(id);
+        if (values[id] < d->min || values[id] > d->max) return MODBUS_EX_ILLEGAL_VALUE;
+    }
+    for (id = reg / 2; id <= (reg + count - 1) / 2; id++) {
+        Config_Set(id, values[id]);
+    }
+    return MODBUS_EX_NONE;
+}
 
-    // ǷҪرͰ
-    if (lid_closing_scheduled && system_runtime_ms >= lid_close_time) {
-        Servo_SetAngle(0.0f); // رͰ
-        lid_closing_scheduled = 0;
+// һ֡ModbusӦDMAȴ
+static void ProcessModbus(void)
+{
+    uint16_t len = UART3_ReadFrame(mb_req, sizeof(mb_req));
+
+    if (len > 0) {
+        len = Modbus_Process(&mb_slave, mb_req, len, mb_rsp);
+        if (len > 0) UART3_SendFrame(mb_rsp, len);
+    }
+    if (mb_save_pending && !UART3_FrameSending()) {
+        mb_save_pending = 0;
+        Config_Save();
     }
 }
 
+// ЭʽʱĿֻŶӵʾ봮1ͻ
+// Modbusѭڲ;ĲдFlash򿪹ظ
+static void IdleWork(void)
+{
+    Voice_Poll(system_runtime_ms);
+}
+
 void ProcessSerialCommands(void)
 {
     if (USART1_NewCmd) {
         if (USART1_RX_CMD == 0x11) {
-            Servo_SetAngle(75.0f); // Ͱ
+            Lid_Set(1); // Ͱ
         } else if (USART1_RX_CMD == 0x22) {
-            Servo_SetAngle(0.0f); // رͰ
+            Lid_Set(0); // رͰ
         }
         USART1_NewCmd = 0; // ־λ
     }
+    Voice_Poll(system_runtime_ms); // ģʱһʾ
+    if (mb_slave.addr) {
+        ProcessModbus(); // 3ΪModbusվ
+    } else {
+        Config_Poll(); // 3
+    }
 }
 
-void Sys_Init(void)
+// ʾ񱾴οõķֽͻʣռ伴Ϊʿ
+static uint16_t MirrorBudget(void)
 {
-    ADCx_Init(ADC1);    // Initialize ADC1
-    OLED_Init();        // Initialize OLED display
-    LED_All_Init();     // Initialize LED
-    Servo_Init();       // Initialize servo motor
-    Buzzer_Init();      // Initialize buzzer
-    usart1_Init(9600);  // Initialize USART1 with baud rate 9600
-    UART3_Init(9600);   // ʼ3
-    CountSensor_Init(); // Initialize red infrared sensors
-    MQ2_Init();         // Initialize MQ2 smoke sensor
-    Timer_Init();       // Initialize timer for tracking
-    HC_SR04_Init();     // Initialize ultrasonic sensor
-    DS1302_GPIO_Init(); // Initialize DS1302 (time kept by backup battery)
+    uint16_t free = UART3_TxFree();
+    return (free > MIRROR_TX_RESERVE) ? free - MIRROR_TX_RESERVE : 0;
 }
 
-void InitTrashSystem(void)
+// һ֡ʾԤڣȴ
+static void MirrorSend(uint16_t len)
 {
-    last_cleanup_time    = system_runtime_s;
-    trash_status         = 0;
-    display_needs_update = 1;
-    time_overflow        = 0;
+    uint16_t i;
 
-    OLED_Clear();
-    OLED_Update();
+    for (i = 0; i < len; i++) UART3_SendByte(mirror_buf[i]);
 }
 
-void ProcessSensorData(void)
+// ÿ֡ʾǰĻص仯ҳһ֡
+static void MirrorPresent(const uint8_t *cur, const uint8_t *prev)
 {
-    uint8_t bottom_sensor = Sensor_GetValue();  // ײ
-    uint8_t top_sensor    = Sensor_GetValue2(); // 
-    uint8_t old_status    = trash_status;
+    if (!mirror_on) return;
+    MirrorSend(Mirror_Present(&mirror, cur, prev, mirror_buf, MirrorBudget()));
+}
 
-    // ⴫ֵ0-ڵ1-δڵ
-    if (bottom_sensor && top_sensor) {
-        trash_status      = 0;                // δڵͰ
-        last_cleanup_time = system_runtime_s; // ʱ
-    } else if (!bottom_sensor && top_sensor) {
-        trash_status = 1; // ײڵ
-    } else if (bottom_sensor && !top_sensor) {
-        trash_status = 1; // ڵ
-    } else if (!bottom_sensor && !top_sensor) {
-        trash_status = 2; // ڵͰ
+// 3 "mirror" on/offأkey·棬޲ͳ
+static void MirrorCommand(char *args)
+{
+    char line[80];
+
+    if (args == NULL) args = "";
+    if (strcmp(args, "on") == 0 || strcmp(args, "key") == 0) {
+        Mirror_Key(&mirror);
+        mirror_on = 1;
+    } else if (strcmp(args, "off") == 0) {
+        mirror_on = 0;
     }
+    sprintf(line, "mirror %s frames=%lu bytes=%lu xor=%lu raw=%lu\r\n", mirror_on ? "on" : "off",
+            (unsigned long)mirror.frames, (unsigned long)mirror.bytes, (unsigned long)mirror.xor_pages,
+            (unsigned long)mirror.raw_pages);
+    UART3_SendString(line);
+}
 
-    if (old_status != trash_status) {
-        display_needs_update = 1;
+// 3 "fc" Ԥ͸ʱѧϰ
+static void PrintForecast(void)
+{
+    char line[64];
+    uint8_t h;
+    static const char *const model_name[] = {"none", "linear", "seasonal"};
+
+    sprintf(line, "fc pm=%u rate=%d model=%s", Fill_GetPermille(&bin.fill), Fill_GetRate(&bin.fill),
+            model_name[bin.ttf_model]);
+    UART3_SendString(line);
+    if (bin.ttf_min == FORECAST_UNKNOWN) {
+        UART3_SendString(" ttf=-\r\n");
+    } else { // dueΪԤװʱ̣tsͬķʱ
+        sprintf(line, " ttf=%u due=%lu\r\n", bin.ttf_min, (unsigned long)(TS_Now() / 60 + bin.ttf_min));
+        UART3_SendString(line);
+    }
+    for (h = 0; h < FORECAST_HOURS; h++) { // ʱ,(ǧֱ/Сʱ),ѧϰ
+        sprintf(line, "%u,%d,%u\r\n", h, Forecast_GetHourRate(&bin.forecast, h), Forecast_GetHourCount(&bin.forecast, h));
+        UART3_SendString(line);
     }
 }
 
-void CheckSmoke(void)
+// 3 "boot" ͽ׶αǵʱ̣΢룩
+static void PrintBoot(void)
 {
-    uint16_t smoke_ppm_value = MQ2_GetData_PPM();                        // ȡPPMֵ
-    smoke_alert_active       = (smoke_ppm_value >= SMOKE_THRESHOLD_PPM); // PPMֵȽ
+    char line[48];
+    const BootMark_t *m;
+    uint8_t i;
+
+    for (i = 0; i < Boot_GetMarkCount(); i++) { // ,ʼ,
+        m = Boot_GetMark(i);
+        sprintf(line, "%s,%lu,%lu\r\n", m->name, (unsigned long)m->start_us, (unsigned long)m->done_us);
+        UART3_SendString(line);
+    }
 }
 
-void CheckCleanupTimeout(void)
+// 3 "fan" ŷռձȺͨ
+static void PrintFan(void)
 {
-    uint32_t current_time = system_runtime_s;
-    uint32_t time_since_cleanup;
+    char line[48];
+
+    sprintf(line, "fan duty=%u demand=%u quiet=%u\r\n", Vent_GetDuty(&vent), Vent_GetDemand(&vent), vent.quiet);
+    UART3_SendString(line);
+}
 
-    if (current_time < last_cleanup_time) {
-        time_overflow = 1;
+// 3 "comp [run|reset]" ֶѹ/ϣѹ״̬
+static void CompactorCommand(char *args)
+{
+    static const char *const names[] = {"idle", "press", "pause", "return", "fault"};
+    char line[80];
+
+    if (args != NULL && strcmp(args, "run") == 0) {
+        Compactor_Run();
+    } else if (args != NULL && strcmp(args, "reset") == 0) {
+        Compactor_Reset();
     }
+    sprintf(line, "comp %s result=%u heat=%u peak=%umA cycles=%lu\r\n", names[Compactor_GetState()],
+            Compactor_GetResult(), Compactor_GetHeat(), Compactor_GetPeak(), (unsigned long)Compactor_GetCycles());
+    UART3_SendString(line);
+}
 
-    if (time_overflow) {
-        time_since_cleanup = (UINT32_MAX - last_cleanup_time) + current_time;
-    } else {
-        time_since_cleanup = current_time - last_cleanup_time;
+// Ĵ30ʾѴ
+static uint8_t ExtraCommands(char *cmd, char *args)
+{
+    if (TS_Command(cmd, args) == 0) return 0;
+    if (strcmp(cmd, "fc") == 0) {
+        PrintForecast();
+        return 0;
+    }
+    if (strcmp(cmd, "boot") == 0) {
+        PrintBoot();
+        return 0;
+    }
+    if (strcmp(cmd, "mirror") == 0) {
+        MirrorCommand(args);
+        return 0;
     }
+    if (strcmp(cmd, "fan") == 0) {
+        PrintFan();
+        return 0;
+    }
+    if (strcmp(cmd, "comp") == 0) {
+        CompactorCommand(args);
+        return 0;
+    }
+    return 1;
+}
+
+/* 䣺ĳʼװΪ޲κ */
+static void Boot_AdcEnable(void)
+{
+    ADCx_Enable(ADC1);
+    ADCx_Enable(ADC2); // ѹ
+}
 
-    // Ͱǿʱ鳬ʱ
-    if (trash_status != 0) {
-        cleanup_alert_active = (time_since_cleanup >= CLEANUP_TIMEOUT_S);
+static void Boot_AdcResetCal(void)
+{
+    ADC_ResetCalibration(ADC1);
+    ADC_ResetCalibration(ADC2); // ѹ
+}
+
+static uint8_t Boot_AdcResetCalDone(void)
+{
+    return ADC_GetResetCalibrationStatus(ADC1) == RESET && ADC_GetResetCalibrationStatus(ADC2) == RESET;
+}
+
+static void Boot_AdcCal(void)
+{
+    ADC_StartCalibration(ADC1);
+    ADC_StartCalibration(ADC2); // ѹ
+}
+
+static uint8_t Boot_AdcCalDone(void)
+{
+    return ADC_GetCalibrationStatus(ADC1) == RESET && ADC_GetCalibrationStatus(ADC2) == RESET;
+}
+
+static void Boot_Usart1(void) // 1ʶMP3ʾ
+{
+    usart1_Init(9600);
+    Voice_Init(&voice_hw);
+}
+
+static void Boot_Uart3(void) // 3Modbusվ
+{
+    if (CFG(CFG_MB_ADDR)) {
+        mb_slave.addr = (uint8_t)CFG(CFG_MB_ADDR);
+        UART3_ModbusInit(CFG(CFG_MB_BAUD));
     } else {
-        cleanup_alert_active = 0;
+        UART3_Init(9600);
+    }
+}
+
+static void Boot_TimeSeries(void) // ʱDS1302ʱΪ׼ָFlash־
+{
+    TS_Init(DS1302_GetEpoch());
+}
+
+static void Boot_Annunciator(void) // ָʾ/ʾ棬˺SysTickжƽ
+{
+    Annun_Init(&ind_hw);
+}
+
+// вѹƲ
+static void CompactorConfigFromCfg(CompactorConfig_t *cfg)
+{
+    Compactor_DefaultConfig(cfg);
+    cfg->enable   = (uint8_t)CFG(CFG_COMP_EN);
+    cfg->stall_ma = (uint16_t)CFG(CFG_COMP_STALL_MA);
+}
+
+static void Boot_Compactor(void) // ѹλ͵⣬˺SysTickжƽ
+{
+    CompactorConfig_t cfg;
+
+    Motor_Init();
+    CompactorConfigFromCfg(&cfg);
+    Compactor_Init(&comp_hw, &cfg);
+    comp_cfg_gen = Config_GetGeneration();
+}
+
+static void Boot_SmokeAWD(void) // ADCģ⿴ŹжֱӱԤȽʹܣ
+{
+    MQ2_AWD_Init(CFG(CFG_SMOKE_PPM));
+}
+
+/* ǰӽ⿪Ĳǰ */
+#define BOOT_OLED_PWR  0
+#define BOOT_CONFIG    1
+#define BOOT_TIMER     2
+#define BOOT_SERVO     3
+#define BOOT_SONAR     4
+#define BOOT_ADC       5
+#define BOOT_ADC_RST   6
+#define BOOT_ADC_CAL   7
+#define BOOT_MQ2       8
+#define BOOT_RED       9
+#define BOOT_DHT11     10
+#define BOOT_SENSORS   11
+#define BOOT_LED       12
+#define BOOT_BUZZER    13
+#define BOOT_AWD       14
+#define BOOT_UART3     15
+#define BOOT_USART1    16
+#define BOOT_DS1302    17
+#define BOOT_TS        18
+#define BOOT_OLED      19
+#define BOOT_ANNUN     20
+#define BOOT_FAN       21
+#define BOOT_COMPACTOR 22
+#define BOOT_STEP_NUM  23
+
+static const BootStep_t boot_steps[BOOT_STEP_NUM] = {
+    [BOOT_OLED_PWR]  = {"oled_pwr", NULL, NULL, 0, OLED_POWER_SETTLE_MS * 1000UL}, // ȴOLEDȶ
+    [BOOT_CONFIG]    = {"config", Config_Init, NULL, 0, 0},                        // в
+    [BOOT_TIMER]     = {"timer", Timer_Init, NULL, 0, 0},                          // ϵͳʱͳʱ
+    [BOOT_SERVO]     = {"servo", Servo_Init, NULL, 0, 0},
+    [BOOT_SONAR]     = {"sonar", HC_SR04_Init, NULL, 0, HC_SR04_SETTLE_US},
+    [BOOT_ADC]       = {"adc", Boot_AdcEnable, NULL, 0, ADC_STAB_US}, // ADCϵȶУ׼У׼ڼ
+    [BOOT_ADC_RST]   = {"adc_rst", Boot_AdcResetCal, Boot_AdcResetCalDone, BOOT_DEP(BOOT_ADC), 0},
+    [BOOT_ADC_CAL]   = {"adc_cal", Boot_AdcCal, Boot_AdcCalDone, BOOT_DEP(BOOT_ADC_RST), 0},
+    [BOOT_MQ2]       = {"mq2", MQ2_Init, NULL, 0, 0},
+    [BOOT_RED]       = {"red", CountSensor_Init, NULL, 0, 0},
+    [BOOT_DHT11]     = {"dht11", DHT11_Init, NULL, 0, 0}, // 첽ɼ
+    [BOOT_SENSORS]   = {"sensors", RegisterSensors, NULL, // עᴫɼ
+                        BOOT_DEP(BOOT_TIMER) | BOOT_DEP(BOOT_SONAR) | BOOT_DEP(BOOT_ADC_CAL) | BOOT_DEP(BOOT_MQ2) |
+                            BOOT_DEP(BOOT_RED) | BOOT_DEP(BOOT_DHT11),
+                        0},
+    [BOOT_LED]       = {"led", LED_All_Init, NULL, 0, 0},
+    [BOOT_BUZZER]    = {"buzzer", Buzzer_Init, NULL, 0, 0},
+    [BOOT_AWD]       = {"awd", Boot_SmokeAWD, NULL, BOOT_DEP(BOOT_CONFIG) | BOOT_DEP(BOOT_ADC_CAL) | BOOT_DEP(BOOT_MQ2), 0},
+    [BOOT_UART3]     = {"uart3", Boot_Uart3, NULL, BOOT_DEP(BOOT_CONFIG), 0},
+    [BOOT_USART1]    = {"usart1", Boot_Usart1, NULL, 0, 0},
+    [BOOT_DS1302]    = {"ds1302", DS1302_GPIO_Init, NULL, 0, 0}, // ʱɺ󱸵ر
+    [BOOT_TS]        = {"ts", Boot_TimeSeries, NULL, BOOT_DEP(BOOT_DS1302), 0},
+    [BOOT_OLED]      = {"oled", OLED_Init, NULL, BOOT_DEP(BOOT_OLED_PWR), 0}, // дʼ
+    [BOOT_ANNUN]     = {"annun", Boot_Annunciator, NULL, BOOT_DEP(BOOT_LED) | BOOT_DEP(BOOT_BUZZER), 0},
+    [BOOT_FAN]       = {"fan", Fan_Init, NULL, 0, 0}, // ŷȵԴPC15PWMTIM3_CH2PB5
+    [BOOT_COMPACTOR] = {"compactor", Boot_Compactor, NULL, BOOT_DEP(BOOT_CONFIG) | BOOT_DEP(BOOT_ADC_CAL), 0}, // ADC2У׼ʼת
+};
+
+void Sys_Init(void)
+{
+    Delay_Init(); // DWTʱʱ͸ȶʱDWT
+    Boot_Begin();
+    Boot_Run(boot_steps, BOOT_STEP_NUM);
+    Boot_Mark("sys");
+
+    Mirror_Init(&mirror);
+    OLED_SetPresentHook(MirrorPresent); // ʾ񣨴3 mirror
+    Config_SetCmdHook(ExtraCommands);   // 3 ʷѯԤ⡢ʱʾŷȡѹ
+    Delay_SetIdleHook(IdleWork);        // Эʽʱڼʾ
+}
+
+// вͨƲ
+static void VentConfigFromCfg(VentConfig_t *cfg)
+{
+    Vent_DefaultConfig(cfg);
+    cfg->ppm_on      = (uint16_t)CFG(CFG_FAN_PPM);
+    cfg->temp_on_x10 = (int16_t)(CFG(CFG_FAN_TEMP) * 10);
+    cfg->quiet_max   = (uint8_t)CFG(CFG_FAN_QUIET_PCT);
+    cfg->quiet_start = (uint8_t)CFG(CFG_QUIET_START);
+    cfg->quiet_end   = (uint8_t)CFG(CFG_QUIET_END);
+}
+
+void InitTrashSystem(void)
+{
+    VentConfig_t vent_cfg;
+
+    // ԤⰴTS_Now()ıʱѧϰʱ
+    TrashBin_Init(&bin, &bin_hw, NULL, Config_Values, system_runtime_s, TS_Now() - system_runtime_s);
+    bin_cfg_gen = Config_GetGeneration();
+    VentConfigFromCfg(&vent_cfg);
+    Vent_Init(&vent, &vent_cfg);
+    vent_cfg_gen = Config_GetGeneration();
+    Boot_Mark("app"); // OLED_Initѭ
+}
+
+void ProcessSensorData(void)
+{
+    CompactorConfig_t cfg;
+
+    TrashBin_ProcessSensors(&bin, system_runtime_s);
+    Comp_UpdateInputs(); // ʱѹڸӹرա˿
+
+    if (comp_cfg_gen != Config_GetGeneration()) { // ޸
+        CompactorConfigFromCfg(&cfg);
+        __disable_irq(); // Compactor_Tickڶʱжжȡ
+        Compactor_SetConfig(&cfg);
+        __enable_irq();
+        comp_cfg_gen = Config_GetGeneration();
     }
-    display_needs_update = 1; // Ҫʾʱ
+}
+
+void CheckSmoke(void)
+{
+    TrashBin_CheckSmoke(&bin);
+}
+
+void CheckCleanupTimeout(void)
+{
+    TrashBin_CheckCleanup(&bin, system_runtime_s);
 }
 
 void UpdateStatusIndicators(void)
 {
-    // ȼ > ʱ > Ͱ > ״ָ̬ʾ
-    if (smoke_alert_active) {
-        // ȼ
-        LED1_OFF();   // ̵
-        LED2_OFF();   // Ƶ
-        LED_Sys_ON(); // 
-        Buzzer_ON();  // 
-    } else if (cleanup_alert_active) {
-        // ʱȼ
-        LED1_OFF();   // ̵
-        LED2_OFF();   // Ƶ
-        LED_Sys_ON(); // 
-        Buzzer_ON();  // 
-    } else {
-        // ״ָ̬ʾ
-        switch (trash_status) {
-            case 0:            // 
-                LED1_ON();     // ̵
-                LED2_OFF();    // Ƶ
-                LED_Sys_OFF(); // 
-                Buzzer_OFF();  // ر
-                break;
-            case 1:            // 
-                LED1_OFF();    // ̵
-                LED2_ON();     // Ƶ
-                LED_Sys_OFF(); // 
-                Buzzer_OFF();  // ر
-                break;
-            case 2:           // 
-                LED1_OFF();   // ̵
-                LED2_OFF();   // Ƶ
-                LED_Sys_ON(); // 
-                Buzzer_ON();  // 
-                break;
-        }
+    TrashBin_UpdateIndicators(&bin);
+}
+
+void HandleVentilation(void)
+{
+    static uint32_t last_s = 0;
+    VentConfig_t cfg;
+    VentInput_t in;
+    SensorSample_t s;
+    uint16_t base;
+
+    if (system_runtime_s == last_s) return; // ÿһ
+    last_s = system_runtime_s;
+
+    if (vent_cfg_gen != Config_GetGeneration()) { // ޸
+        VentConfigFromCfg(&cfg);
+        Vent_SetConfig(&vent, &cfg);
+        vent_cfg_gen = Config_GetGeneration();
+    }
+
+    /* ζȡߵŨȣԤڻδ */
+    in.excess_ppm = 0;
+    if (!(SensorHub_Read(SENSOR_ID_SMOKE, &s) & (SENSOR_Q_NODATA | SENSOR_Q_TIMEOUT | SENSOR_Q_STALE)) &&
+        Smoke_GetLevel(&bin.smoke) != SMOKE_LEVEL_WARMUP) {
+        base = Smoke_GetBaseline(&bin.smoke);
+        if (s.value > base) in.excess_ppm = (uint16_t)(s.value - base);
     }
+    in.alarm    = bin.smoke_alert;
+    in.th_valid = (SensorHub_Read(SENSOR_ID_DHT11, &s) == SENSOR_Q_OK);
+    in.temp_x10 = SENSOR_DHT11_TEMP(s.value);
+    in.humi_x10 = SENSOR_DHT11_HUMI(s.value);
+    in.hour     = (uint8_t)(TS_Now() / 3600 % 24); // DS1302ʱ
+
+    Fan_SetDuty(Vent_Update(&vent, system_runtime_ms, &in));
 }
 
 void UpdateOLEDDisplay(void)
 {
     static uint32_t last_display_time = 0;
-    if (system_runtime_s != last_display_time) {
-        display_needs_update = 1;
-        last_display_time    = system_runtime_s;
+
+    OLED_Poll(); // һ֡ɺͺϲĴ֡
+    if (mirror_on) { // ʾйڵҳ
+        MirrorSend(Mirror_Poll(&mirror, OLED_GetFrame(), mirror_buf, MirrorBudget()));
     }
 
-    if (display_needs_update) {
-        uint32_t current_time = system_runtime_s;
-        uint32_t time_since_cleanup;
+    if (system_runtime_s != last_display_time) {
+        bin.changed       = 1;
+        last_display_time = system_runtime_s;
+    }
 
-        if (time_overflow) {
-            time_since_cleanup = (UINT32_MAX - last_cleanup_time) + current_time;
-        } else {
-            time_since_cleanup = current_time - last_cleanup_time;
-        }
+    if (bin.changed) {
+        uint32_t current_time       = system_runtime_s;
+        uint32_t time_since_cleanup = TrashBin_TimeSinceCleanup(&bin, current_time);
 
         OLED_Clear();
 
         /* ʾͰ״̬; */
         OLED_ShowString(0, 0, ":", OLED_8X16);
-        if (trash_status == 0) {
+        if (bin.trash_status == TRASHBIN_EMPTY) {
             OLED_ShowString(40, 0, "", OLED_8X16);
-        } else if (trash_status == 1) {
+        } else if (bin.trash_status == TRASHBIN_SOME) {
             OLED_ShowString(40, 0, "", OLED_8X16);
         } else {
             OLED_ShowString(40, 0, "", OLED_8X16);
         }
 
         /* ʾ */
-        uint8_t avg_distance = calculate_average_distance();
+        uint16_t avg_distance = TrashBin_GetLidDistance(&bin);
         OLED_ShowString(80, 0, "D:", OLED_8X16);
         OLED_ShowNum(96, 0, avg_distance / 10, 3, OLED_8X16);
 
-        /* ʾδʱ */
-        OLED_ShowString(0, 16, "Time:", OLED_8X16);
-        uint16_t minutes = time_since_cleanup / 60;
-        uint16_t seconds = time_since_cleanup % 60;
-
-        // ʾӣȷʾλ
-        if (minutes < 10) {
-            OLED_ShowString(40, 16, "0", OLED_8X16);
-            OLED_ShowNum(48, 16, minutes, 1, OLED_8X16);
+        /* Ԥʱÿ3ֻʾԤװʱ䣨ʱh֣ */
+        if (bin.ttf_min != FORECAST_UNKNOWN && (current_time / 3) % 2) {
+            OLED_ShowString(0, 16, "ETA:", OLED_8X16);
+            OLED_ShowNum(40, 16, bin.ttf_min / 60, 3, OLED_8X16);
+            OLED_ShowString(64, 16, "h", OLED_8X16);
+            OLED_ShowNum(72, 16, bin.ttf_min % 60, 2, OLED_8X16);
         } else {
-            OLED_ShowNum(40, 16, minutes, 2, OLED_8X16);
+            /* ʾδʱ */
+            OLED_ShowString(0, 16, "Time:", OLED_8X16);
+            uint16_t minutes = time_since_cleanup / 60;
+            uint16_t seconds = time_since_cleanup % 60;
+
+            // ʾӣȷʾλ
+            if (minutes < 10) {
+                OLED_ShowString(40, 16, "0", OLED_8X16);
+                OLED_ShowNum(48, 16, minutes, 1, OLED_8X16);
+            } else {
+                OLED_ShowNum(40, 16, minutes, 2, OLED_8X16);
+            }
+            OLED_ShowString(56, 16, ":", OLED_8X16);
+
+            // ʾȷʾλ
+            if (seconds < 10) {
+                OLED_ShowString(64, 16, "0", OLED_8X16);
+                OLED_ShowNum(72, 16, seconds, 1, OLED_8X16);
+            } else {
+                OLED_ShowNum(64, 16, seconds, 2, OLED_8X16);
+            }
         }
-        OLED_ShowString(56, 16, ":", OLED_8X16);
 
-        // ʾȷʾλ
-        if (seconds < 10) {
-            OLED_ShowString(64, 16, "0", OLED_8X16);
-            OLED_ShowNum(72, 16, seconds, 1, OLED_8X16);
-        } else {
-            OLED_ShowNum(64, 16, seconds, 2, OLED_8X16);
+        /* ʾٷֱȣ޹ʱʾ */
+        if (Fill_GetConfidence(&bin.fill) > 0) {
+            OLED_ShowNum(96, 16, Fill_GetPercent(&bin.fill), 3, OLED_8X16);
+            OLED_ShowString(120, 16, "%", OLED_8X16);
         }
 
         /* ʾʵʱںʱ */
@@ -272,6 +912,15 @@ void UpdateOLEDDisplay(void)
         OLED_ShowString(56, 32, "/", OLED_8X16);
         OLED_ShowNum(64, 32, TimeData.day, 2, OLED_8X16);
 
+        /* ʾȼ */
+        if (Smoke_GetLevel(&bin.smoke) == SMOKE_LEVEL_WARMUP) {
+            OLED_ShowString(96, 32, "WU", OLED_8X16); // Ԥ
+        } else if (bin.smoke_alert) {
+            OLED_ShowString(96, 32, "ALM", OLED_8X16);
+        } else if (bin.smoke_prealert) {
+            OLED_ShowString(96, 32, "PRE", OLED_8X16);
+        }
+
         // ʾʱ
         OLED_ShowNum(0, 48, TimeData.hour, 2, OLED_8X16);
         OLED_ShowString(16, 48, ":", OLED_8X16);
@@ -281,10 +930,12 @@ void UpdateOLEDDisplay(void)
 
         /* ʾֵ */
         OLED_ShowString(72, 48, "P:", OLED_8X16);
-        uint16_t smoke_ppm = MQ2_GetData_PPM();
+        SensorSample_t smoke;
+        SensorHub_Read(SENSOR_ID_SMOKE, &smoke); // ʹ¿գظ
+        uint16_t smoke_ppm = (uint16_t)smoke.value;
         OLED_ShowNum(88, 48, smoke_ppm, 4, OLED_8X16);
 
-        OLED_Update();
-        display_needs_update = 0;
+        OLED_Present(); // 壬TIM4ں̨ͣȴ
+        bin.changed = 0;
     }
 }
@@ -21,18 +21,38 @@
 // 包含所有外设驱动头文件
 #include "adcx.h"
 #include "Common.h"
+#include "Config.h"
 #include "Buzzer.h"
 #include "Delay.h"
-#include "Ds1302.h"
+#include "DHT11.h"
+#include "ds1302.h"
 #include "HC_SR04.h"
+#include "RangeCal.h"
 #include "LED.h"
 #include "mq2.h"
 #include "OLED.h"
+#include "Presence.h"
 #include "RED.h"
 #include "usart1.h"
 #include "UART3.h"
 #include "Servo.h"
 #include "Timer.h"
+#include "SensorHub.h"
+#include "SmokeAnalytics.h"
+#include "FillLevel.h"
+#include "TimeSeries.h"
+#include "FillForecast.h"
+#include "Modbus.h"
+#include "TrashBin.h"
+#include "Boot.h"
+#include "OledMirror.h"
+#include "Annunciator.h"
+#include "VoicePrompt.h"
+#include "fan.h"
+#include "Ventilation.h"
+#include "Motor.h"
+#include "Compactor.h"
+#include "RamFunc.h"
 
 void Sys_Init(void); // 系统初始化函数声明
 
@@ -47,6 +67,8 @@ void InitTrashSystem(void);        // 初始化垃圾桶系统状态
 // 新增模块化功能函数
 void HandleUltrasonicSensor(void); // 处理超声波传感器和自动开关盖逻辑
 void ProcessSerialCommands(void);  // 处理串口命令（如语音控制）
+void PollSensors(void);            // 调度传感器采集并发布样本
+void HandleVentilation(void);      // 按烟雾浓度和温湿度调节排风扇
 
 // 获取系统运行时间(秒)
 extern uint32_t system_runtime_s;
@@ -1,35 +1,88 @@
 /**
  * @file     Delay.c
  * @brief    系统延时功能实现
- * @details  基于SysTick定时器实现的延时函数，包括：
- *          - 微秒级延时
- *          - 毫秒级延时
- *          - 秒级延时
+ * @details  基于DWT周期计数器实现的延时函数，包括：
+ *          - 纳秒级/微秒级/毫秒级/秒级忙等延时
+ *          - 协作式毫秒延时
+ *          计数器只读不写，延时互不干扰，可重入、可在中断中使用，
+ *          SysTick留给系统节拍或性能分析使用
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
  */
 
 #include "stm32f10x.h"
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
+#include <stddef.h>
+
+#define DELAY_DWT_CTRL_CYCCNTENA (1UL << 0) /**< DWT_CTRL：周期计数器使能 */
+#define DELAY_CALIB_TIMES        4          /**< 开销校准次数，取最小值 */
+
+uint32_t Delay_CyclesPerUs = DELAY_CPU_MHZ;
+uint32_t Delay_Overhead    = 0;
+
+static Delay_IdleHook_t delay_idle_hook = NULL; /**< 空闲任务 */
+static volatile uint8_t delay_in_hook   = 0;    /**< 空闲任务正在运行 */
+
+/**
+ * @brief  延时服务初始化
+ * @param  无
+ * @return 无
+ */
+void Delay_Init(void)
+{
+    uint32_t t0, t1, base, cost, min_cost = 0xFFFFFFFF;
+    uint8_t i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DELAY_DWT_CTRL |= DELAY_DWT_CTRL_CYCCNTENA;
+
+    SystemCoreClockUpdate();
+    Delay_CyclesPerUs = SystemCoreClock / 1000000;
+
+    /*校准：测量Delay_Cycles(1)的实际耗时，减去读计数器本身的耗时和1个周期*/
+    Delay_Overhead = 0;
+    for (i = 0; i < DELAY_CALIB_TIMES; i++) {
+        t0   = DELAY_DWT_CYCCNT;
+        t1   = DELAY_DWT_CYCCNT;
+        base = t1 - t0;
+        t0   = DELAY_DWT_CYCCNT;
+        Delay_Cycles(1);
+        t1   = DELAY_DWT_CYCCNT;
+        cost = t1 - t0;
+        cost = (cost > base + 1) ? cost - base - 1 : 0;
+        if (cost < min_cost) min_cost = cost;
+    }
+    Delay_Overhead = min_cost;
+}
+
+/**
+ * @brief  纳秒级延时
+ * @param  ns 延时时长，单位：纳秒
+ * @return 无
+ */
+void Delay_ns(uint32_t ns)
+{
+    /*分两部分计算，避免ns * 周期数溢出*/
+    Delay_Cycles(ns / 1000 * Delay_CyclesPerUs + (ns % 1000 * Delay_CyclesPerUs + 999) / 1000);
+}
 
 /**
  * @brief  微秒级延时函数
- * @details 利用SysTick定时器实现延时，计算原理：
- *         - STM32系统主频为72MHz
- *         - SysTick计数器每个计数需要 1/72 微秒
- *         - reload值 = 延时时间(us) * 72
- * @note   由于定时器最大值限制，延时范围：0~233015微秒
- * @param  xus 延时时长，单位：微秒，范围：0~233015
+ * @details 记录起始计数值后等待差值达到目标周期数：
+ *         - 72MHz下每微秒72个周期
+ *         - 差值按无符号计算，计数器回绕不影响结果
+ *         - 单次最长约59秒，更长的延时分段进行
+ * @param  xus 延时时长，单位：微秒，范围：0~4294967295
  * @return 无
  */
 void Delay_us(uint32_t xus)
 {
-    SysTick->LOAD = 72 * xus;              // 设置定时器重装值
-    SysTick->VAL  = 0x00;                  // 清空当前计数值
-    SysTick->CTRL = 0x00000005;            // 设置时钟源为HCLK，启动定时器
-    while (!(SysTick->CTRL & 0x00010000)); // 等待计数到0
-    SysTick->CTRL = 0x00000004;            // 关闭定时器
+    while (xus > 1000000) {
+        Delay_Cycles(1000000 * Delay_CyclesPerUs);
+        xus -= 1000000;
+    }
+    Delay_Cycles(xus * Delay_CyclesPerUs);
 }
 
 /**
@@ -57,3 +110,47 @@ void Delay_s(uint32_t xs)
         Delay_ms(1000);
     }
 }
+
+/**
+ * @brief  设置空闲任务
+ * @param  hook 空闲任务，NULL表示不运行
+ * @return 无
+ */
+void Delay_SetIdleHook(Delay_IdleHook_t hook)
+{
+    delay_idle_hook = hook;
+}
+
+/**
+ * @brief  协作式毫秒延时
+ * @details 累计经过的周期数，每满1ms减少一次剩余时间，
+ *          期间反复运行空闲任务
+ * @param  ms 延时时长，单位：毫秒
+ * @return 无
+ */
+void Delay_Yield_ms(uint32_t ms)
+{
+    uint32_t cycles_per_ms = Delay_CyclesPerUs * 1000;
+    uint32_t last          = DELAY_DWT_CYCCNT;
+    uint32_t acc           = 0;
+    uint32_t now;
+    uint8_t can_yield;
+
+    /*中断中或空闲任务内嵌套调用时不运行空闲任务*/
+    can_yield = (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) == 0 && !delay_in_hook;
+
+    while (ms) {
+        if (can_yield && delay_idle_hook != NULL) {
+            delay_in_hook = 1;
+            delay_idle_hook();
+            delay_in_hook = 0;
+        }
+        now = DELAY_DWT_CYCCNT;
+        acc += now - last;
+        last = now;
+        while (ms && acc >= cycles_per_ms) {
+            acc -= cycles_per_ms;
+            ms--;
+        }
+    }
+}
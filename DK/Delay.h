@@ -2,9 +2,10 @@
  * @file     Delay.h
  * @brief    系统延时功能头文件
  * @details  声明了系统延时相关的函数接口：
- *          - 微秒级延时
- *          - 毫秒级延时
- *          - 秒级延时
+ *          - 纳秒级/微秒级/毫秒级/秒级忙等延时
+ *          - 短延时内联快速路径（软件模拟总线使用）
+ *          - 协作式毫秒延时，等待期间运行空闲任务
+ *          基于DWT周期计数器实现，不占用SysTick
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
@@ -13,18 +14,77 @@
 #ifndef __DELAY_H
 #define __DELAY_H
 
+#include <stdint.h>
+
+/**
+ * @brief DWT周期计数器（CMSIS 1.30未定义DWT结构体，直接使用寄存器地址）
+ */
+#define DELAY_DWT_CTRL   (*(volatile uint32_t *)0xE0001000UL) /**< DWT控制寄存器 */
+#define DELAY_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004UL) /**< 周期计数器 */
+
+/**
+ * @brief 编译期已知的主频（MHz），供DELAY_NS宏计算常量周期数
+ */
+#define DELAY_CPU_MHZ 72
+
+/**
+ * @brief 空闲任务函数类型
+ */
+typedef void (*Delay_IdleHook_t)(void);
+
+extern uint32_t Delay_CyclesPerUs; /**< 每微秒周期数，由Delay_Init按SystemCoreClock计算 */
+extern uint32_t Delay_Overhead;    /**< Delay_Cycles自身开销（周期），由Delay_Init校准 */
+
+/**
+ * @brief  延时指定周期数（内联快速路径）
+ * @details 只使用局部变量和只读的全局变量，可重入，可在中断中使用；
+ *          已扣除校准得到的调用开销，短于开销的延时直接返回
+ * @param  cycles 周期数，范围：0~2^32-1（72MHz下约59秒）
+ * @return 无
+ */
+static inline void Delay_Cycles(uint32_t cycles)
+{
+    uint32_t start = DELAY_DWT_CYCCNT;
+
+    if (cycles <= Delay_Overhead) return;
+    cycles -= Delay_Overhead;
+    while ((DELAY_DWT_CYCCNT - start) < cycles);
+}
+
+/**
+ * @brief 纳秒级短延时，ns为常量时周期数在编译期算出
+ */
+#define DELAY_NS(ns) Delay_Cycles(((uint32_t)(ns) * DELAY_CPU_MHZ + 999) / 1000)
+
+/**
+ * @brief  延时服务初始化
+ * @details 使能DWT周期计数器（不清零，调试器或其他模块可同时使用），
+ *          按SystemCoreClock计算每微秒周期数并校准Delay_Cycles的开销；
+ *          应在其他初始化之前调用
+ * @param  无
+ * @return 无
+ */
+void Delay_Init(void);
+
+/**
+ * @brief  纳秒级延时
+ * @details 按周期向上取整，实际延时不小于ns（72MHz下分辨率约14ns）
+ * @param  ns 延时时长，单位：纳秒
+ * @return 无
+ */
+void Delay_ns(uint32_t ns);
+
 /**
  * @brief  微秒级延时
- * @details 提供最高精度的延时功能，适用于短时间延时场景
- * @note   延时范围受限于SysTick定时器的最大计数值
- * @param  us 延时时长，单位：微秒，范围：0~233015
+ * @details 忙等，可重入，可在中断中使用
+ * @param  us 延时时长，单位：微秒，范围：0~4294967295
  * @return 无
  */
 void Delay_us(uint32_t us);
 
 /**
  * @brief  毫秒级延时
- * @details 提供毫秒级延时，适用于一般延时场景
+ * @details 提供毫秒级忙等延时，适用于一般延时场景
  * @param  ms 延时时长，单位：毫秒，范围：0~4294967295
  * @return 无
  */
@@ -38,4 +98,24 @@ void Delay_ms(uint32_t ms);
  */
 void Delay_s(uint32_t s);
 
+/**
+ * @brief  设置空闲任务
+ * @details Delay_Yield_ms等待期间反复调用，NULL表示不运行；
+ *          调用方可能正处在一次采样或总线操作中间，空闲任务只能做不改变应用状态的工作
+ *          （如把已排队的数据送入发送缓冲区），不能处理命令、改参数、写Flash或驱动执行器
+ * @param  hook 空闲任务
+ * @return 无
+ */
+void Delay_SetIdleHook(Delay_IdleHook_t hook);
+
+/**
+ * @brief  协作式毫秒延时
+ * @details 等待期间反复运行空闲任务，不再空转；
+ *          空闲任务执行时间会使延时略有超出（不短于ms）；
+ *          在中断中调用或空闲任务内嵌套调用时退化为忙等
+ * @param  ms 延时时长，单位：毫秒
+ * @return 无
+ */
+void Delay_Yield_ms(uint32_t ms);
+
 #endif /* __DELAY_H */
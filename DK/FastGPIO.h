@@ -0,0 +1,106 @@
+/**
+ * @file     FastGPIO.h
+ * @brief    快速GPIO操作层
+ * @details  为软件模拟的总线（I2C、三线、单总线、键盘扫描等）提供零开销的引脚操作：
+ *          - 引脚描述符为宏 FGPIO(端口, 引脚号)，编译期展开为常量
+ *          - 置位/清零编译为一次BSRR/BRR写入，读取为一次IDR读取或位带读取
+ *          - 方向切换预先计算好CRL/CRH的地址、掩码和模式值，
+ *            切换时只需一次读-改-写，不再调用GPIO_Init
+ *          用法：
+ *          @code
+ *          #define OLED_SCL FGPIO(GPIOB, 8)
+ *          FGPIO_H(OLED_SCL);               // GPIOB->BSRR = 1 << 8
+ *          if (FGPIO_IN(OLED_SCL)) { ... }  // GPIOB->IDR & (1 << 8)
+ *          @endcode
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __FASTGPIO_H
+#define __FASTGPIO_H
+
+#include "stm32f10x.h"
+
+/**
+ * @brief 引脚描述符：展开为"端口, 引脚号"参数对
+ */
+#define FGPIO(port, n) port, n
+
+/**
+ * @brief 引脚操作（参数为FGPIO描述符）
+ * @note  外层宏先展开描述符，再交给内层宏处理
+ */
+#define FGPIO_H(pin)        FGPIO_H_(pin)        /**< 输出高电平（开漏时为释放） */
+#define FGPIO_L(pin)        FGPIO_L_(pin)        /**< 输出低电平 */
+#define FGPIO_W(pin, v)     FGPIO_W_(pin, v)     /**< 按v输出电平，v为0或非0 */
+#define FGPIO_IN(pin)       FGPIO_IN_(pin)       /**< 读取引脚电平，结果为0或非0 */
+#define FGPIO_MASK(pin)     FGPIO_MASK_(pin)     /**< 引脚掩码 */
+#define FGPIO_BB_OUT(pin)   FGPIO_BB_OUT_(pin)   /**< ODR对应位的位带别名（可读写） */
+#define FGPIO_BB_IN(pin)    FGPIO_BB_IN_(pin)    /**< IDR对应位的位带别名（只读，结果为0或1） */
+
+#define FGPIO_H_(port, n)      ((port)->BSRR = (1UL << (n)))
+#define FGPIO_L_(port, n)      ((port)->BRR = (1UL << (n)))
+#define FGPIO_W_(port, n, v)   ((port)->BSRR = (1UL << (n)) << ((v) ? 0 : 16))
+#define FGPIO_IN_(port, n)     ((port)->IDR & (1UL << (n)))
+#define FGPIO_MASK_(port, n)   ((uint16_t)(1UL << (n)))
+#define FGPIO_BB_OUT_(port, n) (*(volatile uint32_t *)FGPIO_BB_ADDR((uint32_t)&(port)->ODR, n))
+#define FGPIO_BB_IN_(port, n)  (*(volatile uint32_t *)FGPIO_BB_ADDR((uint32_t)&(port)->IDR, n))
+
+/**
+ * @brief 外设区位带别名地址计算
+ */
+#define FGPIO_BB_ADDR(addr, bit) (PERIPH_BB_BASE + (((addr) - PERIPH_BASE) << 5) + ((bit) << 2))
+
+/**
+ * @brief CRL/CRH中的4位模式值（CNF[1:0]:MODE[1:0]）
+ */
+#define FGPIO_MODE_IN_FLOATING 0x4 /**< 浮空输入 */
+#define FGPIO_MODE_IN_PULL     0x8 /**< 上拉/下拉输入，由ODR决定 */
+#define FGPIO_MODE_OUT_PP      0x3 /**< 推挽输出，50MHz */
+#define FGPIO_MODE_OUT_OD      0x7 /**< 开漏输出，50MHz */
+
+/**
+ * @brief 方向切换描述：预先算好的配置寄存器地址、掩码和两种模式值
+ */
+typedef struct
+{
+    volatile uint32_t *cr; /**< CRL或CRH地址 */
+    uint32_t mask;         /**< 清除该引脚4位配置的掩码 */
+    uint32_t in;           /**< 输入模式值（已移位） */
+    uint32_t out;          /**< 输出模式值（已移位） */
+} FGPIO_Dir_t;
+
+/**
+ * @brief 方向切换描述初始化（参数为FGPIO描述符）
+ */
+#define FGPIO_DIR_INIT(dir, pin, in_mode, out_mode) FGPIO_DIR_INIT_(dir, pin, in_mode, out_mode)
+#define FGPIO_DIR_INIT_(dir, port, n, in_mode, out_mode)                      \
+    do {                                                                      \
+        (dir)->cr   = ((n) < 8) ? &(port)->CRL : &(port)->CRH;                \
+        (dir)->mask = ~((uint32_t)0xF << (((n) & 7) * 4));                    \
+        (dir)->in   = (uint32_t)(in_mode) << (((n) & 7) * 4);                 \
+        (dir)->out  = (uint32_t)(out_mode) << (((n) & 7) * 4);                \
+    } while (0)
+
+/**
+ * @brief  切换为输入
+ * @param  dir 方向切换描述
+ * @return 无
+ */
+static inline void FGPIO_DirIn(const FGPIO_Dir_t *dir)
+{
+    *dir->cr = (*dir->cr & dir->mask) | dir->in;
+}
+
+/**
+ * @brief  切换为输出
+ * @param  dir 方向切换描述
+ * @return 无
+ */
+static inline void FGPIO_DirOut(const FGPIO_Dir_t *dir)
+{
+    *dir->cr = (*dir->cr & dir->mask) | dir->out;
+}
+
+#endif /* __FASTGPIO_H */
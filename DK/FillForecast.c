@@ -0,0 +1,178 @@
+/**
+ * @file     FillForecast.c
+ * @brief    满溢时间预测
+ * @details  时段学习：
+ *          - 当前小时内按清空分段，各段 末值-起始值 累加为增长量（负值按0计），
+ *            跨过整点时按观测时长折算为千分比/小时
+ *          - 相邻小时连续观测时，上一小时的最后一个样本作为下一小时的起点，整点前后的增长不丢失
+ *          - 时段速率以Q4定点保存，首次学习直接采用，之后按天EMA平滑
+ *          预测：季节模型逐小时展开，最后一个小时按速率插值到分钟
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "FillForecast.h"
+#include <stddef.h>
+
+#define FORECAST_RATE_MAX 2000 /**< 单个时段速率上限（千分比/小时），排除异常跳变 */
+
+/**
+ * @brief  初始化（清除学习结果）
+ * @param  fc 预测器
+ * @return 无
+ */
+void Forecast_Init(Forecast_t *fc)
+{
+    uint8_t i;
+
+    for (i = 0; i < FORECAST_HOURS; i++) {
+        fc->rate_q4[i] = 0;
+        fc->count[i]   = 0;
+    }
+    fc->active = 0;
+}
+
+/**
+ * @brief  把当前小时的增长速率学习到对应时段
+ * @param  fc 预测器
+ */
+static void Forecast_Learn(Forecast_t *fc)
+{
+    uint32_t span = fc->last_s - fc->first_s;
+    uint8_t slot  = (uint8_t)(fc->hour % FORECAST_HOURS);
+    int32_t gain, rate;
+
+    if (span < FORECAST_MIN_SPAN_S) return; // 观测时间太短（如刚上电）
+
+    gain = fc->gain + (int32_t)fc->last_pm - (int32_t)fc->seg_pm;
+    if (gain < 0) gain = 0; // 垃圾压实沉降
+    rate = gain * 3600 / (int32_t)span;
+    if (rate > FORECAST_RATE_MAX) rate = FORECAST_RATE_MAX;
+
+    if (fc->count[slot] == 0) {
+        fc->rate_q4[slot] = (int16_t)(rate << 4);
+    } else {
+        fc->rate_q4[slot] += (int16_t)(((rate << 4) - fc->rate_q4[slot]) / (1 << FORECAST_SHIFT));
+    }
+    if (fc->count[slot] < 255) fc->count[slot]++;
+}
+
+/**
+ * @brief  输入一个满溢估计
+ * @param  fc      预测器
+ * @param  now_s   当前时刻（秒）
+ * @param  fill_pm 满溢千分比 0~1000
+ * @return 无
+ */
+void Forecast_Update(Forecast_t *fc, uint32_t now_s, uint16_t fill_pm)
+{
+    uint32_t hour = now_s / 3600;
+
+    if (!fc->active || hour != fc->hour) {
+        if (fc->active && hour == fc->hour + 1) {
+            Forecast_Learn(fc);
+            fc->first_s = fc->last_s; // 连续观测，从上一个样本接续
+            fc->seg_pm  = fc->last_pm;
+        } else {
+            fc->first_s = now_s; // 首个样本、中间有缺失或时钟跳变
+            fc->seg_pm  = fill_pm;
+            fc->last_pm = fill_pm;
+        }
+        fc->hour   = hour;
+        fc->gain   = 0;
+        fc->active = 1;
+    }
+
+    if ((uint32_t)fill_pm + FORECAST_EMPTIED_PM <= fc->last_pm) { // 已清空：结束当前分段
+        fc->gain += (int32_t)fc->last_pm - (int32_t)fc->seg_pm;
+        fc->seg_pm = fill_pm;
+    }
+    fc->last_pm = fill_pm;
+    fc->last_s  = now_s;
+}
+
+/**
+ * @brief  预测达到目标满溢度所需时间
+ * @param  fc        预测器
+ * @param  now_s     当前时刻（秒）
+ * @param  fill_pm   当前满溢千分比
+ * @param  target_pm 目标满溢千分比
+ * @param  rate      最近的增长速率（千分比/小时）
+ * @param  model     输出使用的模型，可为NULL
+ * @return 分钟数，无法预测时为FORECAST_UNKNOWN
+ */
+uint16_t Forecast_TimeToFull(const Forecast_t *fc, uint32_t now_s, uint16_t fill_pm, uint16_t target_pm, int16_t rate, uint8_t *model)
+{
+    int32_t need_q4, mean_q4 = 0, r;
+    uint32_t t_s = 0, left_s, minutes = FORECAST_UNKNOWN;
+    uint8_t i, h, learned = 0, used = FORECAST_MODEL_NONE;
+    uint16_t n;
+
+    for (i = 0; i < FORECAST_HOURS; i++) {
+        if (fc->count[i]) {
+            mean_q4 += fc->rate_q4[i];
+            learned++;
+        }
+    }
+
+    if (learned >= FORECAST_MIN_SLOTS) {
+        used = FORECAST_MODEL_SEASONAL;
+        mean_q4 /= learned;
+        need_q4 = (fill_pm < target_pm) ? ((int32_t)(target_pm - fill_pm) << 4) : 0;
+        h       = (uint8_t)((now_s / 3600) % FORECAST_HOURS);
+        left_s  = 3600 - now_s % 3600; // 当前小时剩余时间
+
+        for (n = 0; n <= FORECAST_HORIZON_H && need_q4 > 0; n++) {
+            r = fc->count[h] ? fc->rate_q4[h] : mean_q4;
+            if (r > 0) {
+                int32_t gain_q4 = r * (int32_t)left_s / 3600;
+                if (gain_q4 >= need_q4) {
+                    t_s += (uint32_t)(need_q4 * 3600 / r);
+                    need_q4 = 0;
+                    break;
+                }
+                need_q4 -= gain_q4;
+            }
+            t_s += left_s;
+            left_s = 3600;
+            h      = (h + 1) % FORECAST_HOURS;
+        }
+        if (need_q4 <= 0) minutes = t_s / 60;
+    } else if (fill_pm >= target_pm) {
+        minutes = 0;
+        used    = FORECAST_MODEL_LINEAR;
+    } else if (rate > 0) {
+        used    = FORECAST_MODEL_LINEAR;
+        minutes = (uint32_t)(target_pm - fill_pm) * 60 / (uint32_t)rate;
+        if (minutes > (uint32_t)FORECAST_HORIZON_H * 60) minutes = FORECAST_UNKNOWN;
+    }
+
+    if (minutes == FORECAST_UNKNOWN) used = FORECAST_MODEL_NONE;
+    if (model != NULL) *model = used;
+    return (uint16_t)minutes;
+}
+
+/**
+ * @brief  获取时段速率
+ * @param  fc 预测器
+ * @param  hour 一天中的小时 0~23
+ * @return 速率（千分比/小时）
+ */
+int16_t Forecast_GetHourRate(const Forecast_t *fc, uint8_t hour)
+{
+    if (hour >= FORECAST_HOURS) return 0;
+    return (int16_t)(fc->rate_q4[hour] / 16);
+}
+
+/**
+ * @brief  获取时段学习次数
+ * @param  fc 预测器
+ * @param  hour 一天中的小时 0~23
+ * @return 次数
+ */
+uint8_t Forecast_GetHourCount(const Forecast_t *fc, uint8_t hour)
+{
+    if (hour >= FORECAST_HOURS) return 0;
+    return fc->count[hour];
+}
@@ -0,0 +1,105 @@
+/**
+ * @file     FillForecast.h
+ * @brief    满溢时间预测头文件
+ * @details  按一天24小时学习各时段的满溢增长速率，预测距离装满还有多久：
+ *          - 每个小时结束时，把该小时内的满溢增长量（清空前后分段累加）折算为
+ *            千分比/小时，定点EMA更新到对应时段，每次更新O(1)
+ *          - 季节模型：从当前时刻起按各时段速率逐小时累加，直到达到满溢线；
+ *            未学习的时段用已学习时段的平均速率代替
+ *          - 学习的时段不足时退回线性模型：剩余量/最近的增长速率
+ *          只保存24个时段的速率和样本数（O(24)内存），不依赖硬件，可在主机上回放
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __FILLFORECAST_H
+#define __FILLFORECAST_H
+
+#include <stdint.h>
+
+/**
+ * @brief 预测模型
+ */
+#define FORECAST_MODEL_NONE     0 /**< 无法预测（无增长） */
+#define FORECAST_MODEL_LINEAR   1 /**< 线性模型 */
+#define FORECAST_MODEL_SEASONAL 2 /**< 按时段速率的季节模型 */
+
+/**
+ * @brief 无法预测时的返回值
+ */
+#define FORECAST_UNKNOWN 0xFFFF
+
+/**
+ * @brief 参数
+ */
+#define FORECAST_HOURS        24   /**< 一天的时段数 */
+#define FORECAST_SHIFT        2    /**< 时段速率EMA系数1/2^n（按天更新） */
+#define FORECAST_MIN_SPAN_S   1800 /**< 一个小时内至少观测到此时长才用于学习 */
+#define FORECAST_MIN_SLOTS    12   /**< 学习过的时段达到此数才使用季节模型 */
+#define FORECAST_EMPTIED_PM   300  /**< 满溢下降超过此值视为清空 */
+#define FORECAST_HORIZON_H    168  /**< 最长预测范围（小时） */
+
+/**
+ * @brief 预测器状态（每个实例一份，互不影响）
+ */
+typedef struct
+{
+    int16_t rate_q4[FORECAST_HOURS]; /**< 各时段速率（千分比/小时，Q4） */
+    uint8_t count[FORECAST_HOURS];   /**< 各时段学习次数 */
+    uint8_t active;                  /**< 当前小时已有样本 */
+    uint32_t hour;                   /**< 当前小时（now_s/3600） */
+    uint32_t first_s;                /**< 当前小时观测起点 */
+    uint32_t last_s;                 /**< 最近样本时刻 */
+    uint16_t seg_pm;                 /**< 当前分段起始满溢度 */
+    uint16_t last_pm;                /**< 最近样本满溢度 */
+    int32_t gain;                    /**< 当前小时已结束分段的增长量 */
+} Forecast_t;
+
+/**
+ * @brief  初始化（清除学习结果）
+ * @param  fc 预测器
+ * @return 无
+ */
+void Forecast_Init(Forecast_t *fc);
+
+/**
+ * @brief  输入一个满溢估计
+ * @details 每个满溢样本调用一次；跨过整点时把上一个小时的增长速率学习到对应时段
+ * @param  fc      预测器
+ * @param  now_s   当前时刻（秒，本地时间，now_s/3600%24为一天中的小时）
+ * @param  fill_pm 满溢千分比 0~1000
+ * @return 无
+ */
+void Forecast_Update(Forecast_t *fc, uint32_t now_s, uint16_t fill_pm);
+
+/**
+ * @brief  预测达到目标满溢度所需时间
+ * @details 季节模型最多展开FORECAST_HORIZON_H个小时
+ * @param  fc        预测器
+ * @param  now_s     当前时刻（秒）
+ * @param  fill_pm   当前满溢千分比
+ * @param  target_pm 目标满溢千分比
+ * @param  rate      最近的增长速率（千分比/小时），供线性模型使用
+ * @param  model     输出使用的模型 FORECAST_MODEL_x，可为NULL
+ * @return 分钟数；已达到目标时为0，无法预测或超出预测范围时为FORECAST_UNKNOWN
+ */
+uint16_t Forecast_TimeToFull(const Forecast_t *fc, uint32_t now_s, uint16_t fill_pm, uint16_t target_pm, int16_t rate, uint8_t *model);
+
+/**
+ * @brief  获取时段速率
+ * @param  fc 预测器
+ * @param  hour 一天中的小时 0~23
+ * @return 速率（千分比/小时），未学习时为0
+ */
+int16_t Forecast_GetHourRate(const Forecast_t *fc, uint8_t hour);
+
+/**
+ * @brief  获取时段学习次数
+ * @param  fc 预测器
+ * @param  hour 一天中的小时 0~23
+ * @return 次数（最大255）
+ */
+uint8_t Forecast_GetHourCount(const Forecast_t *fc, uint8_t hour);
+
+#endif /* __FILLFORECAST_H */
@@ -0,0 +1,265 @@
+/**
+ * @file     FillLevel.c
+ * @brief    满溢程度估计
+ * @details  每个满溢测距样本的处理：
+ *          - 距离换算为千分比：(empty_mm - 距离) / (empty_mm - full_mm)，钳位到0~1000
+ *          - 最近FILL_MEDIAN_WINDOW个有效值取中值，再做定点EMA（Q8）；
+ *            中值比平滑值低emptied_pm以上视为清空，平滑值和速率历史直接复位
+ *          - 红外区间：底部遮挡则不低于ir_bottom_pm，未遮挡则不高于该值，顶部同理；
+ *            顶部遮挡而底部未遮挡（物体卡在上方）时区间无效，不参与融合
+ *          - 估计值为平滑值钳位到红外区间；测距长时间无回波时取区间中点
+ *          - 置信度：中值窗口（去掉首尾）极差越大越低，测距与红外不一致时按偏差扣减，
+ *            仅凭红外估计时固定为较低值
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "FillLevel.h"
+#include <stddef.h>
+
+#define FILL_PM_MAX       1000 /**< 千分比满量程 */
+#define FILL_IR_ONLY_CONF 30   /**< 仅凭红外估计时的置信度 */
+#define FILL_IR_BAD_CONF  10   /**< 红外状态矛盾时的置信度扣减 */
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Fill_DefaultConfig(FillConfig_t *cfg)
+{
+    cfg->rate_interval_ms = FILL_RATE_INTERVAL_MS;
+    cfg->stale_ms         = FILL_STALE_MS;
+    cfg->empty_mm         = FILL_EMPTY_MM;
+    cfg->full_mm          = FILL_FULL_MM;
+    cfg->ir_bottom_pm     = FILL_IR_BOTTOM_PM;
+    cfg->ir_top_pm        = FILL_IR_TOP_PM;
+    cfg->emptied_pm       = FILL_EMPTIED_PM;
+    cfg->spread_pm        = FILL_SPREAD_PM;
+    cfg->smooth_shift     = FILL_SMOOTH_SHIFT;
+}
+
+/**
+ * @brief  初始化/复位估计器
+ * @param  f 估计器
+ * @param  cfg 估计参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Fill_Init(Fill_t *f, const FillConfig_t *cfg)
+{
+    if (cfg == NULL) {
+        Fill_DefaultConfig(&f->cfg);
+    } else {
+        Fill_SetConfig(f, cfg);
+    }
+
+    f->have_range = 0;
+    f->est        = 0;
+    f->conf       = 0;
+    f->rate       = 0;
+    f->med_idx    = 0;
+    f->med_n      = 0;
+    f->hist_idx   = 0;
+    f->hist_n     = 0;
+}
+
+/**
+ * @brief  修改估计参数，不复位估计状态
+ * @details 满溢线不在桶底之上时保留原参数
+ * @param  f 估计器
+ * @param  cfg 估计参数
+ * @return 无
+ */
+void Fill_SetConfig(Fill_t *f, const FillConfig_t *cfg)
+{
+    if (cfg->full_mm >= cfg->empty_mm) return;
+    f->cfg = *cfg;
+}
+
+/**
+ * @brief  距离换算为千分比
+ * @param  f 估计器
+ */
+static uint16_t Fill_RangeToPm(const Fill_t *f, uint16_t range_mm)
+{
+    const FillConfig_t *c = &f->cfg;
+
+    if (range_mm >= c->empty_mm) return 0;
+    if (range_mm <= c->full_mm) return FILL_PM_MAX;
+    return (uint16_t)((uint32_t)(c->empty_mm - range_mm) * FILL_PM_MAX / (c->empty_mm - c->full_mm));
+}
+
+/**
+ * @brief  加入中值窗口并返回中值，同时输出窗口极差
+ * @details 极差去掉最大和最小值后计算，单次异常回波已被中值滤除，不再拉低置信度
+ * @param  f 估计器
+ */
+static uint16_t Fill_Median(Fill_t *f, uint16_t pm, uint16_t *spread)
+{
+    uint16_t sorted[FILL_MEDIAN_WINDOW];
+    uint8_t i, j;
+
+    f->med_buf[f->med_idx] = pm;
+    f->med_idx             = (f->med_idx + 1) % FILL_MEDIAN_WINDOW;
+    if (f->med_n < FILL_MEDIAN_WINDOW) f->med_n++;
+
+    /* 窗口很小，插入排序即可 */
+    for (i = 0; i < f->med_n; i++) {
+        uint16_t v = f->med_buf[i];
+        for (j = i; j > 0 && sorted[j - 1] > v; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    *spread = (f->med_n >= 3) ? sorted[f->med_n - 2] - sorted[1] : sorted[f->med_n - 1] - sorted[0];
+    return sorted[f->med_n / 2];
+}
+
+/**
+ * @brief  清空速率历史
+ * @param  f 估计器
+ */
+static void Fill_ResetRate(Fill_t *f)
+{
+    f->hist_idx = 0;
+    f->hist_n   = 0;
+    f->rate     = 0;
+}
+
+/**
+ * @brief  记录历史并更新增长速率
+ * @param  f 估计器
+ * @param  ranged 1：本次估计来自测距，只有这样的估计才记入历史（红外区间中点误差太大）
+ */
+static void Fill_UpdateRate(Fill_t *f, uint32_t t_ms, uint8_t ranged)
+{
+    uint8_t newest = (f->hist_idx + FILL_RATE_SLOTS - 1) % FILL_RATE_SLOTS;
+    uint8_t oldest = (f->hist_n == FILL_RATE_SLOTS) ? f->hist_idx : 0;
+    uint32_t dt_s;
+
+    if (ranged && (f->hist_n == 0 || t_ms - f->hist_t[newest] >= f->cfg.rate_interval_ms)) {
+        f->hist_pm[f->hist_idx] = f->est;
+        f->hist_t[f->hist_idx]  = t_ms;
+        f->hist_idx             = (f->hist_idx + 1) % FILL_RATE_SLOTS;
+        if (f->hist_n < FILL_RATE_SLOTS) f->hist_n++;
+        oldest = (f->hist_n == FILL_RATE_SLOTS) ? f->hist_idx : 0;
+    }
+
+    /* 千分比/小时即0.1%/小时 */
+    if (f->hist_n == 0) return;
+    dt_s = (t_ms - f->hist_t[oldest]) / 1000;
+    if (dt_s * 1000 >= f->cfg.rate_interval_ms && dt_s > 0) {
+        f->rate = (int16_t)(((int32_t)f->est - (int32_t)f->hist_pm[oldest]) * 3600 / (int32_t)dt_s);
+    } else {
+        f->rate = 0;
+    }
+}
+
+/**
+ * @brief  输入一个样本并更新估计
+ * @param  f 估计器
+ * @param  in 样本
+ * @return 满溢百分比 0~100
+ */
+uint8_t Fill_Update(Fill_t *f, const FillInput_t *in)
+{
+    const FillConfig_t *c = &f->cfg;
+    uint16_t lo = 0, hi = FILL_PM_MAX;
+    uint16_t median, spread = 0, dev = 0;
+    uint8_t ir_ok, ranged;
+    int32_t smooth, conf;
+
+    /* 红外区间 */
+    ir_ok = !(in->ir_top_blocked && !in->ir_bottom_blocked);
+    if (ir_ok) {
+        if (in->ir_bottom_blocked) {
+            lo = c->ir_bottom_pm;
+        } else {
+            hi = c->ir_bottom_pm;
+        }
+        if (in->ir_top_blocked) {
+            lo = c->ir_top_pm;
+        } else if (c->ir_top_pm < hi) {
+            hi = c->ir_top_pm;
+        }
+    }
+
+    if (in->range_valid) {
+        median = Fill_Median(f, Fill_RangeToPm(f, in->range_mm), &spread);
+        if (!f->have_range || (int32_t)median + c->emptied_pm <= (f->smooth_q8 >> 8)) {
+            f->smooth_q8 = (int32_t)median << 8; // 首个样本或已清空：直接跟随
+            if (f->have_range) Fill_ResetRate(f);
+        } else {
+            f->smooth_q8 += (((int32_t)median << 8) - f->smooth_q8) / (1L << c->smooth_shift);
+        }
+        f->have_range = 1;
+        f->last_valid = in->t_ms;
+    }
+
+    ranged = f->have_range && in->t_ms - f->last_valid < c->stale_ms;
+    if (ranged) {
+        smooth = f->smooth_q8 >> 8;
+        if (smooth < lo) {
+            dev    = (uint16_t)(lo - smooth);
+            f->est = lo;
+        } else if (smooth > hi) {
+            dev    = (uint16_t)(smooth - hi);
+            f->est = hi;
+        } else {
+            f->est = (uint16_t)smooth;
+        }
+
+        conf = (int32_t)FILL_CONF_MAX * c->spread_pm / (c->spread_pm + spread);
+        conf -= dev / 5; // 偏离红外区间每0.5%扣1
+        if (!ir_ok) conf -= FILL_IR_BAD_CONF;
+    } else {
+        /* 测距不可用：只用红外区间中点 */
+        f->est = (lo + hi) / 2;
+        conf   = ir_ok ? FILL_IR_ONLY_CONF : FILL_IR_ONLY_CONF - FILL_IR_BAD_CONF;
+    }
+    f->conf = (uint8_t)((conf < 1) ? 1 : conf);
+
+    Fill_UpdateRate(f, in->t_ms, ranged);
+    return Fill_GetPercent(f);
+}
+
+/**
+ * @brief  获取满溢百分比
+ * @param  f 估计器
+ * @return 0~100
+ */
+uint8_t Fill_GetPercent(const Fill_t *f)
+{
+    return (uint8_t)((f->est + 5) / 10);
+}
+
+/**
+ * @brief  获取满溢千分比
+ * @param  f 估计器
+ * @return 0~1000
+ */
+uint16_t Fill_GetPermille(const Fill_t *f)
+{
+    return f->est;
+}
+
+/**
+ * @brief  获取估计置信度
+ * @param  f 估计器
+ * @return 0~FILL_CONF_MAX
+ */
+uint8_t Fill_GetConfidence(const Fill_t *f)
+{
+    return f->conf;
+}
+
+/**
+ * @brief  获取增长速率
+ * @param  f 估计器
+ * @return 速率（0.1%/小时）
+ */
+int16_t Fill_GetRate(const Fill_t *f)
+{
+    return f->rate;
+}
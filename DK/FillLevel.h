@@ -0,0 +1,157 @@
+/**
+ * @file     FillLevel.h
+ * @brief    满溢程度估计头文件
+ * @details  融合桶内向下的超声波测距和顶部/底部两路红外，
+ *          输出连续的满溢百分比、置信度和增长速率：
+ *          - 测距换算为千分比，中值滤波去除单次异常回波
+ *          - 定点EMA平滑垃圾沉降引起的缓慢变化，大幅下降视为清空
+ *          - 红外遮挡状态给出满溢区间，测距超出区间时向区间收敛并降低置信度
+ *          - 按固定间隔记录历史，计算最近一段时间的增长速率（%/小时）
+ *          模块不依赖硬件，可在主机上回放记录的数据
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __FILLLEVEL_H
+#define __FILLLEVEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief 置信度满量程
+ */
+#define FILL_CONF_MAX 100
+
+/**
+ * @brief 默认参数
+ */
+#define FILL_EMPTY_MM         600    /**< 传感器到桶底的距离（毫米） */
+#define FILL_FULL_MM          100    /**< 传感器到满溢线的距离（毫米） */
+#define FILL_IR_BOTTOM_PM     300    /**< 底部红外所在高度（千分比） */
+#define FILL_IR_TOP_PM        900    /**< 顶部红外所在高度（千分比） */
+#define FILL_SMOOTH_SHIFT     2      /**< EMA系数1/2^n */
+#define FILL_EMPTIED_PM       300    /**< 中值比平滑值低出此值视为已清空，立即跟随 */
+#define FILL_SPREAD_PM        100    /**< 中值窗口（去掉首尾）极差达到此值时置信度降为一半 */
+#define FILL_STALE_MS         10000  /**< 超过此时间没有有效回波时只用红外估计 */
+#define FILL_RATE_INTERVAL_MS 600000 /**< 速率历史记录间隔（毫秒） */
+
+/**
+ * @brief 中值滤波窗口（样本数，奇数）
+ */
+#define FILL_MEDIAN_WINDOW 5
+
+/**
+ * @brief 速率历史长度，速率按最早和最新记录计算（默认覆盖1小时）
+ */
+#define FILL_RATE_SLOTS 7
+
+/**
+ * @brief 估计参数
+ */
+typedef struct
+{
+    uint32_t rate_interval_ms; /**< 速率历史记录间隔（毫秒） */
+    uint32_t stale_ms;         /**< 无有效回波的超时时间（毫秒） */
+    uint16_t empty_mm;         /**< 传感器到桶底的距离（毫米） */
+    uint16_t full_mm;          /**< 传感器到满溢线的距离（毫米），应小于empty_mm */
+    uint16_t ir_bottom_pm;     /**< 底部红外高度（千分比） */
+    uint16_t ir_top_pm;        /**< 顶部红外高度（千分比） */
+    uint16_t emptied_pm;       /**< 清空判定的下降量（千分比） */
+    uint16_t spread_pm;        /**< 置信度减半的中值窗口极差（千分比） */
+    uint8_t smooth_shift;      /**< EMA系数 */
+} FillConfig_t;
+
+/**
+ * @brief 单次输入（每个满溢测距样本一次）
+ */
+typedef struct
+{
+    uint32_t t_ms;             /**< 样本时间戳（毫秒） */
+    uint16_t range_mm;         /**< 距离（毫米），range_valid为0时忽略 */
+    uint8_t range_valid;       /**< 1：有回波，0：无回波/超时 */
+    uint8_t ir_bottom_blocked; /**< 1：底部红外被遮挡 */
+    uint8_t ir_top_blocked;    /**< 1：顶部红外被遮挡 */
+} FillInput_t;
+
+/**
+ * @brief 估计器状态（每个实例一份，互不影响）
+ */
+typedef struct
+{
+    FillConfig_t cfg;                     /**< 估计参数 */
+    uint8_t have_range;                   /**< 收到过有效回波 */
+    uint32_t last_valid;                  /**< 上一个有效回波时间 */
+    int32_t smooth_q8;                    /**< 平滑后的测距千分比（Q8） */
+    uint16_t est;                         /**< 融合后的千分比 */
+    uint8_t conf;                         /**< 估计置信度 */
+    int16_t rate;                         /**< 增长速率（0.1%/小时） */
+    uint16_t med_buf[FILL_MEDIAN_WINDOW]; /**< 中值窗口 */
+    uint8_t med_idx;                      /**< 中值窗口写入位置 */
+    uint8_t med_n;                        /**< 中值窗口样本数 */
+    uint16_t hist_pm[FILL_RATE_SLOTS];    /**< 速率历史：千分比 */
+    uint32_t hist_t[FILL_RATE_SLOTS];     /**< 速率历史：时间 */
+    uint8_t hist_idx;                     /**< 速率历史写入位置 */
+    uint8_t hist_n;                       /**< 速率历史记录数 */
+} Fill_t;
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Fill_DefaultConfig(FillConfig_t *cfg);
+
+/**
+ * @brief  初始化/复位估计器
+ * @param  f 估计器
+ * @param  cfg 估计参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Fill_Init(Fill_t *f, const FillConfig_t *cfg);
+
+/**
+ * @brief  修改估计参数，不复位估计状态
+ * @param  f 估计器
+ * @param  cfg 估计参数
+ * @return 无
+ */
+void Fill_SetConfig(Fill_t *f, const FillConfig_t *cfg);
+
+/**
+ * @brief  输入一个样本并更新估计
+ * @param  f 估计器
+ * @param  in 样本
+ * @return 满溢百分比 0~100
+ */
+uint8_t Fill_Update(Fill_t *f, const FillInput_t *in);
+
+/**
+ * @brief  获取满溢百分比
+ * @param  f 估计器
+ * @return 0~100
+ */
+uint8_t Fill_GetPercent(const Fill_t *f);
+
+/**
+ * @brief  获取满溢千分比（内部分辨率）
+ * @param  f 估计器
+ * @return 0~1000
+ */
+uint16_t Fill_GetPermille(const Fill_t *f);
+
+/**
+ * @brief  获取估计置信度
+ * @param  f 估计器
+ * @return 0~FILL_CONF_MAX，0表示尚无数据
+ */
+uint8_t Fill_GetConfidence(const Fill_t *f);
+
+/**
+ * @brief  获取增长速率
+ * @param  f 估计器
+ * @return 速率（0.1%/小时），历史不足一个记录间隔时为0，负值表示下降
+ */
+int16_t Fill_GetRate(const Fill_t *f);
+
+#endif /* __FILLLEVEL_H */
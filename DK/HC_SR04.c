@@ -1,10 +1,38 @@
 #include "HC_SR04.h"
 #include "Timer.h"
 #include "Delay.h"
+#include "RangeCal.h"
 
-uint64_t time     = 0; // 声明变量，用来计时
+volatile u16 time = 0; // 10微秒计数，由TIM4中断累加
 uint64_t time_end = 0; // 声明变量，存储回波信号时间
 
+/*
+ * 单通道测距函数生成宏：每个通道展开一份，触发/回波引脚和量程都是编译期常量，
+ * 引脚操作编译为对固定地址的BSRR/BRR写入和IDR读取，不再从通道表取端口和掩码
+ * 参数为FGPIO描述符，外层宏先展开描述符再交给内层宏（同FGPIO_DIR_INIT）
+ */
+#define HC_SR04_MEASURE_FN(name, trig, echo, max_ticks) HC_SR04_MEASURE_FN_(name, trig, echo, max_ticks)
+#define HC_SR04_MEASURE_FN_(name, trig_port, trig_n, echo_port, echo_n, max_ticks)                \
+    static int16_t name(void)                                                                     \
+    {                                                                                             \
+        FGPIO_H(FGPIO(trig_port, trig_n)); /* 输出高电平 */                                       \
+        Delay_us(15);                      /* 延时15微秒 */                                       \
+        FGPIO_L(FGPIO(trig_port, trig_n)); /* 输出低电平 */                                       \
+        time = 0;                                                                                 \
+        while (!FGPIO_IN(FGPIO(echo_port, echo_n))) { /* 等待回波开始 */                          \
+            if (time >= HC_SR04_START_TICKS) return 0; /* 模块未响应（未接或损坏） */             \
+        }                                                                                         \
+        time = 0; /* 计时清零 */                                                                  \
+        while (FGPIO_IN(FGPIO(echo_port, echo_n))) { /* 等待高电平结束 */                         \
+            if (time >= (max_ticks)) return 0;      /* 超出该通道量程 */                          \
+        }                                                                                         \
+        time_end = time;                               /* 记录结束时的时间 */                     \
+        return RangeCal_TicksToMm((uint32_t)time_end); /* 单位10微秒，按当前温湿度下的声速换算 */ \
+    }
+
+HC_SR04_MEASURE_FN(HC_SR04_MeasureLid, HC_SR04_TRIG, HC_SR04_ECHO, HC_SR04_LID_MAX_TICKS)
+HC_SR04_MEASURE_FN(HC_SR04_MeasureFill, HC_SR04_FILL_TRIG, HC_SR04_FILL_ECHO, HC_SR04_FILL_MAX_TICKS)
+
 void HC_SR04_Init(void)
 {
     RCC_APB2PeriphClockCmd(ULTRASONIC_GPIO_CLK, ENABLE);  // 启用GPIOA外设时钟
@@ -18,42 +46,34 @@ void HC_SR04_Init(void)
     GPIO_InitStructure.GPIO_Pin  = ECHO_GPIO_PIN;                  // 设置GPIO口6
     GPIO_Init(ULTRASONIC_GPIO_PORT, &GPIO_InitStructure);          // 初始化GPIOA
     GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_RESET); // 输出低电平
-    Delay_us(15);                                                  // 延时15微秒
+
+    RCC_APB2PeriphClockCmd(FILL_GPIO_CLK, ENABLE); // 满溢测距模块
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
+    GPIO_InitStructure.GPIO_Pin  = FILL_TRIG_PIN;
+    GPIO_Init(FILL_GPIO_PORT, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPD;
+    GPIO_InitStructure.GPIO_Pin  = FILL_ECHO_PIN;
+    GPIO_Init(FILL_GPIO_PORT, &GPIO_InitStructure);
+    GPIO_WriteBit(FILL_GPIO_PORT, FILL_TRIG_PIN, Bit_RESET);
+
+    RangeCal_Init(); // 按默认温湿度计算声速，触发脚低电平需保持HC_SR04_SETTLE_US后才能测距
 }
 
-int16_t sonar_mm(void) // 测距并返回单位为毫米的距离结果
+int16_t HC_SR04_Measure(uint8_t ch) // 指定通道测距，返回毫米，超时或通道无效返回0
 {
-    uint32_t Distance, Distance_mm = 0;
-    GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_SET);             // 输出高电平
-    Delay_us(15);                                                            // 延时15微秒
-    GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_RESET);           // 输出低电平
-    while (GPIO_ReadInputDataBit(ULTRASONIC_GPIO_PORT, ECHO_GPIO_PIN) == 0); // 等待低电平结束
-    time = 0;                                                                // 计时清零
-    while (GPIO_ReadInputDataBit(ULTRASONIC_GPIO_PORT, ECHO_GPIO_PIN) == 1); // 等待高电平结束
-    time_end = time;                                                         // 记录结束时的时间
-    if (time_end / 100 < 38)                                                 // 判断是否小于38毫秒，大于38毫秒的就是超时，直接调到下面返回0
-    {
-        Distance    = (time_end * 346) / 2; // 计算距离，25°C空气中的音速为346m/s
-        Distance_mm = Distance / 100;       // 因为上面的time_end的单位是10微秒，所以要得出单位为毫米的距离结果，还得除以100
+    switch (ch) {
+        case HC_SR04_CH_LID: return HC_SR04_MeasureLid();
+        case HC_SR04_CH_FILL: return HC_SR04_MeasureFill();
+        default: return 0;
     }
-    return Distance_mm; // 返回测距结果
+}
+
+int16_t sonar_mm(void) // 测距并返回单位为毫米的距离结果
+{
+    return HC_SR04_MeasureLid();
 }
 
 float sonar(void) // 测距并返回单位为米的距离结果
 {
-    uint32_t Distance, Distance_mm = 0;
-    float Distance_m = 0;
-    GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_SET); // 输出高电平
-    Delay_us(15);
-    GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_RESET); // 输出低电平
-    while (GPIO_ReadInputDataBit(ULTRASONIC_GPIO_PORT, ECHO_GPIO_PIN) == 0);
-    time = 0;
-    while (GPIO_ReadInputDataBit(ULTRASONIC_GPIO_PORT, ECHO_GPIO_PIN) == 1);
-    time_end = time;
-    if (time_end / 100 < 38) {
-        Distance    = (time_end * 346) / 2;
-        Distance_mm = Distance / 100;
-        Distance_m  = Distance_mm / 1000;
-    }
-    return Distance_m;
-}
\ No newline at end of file
+    return HC_SR04_MeasureLid() / 1000.0f;
+}
@@ -1,9 +1,10 @@
 #ifndef __HC_SR04_H
 #define __HC_SR04_H
-#include "dk_C8T6.h" // Device header
+#include "DK_C8T6.h" // Device header
+#include "FastGPIO.h"
 
-/* 声速计算相关参数 */
-#define ULTRASONIC_TEMPERATURE 25    // 默认温度25℃
+/* 声速计算相关参数（定点计算见RangeCal.h） */
+#define ULTRASONIC_TEMPERATURE 25    // 默认温度25℃，无温湿度数据时使用
 #define ULTRASONIC_HUMIDITY    40    // 默认湿度40%
 #define SOUND_SPEED_BASE       331.4 // 声速基准值(0℃时)
 
@@ -12,11 +13,34 @@
 #define ULTRASONIC_GPIO_PORT GPIOA
 #define TRIG_GPIO_PIN        GPIO_Pin_2
 #define ECHO_GPIO_PIN        GPIO_Pin_3
+#define HC_SR04_TRIG         FGPIO(GPIOA, 2) // 快速GPIO引脚描述，与上面的端口/引脚一致
+#define HC_SR04_ECHO         FGPIO(GPIOA, 3)
 
 #define TRIG_Send            PAout(2)
 #define ECHO_Reci            PAin(3)
 
+/* 桶内向下的满溢测距模块（与盖上方模块共用测距函数，分时工作） */
+#define FILL_GPIO_CLK     RCC_APB2Periph_GPIOB
+#define FILL_GPIO_PORT    GPIOB
+#define FILL_TRIG_PIN     GPIO_Pin_6
+#define FILL_ECHO_PIN     GPIO_Pin_7         // 5V容忍引脚
+#define HC_SR04_FILL_TRIG FGPIO(GPIOB, 6)
+#define HC_SR04_FILL_ECHO FGPIO(GPIOB, 7)
+
+/* 测距通道 */
+#define HC_SR04_CH_LID  0 // 盖上方，接近检测
+#define HC_SR04_CH_FILL 1 // 桶内，满溢检测
+#define HC_SR04_CH_NUM  2
+
+/* 回波等待上限（10微秒计数） */
+#define HC_SR04_START_TICKS     300  // 触发后3ms内回波未开始视为模块未响应
+#define HC_SR04_LID_MAX_TICKS   3800 // 38ms，模块自身的无回波超时
+#define HC_SR04_FILL_MAX_TICKS  1200 // 12ms，约2米往返，桶内不会更远
+#define HC_SR04_FILL_WORST_MS   16   // 满溢测距最长耗时（毫秒），用于分时调度
+#define HC_SR04_SETTLE_US       15   // 初始化后触发脚低电平保持时间，之后才能测距
+
 void HC_SR04_Init(void);
+int16_t HC_SR04_Measure(uint8_t ch);
 int16_t sonar_mm(void);
 float sonar(void);
 
@@ -16,7 +16,7 @@
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
 #include "Delay.h"     // 延时函数
-#include "dk_C8T6.h"   // 项目主头文件
+#include "DK_C8T6.h"   // 项目主头文件
 
 /**
  * @brief 列线引脚定义 (PB12-PB15)
@@ -31,6 +31,7 @@
 #define KEY_ROW2_PIN GPIO_Pin_10
 #define KEY_ROW3_PIN GPIO_Pin_9
 #define KEY_ROW4_PIN GPIO_Pin_8
+#define KEY_ROW_ALL  (KEY_ROW1_PIN | KEY_ROW2_PIN | KEY_ROW3_PIN | KEY_ROW4_PIN)
 
 /**
  * @brief  矩阵键盘初始化
@@ -86,37 +87,34 @@ uint8_t Key_GetNum(void)
 {
     uint8_t KeyNum = 0;
     uint8_t row, col;
-    uint16_t rowPins[4] = {KEY_ROW1_PIN, KEY_ROW2_PIN, KEY_ROW3_PIN, KEY_ROW4_PIN};
-    uint16_t colPins[4] = {KEY_COL1_PIN, KEY_COL2_PIN, KEY_COL3_PIN, KEY_COL4_PIN};
+    static const uint16_t rowPins[4] = {KEY_ROW1_PIN, KEY_ROW2_PIN, KEY_ROW3_PIN, KEY_ROW4_PIN};
+    static const uint16_t colPins[4] = {KEY_COL1_PIN, KEY_COL2_PIN, KEY_COL3_PIN, KEY_COL4_PIN};
 
     /* 扫描每一行 */
     for (row = 0; row < 4; row++) {
-        /* 当前行置低，其他行置高 */
-        // 设置当前行为低电平，其他行为高电平
-        GPIO_WriteBit(GPIOA, rowPins[0], (row == 0) ? Bit_RESET : Bit_SET);
-        GPIO_WriteBit(GPIOA, rowPins[1], (row == 1) ? Bit_RESET : Bit_SET);
-        GPIO_WriteBit(GPIOA, rowPins[2], (row == 2) ? Bit_RESET : Bit_SET);
-        GPIO_WriteBit(GPIOA, rowPins[3], (row == 3) ? Bit_RESET : Bit_SET);
+        /* 当前行置低，其他行置高，一次BSRR写入同时完成 */
+        GPIOA->BSRR = (KEY_ROW_ALL & ~rowPins[row]) | ((uint32_t)rowPins[row] << 16);
+        Delay_us(1); // 等待列线电平稳定
 
         /* 检查每一列 */
         for (col = 0; col < 4; col++) {
-            if (GPIO_ReadInputDataBit(GPIOB, colPins[col]) == 0) // 检测到按键按下
+            if ((GPIOB->IDR & colPins[col]) == 0) // 检测到按键按下
             {
                 // 在这里添加调试显示代码
                 // OLED_ShowNum(2, 1, row, 1); // 显示行号
                 // OLED_ShowNum(2, 3, col, 1); // 显示列号
                 // OLED_ShowNum(3, 1, 88, 2);  // 显示一个固定数字，表示进入了按键检测分支
 
-                Delay_ms(20);                                            // 延时消抖
-                while (GPIO_ReadInputDataBit(GPIOB, colPins[col]) == 0); // 等待按键释放
-                Delay_ms(20);                                            // 延时消抖
+                Delay_Yield_ms(20);                                      // 延时消抖
+                while ((GPIOB->IDR & colPins[col]) == 0);                // 等待按键释放
+                Delay_Yield_ms(20);                                      // 延时消抖
                 KeyNum = (3 - col) * 4 + (3 - row) + 1;                  // 计算键值(1-16)
                 break;
             }
         }
 
         /* 恢复所有行线为高 */
-        GPIO_SetBits(GPIOA, KEY_ROW1_PIN | KEY_ROW2_PIN | KEY_ROW3_PIN | KEY_ROW4_PIN);
+        GPIOA->BSRR = KEY_ROW_ALL;
 
         if (KeyNum != 0) break; // 已检测到按键，退出扫描
     }
@@ -11,7 +11,7 @@
  */
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
-#include "dk_C8T6.h"   // 项目主头文件
+#include "DK_C8T6.h"   // 项目主头文件
 #include "LED.h"       // LED驱动程序头文件
 
 /**
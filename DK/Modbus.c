@@ -0,0 +1,194 @@
+/**
+ * @file     Modbus.c
+ * @brief    Modbus RTU从站协议处理
+ * @details  请求帧先校验长度和CRC，再按地址过滤；
+ *          读请求逐个寄存器回调，写请求把整段寄存器一次交给应用；
+ *          应答在调用者提供的缓冲区中生成，不占用额外RAM
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Modbus.h"
+
+#define MODBUS_ADDR_BROADCAST 0
+
+/**
+ * @brief CRC16查表（多项式0xA001，反射）
+ */
+static const uint16_t modbus_crc_table[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+/**
+ * @brief  计算CRC16
+ * @param  buf 数据
+ * @param  len 长度
+ * @return CRC16
+ */
+uint16_t Modbus_CRC16(const uint8_t *buf, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--) {
+        crc = (crc >> 8) ^ modbus_crc_table[(crc ^ *buf++) & 0xFF];
+    }
+    return crc;
+}
+
+/**
+ * @brief  追加CRC
+ * @return 含CRC的帧长度
+ */
+static uint16_t Modbus_Finish(uint8_t *rsp, uint16_t len)
+{
+    uint16_t crc = Modbus_CRC16(rsp, len);
+
+    rsp[len]     = (uint8_t)(crc & 0xFF);
+    rsp[len + 1] = (uint8_t)(crc >> 8);
+    return len + 2;
+}
+
+/**
+ * @brief  读寄存器（03/04）
+ * @return 异常码
+ */
+static uint8_t Modbus_Read(Modbus_Slave_t *s, uint8_t table, const uint8_t *req, uint16_t len, uint8_t *rsp,
+                           uint16_t *rsp_len)
+{
+    uint16_t reg, count, i, value;
+    uint8_t ex;
+
+    if (len != 8) return MODBUS_EX_ILLEGAL_VALUE;
+    reg   = MODBUS_GET16(&req[2]);
+    count = MODBUS_GET16(&req[4]);
+    if (count == 0 || count > MODBUS_READ_MAX) return MODBUS_EX_ILLEGAL_VALUE;
+    if ((uint32_t)reg + count > 0x10000UL) return MODBUS_EX_ILLEGAL_ADDR;
+
+    for (i = 0; i < count; i++) {
+        ex = s->read(s->ctx, table, reg + i, &value);
+        if (ex != MODBUS_EX_NONE) return ex;
+        rsp[3 + i * 2] = (uint8_t)(value >> 8);
+        rsp[4 + i * 2] = (uint8_t)(value & 0xFF);
+    }
+    rsp[2]   = (uint8_t)(count * 2);
+    *rsp_len = 3 + count * 2;
+    return MODBUS_EX_NONE;
+}
+
+/**
+ * @brief  写寄存器（06/16）
+ * @details 寄存器值直接以请求帧中的大端字节交给应用，不在栈上展开
+ * @return 异常码
+ */
+static uint8_t Modbus_Write(Modbus_Slave_t *s, const uint8_t *req, uint16_t len, uint8_t *rsp, uint16_t *rsp_len)
+{
+    uint16_t reg = MODBUS_GET16(&req[2]);
+    uint16_t count, i;
+    const uint8_t *data;
+    uint8_t ex;
+
+    if (req[1] == MODBUS_FC_WRITE_SINGLE) {
+        if (len != 8) return MODBUS_EX_ILLEGAL_VALUE;
+        count = 1;
+        data  = &req[4];
+    } else {
+        if (len < 9) return MODBUS_EX_ILLEGAL_VALUE;
+        count = MODBUS_GET16(&req[4]);
+        if (count == 0 || count > MODBUS_WRITE_MAX || req[6] != count * 2 || len != 9 + count * 2) {
+            return MODBUS_EX_ILLEGAL_VALUE;
+        }
+        data = &req[7];
+    }
+    if ((uint32_t)reg + count > 0x10000UL) return MODBUS_EX_ILLEGAL_ADDR;
+
+    ex = s->write(s->ctx, reg, data, count);
+    if (ex != MODBUS_EX_NONE) return ex;
+
+    /* 06原样回送，16回送地址和数量 */
+    for (i = 2; i < 6; i++) {
+        rsp[i] = req[i];
+    }
+    *rsp_len = 6;
+    return MODBUS_EX_NONE;
+}
+
+/**
+ * @brief  处理一个请求帧
+ * @param  slave 从站
+ * @param  req   请求帧
+ * @param  len   请求帧长度
+ * @param  rsp   应答缓冲区
+ * @return 应答帧长度，0表示不应答
+ */
+uint16_t Modbus_Process(Modbus_Slave_t *slave, const uint8_t *req, uint16_t len, uint8_t *rsp)
+{
+    uint16_t rsp_len = 0;
+    uint8_t ex;
+
+    if (len < MODBUS_FRAME_MIN || len > MODBUS_FRAME_MAX) return 0;
+    if (req[0] != slave->addr && req[0] != MODBUS_ADDR_BROADCAST) return 0; // 其他从站的帧，不必校验
+    if (Modbus_CRC16(req, len - 2) != (uint16_t)(req[len - 2] | (req[len - 1] << 8))) {
+        slave->crc_errors++;
+        return 0;
+    }
+    slave->frames++;
+
+    rsp[0] = slave->addr;
+    rsp[1] = req[1];
+    switch (req[1]) {
+        case MODBUS_FC_READ_HOLDING:
+            ex = Modbus_Read(slave, MODBUS_TABLE_HOLDING, req, len, rsp, &rsp_len);
+            break;
+        case MODBUS_FC_READ_INPUT:
+            ex = Modbus_Read(slave, MODBUS_TABLE_INPUT, req, len, rsp, &rsp_len);
+            break;
+        case MODBUS_FC_WRITE_SINGLE:
+        case MODBUS_FC_WRITE_MULTI:
+            ex = Modbus_Write(slave, req, len, rsp, &rsp_len);
+            break;
+        default:
+            ex = MODBUS_EX_ILLEGAL_FUNC;
+            break;
+    }
+
+    if (req[0] == MODBUS_ADDR_BROADCAST) return 0; // 广播不应答
+    if (ex != MODBUS_EX_NONE) {
+        slave->exceptions++;
+        rsp[1] = req[1] | 0x80;
+        rsp[2] = ex;
+        rsp_len = 3;
+    }
+    return Modbus_Finish(rsp, rsp_len);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file     Modbus.h
+ * @brief    Modbus RTU从站协议处理头文件
+ * @details  处理一个完整的RTU请求帧并生成应答帧：
+ *          - CRC16查表计算（多项式0xA001，低字节在前）
+ *          - 支持功能码 03读保持寄存器、04读输入寄存器、06写单个寄存器、16写多个寄存器
+ *          - 寄存器读写通过回调交给应用，出错时回送异常码
+ *          - 广播地址0只执行写操作，不应答
+ *          帧的收发（3.5字符间隔断帧、DMA）由串口驱动完成，本模块不依赖硬件，可在主机上仿真
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __MODBUS_H
+#define __MODBUS_H
+
+#include <stdint.h>
+
+/**
+ * @brief 帧长度
+ */
+#define MODBUS_FRAME_MAX 256 /**< RTU帧最大长度（字节） */
+#define MODBUS_FRAME_MIN 4   /**< 地址+功能码+CRC */
+#define MODBUS_READ_MAX  125 /**< 单次读寄存器最大数量 */
+#define MODBUS_WRITE_MAX 123 /**< 单次写多个寄存器最大数量 */
+
+/**
+ * @brief 读取大端16位（写回调中取寄存器值）
+ */
+#define MODBUS_GET16(p) ((uint16_t)(((const uint8_t *)(p))[0] << 8 | ((const uint8_t *)(p))[1]))
+
+/**
+ * @brief 寄存器表
+ */
+#define MODBUS_TABLE_INPUT   0 /**< 输入寄存器（只读） */
+#define MODBUS_TABLE_HOLDING 1 /**< 保持寄存器 */
+
+/**
+ * @brief 功能码
+ */
+#define MODBUS_FC_READ_HOLDING  0x03
+#define MODBUS_FC_READ_INPUT    0x04
+#define MODBUS_FC_WRITE_SINGLE  0x06
+#define MODBUS_FC_WRITE_MULTI   0x10
+
+/**
+ * @brief 异常码，回调返回0表示成功
+ */
+#define MODBUS_EX_NONE          0x00
+#define MODBUS_EX_ILLEGAL_FUNC  0x01 /**< 不支持的功能码 */
+#define MODBUS_EX_ILLEGAL_ADDR  0x02 /**< 寄存器地址无效 */
+#define MODBUS_EX_ILLEGAL_VALUE 0x03 /**< 数值或数量无效 */
+#define MODBUS_EX_DEVICE_FAIL   0x04 /**< 执行失败 */
+
+/**
+ * @brief 从站
+ */
+typedef struct
+{
+    uint8_t addr; /**< 从站地址 1~247 */
+    void *ctx;    /**< 回调上下文 */
+    /**
+     * @brief 读一个寄存器
+     * @param table 寄存器表 MODBUS_TABLE_x
+     * @return 异常码
+     */
+    uint8_t (*read)(void *ctx, uint8_t table, uint16_t reg, uint16_t *value);
+    /**
+     * @brief 写连续的保持寄存器（同一请求中的寄存器一次交给应用，便于成对写32位参数）
+     * @param data 寄存器值，每个寄存器2字节大端，用MODBUS_GET16读取
+     * @return 异常码
+     */
+    uint8_t (*write)(void *ctx, uint16_t reg, const uint8_t *data, uint16_t count);
+    uint32_t frames;     /**< 发给本站（含广播）且校验通过的请求数 */
+    uint32_t crc_errors; /**< CRC错误帧数 */
+    uint32_t exceptions; /**< 异常应答数 */
+} Modbus_Slave_t;
+
+/**
+ * @brief  计算CRC16
+ * @param  buf 数据
+ * @param  len 长度
+ * @return CRC16，发送时低字节在前
+ */
+uint16_t Modbus_CRC16(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  处理一个请求帧
+ * @param  slave 从站
+ * @param  req   请求帧（含CRC）
+ * @param  len   请求帧长度
+ * @param  rsp   应答缓冲区，至少MODBUS_FRAME_MAX字节
+ * @return 应答帧长度（含CRC），0表示不应答（校验错误、非本站地址或广播）
+ */
+uint16_t Modbus_Process(Modbus_Slave_t *slave, const uint8_t *req, uint16_t len, uint8_t *rsp);
+
+#endif /* __MODBUS_H */
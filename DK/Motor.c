@@ -5,6 +5,7 @@
  *          - PWM调速
  *          - 正反转控制
  *          - 启停控制
+ *          - 限位开关和电流检测（压缩机）
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
@@ -12,30 +13,58 @@
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
 #include "PWM.h"       // PWM驱动头文件
-#include "dk_C8T6.h"   // 项目主头文件
+#include "Motor.h"     // 电机引脚定义
+#include "DK_C8T6.h"   // 项目主头文件
 
 /**
  * @brief  直流电机初始化
  * @details 完成以下配置：
  *         1. 使能GPIO时钟
- *         2. 配置方向控制引脚（PA4和PA5）为推挽输出
- *         3. 初始化PWM（用于速度控制）
- * @note   使用TIM3的通道1输出PWM信号
+ *         2. 配置方向控制引脚（PB14和PB15）为推挽输出
+ *         3. 初始化PWM（用于速度控制，同时关闭JTAG释放PB3/PA15）
+ *         4. 配置限位开关为上拉输入
+ *         5. 电流检测通道开始连续转换
+ * @note   使用TIM3的通道1（PB4）输出PWM信号；ADC2由启动流程上电并校准
  * @param  无
  * @return 无
  */
 void Motor_Init(void)
 {
     /*开启时钟*/
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE); // 开启GPIOA的时钟
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | MOTOR_IN_CLK, ENABLE); // 开启GPIOA和方向引脚的时钟
 
     GPIO_InitTypeDef GPIO_InitStructure;
     GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP;
-    GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_4 | GPIO_Pin_5;
+    GPIO_InitStructure.GPIO_Pin   = MOTOR_IN1_PIN | MOTOR_IN2_PIN;
     GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-    GPIO_Init(GPIOA, &GPIO_InitStructure); // 将PA4和PA5引脚初始化为推挽输出
+    GPIO_Init(MOTOR_IN_PORT, &GPIO_InitStructure); // 方向引脚初始化为推挽输出
 
     PWM_Init(); // 初始化直流电机的底层PWM
+
+#if MOTOR_LIMIT_EN
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU; // 限位开关接地，上拉输入
+    GPIO_InitStructure.GPIO_Pin  = MOTOR_END_PIN;
+    GPIO_Init(MOTOR_END_PORT, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin = MOTOR_HOME_PIN;
+    GPIO_Init(MOTOR_HOME_PORT, &GPIO_InitStructure);
+#endif
+
+#if MOTOR_SENSE_EN
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AIN; // PA4模拟输入
+    GPIO_InitStructure.GPIO_Pin  = GPIO_Pin_4;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    ADC_InitTypeDef ADC_InitStructure;
+    ADC_InitStructure.ADC_Mode               = ADC_Mode_Independent;
+    ADC_InitStructure.ADC_DataAlign          = ADC_DataAlign_Right;
+    ADC_InitStructure.ADC_ExternalTrigConv   = ADC_ExternalTrigConv_None;
+    ADC_InitStructure.ADC_ContinuousConvMode = ENABLE; // 连续转换，Motor_GetCurrent直接取最新结果
+    ADC_InitStructure.ADC_ScanConvMode       = DISABLE;
+    ADC_InitStructure.ADC_NbrOfChannel       = 1;
+    ADC_Init(ADC2, &ADC_InitStructure);
+    ADC_RegularChannelConfig(ADC2, MOTOR_SENSE_CHANNEL, 1, ADC_SampleTime_55Cycles5);
+    ADC_SoftwareStartConvCmd(ADC2, ENABLE);
+#endif
 }
 
 /**
@@ -54,13 +83,48 @@ void Motor_SetSpeed(int8_t Speed)
 {
     if (Speed >= 0) // 如果设置正转的速度值
     {
-        GPIO_SetBits(GPIOA, GPIO_Pin_4);   // PA4置高电平
-        GPIO_ResetBits(GPIOA, GPIO_Pin_5); // PA5置低电平，设置方向为正转
-        PWM_SetCompare1(Speed);            // PWM设置为速度值
-    } else                                 // 否则，即设置反转的速度值
+        GPIO_SetBits(MOTOR_IN_PORT, MOTOR_IN1_PIN);   // IN1置高电平
+        GPIO_ResetBits(MOTOR_IN_PORT, MOTOR_IN2_PIN); // IN2置低电平，设置方向为正转
+        PWM_SetCompare1(Speed);                       // PWM设置为速度值
+    } else                                            // 否则，即设置反转的速度值
     {
-        GPIO_ResetBits(GPIOA, GPIO_Pin_4); // PA4置低电平
-        GPIO_SetBits(GPIOA, GPIO_Pin_5);   // PA5置高电平，设置方向为反转
-        PWM_SetCompare1(-Speed);           // PWM设置为负的速度值，因为此时速度值为负数，而PWM只能给正数
+        GPIO_ResetBits(MOTOR_IN_PORT, MOTOR_IN1_PIN); // IN1置低电平
+        GPIO_SetBits(MOTOR_IN_PORT, MOTOR_IN2_PIN);   // IN2置高电平，设置方向为反转
+        PWM_SetCompare1(-Speed);                      // PWM设置为负的速度值，因为此时速度值为负数，而PWM只能给正数
     }
 }
+
+/**
+ * @brief  读取电机电流
+ * @details 电压 = raw * 3300 / 4096（mV），电流 = 电压 * 1000 / MOTOR_SENSE_MV_PER_A（mA），见MOTOR_RAW_TO_MA
+ * @param  无
+ * @return 电流（毫安），没有电流检测时为0
+ */
+uint16_t Motor_GetCurrent(void)
+{
+#if MOTOR_SENSE_EN
+    return (uint16_t)MOTOR_RAW_TO_MA(ADC_GetConversionValue(ADC2));
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief  到底限位是否触发
+ * @param  无
+ * @return 1：触发（低电平）
+ */
+uint8_t Motor_AtEnd(void)
+{
+    return GPIO_ReadInputDataBit(MOTOR_END_PORT, MOTOR_END_PIN) == Bit_RESET;
+}
+
+/**
+ * @brief  原位限位是否触发
+ * @param  无
+ * @return 1：触发（低电平）
+ */
+uint8_t Motor_AtHome(void)
+{
+    return GPIO_ReadInputDataBit(MOTOR_HOME_PORT, MOTOR_HOME_PIN) == Bit_RESET;
+}
@@ -1,7 +1,9 @@
 /**
  * @file     Motor.h
  * @brief    直流电机驱动程序头文件
- * @details  声明电机控制相关的函数接口
+ * @details  声明电机控制相关的函数接口；电机用于垃圾压缩机（见Compactor.h）：
+ *          - 正转压下，反转收回
+ *          - 到底/原位限位开关，电流检测用于判断堵转
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
@@ -10,11 +12,46 @@
 #ifndef __MOTOR_H
 #define __MOTOR_H
 
+#include <stdint.h>
+
+/**
+ * @brief 电机硬件连接定义
+ * @note  原方向引脚PA5与DS1302的CE冲突，改到PB14/PB15；
+ *        PWM为TIM3_CH1重映射到PB4，限位开关PB3/PA15需关闭JTAG（PWM初始化时完成）
+ */
+#define MOTOR_IN_PORT   GPIOB               /**< 方向控制端口（H桥IN1/IN2） */
+#define MOTOR_IN_CLK    RCC_APB2Periph_GPIOB
+#define MOTOR_IN1_PIN   GPIO_Pin_14         /**< 方向1，PB14 */
+#define MOTOR_IN2_PIN   GPIO_Pin_15         /**< 方向2，PB15 */
+#define MOTOR_END_PORT  GPIOB               /**< 到底限位，PB3，低电平触发 */
+#define MOTOR_END_PIN   GPIO_Pin_3
+#define MOTOR_HOME_PORT GPIOA               /**< 原位限位，PA15，低电平触发 */
+#define MOTOR_HOME_PIN  GPIO_Pin_15
+
+/**
+ * @brief 电流检测：采样电阻+放大器输出接PA4（ADC2通道4），ADC2连续转换
+ */
+#define MOTOR_LIMIT_EN       1             /**< 1：装有限位开关，0：只靠电流和超时 */
+#define MOTOR_SENSE_EN       1             /**< 1：装有电流检测 */
+#define MOTOR_SENSE_CHANNEL  ADC_Channel_4 /**< PA4 */
+#define MOTOR_SENSE_MV_PER_A 1000          /**< 检测电压（mV/A），如0.05Ω采样电阻+20倍放大 */
+
+/**
+ * @brief  ADC原始值换算为电流（毫安）
+ * @details 先换算为电压（mV，不超过3300），再换算为电流，32位运算不溢出
+ *         （raw * 3300 * 1000 在raw > 1301时超过32位）；主机端检查见Tools/motor_sense
+ * @param  raw ADC原始值，范围：0~4095
+ * @return 电流（毫安），uint32_t
+ */
+#define MOTOR_RAW_TO_MA(raw) ((uint32_t)(raw) * 3300UL / 4096UL * 1000UL / MOTOR_SENSE_MV_PER_A)
+
 /**
  * @brief  初始化直流电机
  * @details 配置GPIO和PWM：
- *         - PA4/PA5：方向控制引脚
- *         - TIM3_CH1：PWM输出引脚
+ *         - PB14/PB15：方向控制引脚
+ *         - TIM3_CH1（PB4）：PWM输出引脚
+ *         - PB3/PA15：限位开关输入（上拉）
+ *         - PA4：电流检测，ADC2连续转换（ADC2需已校准）
  * @param  无
  * @return 无
  */
@@ -23,7 +60,7 @@ void Motor_Init(void);
 /**
  * @brief  设置电机速度
  * @details 通过PWM占空比和方向控制实现速度调节：
- *         - 使用PA4和PA5控制方向
+ *         - 使用PB14和PB15控制方向
  *         - 使用PWM控制速度
  * @param  Speed 速度值，范围-100~100
  *         - -100~-1：反转，速度随绝对值增大而增大
@@ -33,4 +70,26 @@ void Motor_Init(void);
  */
 void Motor_SetSpeed(int8_t Speed);
 
+/**
+ * @brief  读取电机电流
+ * @details 直接取ADC2最新的转换结果，不等待
+ * @param  无
+ * @return 电流（毫安）
+ */
+uint16_t Motor_GetCurrent(void);
+
+/**
+ * @brief  到底限位是否触发
+ * @param  无
+ * @return 1：触发
+ */
+uint8_t Motor_AtEnd(void);
+
+/**
+ * @brief  原位限位是否触发
+ * @param  无
+ * @return 1：触发
+ */
+uint8_t Motor_AtHome(void);
+
 #endif /* __MOTOR_H */
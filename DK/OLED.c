@@ -1,5 +1,8 @@
 #include "stm32f10x.h"
 #include "OLED.h"
+#include "FastGPIO.h"
+#include "Delay.h"
+#include "RamFunc.h"
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -58,45 +61,68 @@
  * OLED_UpdateOLED_UpdateArea
  * ŻὫԴݷ͵OLEDӲʾ
  */
+#if OLED_DOUBLE_BUFFER
+static uint8_t OLED_FrameBuf[2][8][128];
+uint8_t (*OLED_DisplayBuf)[128]       = OLED_FrameBuf[0]; // ̨壬ʾڴ˻
+static uint8_t (*OLED_FrontBuf)[128] = OLED_FrameBuf[1]; // ǰ̨壬̨ڼ䲻޸
+static uint8_t OLED_PresentPending   = 0;                // һ֡ȴ
+#else
 uint8_t OLED_DisplayBuf[8][128];
+#endif
+
+/**
+ * 첽ˢ´䣬ĬΪI2C
+ * ڼɴռãͬд루OLED_Updateȣȵȴ
+ */
+static const OLED_Transport_t *OLED_Transport = &OLED_TransportBitBang;
+
+/*ÿ֡ʾǰãΪ֡Ļϵһ֡8ҳx128Уţ*/
+static OLED_PresentHook_t OLED_PresentHook = NULL;
 
 /*********************ȫֱ*/
 
 /**********************/
 
+/*OLEDţSCL-PB8SDA-PB9©*/
+#define OLED_SCL FGPIO(GPIOB, 8)
+#define OLED_SDA FGPIO(GPIOB, 9)
+
 /**
- *     OLEDдSCLߵ͵ƽ
- *     ҪдSCLĵƽֵΧ0/1
+ * ˵    ÿдSCL/SDAıʱ䣨룩
+ *           ŲǵBSRR/BRRд룬ʱSCLɴMHzOLEDI2CʱҪ
+ *           ԭ⺯дÿԼ0.3usĻȶʵӴ
+ */
+#define OLED_I2C_HOLD_NS 150
+
+/**
+ *     I2Cʱ
+ *     
  *   ֵ
- * ˵    ϲ㺯ҪдSCLʱ˺ᱻ
- *           ûҪݲֵSCLΪߵƽߵ͵ƽ
- *           0ʱSCLΪ͵ƽ1ʱSCLΪߵƽ
+ * ˵    ʹDelayĶʱ·ڱ
  */
-void OLED_W_SCL(uint8_t BitValue)
-{
-    /*BitValueֵSCLøߵƽߵ͵ƽ*/
-    GPIO_WriteBit(GPIOB, GPIO_Pin_8, (BitAction)BitValue);
+#define OLED_I2C_Delay() DELAY_NS(OLED_I2C_HOLD_NS)
 
-    /*Ƭٶȹ죬ڴʱԱⳬI2Cͨŵٶ*/
-    //...
-}
+/**
+ *     OLEDдSCLߵ͵ƽ
+ *     ҪдSCLĵƽֵΧ0/1
+ * ˵    ΪһBSRRд룬֮󱣳һ
+ */
+#define OLED_W_SCL(BitValue)                 \
+    do {                                     \
+        FGPIO_W(OLED_SCL, BitValue);         \
+        OLED_I2C_Delay();                    \
+    } while (0)
 
 /**
  *     OLEDдSDAߵ͵ƽ
  *     ҪдSDAĵƽֵΧ0/1
- *   ֵ
- * ˵    ϲ㺯ҪдSDAʱ˺ᱻ
- *           ûҪݲֵSDAΪߵƽߵ͵ƽ
- *           0ʱSDAΪ͵ƽ1ʱSDAΪߵƽ
+ * ˵    ΪһBSRRд룬֮󱣳һڣݽʼ/ֹʱ
  */
-void OLED_W_SDA(uint8_t BitValue)
-{
-    /*BitValueֵSDAøߵƽߵ͵ƽ*/
-    GPIO_WriteBit(GPIOB, GPIO_Pin_9, (BitAction)BitValue);
-
-    /*Ƭٶȹ죬ڴʱԱⳬI2Cͨŵٶ*/
-    //...
-}
+#define OLED_W_SDA(BitValue)                 \
+    do {                                     \
+        FGPIO_W(OLED_SDA, BitValue);         \
+        OLED_I2C_Delay();                    \
+    } while (0)
 
 /**
  *     OLEDųʼ
@@ -107,12 +133,7 @@ void OLED_W_SDA(uint8_t BitValue)
  */
 void OLED_GPIO_Init(void)
 {
-    uint32_t i, j;
-
-    /*ڳʼǰʱOLEDȶ*/
-    for (i = 0; i < 1000; i++) {
-        for (j = 0; j < 1000; j++);
-    }
+    /*ϵȴOLEDȶOLED_POWER_SETTLE_MSɵ߰ţBoot.c*/
 
     /*SCLSDAųʼΪ©ģʽ*/
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
@@ -139,7 +160,7 @@ void OLED_GPIO_Init(void)
  *     
  *   ֵ
  */
-void OLED_I2C_Start(void)
+RAMFUNC void OLED_I2C_Start(void)
 {
     OLED_W_SDA(1); // ͷSDAȷSDAΪߵƽ
     OLED_W_SCL(1); // ͷSCLȷSCLΪߵƽ
@@ -152,7 +173,7 @@ void OLED_I2C_Start(void)
  *     
  *   ֵ
  */
-void OLED_I2C_Stop(void)
+RAMFUNC void OLED_I2C_Stop(void)
 {
     OLED_W_SDA(0); // SDAȷSDAΪ͵ƽ
     OLED_W_SCL(1); // ͷSCLʹSCLָߵƽ
@@ -164,7 +185,7 @@ void OLED_I2C_Stop(void)
  *     Byte Ҫ͵һֽݣΧ0x00~0xFF
  *   ֵ
  */
-void OLED_I2C_SendByte(uint8_t Byte)
+RAMFUNC void OLED_I2C_SendByte(uint8_t Byte)
 {
     uint8_t i;
 
@@ -181,6 +202,16 @@ void OLED_I2C_SendByte(uint8_t Byte)
     OLED_W_SCL(0);
 }
 
+/**
+ *     ȴ첽ˢɣͷ
+ *     
+ *   ֵ
+ */
+static void OLED_WaitIdle(void)
+{
+    while (OLED_Transport->Busy());
+}
+
 /**
  *     OLEDд
  *     Command ҪдֵΧ0x00~0xFF
@@ -188,6 +219,7 @@ void OLED_I2C_SendByte(uint8_t Byte)
  */
 void OLED_WriteCommand(uint8_t Command)
 {
+    OLED_WaitIdle(); // ȴ̨
     OLED_I2C_Start();           // I2Cʼ
     OLED_I2C_SendByte(0x78);    // OLEDI2Cӻַ
     OLED_I2C_SendByte(0x00);    // ֽڣ0x00ʾд
@@ -195,6 +227,98 @@ void OLED_WriteCommand(uint8_t Command)
     OLED_I2C_Stop();            // I2Cֹ
 }
 
+/**
+ *     OLEDд
+ *     Commands Ҫдʼַ
+ *     Count Ҫд
+ *   ֵ
+ * ˵    һʼ/ֹֽͣ0x00Co=0ֽڶ
+ */
+void OLED_WriteCommands(const uint8_t *Commands, uint8_t Count)
+{
+    uint8_t i;
+
+    OLED_WaitIdle(); // ȴ̨
+    OLED_I2C_Start();        // I2Cʼ
+    OLED_I2C_SendByte(0x78); // OLEDI2Cӻַ
+    OLED_I2C_SendByte(0x00); // ֽڣ0x00ʾ֮
+    for (i = 0; i < Count; i++) {
+        OLED_I2C_SendByte(Commands[i]); // ηÿһ
+    }
+    OLED_I2C_Stop(); // I2Cֹ
+}
+
+/**
+ * ˵    OLEDѶռһI2Cд
+ *           ʱȷռֽҪԽ߽
+ */
+#define OLED_CMD_STREAM_SIZE 16
+
+typedef struct
+{
+    uint8_t Buf[OLED_CMD_STREAM_SIZE]; // ռ
+    uint8_t Len;                       // ռ
+} OLED_CmdStream_t;
+
+/**
+ *     ʼռ
+ *     Stream 
+ *   ֵ
+ */
+static void OLED_CmdStream_Begin(OLED_CmdStream_t *Stream)
+{
+    Stream->Len = 0;
+}
+
+/**
+ *     ռ
+ *     Stream 
+ *   ֵ
+ */
+static void OLED_CmdStream_Send(OLED_CmdStream_t *Stream)
+{
+    if (Stream->Len > 0) {
+        OLED_WriteCommands(Stream->Buf, Stream->Len);
+    }
+    Stream->Len = 0;
+}
+
+/**
+ *     ׷һ
+ *     Stream 
+ *     Command ֵΧ0x00~0xFF
+ *   ֵ
+ */
+static void OLED_CmdStream_Put(OLED_CmdStream_t *Stream, uint8_t Command)
+{
+    if (Stream->Len >= OLED_CMD_STREAM_SIZE) {
+        OLED_CmdStream_Send(Stream);
+    }
+    Stream->Buf[Stream->Len++] = Command;
+}
+
+/**
+ *     OLEDд봰
+ *     X0 ʼУX1 УΧ0~127
+ *     Page0 ʼҳPage1 ҳΧ0~7
+ *   ֵ
+ * ˵    ˮƽѰַģʽ£֮дڴСҳԶ
+ *           еַҳַһI2Cд
+ */
+static void OLED_SetWindow(uint8_t X0, uint8_t X1, uint8_t Page0, uint8_t Page1)
+{
+    OLED_CmdStream_t Stream;
+
+    OLED_CmdStream_Begin(&Stream);
+    OLED_CmdStream_Put(&Stream, 0x21); // еַΧ
+    OLED_CmdStream_Put(&Stream, X0);
+    OLED_CmdStream_Put(&Stream, X1);
+    OLED_CmdStream_Put(&Stream, 0x22); // ҳַΧ
+    OLED_CmdStream_Put(&Stream, Page0);
+    OLED_CmdStream_Put(&Stream, Page1);
+    OLED_CmdStream_Send(&Stream);
+}
+
 /**
  *     OLEDд
  *     Data Ҫдݵʼַ
@@ -205,6 +329,7 @@ void OLED_WriteData(uint8_t *Data, uint8_t Count)
 {
     uint8_t i;
 
+    OLED_WaitIdle(); // ȴ̨
     OLED_I2C_Start();        // I2Cʼ
     OLED_I2C_SendByte(0x78); // OLEDI2Cӻַ
     OLED_I2C_SendByte(0x40); // ֽڣ0x40ʾд
@@ -215,10 +340,54 @@ void OLED_WriteData(uint8_t *Data, uint8_t Count)
     OLED_I2C_Stop(); // I2Cֹ
 }
 
+/**
+ *     OLEDдԴ洰
+ *     X ʼУΧ0~127
+ *     Width Χ1~128-X
+ *     Page0 ʼҳPage1 ҳΧ0~7
+ *   ֵ
+ * ˵    д봰ڣٰѴڸҳԴһI2Cд
+ */
+static void OLED_WriteWindow(uint8_t X, uint8_t Width, uint8_t Page0, uint8_t Page1)
+{
+    uint8_t i, j;
+
+    OLED_SetWindow(X, X + Width - 1, Page0, Page1);
+
+    OLED_I2C_Start();        // I2Cʼ
+    OLED_I2C_SendByte(0x78); // OLEDI2Cӻַ
+    OLED_I2C_SendByte(0x40); // ֽڣ0x40ʾд
+    for (j = Page0; j <= Page1; j++) {
+        for (i = 0; i < Width; i++) {
+            OLED_I2C_SendByte(OLED_DisplayBuf[j][X + i]); // ҳд
+        }
+    }
+    OLED_I2C_Stop(); // I2Cֹ
+}
+
 /*********************ͨЭ*/
 
 /*Ӳ*********************/
 
+/*OLEDʼУʾֹرգٿ*/
+static const uint8_t OLED_InitCmds[] = {
+    0xAE,       // ʾ/رգ0xAEرգ0xAF
+    0xD5, 0x80, // ʾʱӷƵ/Ƶʣ0x00~0xFF
+    0xA8, 0x3F, // ö·ʣ0x0E~0x3F
+    0xD3, 0x00, // ʾƫƣ0x00~0x7F
+    0x40,       // ʾʼУ0x40~0x7F
+    0xA1,       // ҷ0xA10xA0ҷ
+    0xC8,       // ·0xC80xC0·
+    0xDA, 0x12, // COMӲ
+    0x81, 0xCF, // öԱȶȣ0x00~0xFF
+    0xD9, 0xF1, // Ԥ
+    0xDB, 0x30, // VCOMHȡѡ񼶱
+    0xA4,       // ʾ/ر
+    0xA6,       // /ɫʾ0xA60xA7ɫ
+    0x8D, 0x14, // ó
+    0x20, 0x00, // ڴѰַģʽ0x00ˮƽѰַˢʱڸҳһд
+};
+
 /**
  *     OLEDʼ
  *     
@@ -229,47 +398,13 @@ void OLED_Init(void)
 {
     OLED_GPIO_Init(); // ȵõײĶ˿ڳʼ
 
-    /*дһϵеOLEDгʼ*/
-    OLED_WriteCommand(0xAE); // ʾ/رգ0xAEرգ0xAF
-
-    OLED_WriteCommand(0xD5); // ʾʱӷƵ/Ƶ
-    OLED_WriteCommand(0x80); // 0x00~0xFF
-
-    OLED_WriteCommand(0xA8); // ö·
-    OLED_WriteCommand(0x3F); // 0x0E~0x3F
-
-    OLED_WriteCommand(0xD3); // ʾƫ
-    OLED_WriteCommand(0x00); // 0x00~0x7F
-
-    OLED_WriteCommand(0x40); // ʾʼУ0x40~0x7F
-
-    OLED_WriteCommand(0xA1); // ҷ0xA10xA0ҷ
-
-    OLED_WriteCommand(0xC8); // ·0xC80xC0·
-
-    OLED_WriteCommand(0xDA); // COMӲ
-    OLED_WriteCommand(0x12);
-
-    OLED_WriteCommand(0x81); // öԱȶ
-    OLED_WriteCommand(0xCF); // 0x00~0xFF
-
-    OLED_WriteCommand(0xD9); // Ԥ
-    OLED_WriteCommand(0xF1);
-
-    OLED_WriteCommand(0xDB); // VCOMHȡѡ񼶱
-    OLED_WriteCommand(0x30);
-
-    OLED_WriteCommand(0xA4); // ʾ/ر
-
-    OLED_WriteCommand(0xA6); // /ɫʾ0xA60xA7ɫ
-
-    OLED_WriteCommand(0x8D); // ó
-    OLED_WriteCommand(0x14);
-
-    OLED_WriteCommand(0xAF); // ʾ
+    /*ʼһI2Cд*/
+    OLED_WriteCommands(OLED_InitCmds, sizeof(OLED_InitCmds));
 
     OLED_Clear();  // Դ
-    OLED_Update(); // ʾֹʼδʾʱ
+    OLED_Update(); // ʾֹʾ
+
+    OLED_WriteCommand(0xAF); // ٿʾ
 }
 
 /**
@@ -281,16 +416,12 @@ void OLED_Init(void)
  */
 void OLED_SetCursor(uint8_t Page, uint8_t X)
 {
-    /*ʹô˳1.3OLEDʾҪע*/
-    /*Ϊ1.3OLEDоƬSH1106132*/
+    /*ʹô˳1.3OLEDʾҪĻҳѰַʽ*/
+    /*Ϊ1.3OLEDоƬSH1106֧ˮƽѰַģʽ132*/
     /*Ļʼн˵2Уǵ0*/
-    /*ҪX2ʾ*/
-    //	X += 2;
 
-    /*ָͨҳַеַ*/
-    OLED_WriteCommand(0xB0 | Page);              // ҳλ
-    OLED_WriteCommand(0x10 | ((X & 0xF0) >> 4)); // Xλø4λ
-    OLED_WriteCommand(0x00 | (X & 0x0F));        // Xλõ4λ
+    /*ˮƽѰַģʽ£ҳַ0xB0~0xB7Чͨд봰ù*/
+    OLED_SetWindow(X, 127, Page, 7);
 }
 
 /*********************Ӳ*/
@@ -379,14 +510,8 @@ uint8_t OLED_IsInAngle(int16_t X, int16_t Y, int16_t StartAngle, int16_t EndAngl
  */
 void OLED_Update(void)
 {
-    uint8_t j;
-    /*ÿһҳ*/
-    for (j = 0; j < 8; j++) {
-        /*ùλΪÿһҳĵһ*/
-        OLED_SetCursor(j, 0);
-        /*д128ݣԴд뵽OLEDӲ*/
-        OLED_WriteData(OLED_DisplayBuf[j], 128);
-    }
+    /*Ϊһڣ1024ֽһδд*/
+    OLED_WriteWindow(0, 128, 0, 7);
 }
 
 /**
@@ -405,9 +530,10 @@ void OLED_Update(void)
  */
 void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 {
-    int16_t j;
     int16_t Page, Page1;
 
+    if (X < 0 || X > 127 || Width == 0 || Height == 0) return; // Ļݲʾ
+
     /*ڼҳַʱҪһƫ*/
     /*(Y + Height - 1) / 8 + 1Ŀ(Y + Height) / 8ȡ*/
     Page  = Y / 8;
@@ -417,16 +543,244 @@ void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
         Page1 -= 1;
     }
 
-    /*ָ漰ҳ*/
-    for (j = Page; j < Page1; j++) {
-        if (X >= 0 && X <= 127 && j >= 0 && j <= 7) // Ļݲʾ
-        {
-            /*ùλΪҳָ*/
-            OLED_SetCursor(j, X);
-            /*дWidthݣԴд뵽OLEDӲ*/
-            OLED_WriteData(&OLED_DisplayBuf[j][X], Width);
-        }
+    /*ֻĻڵҳ*/
+    if (Page < 0) Page = 0;
+    if (Page1 > 8) Page1 = 8;
+    if (Page >= Page1) return;
+    if (X + Width > 128) Width = 128 - X;
+
+    /*ҳָΪһڣһδд*/
+    OLED_WriteWindow(X, Width, Page, Page1 - 1);
+}
+
+/**
+ * ˵    ˫̨ˢ
+ *           ʾֻд̨OLED_DisplayBufOLED_Presentǰ̨壬
+ *           ɴں̨ǰ̨壬߲ȴߣ
+ *           1. ǰ̨ڷڼ䲻޸ģĻϲְ֡˺ѣ
+ *           2. µǰ̨帴Ƶ̨ƵĴ벻Ҫ޸
+ *           3. һ֡ڷʱΪͣڼٴεֻݣϲ
+ *              OLED_Pollڷɺ󽻻ͣм֡
+ *           4. OLED_PollӦѭСλ֮ã֤ʱ̨һ֡
+ *           OLED_UpdateOLED_UpdateAreaΪͬˢ£ȵȴ̨ɣڳʼȳ
+ */
+
+/*̨ˢ״̬I2C*********************/
+
+#define OLED_FLUSH_IDLE  0 // 
+#define OLED_FLUSH_START 1 // ʼ
+#define OLED_FLUSH_BYTE  2 // λֽ
+#define OLED_FLUSH_STOP  3 // ֹ
+
+/*һδ䣺ڣַֽں*/
+static const uint8_t OLED_FlushCmds[] = {0x78, 0x00, 0x21, 0, 127, 0x22, 0, 7};
+
+static volatile uint8_t OLED_FlushState = OLED_FLUSH_IDLE; // ״̬д룬жϾݴ˿ʼ
+static volatile uint8_t OLED_FlushPhase;                   // 0䣬1ݴ
+static const uint8_t *volatile OLED_FlushFrame;            // ڷ͵֡
+static uint16_t OLED_FlushPos;                             // δѷ͵ֽ
+static uint8_t OLED_FlushBit;                              // ǰֽѷ͵λ8ΪӦλ
+
+/**
+ *     ̨ˢµǰҪ͵ֽ
+ *     
+ *   ֵֵֽ
+ */
+static RAMFUNC uint8_t OLED_FlushByte(void)
+{
+    if (OLED_FlushPhase == 0) return OLED_FlushCmds[OLED_FlushPos];
+    if (OLED_FlushPos == 0) return 0x78; // ӻַ
+    if (OLED_FlushPos == 1) return 0x40; // ֽڣ֮
+    return OLED_FlushFrame[OLED_FlushPos - 2];
+}
+
+/**
+ *     ̨ˢµǰֽ
+ *     
+ *   ֵֽ
+ */
+static RAMFUNC uint16_t OLED_FlushLen(void)
+{
+    return (OLED_FlushPhase == 0) ? sizeof(OLED_FlushCmds) : 2 + 8 * 128;
+}
+
+/**
+ *     I2C俪ʼһ֡
+ *     Frame 8ҳx128е֡ǰ豣ֲ
+ *   ֵ
+ */
+static void OLED_BitBangStart(const uint8_t (*Frame)[128])
+{
+    OLED_FlushFrame = Frame[0];
+    OLED_FlushPhase = 0;
+    OLED_FlushState = OLED_FLUSH_START; // д״̬֮OLED_Tickƽ
+}
+
+/**
+ *     I2CǷڷ
+ *     
+ *   ֵ1У0
+ */
+static uint8_t OLED_BitBangBusy(void)
+{
+    return OLED_FlushState != OLED_FLUSH_IDLE;
+}
+
+const OLED_Transport_t OLED_TransportBitBang = {OLED_BitBangStart, OLED_BitBangBusy};
+
+/**
+ *     I2C̨ˢ½
+ *     
+ *   ֵ
+ * ˵    ɶʱжڵãTIM410usÿֻһλһʼ/ֹ
+ *           жںʱԼ1usԼ9300ģ10usԼ93msһ֡
+ *           õʼ/ֹȡֽںͬSRAM
+ */
+RAMFUNC void OLED_Tick(void)
+{
+    uint8_t Byte;
+
+    switch (OLED_FlushState) {
+        case OLED_FLUSH_START:
+            OLED_I2C_Start();
+            OLED_FlushPos   = 0;
+            OLED_FlushBit   = 0;
+            OLED_FlushState = OLED_FLUSH_BYTE;
+            break;
+
+        case OLED_FLUSH_BYTE:
+            if (OLED_FlushBit < 8) {
+                Byte = OLED_FlushByte();
+                OLED_W_SDA(!!(Byte & (0x80 >> OLED_FlushBit)));
+                OLED_W_SCL(1); // ӻSCLߵƽڼȡSDA
+                OLED_W_SCL(0);
+                OLED_FlushBit++;
+            } else {
+                OLED_W_SCL(1); // һʱӣӦź
+                OLED_W_SCL(0);
+                OLED_FlushBit = 0;
+                if (++OLED_FlushPos >= OLED_FlushLen()) OLED_FlushState = OLED_FLUSH_STOP;
+            }
+            break;
+
+        case OLED_FLUSH_STOP:
+            OLED_I2C_Stop();
+            if (OLED_FlushPhase == 0) { // ãʼݴ
+                OLED_FlushPhase = 1;
+                OLED_FlushState = OLED_FLUSH_START;
+            } else {
+                OLED_FlushState = OLED_FLUSH_IDLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*********************̨ˢ״̬I2C*/
+
+/**
+ *     ų́ˢʹõĴ
+ *     Transport ӿڣOLED_TransportBitBang
+ *   ֵ
+ * ˵    ȵȴǰ䷢л
+ */
+void OLED_SetTransport(const OLED_Transport_t *Transport)
+{
+    OLED_WaitIdle();
+    OLED_Transport = Transport;
+}
+
+/**
+ *     ̨ˢǷڷ
+ *     
+ *   ֵ1У0
+ */
+uint8_t OLED_IsBusy(void)
+{
+    return OLED_Transport->Busy();
+}
+
+#if OLED_DOUBLE_BUFFER
+/**
+ *     ǰ̨岢ʼ̨
+ *     
+ *   ֵ
+ */
+static void OLED_SwapAndStart(void)
+{
+    uint8_t (*Front)[128] = OLED_DisplayBuf;
+
+    if (OLED_PresentHook) OLED_PresentHook(OLED_DisplayBuf[0], OLED_FrontBuf[0]);
+    OLED_DisplayBuf     = OLED_FrontBuf;
+    OLED_FrontBuf       = Front;
+    OLED_PresentPending = 0;
+    OLED_Transport->Start(OLED_FrontBuf);
+    memcpy(OLED_DisplayBuf, OLED_FrontBuf, 8 * 128); // ̨Ļͬ
+}
+#endif
+
+/**
+ *     ʾ̨лƺõһ֡
+ *     
+ *   ֵOLED_PRESENT_STARTED ѽʼ̨
+ *           OLED_PRESENT_PENDING һ֡ڷͣ֡OLED_PollԺ
+ * ˵    ȴߣر˫ʱͬˢ
+ */
+uint8_t OLED_Present(void)
+{
+#if OLED_DOUBLE_BUFFER
+    if (OLED_Transport->Busy()) {
+        OLED_PresentPending = 1;
+        return OLED_PRESENT_PENDING;
     }
+    OLED_SwapAndStart();
+#else
+    if (OLED_PresentHook) OLED_PresentHook(OLED_DisplayBuf[0], NULL); // ûһ֡
+    OLED_Update();
+#endif
+    return OLED_PRESENT_STARTED;
+}
+
+/**
+ *     ʹ͵֡
+ *     
+ *   ֵ
+ * ˵    ѭеãһ֡ɺOLED_PresentµĴ֡
+ */
+void OLED_Poll(void)
+{
+#if OLED_DOUBLE_BUFFER
+    if (OLED_PresentPending && !OLED_Transport->Busy()) {
+        OLED_SwapAndStart();
+    }
+#endif
+}
+
+/**
+ *     ÿ֡ʾǰĻص
+ *     Hook صNULLȡ
+ *   ֵ
+ * ˵    OLED_PresentOLED_Pollʱãʾ
+ */
+void OLED_SetPresentHook(OLED_PresentHook_t Hook)
+{
+    OLED_PresentHook = Hook;
+}
+
+/**
+ *     ȡĻϵǰʾ֡
+ *     
+ *   ֵ8ҳx128Уţ˫ʱΪǰ̨壬ֱ´νǰ
+ */
+const uint8_t *OLED_GetFrame(void)
+{
+#if OLED_DOUBLE_BUFFER
+    return OLED_FrontBuf[0];
+#else
+    return OLED_DisplayBuf[0];
+#endif
 }
 
 /**
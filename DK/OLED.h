@@ -15,6 +15,30 @@
 #define OLED_UNFILLED			0
 #define OLED_FILLED				1
 
+/*ϵOLEDȶʱ䣨룩OLED_InitǰӦپʱ*/
+#define OLED_POWER_SETTLE_MS	50
+
+/*˫ģʽ1ռ1KB RAM0رգOLED_PresentͬOLED_Update*/
+#ifndef OLED_DOUBLE_BUFFER
+#define OLED_DOUBLE_BUFFER		1
+#endif
+
+/*OLED_Presentֵ*/
+#define OLED_PRESENT_STARTED	0	//ѽ壬ʼ̨
+#define OLED_PRESENT_PENDING	1	//һ֡ڷͣ֡ȴOLED_Pollͣڼ֡ϲΪһ֡
+
+/*첽ˢ´ӿ*/
+typedef struct
+{
+	void (*Start)(const uint8_t (*Frame)[128]);	//ʼһ֡8ҳx128Уڣ
+	uint8_t (*Busy)(void);						//ڷͷ1
+} OLED_Transport_t;
+
+extern const OLED_Transport_t OLED_TransportBitBang;	//I2COLED_Tickʱλƽ
+
+/*ÿ֡ʾǰĻصNewΪ֡OldΪĻϵһ֡ʱΪNULLΪ8ҳx128*/
+typedef void (*OLED_PresentHook_t)(const uint8_t *New, const uint8_t *Old);
+
 /*********************궨*/
 
 
@@ -27,6 +51,15 @@ void OLED_Init(void);
 void OLED_Update(void);
 void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height);
 
+/*˫庯*/
+uint8_t OLED_Present(void);
+void OLED_Poll(void);
+uint8_t OLED_IsBusy(void);
+void OLED_SetTransport(const OLED_Transport_t *Transport);
+void OLED_Tick(void);
+void OLED_SetPresentHook(OLED_PresentHook_t Hook);
+const uint8_t *OLED_GetFrame(void);
+
 /*Դƺ*/
 void OLED_Clear(void);
 void OLED_ClearArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height);
@@ -0,0 +1,151 @@
+/**
+ * @file     OledMirror.c
+ * @brief    OLED显示镜像编码实现
+ * @details  一帧中的页按页号顺序尝试编码，每页先编码到帧缓冲区的剩余空间，
+ *          超出预算时放弃该页（不影响已编码的页），帧只在有页时输出；
+ *          整屏完整页编码通常在250字节以内放不下，过期页会分几帧发完
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "OledMirror.h"
+#include "Modbus.h"
+#include <stddef.h>
+#include <string.h>
+
+// 函数：页校验值（Fletcher-16）
+static uint16_t Mirror_Sum(const uint8_t *page)
+{
+    uint16_t a = 0, b = 0, i;
+
+    for (i = 0; i < MIRROR_WIDTH; i++) {
+        a = (a + page[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)(b << 8 | a);
+}
+
+// 函数：本次可用的数据长度
+static uint16_t Mirror_Limit(uint16_t budget)
+{
+    if (budget > MIRROR_FRAME_MAX) budget = MIRROR_FRAME_MAX;
+    return (budget > MIRROR_OVERHEAD) ? budget - MIRROR_OVERHEAD : 0;
+}
+
+// 函数：在数据区追加一页，放不下返回0
+static uint8_t Mirror_AddPage(uint8_t *out, uint16_t *len, uint16_t limit, uint8_t page, const uint8_t *cur,
+                              const uint8_t *prev)
+{
+    uint8_t *p = out + 4 + *len; // 数据从帧的第4字节开始
+    uint16_t n;
+
+    if (*len + 3 > limit) return 0; // 页头 + 最短的一个游程
+    n = Mirror_EncodePage(p + 1, limit - *len - 1, cur + page * MIRROR_WIDTH,
+                          (prev != NULL) ? prev + page * MIRROR_WIDTH : NULL);
+    if (n == 0) return 0;
+    p[0] = page | ((prev != NULL) ? MIRROR_PAGE_XOR : 0);
+    *len += 1 + n;
+    return 1;
+}
+
+// 函数：填写帧头和CRC，返回帧长度
+static uint16_t Mirror_Finish(Mirror_t *m, uint8_t *out, uint16_t len)
+{
+    uint16_t crc;
+
+    out[0]       = MIRROR_SYNC0;
+    out[1]       = MIRROR_SYNC1;
+    out[2]       = m->seq++;
+    out[3]       = (uint8_t)len;
+    crc          = Modbus_CRC16(out + 2, len + 2);
+    out[4 + len] = (uint8_t)(crc & 0xFF);
+    out[5 + len] = (uint8_t)(crc >> 8);
+
+    m->frames++;
+    m->bytes += len + MIRROR_OVERHEAD;
+    return len + MIRROR_OVERHEAD;
+}
+
+void Mirror_Init(Mirror_t *m)
+{
+    memset(m, 0, sizeof(*m));
+    m->stale = 0xFF;
+}
+
+void Mirror_Key(Mirror_t *m)
+{
+    m->stale = 0xFF;
+}
+
+uint16_t Mirror_EncodePage(uint8_t *out, uint16_t size, const uint8_t *cur, const uint8_t *prev)
+{
+    uint8_t v[MIRROR_WIDTH];
+    uint16_t i, j, run, n = 0;
+
+    for (i = 0; i < MIRROR_WIDTH; i++) {
+        v[i] = (prev != NULL) ? cur[i] ^ prev[i] : cur[i];
+    }
+
+    i = 0;
+    while (i < MIRROR_WIDTH) {
+        run = 1;
+        while (i + run < MIRROR_WIDTH && v[i + run] == v[i]) run++;
+        if (run >= 2) { // 重复：2字节
+            if (n + 2 > size) return 0;
+            out[n++] = (uint8_t)(0x80 | (run - 1));
+            out[n++] = v[i];
+            i += run;
+            continue;
+        }
+
+        // 原样：到下一个至少3字节的重复为止（2字节的重复并入原样更短）
+        j = i + 1;
+        while (j < MIRROR_WIDTH && !(j + 2 < MIRROR_WIDTH && v[j] == v[j + 1] && v[j] == v[j + 2])) j++;
+        if (n + 1 + (j - i) > size) return 0;
+        out[n++] = (uint8_t)(j - i - 1);
+        while (i < j) out[n++] = v[i++];
+    }
+    return n;
+}
+
+uint16_t Mirror_Present(Mirror_t *m, const uint8_t *cur, const uint8_t *prev, uint8_t *out, uint16_t budget)
+{
+    uint16_t limit = Mirror_Limit(budget), len = 0, sum;
+    uint8_t page, bit, changed;
+
+    for (page = 0; page < MIRROR_PAGES; page++) {
+        bit = (uint8_t)(1 << page);
+        if (prev != NULL) {
+            changed = memcmp(cur + page * MIRROR_WIDTH, prev + page * MIRROR_WIDTH, MIRROR_WIDTH) != 0;
+        } else {
+            sum          = Mirror_Sum(cur + page * MIRROR_WIDTH);
+            changed      = sum != m->sum[page];
+            m->sum[page] = sum;
+        }
+        if (!changed || (m->stale & bit)) continue; // 过期页由Mirror_Poll按当前内容补发
+
+        if (prev != NULL && Mirror_AddPage(out, &len, limit, page, cur, prev)) {
+            m->xor_pages++;
+        } else {
+            m->stale |= bit; // 没有上一帧或预算不足
+        }
+    }
+    return (len > 0) ? Mirror_Finish(m, out, len) : 0;
+}
+
+uint16_t Mirror_Poll(Mirror_t *m, const uint8_t *cur, uint8_t *out, uint16_t budget)
+{
+    uint16_t limit = Mirror_Limit(budget), len = 0;
+    uint8_t page, bit;
+
+    if (m->stale == 0) return 0;
+    for (page = 0; page < MIRROR_PAGES; page++) {
+        bit = (uint8_t)(1 << page);
+        if ((m->stale & bit) && Mirror_AddPage(out, &len, limit, page, cur, NULL)) {
+            m->stale &= (uint8_t)~bit;
+            m->raw_pages++;
+        }
+    }
+    return (len > 0) ? Mirror_Finish(m, out, len) : 0;
+}
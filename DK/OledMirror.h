@@ -0,0 +1,96 @@
+/**
+ * @file     OledMirror.h
+ * @brief    OLED显示镜像编码头文件
+ * @details  把屏幕内容按页编码为紧凑的帧，经串口发给主机端查看工具重建显示：
+ *          - 每页128字节，变化的页与上一帧异或后游程编码（XOR-RLE），通常只有几个字节
+ *          - 接收端没有上一帧内容的页（首次、丢帧、来不及发送）标记为过期，
+ *            之后从屏幕当前内容以完整页游程编码（RLE）发送
+ *          - 每次只编码能放进给定字节预算的页，放不下的页标记为过期，由Mirror_Poll补发，
+ *            发送速率由调用者按串口发送缓冲区剩余空间控制
+ *          帧格式：A5 4D 序号 长度 数据 CRC16（低字节在前，覆盖序号~数据，同Modbus）
+ *          数据为若干页：页头（bit0~2页号，bit7为1表示异或上一帧）+ 恰好展开为128字节的游程编码
+ *          游程编码：控制字节c，c<0x80时后跟c+1个原样字节；c>=0x80时后跟1个字节，重复(c&0x7F)+1次
+ *          本模块不依赖硬件，可在主机上仿真
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __OLEDMIRROR_H
+#define __OLEDMIRROR_H
+
+#include <stdint.h>
+
+/**
+ * @brief 帧格式
+ */
+#define MIRROR_SYNC0       0xA5 /**< 帧头第1字节 */
+#define MIRROR_SYNC1       0x4D /**< 帧头第2字节（'M'） */
+#define MIRROR_OVERHEAD    6    /**< 帧头、序号、长度、CRC */
+#define MIRROR_PAYLOAD_MAX 250  /**< 数据最大长度（长度字段1字节） */
+#define MIRROR_FRAME_MAX   (MIRROR_PAYLOAD_MAX + MIRROR_OVERHEAD)
+#define MIRROR_PAGE_XOR    0x80 /**< 页头标志：与上一帧异或 */
+#define MIRROR_PAGES       8    /**< 页数 */
+#define MIRROR_WIDTH       128  /**< 每页字节数 */
+
+/**
+ * @brief 镜像编码状态
+ */
+typedef struct
+{
+    uint8_t stale;              /**< 接收端内容过期的页（按位），需以完整页发送 */
+    uint8_t seq;                /**< 下一帧序号 */
+    uint16_t sum[MIRROR_PAGES]; /**< 各页校验值，没有上一帧时用于判断变化 */
+    uint32_t frames;            /**< 已编码帧数 */
+    uint32_t bytes;             /**< 已编码字节数（含帧开销） */
+    uint32_t xor_pages;         /**< 异或编码的页数 */
+    uint32_t raw_pages;         /**< 完整页编码的页数 */
+} Mirror_t;
+
+/**
+ * @brief  初始化，所有页标记为过期（第一次发送完整画面）
+ * @param  m 镜像编码状态
+ * @return 无
+ */
+void Mirror_Init(Mirror_t *m);
+
+/**
+ * @brief  请求完整画面（如接收端重新连接），所有页标记为过期
+ * @param  m 镜像编码状态
+ * @return 无
+ */
+void Mirror_Key(Mirror_t *m);
+
+/**
+ * @brief  新帧显示时调用，编码变化的页
+ * @details 未过期的变化页与上一帧异或编码；预算不足的页和已过期的页留给Mirror_Poll
+ * @param  m      镜像编码状态
+ * @param  cur    新帧（8页x128字节，连续存放）
+ * @param  prev   屏幕上的上一帧，NULL表示没有（此时按校验值判断变化，变化页标记为过期）
+ * @param  out    输出帧缓冲区
+ * @param  budget 本次最多输出的字节数（不超过MIRROR_FRAME_MAX时有效）
+ * @return 帧长度，0表示没有需要立即发送的页
+ */
+uint16_t Mirror_Present(Mirror_t *m, const uint8_t *cur, const uint8_t *prev, uint8_t *out, uint16_t budget);
+
+/**
+ * @brief  补发过期的页（完整页编码）
+ * @param  m      镜像编码状态
+ * @param  cur    屏幕当前内容（8页x128字节，连续存放）
+ * @param  out    输出帧缓冲区
+ * @param  budget 本次最多输出的字节数
+ * @return 帧长度，0表示没有过期页或预算不足
+ */
+uint16_t Mirror_Poll(Mirror_t *m, const uint8_t *cur, uint8_t *out, uint16_t budget);
+
+/**
+ * @brief  游程编码一页
+ * @param  out  输出缓冲区
+ * @param  size 输出缓冲区大小
+ * @param  cur  本页内容（128字节）
+ * @param  prev 上一帧本页内容，非NULL时编码两者的异或
+ * @return 编码长度，0表示超出size
+ */
+uint16_t Mirror_EncodePage(uint8_t *out, uint16_t size, const uint8_t *cur, const uint8_t *prev);
+
+#endif /* __OLEDMIRROR_H */
@@ -1,41 +1,31 @@
 /**
  * @file     PWM.c
  * @brief    PWM驱动程序
- * @details  使用TIM3和TIM4实现PWM输出：
- *          - TIM3_CH1：用于直流电机速度控制
- *          - TIM4_CH3：用于舵机角度控制
+ * @details  使用TIM3实现20KHz PWM输出（部分重映射）：
+ *          - TIM3_CH1（PB4）：用于直流电机速度控制
+ *          - TIM3_CH2（PB5）：用于排风扇调速
+ *          舵机使用TIM2_CH2（PA1），见Servo.c
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
  */
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
-#include "dk_C8T6.h"   // 项目主头文件
+#include "DK_C8T6.h"   // 项目主头文件
 
-/**
- * @brief  PWM初始化（用于直流电机）
- * @details 配置TIM3_CH1为PWM输出模式：
- *         1. 使能GPIO和定时器时钟
- *         2. 配置GPIO为复用推挽输出
- *         3. 配置定时器基本参数：
- *            - 72MHz / 36 = 2MHz 计数频率
- *            - 2MHz / 100 = 20KHz PWM频率
- *         4. 配置PWM模式和输出极性
- * @param  无
- * @return 无
- */
-void PWM_Init(void)
+static uint8_t pwm_timebase_ready = 0; /**< TIM3时基已配置 */
+
+// 函数：配置TIM3时基和引脚重映射，只执行一次
+static void PWM_InitTimeBase(void)
 {
     /*开启时钟*/
-    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);  // 开启TIM3时钟
-    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE); // 开启GPIOA时钟
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);                       // 开启TIM3时钟
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE); // 开启GPIOB和AFIO时钟
 
-    /*GPIO初始化*/
-    GPIO_InitTypeDef GPIO_InitStructure;
-    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_AF_PP;    // 复用推挽输出
-    GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_6;         // PA6（TIM3_CH1）
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-    GPIO_Init(GPIOA, &GPIO_InitStructure);
+    /*引脚重映射：默认引脚PA6/PA7为DS1302，PB0/PB1为红外传感器*/
+    GPIO_PinRemapConfig(GPIO_PartialRemap_TIM3, ENABLE);     // CH1->PB4，CH2->PB5
+    GPIO_PinRemapConfig(GPIO_Remap_SWJ_JTAGDisable, ENABLE); // 释放PB3/PB4/PA15（JTAG），SWD不受影响
+                                                             // SWJ_CFG只写，其他重映射会把它写成全1，因此放在最后
 
     /*配置时钟源*/
     TIM_InternalClockConfig(TIM3); // 使用内部时钟源
@@ -49,17 +39,58 @@ void PWM_Init(void)
     TIM_TimeBaseInitStructure.TIM_RepetitionCounter = 0;                  // 重复计数器值
     TIM_TimeBaseInit(TIM3, &TIM_TimeBaseInitStructure);
 
-    /*输出比较初始化*/
-    TIM_OCInitTypeDef TIM_OCInitStructure;
-    TIM_OCStructInit(&TIM_OCInitStructure);                      // 结构体初始化
-    TIM_OCInitStructure.TIM_OCMode      = TIM_OCMode_PWM1;      // PWM模式1
-    TIM_OCInitStructure.TIM_OCPolarity  = TIM_OCPolarity_High;  // 输出极性为高
-    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable;// 使能输出
-    TIM_OCInitStructure.TIM_Pulse       = 0;                     // 初始占空比为0
-    TIM_OC1Init(TIM3, &TIM_OCInitStructure);
-
     /*使能定时器*/
     TIM_Cmd(TIM3, ENABLE);
+    pwm_timebase_ready = 1;
+}
+
+/**
+ * @brief  初始化一个PWM通道
+ * @details 配置TIM3的一个通道为PWM输出模式：
+ *         1. 第一次调用时配置时基（各通道共用）：
+ *            - 72MHz / 36 = 2MHz 计数频率
+ *            - 2MHz / 100 = 20KHz PWM频率
+ *            - TIM3部分重映射，CH1/CH2输出到PB4/PB5
+ *         2. 配置通道引脚为复用推挽输出
+ *         3. 配置PWM模式和输出极性，初始占空比为0
+ * @param  ch 通道：1-PB4（直流电机），2-PB5（风扇）
+ * @return 无
+ */
+void PWM_InitChannel(uint8_t ch)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    TIM_OCInitTypeDef TIM_OCInitStructure;
+
+    if (!pwm_timebase_ready) PWM_InitTimeBase();
+
+    /*GPIO初始化*/
+    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_AF_PP; // 复用推挽输出
+    GPIO_InitStructure.GPIO_Pin   = (ch == 1) ? GPIO_Pin_4 : GPIO_Pin_5;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIOB, &GPIO_InitStructure);
+
+    /*输出比较初始化*/
+    TIM_OCStructInit(&TIM_OCInitStructure);                       // 结构体初始化
+    TIM_OCInitStructure.TIM_OCMode      = TIM_OCMode_PWM1;        // PWM模式1
+    TIM_OCInitStructure.TIM_OCPolarity  = TIM_OCPolarity_High;    // 输出极性为高
+    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable; // 使能输出
+    TIM_OCInitStructure.TIM_Pulse       = 0;                      // 初始占空比为0
+    if (ch == 1) {
+        TIM_OC1Init(TIM3, &TIM_OCInitStructure);
+    } else {
+        TIM_OC2Init(TIM3, &TIM_OCInitStructure);
+    }
+}
+
+/**
+ * @brief  PWM初始化（用于直流电机）
+ * @details 初始化TIM3_CH1（PB4），见PWM_InitChannel
+ * @param  无
+ * @return 无
+ */
+void PWM_Init(void)
+{
+    PWM_InitChannel(1);
 }
 
 /**
@@ -75,7 +106,7 @@ void PWM_SetCompare1(uint16_t Compare)
 }
 
 /**
- * @brief  设置TIM3通道2的PWM占空比
+ * @brief  设置TIM3通道2的PWM占空比（风扇控制）
  * @param  Compare 占空比值，范围：0~100
  *         - 0: 输出一直为低电平
  *         - 100: 输出一直为高电平
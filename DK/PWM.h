@@ -10,12 +10,23 @@
 #ifndef __PWM_H
 #define __PWM_H
 
+#include <stdint.h>
+
+/**
+ * @brief  初始化一个PWM通道
+ * @details TIM3部分重映射，各通道共用时基：
+ *         - 通道1（PB4）：直流电机
+ *         - 通道2（PB5）：排风扇
+ *         - 频率：20KHz，占空比范围：0~100%
+ *         PB4默认为JTAG引脚，初始化时关闭JTAG（同时释放PB3/PA15），调试使用SWD
+ * @param  ch 通道 1或2
+ * @return 无
+ */
+void PWM_InitChannel(uint8_t ch);
+
 /**
  * @brief  PWM初始化
- * @details 配置TIM3为PWM输出模式：
- *         - TIM3_CH1(PA6)：电机控制
- *         - 频率：20KHz
- *         - 占空比范围：0~100%
+ * @details 初始化TIM3_CH1(PB4)，用于电机控制，同PWM_InitChannel(1)
  * @param  无
  * @return 无
  */
@@ -34,6 +45,7 @@ void PWM_SetCompare1(uint16_t Compare);
 
 /**
  * @brief  设置TIM3通道2的PWM占空比
+ * @details 用于风扇调速
  * @param  Compare 占空比值，范围0~100
  * @return 无
  */
@@ -41,6 +53,7 @@ void PWM_SetCompare2(uint16_t Compare);
 
 /**
  * @brief  设置TIM3通道3的PWM占空比
+ * @note   重映射后通道3为PB0（底部红外传感器），未初始化输出
  * @param  Compare 占空比值，范围0~100
  * @return 无
  */
@@ -0,0 +1,215 @@
+/**
+ * @file     Presence.c
+ * @brief    用户接近检测（多传感器融合）
+ * @details  每个超声波样本计算一次证据并累加到置信度：
+ *          - 近距离：+w_near
+ *          - 以步行速度持续靠近（目标出现后已靠近approach_mm以上）：
+ *            近距离内+w_approach，近距离的2倍范围内+w_approach/2，用于提前开盖
+ *          - 开盖期间有人且顶部红外被遮挡（正在投放）：+w_deposit
+ *          - 远离、无回波或距离与背景一致：-w_absent
+ *          置信度达到open_conf进入ACTIVE，降到close_conf回到IDLE。
+ *          近距离目标静止超过static_ms（开盖时为hold_ms）后记为背景，
+ *          背景距离处的回波不再作为证据，直到该距离变远（物体被拿走）
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Presence.h"
+#include <stddef.h>
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Presence_DefaultConfig(PresenceConfig_t *cfg)
+{
+    cfg->near_mm          = PRESENCE_NEAR_MM;
+    cfg->approach_min_mms = PRESENCE_APPROACH_MIN_MMS;
+    cfg->approach_max_mms = PRESENCE_APPROACH_MAX_MMS;
+    cfg->approach_mm      = PRESENCE_APPROACH_MM;
+    cfg->max_step_mm      = PRESENCE_MAX_STEP_MM;
+    cfg->jitter_mm        = PRESENCE_JITTER_MM;
+    cfg->static_ms        = PRESENCE_STATIC_MS;
+    cfg->hold_ms          = PRESENCE_HOLD_MS;
+    cfg->w_near           = PRESENCE_W_NEAR;
+    cfg->w_approach       = PRESENCE_W_APPROACH;
+    cfg->w_deposit        = PRESENCE_W_DEPOSIT;
+    cfg->w_absent         = PRESENCE_W_ABSENT;
+    cfg->open_conf        = PRESENCE_OPEN_CONF;
+    cfg->close_conf       = PRESENCE_CLOSE_CONF;
+}
+
+/**
+ * @brief  初始化/复位检测器
+ * @param  p 检测器
+ * @param  cfg 检测参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Presence_Init(Presence_t *p, const PresenceConfig_t *cfg)
+{
+    if (cfg == NULL) {
+        Presence_DefaultConfig(&p->cfg);
+    } else {
+        p->cfg = *cfg;
+    }
+
+    p->state     = PRESENCE_IDLE;
+    p->conf      = 0;
+    p->have_prev = 0;
+    p->vel       = 0;
+    p->still_ms  = 0;
+    p->bg_mm     = 0;
+}
+
+/**
+ * @brief  修改检测参数，不复位检测状态
+ * @param  p 检测器
+ * @param  cfg 检测参数
+ * @return 无
+ */
+void Presence_SetConfig(Presence_t *p, const PresenceConfig_t *cfg)
+{
+    p->cfg = *cfg;
+}
+
+/**
+ * @brief  计算距离差的绝对值
+ */
+static uint16_t Presence_Diff(uint16_t a, uint16_t b)
+{
+    return (a > b) ? (a - b) : (b - a);
+}
+
+/**
+ * @brief  根据一个有效距离更新速度、静止时间和背景，返回该样本的证据
+ * @param  p 检测器
+ * @param  in 样本
+ * @return 证据值，正数支持有人，负数支持无人
+ */
+static int16_t Presence_RangeEvidence(Presence_t *p, const PresenceInput_t *in)
+{
+    const PresenceConfig_t *c = &p->cfg;
+    uint16_t d                = in->range_mm;
+    uint32_t dt               = in->t_ms - p->prev_t;
+    uint8_t approaching;
+    int16_t evidence;
+
+    /* 速度：只对连续、跳变不大的样本计算，一阶平滑(α=1/4)；否则视为新目标出现 */
+    if (p->have_prev && dt > 0 && dt < 1000 && Presence_Diff(d, p->prev_mm) <= c->max_step_mm) {
+        int32_t v = ((int32_t)d - (int32_t)p->prev_mm) * 1000 / (int32_t)dt;
+        p->vel    = (int16_t)((p->vel * 3 + v) / 4);
+    } else {
+        p->vel      = 0;
+        p->entry_mm = d;
+        dt          = 0;
+    }
+    p->have_prev = 1;
+    p->prev_mm   = d;
+    p->prev_t    = in->t_ms;
+
+    /* 背景物体被拿走 */
+    if (p->bg_mm != 0 && d > p->bg_mm + c->jitter_mm) {
+        p->bg_mm = 0;
+    }
+
+    approaching = p->vel <= -(int16_t)c->approach_min_mms && p->vel >= -(int16_t)c->approach_max_mms &&
+                  p->entry_mm >= d + c->approach_mm;
+
+    if (d >= c->near_mm) {
+        p->still_ms = 0;
+        if (approaching && d < 2 * (uint32_t)c->near_mm) {
+            return c->w_approach / 2; // 正在走近，提前积累置信度
+        }
+        return -(int16_t)c->w_absent;
+    }
+
+    /* 静止计时，超过阈值学习为背景 */
+    if (Presence_Diff(d, p->anchor) <= c->jitter_mm) {
+        p->still_ms += dt;
+    } else {
+        p->anchor   = d;
+        p->still_ms = 0;
+    }
+    if (p->still_ms >= ((p->state == PRESENCE_ACTIVE) ? c->hold_ms : c->static_ms)) {
+        p->bg_mm = p->anchor;
+    }
+
+    if (p->bg_mm != 0 && Presence_Diff(d, p->bg_mm) <= c->jitter_mm) {
+        return -(int16_t)c->w_absent; // 背景物体，不是使用者
+    }
+
+    evidence = c->w_near;
+    if (approaching) {
+        evidence += c->w_approach;
+    }
+    return evidence;
+}
+
+/**
+ * @brief  输入一个样本并更新判定
+ * @param  p 检测器
+ * @param  in 样本
+ * @return 当前状态
+ */
+uint8_t Presence_Update(Presence_t *p, const PresenceInput_t *in)
+{
+    int16_t evidence;
+    int16_t conf;
+
+    if (in->range_valid) {
+        evidence = Presence_RangeEvidence(p, in);
+    } else {
+        p->have_prev = 0;
+        p->vel       = 0;
+        p->still_ms  = 0;
+        evidence     = -(int16_t)p->cfg.w_absent;
+    }
+
+    if (p->state == PRESENCE_ACTIVE && in->ir_top_blocked && evidence > 0) {
+        evidence += p->cfg.w_deposit; // 有人且正在投放，保持开盖（桶满时顶部红外常遮挡，不单独计入）
+    }
+
+    conf = (int16_t)p->conf + evidence;
+    if (conf < 0) conf = 0;
+    if (conf > PRESENCE_CONF_MAX) conf = PRESENCE_CONF_MAX;
+    p->conf = (uint8_t)conf;
+
+    if (p->state == PRESENCE_IDLE && p->conf >= p->cfg.open_conf) {
+        p->state = PRESENCE_ACTIVE;
+    } else if (p->state == PRESENCE_ACTIVE && p->conf <= p->cfg.close_conf) {
+        p->state = PRESENCE_IDLE;
+    }
+    return p->state;
+}
+
+/**
+ * @brief  获取当前状态
+ * @param  p 检测器
+ * @return PRESENCE_IDLE 或 PRESENCE_ACTIVE
+ */
+uint8_t Presence_GetState(const Presence_t *p)
+{
+    return p->state;
+}
+
+/**
+ * @brief  获取当前置信度
+ * @param  p 检测器
+ * @return 0~PRESENCE_CONF_MAX
+ */
+uint8_t Presence_GetConfidence(const Presence_t *p)
+{
+    return p->conf;
+}
+
+/**
+ * @brief  获取平滑后的距离变化速度
+ * @param  p 检测器
+ * @return 速度（毫米/秒），负值表示靠近
+ */
+int16_t Presence_GetVelocity(const Presence_t *p)
+{
+    return p->vel;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file     Presence.h
+ * @brief    用户接近检测（多传感器融合）头文件
+ * @details  融合超声波距离、距离变化速度和顶部红外状态，
+ *          输出定点置信度和开盖判定：
+ *          - 近距离、持续靠近、投放动作作为正证据，离开/无回波作为负证据
+ *          - 长时间静止的近距离目标学习为背景（放在桶边的物体）
+ *          - 置信度带回差的两状态判定，减少路人经过造成的误开盖
+ *          模块不依赖硬件，可在主机上回放记录的数据
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __PRESENCE_H
+#define __PRESENCE_H
+
+#include <stdint.h>
+
+/**
+ * @brief 检测状态
+ */
+#define PRESENCE_IDLE     0 /**< 无人使用，保持关盖 */
+#define PRESENCE_ACTIVE   1 /**< 有人使用，应当开盖 */
+
+/**
+ * @brief 置信度满量程
+ */
+#define PRESENCE_CONF_MAX 100
+
+/**
+ * @brief 默认参数
+ */
+#define PRESENCE_NEAR_MM          500   /**< 近距离判定阈值（毫米） */
+#define PRESENCE_APPROACH_MIN_MMS 150   /**< 靠近速度下限（毫米/秒） */
+#define PRESENCE_APPROACH_MAX_MMS 2000  /**< 靠近速度上限，更快的变化视为目标突然进入 */
+#define PRESENCE_APPROACH_MM      150   /**< 目标出现后至少靠近此距离才计入靠近证据 */
+#define PRESENCE_MAX_STEP_MM      300   /**< 相邻样本距离跳变超过此值时视为新目标出现 */
+#define PRESENCE_JITTER_MM        30    /**< 静止判定的距离抖动范围（毫米） */
+#define PRESENCE_STATIC_MS        1500  /**< 空闲时静止超过此时间学习为背景，应短于仅凭近距离开盖所需时间 */
+#define PRESENCE_HOLD_MS          15000 /**< 开盖时静止超过此时间学习为背景 */
+#define PRESENCE_W_NEAR           2     /**< 近距离证据权重 */
+#define PRESENCE_W_APPROACH       12    /**< 靠近证据权重 */
+#define PRESENCE_W_DEPOSIT        20    /**< 开盖时顶部红外被遮挡（正在投放）的证据权重 */
+#define PRESENCE_W_ABSENT         15    /**< 远离/无回波/背景的负证据权重 */
+#define PRESENCE_OPEN_CONF        60    /**< 置信度达到此值开盖 */
+#define PRESENCE_CLOSE_CONF       20    /**< 置信度降到此值关盖 */
+
+/**
+ * @brief 检测参数
+ */
+typedef struct
+{
+    uint16_t near_mm;          /**< 近距离判定阈值（毫米） */
+    uint16_t approach_min_mms; /**< 靠近速度下限（毫米/秒） */
+    uint16_t approach_max_mms; /**< 靠近速度上限（毫米/秒） */
+    uint16_t approach_mm;      /**< 计入靠近证据的最小靠近距离（毫米） */
+    uint16_t max_step_mm;      /**< 新目标判定的距离跳变（毫米） */
+    uint16_t jitter_mm;        /**< 静止判定抖动范围（毫米） */
+    uint16_t static_ms;        /**< 空闲时学习背景的静止时间（毫秒） */
+    uint16_t hold_ms;          /**< 开盖时学习背景的静止时间（毫秒） */
+    uint8_t w_near;            /**< 近距离证据权重 */
+    uint8_t w_approach;        /**< 靠近证据权重 */
+    uint8_t w_deposit;         /**< 投放证据权重 */
+    uint8_t w_absent;          /**< 负证据权重 */
+    uint8_t open_conf;         /**< 开盖置信度阈值 */
+    uint8_t close_conf;        /**< 关盖置信度阈值 */
+} PresenceConfig_t;
+
+/**
+ * @brief 单次输入（每个超声波样本一次）
+ */
+typedef struct
+{
+    uint32_t t_ms;          /**< 样本时间戳（毫秒） */
+    uint16_t range_mm;      /**< 距离（毫米），range_valid为0时忽略 */
+    uint8_t range_valid;    /**< 1：有回波，0：无回波/超时 */
+    uint8_t ir_top_blocked; /**< 1：顶部红外被遮挡 */
+} PresenceInput_t;
+
+/**
+ * @brief 检测器状态（每个实例一份，互不影响）
+ */
+typedef struct
+{
+    PresenceConfig_t cfg; /**< 检测参数 */
+    uint8_t state;        /**< PRESENCE_IDLE 或 PRESENCE_ACTIVE */
+    uint8_t conf;         /**< 置信度 */
+    uint8_t have_prev;    /**< 上一个样本是否有回波 */
+    uint16_t prev_mm;     /**< 上一个有效距离 */
+    uint32_t prev_t;      /**< 上一个有效样本时间 */
+    int16_t vel;          /**< 平滑后的速度（毫米/秒） */
+    uint16_t entry_mm;    /**< 目标出现时的距离 */
+    uint16_t anchor;      /**< 静止判定的参考距离 */
+    uint32_t still_ms;    /**< 在参考距离处静止的时间 */
+    uint16_t bg_mm;       /**< 背景距离，0表示无背景 */
+} Presence_t;
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Presence_DefaultConfig(PresenceConfig_t *cfg);
+
+/**
+ * @brief  初始化/复位检测器
+ * @param  p 检测器
+ * @param  cfg 检测参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Presence_Init(Presence_t *p, const PresenceConfig_t *cfg);
+
+/**
+ * @brief  修改检测参数，不复位检测状态
+ * @param  p 检测器
+ * @param  cfg 检测参数
+ * @return 无
+ */
+void Presence_SetConfig(Presence_t *p, const PresenceConfig_t *cfg);
+
+/**
+ * @brief  输入一个样本并更新判定
+ * @param  p 检测器
+ * @param  in 样本
+ * @return 当前状态 PRESENCE_IDLE 或 PRESENCE_ACTIVE
+ */
+uint8_t Presence_Update(Presence_t *p, const PresenceInput_t *in);
+
+/**
+ * @brief  获取当前状态
+ * @param  p 检测器
+ * @return PRESENCE_IDLE 或 PRESENCE_ACTIVE
+ */
+uint8_t Presence_GetState(const Presence_t *p);
+
+/**
+ * @brief  获取当前置信度
+ * @param  p 检测器
+ * @return 0~PRESENCE_CONF_MAX
+ */
+uint8_t Presence_GetConfidence(const Presence_t *p);
+
+/**
+ * @brief  获取平滑后的距离变化速度
+ * @param  p 检测器
+ * @return 速度（毫米/秒），负值表示靠近
+ */
+int16_t Presence_GetVelocity(const Presence_t *p);
+
+#endif /* __PRESENCE_H */
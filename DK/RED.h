@@ -13,7 +13,7 @@
 #define __RED_H
 
 #include <stdint.h>
-#include "dk_C8T6.h" // 项目主头文件
+#include "DK_C8T6.h" // 项目主头文件
 
 /**
  * @brief 红外检测状态标志
@@ -0,0 +1,34 @@
+/**
+ * @file     RamFunc.h
+ * @brief    函数放入SRAM运行
+ * @details  72MHz下flash有2个等待周期，分支处预取缓冲失效时每次取指都要等待；
+ *          对位操作总线的收发循环和高频中断，从SRAM取指没有等待周期：
+ *          - RAMFUNC修饰的函数放入.ramfunc段，链接到SRAM，启动时从flash复制
+ *            （Keil：Start/Trash.sct，由__main分散加载；GCC：Start/gcc/sections.ld，随.data复制）
+ *          - 中断服务函数同样适用，向量表直接指向SRAM中的地址
+ *          - flash与SRAM之间的调用超出BL范围，由链接器自动插入跳转代码
+ *          - 定义RAMFUNC_DISABLE时不改变放置，用于对比测试（make bench RAMFUNC=0）
+ *          用法：
+ *          @code
+ *          RAMFUNC void OLED_I2C_SendByte(uint8_t Byte) { ... }
+ *          @endcode
+ *          每个函数占用等量的SRAM，只用于确实热的短函数
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __RAMFUNC_H
+#define __RAMFUNC_H
+
+#if defined(RAMFUNC_DISABLE)
+#define RAMFUNC
+#elif defined(__CC_ARM)
+#define RAMFUNC __attribute__((section(".ramfunc")))
+#elif defined(__GNUC__)
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#else
+#define RAMFUNC
+#endif
+
+#endif /* __RAMFUNC_H */
@@ -0,0 +1,99 @@
+/**
+ * @file     RangeCal.c
+ * @brief    超声波测距声速校准
+ * @details  维护回波计数到距离的Q16换算系数：
+ *          - 距离(mm) = ticks × TICK_US × c / 2 / 10^6
+ *          - 系数 scale = c × TICK_US × 65536 / (2 × 10^6)
+ *                      = c × TICK_US × 512 / 15625，32位运算即可完成
+ *          - 系数为单个32位字，更新与读取天然原子
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "RangeCal.h"
+#include "HC_SR04.h"
+
+#define RANGE_CAL_SCALE(speed) (((uint32_t)(speed) * RANGE_CAL_TICK_US * 512 + 15625 / 2) / 15625)
+
+static volatile uint32_t range_scale_q16 = RANGE_CAL_SCALE(RANGE_CAL_BASE_MM_S); /**< 每个计数对应的毫米数（Q16），初始化前按0℃取值 */
+static uint32_t range_speed_mm_s         = 0; /**< 当前声速（毫米/秒） */
+static int16_t range_temp_x10            = 0; /**< 参与计算的温度（0.1℃） */
+static uint16_t range_humi_x10           = 0; /**< 参与计算的湿度（0.1%RH） */
+
+/**
+ * @brief  按温湿度重新计算声速和换算系数
+ * @param  temp_x10 温度（0.1℃）
+ * @param  humi_x10 湿度（0.1%RH）
+ * @return 无
+ */
+static void RangeCal_Compute(int16_t temp_x10, uint16_t humi_x10)
+{
+    int32_t speed = RANGE_CAL_BASE_MM_S + (int32_t)RANGE_CAL_TEMP_COEF * temp_x10 / 10 +
+                    (int32_t)RANGE_CAL_HUMI_COEF_X10 * humi_x10 / 100;
+
+    range_temp_x10   = temp_x10;
+    range_humi_x10   = humi_x10;
+    range_speed_mm_s = (uint32_t)speed;
+    range_scale_q16  = RANGE_CAL_SCALE(speed);
+}
+
+/**
+ * @brief  校准初始化
+ * @param  无
+ * @return 无
+ */
+void RangeCal_Init(void)
+{
+    RangeCal_Compute(ULTRASONIC_TEMPERATURE * 10, ULTRASONIC_HUMIDITY * 10);
+}
+
+/**
+ * @brief  用新的温湿度更新校准
+ * @param  temp_x10 空气温度（0.1℃）
+ * @param  humi_x10 相对湿度（0.1%RH）
+ * @return 1：换算系数已更新，0：未变化或参数超出范围
+ */
+uint8_t RangeCal_Update(int16_t temp_x10, uint16_t humi_x10)
+{
+    int16_t dt;
+    int16_t dh;
+
+    if (temp_x10 < RANGE_CAL_TEMP_MIN_X10 || temp_x10 > RANGE_CAL_TEMP_MAX_X10 || humi_x10 > 1000) {
+        return 0; // 明显错误的读数，保留原系数
+    }
+
+    dt = temp_x10 - range_temp_x10;
+    dh = (int16_t)humi_x10 - (int16_t)range_humi_x10;
+    if (dt < RANGE_CAL_TEMP_HYST_X10 && dt > -RANGE_CAL_TEMP_HYST_X10 &&
+        dh < RANGE_CAL_HUMI_HYST_X10 && dh > -RANGE_CAL_HUMI_HYST_X10) {
+        return 0;
+    }
+
+    RangeCal_Compute(temp_x10, humi_x10);
+    return 1;
+}
+
+/**
+ * @brief  获取当前声速
+ * @return 声速（毫米/秒）
+ */
+uint32_t RangeCal_GetSpeed(void)
+{
+    return range_speed_mm_s;
+}
+
+/**
+ * @brief  把回波高电平计数换算为距离
+ * @param  ticks 回波计数值
+ * @return 单程距离（毫米）
+ */
+uint32_t RangeCal_TicksToMm(uint32_t ticks)
+{
+    uint32_t scale = range_scale_q16;
+
+    if (ticks > UINT32_MAX / scale) {
+        ticks = UINT32_MAX / scale; // 防止溢出，远超传感器量程
+    }
+    return (ticks * scale + 0x8000) >> 16;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file     RangeCal.h
+ * @brief    超声波测距声速校准头文件
+ * @details  根据空气温湿度计算声速，并缓存回波计数到毫米的换算系数：
+ *          - 声速采用定点线性近似 c = 331.4 + 0.607·T + 0.0124·RH (m/s)
+ *          - 换算系数为Q16定点数，仅在温湿度变化超过回差时重新计算
+ *          - 每次测距换算只需一次乘法和移位，无浮点运算
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __RANGECAL_H
+#define __RANGECAL_H
+
+#include <stdint.h>
+
+/**
+ * @brief 校准参数配置
+ */
+#define RANGE_CAL_TICK_US       10     /**< 回波计时单位（TIM4中断周期，微秒），不超过20 */
+#define RANGE_CAL_BASE_MM_S     331400 /**< 0℃、干燥空气中的声速（毫米/秒） */
+#define RANGE_CAL_TEMP_COEF     607    /**< 温度系数（毫米/秒/℃） */
+#define RANGE_CAL_HUMI_COEF_X10 124    /**< 湿度系数（0.1毫米/秒/%RH） */
+#define RANGE_CAL_TEMP_HYST_X10 5      /**< 温度回差（0.1℃），变化小于此值不重新计算 */
+#define RANGE_CAL_HUMI_HYST_X10 50     /**< 湿度回差（0.1%RH） */
+#define RANGE_CAL_TEMP_MIN_X10  -400   /**< 可接受的温度下限（0.1℃） */
+#define RANGE_CAL_TEMP_MAX_X10  850    /**< 可接受的温度上限（0.1℃） */
+
+/**
+ * @brief  校准初始化
+ * @details 按默认温湿度（ULTRASONIC_TEMPERATURE/ULTRASONIC_HUMIDITY）计算换算系数
+ * @param  无
+ * @return 无
+ */
+void RangeCal_Init(void);
+
+/**
+ * @brief  用新的温湿度更新校准
+ * @details 与上次参与计算的温湿度相比变化未超过回差时直接返回
+ * @param  temp_x10 空气温度（0.1℃）
+ * @param  humi_x10 相对湿度（0.1%RH）
+ * @return 1：换算系数已更新，0：未变化或参数超出范围
+ */
+uint8_t RangeCal_Update(int16_t temp_x10, uint16_t humi_x10);
+
+/**
+ * @brief  获取当前声速
+ * @return 声速（毫米/秒）
+ */
+uint32_t RangeCal_GetSpeed(void);
+
+/**
+ * @brief  把回波高电平计数换算为距离
+ * @param  ticks 回波高电平持续的计数值（单位RANGE_CAL_TICK_US）
+ * @return 单程距离（毫米）
+ */
+uint32_t RangeCal_TicksToMm(uint32_t ticks);
+
+#endif /* __RANGECAL_H */
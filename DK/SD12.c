@@ -10,7 +10,7 @@
  */
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
-#include "dk_C8T6.h"   // 项目主头文件
+#include "DK_C8T6.h"   // 项目主头文件
 
 /**
  * @brief  SD12传感器初始化
@@ -0,0 +1,206 @@
+/**
+ * @file     SensorHub.c
+ * @brief    传感器中心（Sensor Hub）
+ * @details  统一调度各传感器的采集并发布带时间戳的样本：
+ *          - 每个样本槽为双缓冲：写者写入后台缓冲后翻转索引，
+ *            读者按序号校验读取，无需关中断
+ *          - 每条总线同一时刻只有一个采集在进行
+ *          - 总线刚完成一次采集时，临近到期的同总线采集会被提前合并执行，
+ *            减少总线的启停次数
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "SensorHub.h"
+#include <string.h>
+
+/**
+ * @brief 传感器注册项
+ */
+typedef struct
+{
+    const SensorDesc_t *desc;        /**< 描述符，NULL表示未注册 */
+    volatile SensorSample_t slot[2]; /**< 双缓冲样本槽，volatile保证写入不被移到翻转front之后 */
+    volatile uint8_t front;          /**< 当前对读者可见的缓冲索引 */
+    uint8_t busy;                    /**< 异步采集进行中 */
+    uint8_t started;                 /**< 是否启动过采集 */
+    uint16_t seq;                    /**< 下一次发布的序号 */
+    uint32_t last_start;             /**< 上次启动采集的时刻 */
+} SensorEntry_t;
+
+static SensorEntry_t sensor_table[SENSOR_HUB_MAX_SENSORS];
+static volatile uint32_t hub_now = 0; /**< 最近一次轮询的时刻，用于判断样本是否过期 */
+
+/**
+ * @brief  调用采集函数，完成时发布结果
+ * @param  id 传感器编号
+ * @return SENSOR_ACQ_DONE、SENSOR_ACQ_BUSY 或 SENSOR_ACQ_DEFER
+ */
+static uint8_t SensorHub_Run(uint8_t id)
+{
+    SensorEntry_t *e = &sensor_table[id];
+    int32_t value    = 0;
+    uint8_t quality  = SENSOR_Q_OK;
+    uint8_t ret      = e->desc->acquire(&value, &quality);
+
+    if (ret == SENSOR_ACQ_BUSY) {
+        e->busy = 1;
+        return SENSOR_ACQ_BUSY;
+    }
+    if (ret == SENSOR_ACQ_DEFER) {
+        e->busy    = 0;
+        e->started = 0; // 下次轮询立即到期
+        return SENSOR_ACQ_DEFER;
+    }
+
+    e->busy = 0;
+    SensorHub_Publish(id, value, quality, hub_now);
+    return SENSOR_ACQ_DONE;
+}
+
+/**
+ * @brief  传感器中心初始化
+ * @param  无
+ * @return 无
+ */
+void SensorHub_Init(void)
+{
+    uint8_t i;
+
+    memset(sensor_table, 0, sizeof(sensor_table));
+    for (i = 0; i < SENSOR_HUB_MAX_SENSORS; i++) {
+        sensor_table[i].slot[0].quality = SENSOR_Q_NODATA;
+        sensor_table[i].slot[1].quality = SENSOR_Q_NODATA;
+    }
+}
+
+/**
+ * @brief  注册传感器
+ * @param  id   传感器编号
+ * @param  desc 传感器描述符
+ * @return 0：成功，1：参数错误
+ */
+uint8_t SensorHub_Register(uint8_t id, const SensorDesc_t *desc)
+{
+    if (id >= SENSOR_HUB_MAX_SENSORS || desc == NULL || desc->acquire == NULL || desc->bus >= SENSOR_BUS_NUM) {
+        return 1;
+    }
+
+    sensor_table[id].busy    = 0;
+    sensor_table[id].started = 0;
+    sensor_table[id].desc    = desc;
+    return 0;
+}
+
+/**
+ * @brief  传感器调度轮询
+ * @details 分两轮处理：
+ *         1. 推进所有进行中的异步采集，完成的立即发布
+ *         2. 为空闲总线启动已到期的采集；若该总线本轮刚完成过采集，
+ *            则到期判断放宽SENSOR_HUB_COALESCE_MS，实现合并采集；
+ *            推迟的采集不占用总线
+ * @param  now_ms 当前系统时间（毫秒）
+ * @return 无
+ */
+void SensorHub_Poll(uint32_t now_ms)
+{
+    uint8_t bus_busy[SENSOR_BUS_NUM] = {0};
+    uint8_t bus_warm[SENSOR_BUS_NUM] = {0};
+    uint8_t i;
+
+    hub_now = now_ms;
+
+    /* 第一轮：推进进行中的采集 */
+    for (i = 0; i < SENSOR_HUB_MAX_SENSORS; i++) {
+        SensorEntry_t *e = &sensor_table[i];
+        if (e->desc == NULL || !e->busy) continue;
+
+        if (SensorHub_Run(i) == SENSOR_ACQ_BUSY) {
+            bus_busy[e->desc->bus] = 1;
+        } else {
+            bus_warm[e->desc->bus] = 1;
+        }
+    }
+
+    /* 第二轮：启动到期的采集 */
+    for (i = 0; i < SENSOR_HUB_MAX_SENSORS; i++) {
+        SensorEntry_t *e = &sensor_table[i];
+        uint32_t window;
+        uint8_t ret;
+
+        if (e->desc == NULL || e->busy || bus_busy[e->desc->bus]) continue;
+
+        window = bus_warm[e->desc->bus] ? SENSOR_HUB_COALESCE_MS : 0;
+        if (e->started && (uint32_t)(now_ms - e->last_start) + window < e->desc->period_ms) continue;
+
+        e->started    = 1;
+        e->last_start = now_ms;
+        ret           = SensorHub_Run(i);
+        if (ret == SENSOR_ACQ_BUSY) {
+            bus_busy[e->desc->bus] = 1;
+        } else if (ret == SENSOR_ACQ_DONE) {
+            bus_warm[e->desc->bus] = 1;
+        }
+    }
+}
+
+/**
+ * @brief  发布一个样本
+ * @details 写入后台缓冲后再翻转front，读者始终看到完整的样本；
+ *         样本槽和front都是volatile，编译器不会把样本的写入移到翻转之后
+ * @note   每个传感器只能有一个写者（轮询或中断回调之一）
+ * @param  id       传感器编号
+ * @param  value    采样值
+ * @param  quality  质量标志
+ * @param  now_ms   采集完成时刻（毫秒）
+ * @return 无
+ */
+void SensorHub_Publish(uint8_t id, int32_t value, uint8_t quality, uint32_t now_ms)
+{
+    SensorEntry_t *e;
+    volatile SensorSample_t *s;
+
+    if (id >= SENSOR_HUB_MAX_SENSORS) return;
+
+    e            = &sensor_table[id];
+    s            = &e->slot[e->front ^ 1];
+    s->value     = value;
+    s->timestamp = now_ms;
+    s->quality   = quality;
+    s->seq       = e->seq++;
+    e->front ^= 1;
+}
+
+/**
+ * @brief  读取传感器最新样本快照（无锁）
+ * @details 复制期间若写者连续发布两次导致缓冲被覆盖，
+ *          通过front和序号的变化检测到并重读
+ * @param  id  传感器编号
+ * @param  out 输出样本
+ * @return 样本质量标志
+ */
+uint8_t SensorHub_Read(uint8_t id, SensorSample_t *out)
+{
+    SensorEntry_t *e;
+    uint8_t f;
+    uint8_t retry = 4;
+
+    if (id >= SENSOR_HUB_MAX_SENSORS || sensor_table[id].desc == NULL) {
+        memset(out, 0, sizeof(*out));
+        out->quality = SENSOR_Q_NODATA;
+        return out->quality;
+    }
+
+    e = &sensor_table[id];
+    do {
+        f    = e->front;
+        *out = e->slot[f];
+    } while ((f != e->front || out->seq != e->slot[f].seq) && --retry);
+
+    if (!(out->quality & SENSOR_Q_NODATA) &&
+        (uint32_t)(hub_now - out->timestamp) > 2UL * e->desc->period_ms) {
+        out->quality |= SENSOR_Q_STALE;
+    }
+    return out->quality;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file     SensorHub.h
+ * @brief    传感器中心（Sensor Hub）头文件
+ * @details  为所有传感器提供统一的采样接口：
+ *          - 每个传感器注册采样周期和（可异步的）采集函数
+ *          - 采样结果发布到双缓冲样本槽：数值、时间戳、序号、质量标志
+ *          - 消费者通过无锁快照读取最新样本
+ *          - 同一总线上的采集按总线串行化，临近到期的采集合并执行
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __SENSORHUB_H
+#define __SENSORHUB_H
+
+#include <stdint.h>
+
+/**
+ * @brief 传感器中心容量配置
+ */
+#define SENSOR_HUB_MAX_SENSORS 8  /**< 最多可注册的传感器数量 */
+#define SENSOR_HUB_COALESCE_MS 20 /**< 总线已在工作时，提前合并执行的到期窗口（毫秒） */
+
+/**
+ * @brief 传感器编号
+ * @note  编号即样本槽索引，注册时使用
+ */
+#define SENSOR_ID_SONAR     0 /**< 超声波距离（毫米） */
+#define SENSOR_ID_SMOKE     1 /**< MQ2烟雾浓度（PPM） */
+#define SENSOR_ID_IR_BOTTOM 2 /**< 底部红外（原始电平） */
+#define SENSOR_ID_IR_TOP    3 /**< 顶部红外（原始电平） */
+#define SENSOR_ID_DHT11     4 /**< DHT11温湿度，打包格式见SENSOR_DHT11_PACK */
+#define SENSOR_ID_FILL      5 /**< 桶内满溢测距（毫米） */
+
+/**
+ * @brief DHT11样本打包：低16位为温度(0.1℃，有符号)，高16位为湿度(0.1%RH)
+ */
+#define SENSOR_DHT11_PACK(t10, h10) ((int32_t)(((uint32_t)(uint16_t)(h10) << 16) | (uint16_t)(int16_t)(t10)))
+#define SENSOR_DHT11_TEMP(v)        ((int16_t)((uint32_t)(v) & 0xFFFF))
+#define SENSOR_DHT11_HUMI(v)        ((uint16_t)((uint32_t)(v) >> 16))
+
+/**
+ * @brief 传感器所在总线，同一总线同一时刻只允许一个采集在进行
+ */
+#define SENSOR_BUS_GPIO     0 /**< 普通GPIO电平读取 */
+#define SENSOR_BUS_ADC      1 /**< ADC1 */
+#define SENSOR_BUS_SONAR    2 /**< 超声波测距 */
+#define SENSOR_BUS_ONEWIRE  3 /**< 单总线（DHT11） */
+#define SENSOR_BUS_NUM      4
+
+/**
+ * @brief 样本质量标志（可按位组合）
+ */
+#define SENSOR_Q_OK         0x00 /**< 数据有效 */
+#define SENSOR_Q_NODATA     0x01 /**< 尚未采到任何数据 */
+#define SENSOR_Q_TIMEOUT    0x02 /**< 采集超时（如超声波无回波） */
+#define SENSOR_Q_RANGE      0x04 /**< 超出量程，数值已被钳位 */
+#define SENSOR_Q_CHECKSUM   0x08 /**< 校验失败 */
+#define SENSOR_Q_STALE      0x10 /**< 样本已超过两个采样周期未更新 */
+
+/**
+ * @brief 采集函数返回值
+ */
+#define SENSOR_ACQ_DONE     0 /**< 采集完成，value/quality有效 */
+#define SENSOR_ACQ_BUSY     1 /**< 采集进行中，下次轮询继续调用 */
+#define SENSOR_ACQ_DEFER    2 /**< 本轮条件不满足，未采集也不占用总线，下次轮询重新尝试 */
+
+/**
+ * @brief  采集函数类型
+ * @details 首次调用启动一次采集；异步驱动在完成前返回SENSOR_ACQ_BUSY，
+ *          完成后返回SENSOR_ACQ_DONE并填写数值和质量标志；
+ *          首次调用时可返回SENSOR_ACQ_DEFER推迟本次采集（如等待共用总线的空闲段）
+ * @param  value   输出采样值
+ * @param  quality 输出质量标志
+ * @return SENSOR_ACQ_DONE 或 SENSOR_ACQ_BUSY
+ */
+typedef uint8_t (*SensorAcquireFn)(int32_t *value, uint8_t *quality);
+
+/**
+ * @brief 传感器描述符（注册时提供，通常定义为const）
+ */
+typedef struct
+{
+    const char *name;        /**< 传感器名称 */
+    uint16_t period_ms;      /**< 采样周期（毫秒） */
+    uint8_t bus;             /**< 所在总线 SENSOR_BUS_x */
+    SensorAcquireFn acquire; /**< 采集函数 */
+} SensorDesc_t;
+
+/**
+ * @brief 传感器样本
+ */
+typedef struct
+{
+    int32_t value;      /**< 采样值，单位由传感器决定 */
+    uint32_t timestamp; /**< 采集完成时刻（系统毫秒） */
+    uint16_t seq;       /**< 发布序号，每次发布加1 */
+    uint8_t quality;    /**< 质量标志 SENSOR_Q_x */
+} SensorSample_t;
+
+/**
+ * @brief  传感器中心初始化
+ * @details 清空所有注册信息和样本槽
+ * @param  无
+ * @return 无
+ */
+void SensorHub_Init(void);
+
+/**
+ * @brief  注册传感器
+ * @param  id   传感器编号，范围：0~SENSOR_HUB_MAX_SENSORS-1
+ * @param  desc 传感器描述符，需在整个运行期间有效
+ * @return 0：成功，1：参数错误
+ */
+uint8_t SensorHub_Register(uint8_t id, const SensorDesc_t *desc);
+
+/**
+ * @brief  传感器调度轮询
+ * @details 在主循环中周期调用：推进进行中的异步采集，
+ *          启动已到期的采集，并把完成的结果发布到样本槽
+ * @param  now_ms 当前系统时间（毫秒）
+ * @return 无
+ */
+void SensorHub_Poll(uint32_t now_ms);
+
+/**
+ * @brief  发布一个样本
+ * @details 供中断完成回调等直接推送结果使用，可在中断中调用
+ * @param  id       传感器编号
+ * @param  value    采样值
+ * @param  quality  质量标志
+ * @param  now_ms   采集完成时刻（毫秒）
+ * @return 无
+ */
+void SensorHub_Publish(uint8_t id, int32_t value, uint8_t quality, uint32_t now_ms);
+
+/**
+ * @brief  读取传感器最新样本快照（无锁）
+ * @details 样本超过两个采样周期未更新时附加SENSOR_Q_STALE标志
+ * @param  id  传感器编号
+ * @param  out 输出样本
+ * @return 样本质量标志，SENSOR_Q_OK表示新鲜有效
+ */
+uint8_t SensorHub_Read(uint8_t id, SensorSample_t *out);
+
+#endif /* __SENSORHUB_H */
@@ -12,7 +12,7 @@
 
 #include "stm32f10x.h" // STM32F10x外设库头文件
 #include "PWM.h"       // PWM驱动头文件
-#include "dk_C8T6.h"   // 项目主头文件
+#include "DK_C8T6.h"   // 项目主头文件
 
 /**
  * @brief  舵机初始化
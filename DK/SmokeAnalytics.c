@@ -0,0 +1,218 @@
+/**
+ * @file     SmokeAnalytics.c
+ * @brief    烟雾分析（基线跟踪+上升速率）
+ * @details  每个样本的处理：
+ *          - 上升速率：与SMOKE_RISE_WINDOW个样本之前的浓度比较，环形缓冲O(1)
+ *          - 预热期：基线以较大系数快速跟随，等级保持WARMUP
+ *          - 证据：超出基线alarm_excess，或上升快且已超出pre_excess，为报警证据；
+ *            超出基线pre_excess，或上升较快且已超出pre_excess/2，为预警证据
+ *          - 等级：证据高于当前等级持续sustain_ms升级，低于当前等级持续clear_ms降级
+ *          - 基线：Q8定点EMA，只在正常且超出量小于pre_excess/2时跟随上升，
+ *            低于基线时总是跟随，避免烟雾被吸收进基线；
+ *            预警期间浓度平稳超过relearn_ms视为基线阶跃（如环境变化），重新学习
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "SmokeAnalytics.h"
+#include <stddef.h>
+
+#define SMOKE_MAX_DT_MS 1000 /**< 单个样本最多计入的时间，避免数据中断后直接升级 */
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Smoke_DefaultConfig(SmokeConfig_t *cfg)
+{
+    cfg->warmup_ms        = SMOKE_WARMUP_MS;
+    cfg->relearn_ms       = SMOKE_RELEARN_MS;
+    cfg->pre_excess_ppm   = SMOKE_PRE_EXCESS_PPM;
+    cfg->alarm_excess_ppm = SMOKE_ALARM_EXCESS_PPM;
+    cfg->pre_rise_ppms    = SMOKE_PRE_RISE_PPMS;
+    cfg->alarm_rise_ppms  = SMOKE_ALARM_RISE_PPMS;
+    cfg->sustain_ms       = SMOKE_SUSTAIN_MS;
+    cfg->clear_ms         = SMOKE_CLEAR_MS;
+    cfg->base_shift       = SMOKE_BASE_SHIFT;
+    cfg->warmup_shift     = SMOKE_WARMUP_SHIFT;
+}
+
+/**
+ * @brief  初始化/复位分析器
+ * @param  s 分析器
+ * @param  cfg 分析参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Smoke_Init(Smoke_t *s, const SmokeConfig_t *cfg)
+{
+    if (cfg == NULL) {
+        Smoke_DefaultConfig(&s->cfg);
+    } else {
+        s->cfg = *cfg;
+    }
+
+    s->level    = SMOKE_LEVEL_WARMUP;
+    s->started  = 0;
+    s->rise     = 0;
+    s->up_ms    = 0;
+    s->down_ms  = 0;
+    s->flat_ms  = 0;
+    s->ring_idx = 0;
+    s->ring_n   = 0;
+}
+
+/**
+ * @brief  基线向当前浓度靠近一步
+ * @param  s 分析器
+ */
+static void Smoke_Track(Smoke_t *s, uint16_t ppm, uint8_t shift)
+{
+    int32_t delta = ((int32_t)ppm << 8) - s->base_q8;
+    s->base_q8 += delta / (1L << shift);
+}
+
+/**
+ * @brief  更新上升速率
+ * @param  s 分析器
+ */
+static void Smoke_UpdateRise(Smoke_t *s, uint32_t t_ms, uint16_t ppm)
+{
+    uint8_t oldest = (s->ring_n == SMOKE_RISE_WINDOW) ? s->ring_idx : 0;
+    uint32_t dt;
+    int32_t rise = 0;
+
+    if (s->ring_n > 0) {
+        dt = t_ms - s->ring_t[oldest];
+        if (dt > 0) {
+            rise = ((int32_t)ppm - (int32_t)s->ring_ppm[oldest]) * 1000 / (int32_t)dt;
+        }
+    }
+    if (rise > INT16_MAX) rise = INT16_MAX;
+    if (rise < INT16_MIN) rise = INT16_MIN;
+    s->rise = (int16_t)rise;
+
+    s->ring_ppm[s->ring_idx] = ppm;
+    s->ring_t[s->ring_idx]   = t_ms;
+    s->ring_idx              = (s->ring_idx + 1) & (SMOKE_RISE_WINDOW - 1);
+    if (s->ring_n < SMOKE_RISE_WINDOW) s->ring_n++;
+}
+
+/**
+ * @brief  输入一个样本并更新判定
+ * @param  s     分析器
+ * @param  t_ms  样本时间戳（毫秒）
+ * @param  ppm   浓度（PPM）
+ * @param  valid 1：有效样本，0：传感器异常
+ * @return 当前等级
+ */
+uint8_t Smoke_Update(Smoke_t *s, uint32_t t_ms, uint16_t ppm, uint8_t valid)
+{
+    const SmokeConfig_t *c = &s->cfg;
+    uint32_t dt;
+    int32_t excess;
+    uint8_t evidence;
+
+    if (!valid) return s->level;
+
+    if (!s->started) {
+        s->started = 1;
+        s->t0      = t_ms;
+        s->last_t  = t_ms;
+        s->base_q8 = (int32_t)ppm << 8;
+    }
+    dt        = t_ms - s->last_t;
+    s->last_t = t_ms;
+    if (dt > SMOKE_MAX_DT_MS) dt = SMOKE_MAX_DT_MS;
+
+    Smoke_UpdateRise(s, t_ms, ppm);
+
+    /* 预热期：MQ2加热丝未稳定，读数从高处回落，只跟踪基线 */
+    if (t_ms - s->t0 < c->warmup_ms) {
+        Smoke_Track(s, ppm, c->warmup_shift);
+        s->level = SMOKE_LEVEL_WARMUP;
+        return s->level;
+    }
+    if (s->level == SMOKE_LEVEL_WARMUP) s->level = SMOKE_LEVEL_NONE;
+
+    excess = (int32_t)ppm - (s->base_q8 >> 8);
+    if (excess >= c->alarm_excess_ppm || (s->rise >= (int16_t)c->alarm_rise_ppms && excess >= c->pre_excess_ppm)) {
+        evidence = SMOKE_LEVEL_ALARM;
+    } else if (excess >= c->pre_excess_ppm ||
+               (s->rise >= (int16_t)c->pre_rise_ppms && excess >= c->pre_excess_ppm / 2)) {
+        evidence = SMOKE_LEVEL_PRE;
+    } else {
+        evidence = SMOKE_LEVEL_NONE;
+    }
+
+    /* 持续升级/降级 */
+    if (evidence > s->level) {
+        s->up_ms += dt;
+        if (s->up_ms >= c->sustain_ms) {
+            s->level = evidence;
+            s->up_ms = 0;
+        }
+    } else {
+        s->up_ms = 0;
+    }
+    if (evidence < s->level) {
+        s->down_ms += dt;
+        if (s->down_ms >= c->clear_ms) {
+            s->level   = evidence;
+            s->down_ms = 0;
+        }
+    } else {
+        s->down_ms = 0;
+    }
+
+    /* 基线跟踪 */
+    if (excess < 0 || (s->level == SMOKE_LEVEL_NONE && excess < c->pre_excess_ppm / 2)) {
+        Smoke_Track(s, ppm, c->base_shift);
+    }
+
+    /* 预警期间浓度平稳：基线阶跃，重新学习 */
+    if (s->level == SMOKE_LEVEL_PRE && s->rise < (int16_t)(c->pre_rise_ppms / 2) &&
+        s->rise > -(int16_t)(c->pre_rise_ppms / 2)) {
+        s->flat_ms += dt;
+        if (s->flat_ms >= c->relearn_ms) {
+            s->base_q8 = (int32_t)ppm << 8;
+            s->level   = SMOKE_LEVEL_NONE;
+            s->flat_ms = 0;
+        }
+    } else {
+        s->flat_ms = 0;
+    }
+
+    return s->level;
+}
+
+/**
+ * @brief  获取当前等级
+ * @param  s 分析器
+ * @return SMOKE_LEVEL_x
+ */
+uint8_t Smoke_GetLevel(const Smoke_t *s)
+{
+    return s->level;
+}
+
+/**
+ * @brief  获取当前基线
+ * @param  s 分析器
+ * @return 基线浓度（PPM）
+ */
+uint16_t Smoke_GetBaseline(const Smoke_t *s)
+{
+    return (uint16_t)(s->base_q8 >> 8);
+}
+
+/**
+ * @brief  获取短窗口上升速率
+ * @param  s 分析器
+ * @return 速率（PPM/秒）
+ */
+int16_t Smoke_GetRise(const Smoke_t *s)
+{
+    return s->rise;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file     SmokeAnalytics.h
+ * @brief    烟雾分析（基线跟踪+上升速率）头文件
+ * @details  对MQ2的PPM样本做分级判定，取代固定阈值比较：
+ *          - 慢速自适应基线（定点EMA），跟踪温湿度和器件老化引起的漂移
+ *          - 短窗口上升速率，快速燃烧时提前报警
+ *          - 上电预热期内不报警，基线快速收敛
+ *          - 超出基线的浓度或上升速率持续一段时间才升级为预警/报警
+ *          每个样本O(1)，只用整数运算；模块不依赖硬件，可在主机上回放记录的数据
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __SMOKEANALYTICS_H
+#define __SMOKEANALYTICS_H
+
+#include <stdint.h>
+
+/**
+ * @brief 报警等级
+ */
+#define SMOKE_LEVEL_NONE    0 /**< 正常 */
+#define SMOKE_LEVEL_PRE     1 /**< 预警 */
+#define SMOKE_LEVEL_ALARM   2 /**< 报警 */
+#define SMOKE_LEVEL_WARMUP  3 /**< 预热中，不判定 */
+
+/**
+ * @brief 默认参数
+ */
+#define SMOKE_WARMUP_MS        60000 /**< 上电预热时间（毫秒） */
+#define SMOKE_BASE_SHIFT       9     /**< 基线EMA系数1/2^n，500ms采样时时间常数约4分钟 */
+#define SMOKE_WARMUP_SHIFT     2     /**< 预热期基线EMA系数，快速收敛 */
+#define SMOKE_PRE_EXCESS_PPM   80    /**< 超出基线达到此值为预警证据 */
+#define SMOKE_ALARM_EXCESS_PPM 200   /**< 超出基线达到此值为报警证据 */
+#define SMOKE_PRE_RISE_PPMS    10    /**< 上升速率达到此值（PPM/秒）且已超出基线一半预警值时为预警证据 */
+#define SMOKE_ALARM_RISE_PPMS  40    /**< 上升速率达到此值且已达预警超出值时为报警证据 */
+#define SMOKE_SUSTAIN_MS       3000  /**< 证据持续此时间才升级 */
+#define SMOKE_CLEAR_MS         10000 /**< 证据消失持续此时间才降级 */
+#define SMOKE_RELEARN_MS       600000 /**< 预警期间浓度平稳超过此时间，视为基线阶跃并重新学习 */
+
+/**
+ * @brief 上升速率窗口（样本数，2的幂）
+ */
+#define SMOKE_RISE_WINDOW 8
+
+/**
+ * @brief 分析参数
+ */
+typedef struct
+{
+    uint32_t warmup_ms;        /**< 预热时间（毫秒） */
+    uint32_t relearn_ms;       /**< 平稳预警重新学习基线的时间（毫秒） */
+    uint16_t pre_excess_ppm;   /**< 预警超出值（PPM） */
+    uint16_t alarm_excess_ppm; /**< 报警超出值（PPM） */
+    uint16_t pre_rise_ppms;    /**< 预警上升速率（PPM/秒） */
+    uint16_t alarm_rise_ppms;  /**< 报警上升速率（PPM/秒） */
+    uint16_t sustain_ms;       /**< 升级持续时间（毫秒） */
+    uint16_t clear_ms;         /**< 降级持续时间（毫秒） */
+    uint8_t base_shift;        /**< 基线EMA系数 */
+    uint8_t warmup_shift;      /**< 预热期基线EMA系数 */
+} SmokeConfig_t;
+
+/**
+ * @brief 分析器状态（每个实例一份，互不影响）
+ */
+typedef struct
+{
+    SmokeConfig_t cfg;                    /**< 分析参数 */
+    uint8_t level;                        /**< 当前等级 SMOKE_LEVEL_x */
+    uint8_t started;                      /**< 已收到第一个有效样本 */
+    uint32_t t0;                          /**< 第一个有效样本时间 */
+    uint32_t last_t;                      /**< 上一个有效样本时间 */
+    int32_t base_q8;                      /**< 基线（Q8） */
+    int16_t rise;                         /**< 上升速率（PPM/秒） */
+    uint32_t up_ms;                       /**< 证据高于当前等级的持续时间 */
+    uint32_t down_ms;                     /**< 证据低于当前等级的持续时间 */
+    uint32_t flat_ms;                     /**< 预警期间浓度平稳的持续时间 */
+    uint16_t ring_ppm[SMOKE_RISE_WINDOW]; /**< 上升速率窗口：浓度 */
+    uint32_t ring_t[SMOKE_RISE_WINDOW];   /**< 上升速率窗口：时间 */
+    uint8_t ring_idx;                     /**< 窗口写入位置 */
+    uint8_t ring_n;                       /**< 窗口样本数 */
+} Smoke_t;
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Smoke_DefaultConfig(SmokeConfig_t *cfg);
+
+/**
+ * @brief  初始化/复位分析器（重新开始预热）
+ * @param  s 分析器
+ * @param  cfg 分析参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Smoke_Init(Smoke_t *s, const SmokeConfig_t *cfg);
+
+/**
+ * @brief  输入一个样本并更新判定
+ * @param  s     分析器
+ * @param  t_ms  样本时间戳（毫秒）
+ * @param  ppm   浓度（PPM）
+ * @param  valid 1：有效样本，0：传感器异常（不更新基线和判定）
+ * @return 当前等级 SMOKE_LEVEL_x
+ */
+uint8_t Smoke_Update(Smoke_t *s, uint32_t t_ms, uint16_t ppm, uint8_t valid);
+
+/**
+ * @brief  获取当前等级
+ * @param  s 分析器
+ * @return SMOKE_LEVEL_x
+ */
+uint8_t Smoke_GetLevel(const Smoke_t *s);
+
+/**
+ * @brief  获取当前基线
+ * @param  s 分析器
+ * @return 基线浓度（PPM）
+ */
+uint16_t Smoke_GetBaseline(const Smoke_t *s);
+
+/**
+ * @brief  获取短窗口上升速率
+ * @param  s 分析器
+ * @return 速率（PPM/秒），负值表示下降
+ */
+int16_t Smoke_GetRise(const Smoke_t *s);
+
+#endif /* __SMOKEANALYTICS_H */
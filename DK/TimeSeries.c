@@ -0,0 +1,632 @@
+/**
+ * @file     TimeSeries.c
+ * @brief    时间序列存储（多级降采样）
+ * @details  记录格式（字节）：[长度n][载荷n字节]，载荷依次为：
+ *          - 与上一条记录的时间差（本层单位：分钟/小时/天），变长整数
+ *          - 每个序列：次数；次数非0时再跟 最小值与上一条记录该序列最小值的差（zigzag）、
+ *            极差（最大-最小）、总和-最小值×次数，均为变长整数（每字节7位，最高位为续位）
+ *          分钟层放在RAM环形缓冲中，写满时丢弃最旧的记录，并解码它以更新差分基准；
+ *          小时/天层按页写入Flash，页头为 标识|层级|版本、序号、基准时间 三个字，
+ *          每页第一条记录以页头基准时间和最小值0为差分基准，可独立解码；
+ *          页写满后擦除下一页（最旧的数据）继续写入，擦除期间CPU暂停约20ms
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "TimeSeries.h"
+#include "stm32f10x.h"
+#include "Timer.h"
+#include "UART3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TS_REC_MAX       64 /**< 单条记录最大字节数（含长度字节） */
+#define TS_PAGE_HDR      12 /**< 页头字节数 */
+#define TS_LINE_MAX      128 /**< 单行输出最大长度 */
+#define TS_SCAN_PER_POLL 16 /**< 查询时每次轮询最多解码的记录数 */
+
+/**
+ * @brief Flash日志状态
+ */
+typedef struct
+{
+    uint32_t addr;                    /**< 首页地址 */
+    uint8_t pages;                    /**< 页数 */
+    uint8_t tier;                     /**< 层级 */
+    uint8_t page;                     /**< 当前写入页 */
+    uint16_t off;                     /**< 当前页写入偏移，0表示还没有可写入的页 */
+    uint32_t seq;                     /**< 当前页序号 */
+    uint32_t last_t;                  /**< 最后一条记录时间（分钟） */
+    uint16_t last_min[TS_SERIES_NUM]; /**< 最小值差分基准 */
+} TS_Log_t;
+
+/**
+ * @brief 查询游标
+ */
+typedef struct
+{
+    uint8_t active;                   /**< 查询进行中 */
+    uint8_t header;                   /**< 表头尚未输出 */
+    uint8_t tier;                     /**< 层级 */
+    uint32_t from, to;                /**< 时间范围（分钟） */
+    uint16_t lines;                   /**< 已输出行数 */
+    uint32_t t;                       /**< 差分基准时间 */
+    uint16_t prev_min[TS_SERIES_NUM]; /**< 最小值差分基准 */
+    uint32_t pos;                     /**< 分钟层：环形缓冲累计位置 */
+    uint8_t page;                     /**< Flash层：当前页 */
+    uint8_t pages_left;               /**< Flash层：剩余页数 */
+    uint16_t off;                     /**< Flash层：页内偏移，0表示需要读页头 */
+    uint32_t seq;                     /**< Flash层：当前页序号，页被改写时跳过 */
+} TS_Cursor_t;
+
+static const uint16_t ts_unit[TS_TIER_NUM] = {1, 60, 1440}; /**< 各层桶长度（分钟） */
+static const char ts_tier_name[TS_TIER_NUM] = {'m', 'h', 'd'};
+
+static uint32_t ts_epoch_base = 0; /**< system_runtime_s为0时对应的时刻（秒） */
+static TS_Bucket_t ts_open[TS_TIER_NUM]; /**< 各层正在汇总的桶 */
+
+static uint8_t ts_ring[TS_RING_BYTES];
+static uint32_t ts_ring_head = 0; /**< 写入位置（累计字节数） */
+static uint32_t ts_ring_tail = 0; /**< 最旧记录位置（累计字节数） */
+static uint32_t ts_head_t, ts_tail_t;
+static uint16_t ts_head_min[TS_SERIES_NUM], ts_tail_min[TS_SERIES_NUM];
+
+static TS_Log_t ts_log[TS_TIER_NUM] = {
+    [TS_TIER_HOUR] = {TS_HOUR_FLASH_ADDR, TS_HOUR_FLASH_PAGES, TS_TIER_HOUR},
+    [TS_TIER_DAY]  = {TS_DAY_FLASH_ADDR, TS_DAY_FLASH_PAGES, TS_TIER_DAY},
+};
+
+static TS_Cursor_t ts_q;
+
+/* ---------------- 编码 ---------------- */
+
+static uint8_t TS_PutVarint(uint8_t *p, uint32_t v)
+{
+    uint8_t n = 0;
+
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint8_t TS_GetVarint(const uint8_t *p, uint8_t len, uint8_t *pos, uint32_t *v)
+{
+    uint8_t shift = 0;
+
+    *v = 0;
+    while (*pos < len && shift < 35) {
+        uint8_t b = p[(*pos)++];
+        *v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return 0;
+        shift += 7;
+    }
+    return 1; // 截断或过长
+}
+
+/**
+ * @brief  编码一个桶
+ * @param  out      输出载荷
+ * @param  dt       与上一条记录的时间差（本层单位）
+ * @param  b        桶
+ * @param  prev_min 最小值差分基准，编码后更新
+ * @return 载荷长度
+ */
+static uint8_t TS_Encode(uint8_t *out, uint32_t dt, const TS_Bucket_t *b, uint16_t *prev_min)
+{
+    uint8_t n = TS_PutVarint(out, dt);
+    uint8_t s;
+
+    for (s = 0; s < TS_SERIES_NUM; s++) {
+        const TS_Agg_t *a = &b->agg[s];
+        int32_t d         = (int32_t)a->min - (int32_t)prev_min[s];
+
+        n += TS_PutVarint(out + n, a->count);
+        if (a->count == 0) continue;
+        n += TS_PutVarint(out + n, ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+        n += TS_PutVarint(out + n, a->max - a->min);
+        n += TS_PutVarint(out + n, a->sum - (uint32_t)a->min * a->count);
+        prev_min[s] = a->min;
+    }
+    return n;
+}
+
+/**
+ * @brief  解码一个桶
+ * @param  in       载荷
+ * @param  len      载荷长度
+ * @param  unit     本层单位（分钟）
+ * @param  t        时间差分基准，成功时更新
+ * @param  prev_min 最小值差分基准，成功时更新
+ * @param  b        输出桶
+ * @return 0：成功，1：格式错误
+ */
+static uint8_t TS_Decode(const uint8_t *in, uint8_t len, uint16_t unit, uint32_t *t, uint16_t *prev_min,
+                         TS_Bucket_t *b)
+{
+    uint16_t mins[TS_SERIES_NUM];
+    uint8_t pos = 0, s;
+    uint32_t v, range, rest;
+
+    if (TS_GetVarint(in, len, &pos, &v)) return 1;
+    b->t = *t + v * unit;
+
+    for (s = 0; s < TS_SERIES_NUM; s++) {
+        TS_Agg_t *a = &b->agg[s];
+
+        memset(a, 0, sizeof(*a));
+        mins[s] = prev_min[s];
+        if (TS_GetVarint(in, len, &pos, &a->count)) return 1;
+        if (a->count == 0) continue;
+        if (TS_GetVarint(in, len, &pos, &v) || TS_GetVarint(in, len, &pos, &range) ||
+            TS_GetVarint(in, len, &pos, &rest)) {
+            return 1;
+        }
+        a->min  = (uint16_t)((int32_t)prev_min[s] + (int32_t)((v >> 1) ^ (0 - (v & 1))));
+        a->max  = (uint16_t)(a->min + range);
+        a->sum  = rest + (uint32_t)a->min * a->count;
+        mins[s] = a->min;
+    }
+
+    *t = b->t;
+    memcpy(prev_min, mins, sizeof(mins));
+    return 0;
+}
+
+/* ---------------- 桶 ---------------- */
+
+static void TS_Clear(TS_Bucket_t *b, uint32_t t)
+{
+    memset(b, 0, sizeof(*b));
+    b->t = t;
+}
+
+static uint8_t TS_HasData(const TS_Bucket_t *b)
+{
+    uint8_t s;
+
+    for (s = 0; s < TS_SERIES_NUM; s++) {
+        if (b->agg[s].count) return 1;
+    }
+    return 0;
+}
+
+static void TS_Merge(TS_Bucket_t *dst, const TS_Bucket_t *src)
+{
+    uint8_t s;
+
+    for (s = 0; s < TS_SERIES_NUM; s++) {
+        TS_Agg_t *d       = &dst->agg[s];
+        const TS_Agg_t *a = &src->agg[s];
+
+        if (a->count == 0) continue;
+        if (d->count == 0) {
+            *d = *a;
+            continue;
+        }
+        if (a->min < d->min) d->min = a->min;
+        if (a->max > d->max) d->max = a->max;
+        d->count += a->count;
+        d->sum += a->sum;
+    }
+}
+
+/* ---------------- 分钟层环形缓冲 ---------------- */
+
+static void TS_RingCopy(uint32_t pos, uint8_t *dst, uint8_t n)
+{
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        dst[i] = ts_ring[(pos + i) % TS_RING_BYTES];
+    }
+}
+
+/**
+ * @brief  丢弃最旧的记录，解码它以更新差分基准
+ */
+static void TS_RingDrop(void)
+{
+    uint8_t rec[TS_REC_MAX];
+    uint8_t len = ts_ring[ts_ring_tail % TS_RING_BYTES];
+    TS_Bucket_t b;
+
+    TS_RingCopy(ts_ring_tail + 1, rec, len);
+    TS_Decode(rec, len, 1, &ts_tail_t, ts_tail_min, &b);
+    ts_ring_tail += 1 + len;
+}
+
+static void TS_RingAppend(const TS_Bucket_t *b)
+{
+    uint8_t rec[TS_REC_MAX];
+    uint8_t n, i;
+
+    n      = 1 + TS_Encode(rec + 1, b->t - ts_head_t, b, ts_head_min);
+    rec[0] = n - 1;
+    while (TS_RING_BYTES - (ts_ring_head - ts_ring_tail) < n) {
+        TS_RingDrop();
+    }
+    for (i = 0; i < n; i++) {
+        ts_ring[(ts_ring_head + i) % TS_RING_BYTES] = rec[i];
+    }
+    ts_ring_head += n;
+    ts_head_t = b->t;
+}
+
+/* ---------------- Flash日志 ---------------- */
+
+static const uint32_t *TS_PageHdr(const TS_Log_t *log, uint8_t page)
+{
+    return (const uint32_t *)(log->addr + (uint32_t)page * TS_FLASH_PAGE_SIZE);
+}
+
+static uint8_t TS_PageValid(const TS_Log_t *log, uint8_t page)
+{
+    uint32_t w = TS_PageHdr(log, page)[0];
+
+    return (w & 0xFFFF) == TS_FLASH_MAGIC && ((w >> 16) & 0xFF) == log->tier && (w >> 24) == TS_FLASH_VERSION;
+}
+
+/**
+ * @brief  读取页内下一条记录
+ * @param  off      页内偏移，成功时前移到下一条记录
+ * @param  t        时间差分基准
+ * @param  prev_min 最小值差分基准
+ * @return 0：成功，1：页内没有更多记录
+ */
+static uint8_t TS_PageNext(const TS_Log_t *log, uint8_t page, uint16_t *off, uint32_t *t, uint16_t *prev_min,
+                           TS_Bucket_t *b)
+{
+    const uint8_t *p = (const uint8_t *)TS_PageHdr(log, page);
+    uint8_t len;
+
+    if (*off >= TS_FLASH_PAGE_SIZE || p[*off] == 0xFF) return 1;
+    len = p[*off];
+    if (len >= TS_REC_MAX || *off + 1 + len > TS_FLASH_PAGE_SIZE ||
+        TS_Decode(p + *off + 1, len, ts_unit[log->tier], t, prev_min, b)) {
+        return 1;
+    }
+    *off += (1 + len + 1) & ~1U; // 记录按半字对齐
+    return 0;
+}
+
+/**
+ * @brief  从Flash恢复写入位置
+ * @details 取序号最大的有效页，逐条解码到页尾得到写入偏移和差分基准
+ */
+static void TS_LogRecover(TS_Log_t *log)
+{
+    const uint32_t *hdr;
+    TS_Bucket_t b;
+    uint8_t i, found = 0;
+
+    log->off = 0;
+    for (i = 0; i < log->pages; i++) {
+        if (!TS_PageValid(log, i)) continue;
+        hdr = TS_PageHdr(log, i);
+        if (!found || (int32_t)(hdr[1] - log->seq) > 0) {
+            log->page = i;
+            log->seq  = hdr[1];
+            found     = 1;
+        }
+    }
+    if (!found) return;
+
+    hdr          = TS_PageHdr(log, log->page);
+    log->off     = TS_PAGE_HDR;
+    log->last_t  = hdr[2];
+    memset(log->last_min, 0, sizeof(log->last_min));
+    while (TS_PageNext(log, log->page, &log->off, &log->last_t, log->last_min, &b) == 0);
+}
+
+static FLASH_Status TS_FlashWrite(uint32_t addr, const uint8_t *data, uint8_t n)
+{
+    FLASH_Status status = FLASH_COMPLETE;
+    uint8_t i;
+
+    for (i = 0; i + 1 < n && status == FLASH_COMPLETE; i += 2) {
+        status = FLASH_ProgramHalfWord(addr + i, data[i] | ((uint16_t)data[i + 1] << 8));
+    }
+    return status;
+}
+
+/**
+ * @brief  追加一条记录，当前页放不下时擦除下一页
+ */
+static void TS_LogAppend(TS_Log_t *log, const TS_Bucket_t *b)
+{
+    uint8_t rec[TS_REC_MAX + 1];
+    uint16_t prev[TS_SERIES_NUM];
+    uint32_t hdr[3], addr;
+    uint8_t n      = 0;
+    FLASH_Status s = FLASH_COMPLETE;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+
+    if (log->off != 0 && b->t >= log->last_t) { // 时钟被调回时另起一页
+        memcpy(prev, log->last_min, sizeof(prev));
+        n = 1 + TS_Encode(rec + 1, (b->t - log->last_t) / ts_unit[log->tier], b, prev);
+        if (log->off + ((n + 1) & ~1U) > TS_FLASH_PAGE_SIZE) n = 0;
+    }
+    if (n == 0) {
+        log->page = (log->off == 0) ? 0 : (log->page + 1) % log->pages;
+        log->seq++;
+        addr   = (uint32_t)TS_PageHdr(log, log->page);
+        hdr[0] = TS_FLASH_MAGIC | ((uint32_t)log->tier << 16) | ((uint32_t)TS_FLASH_VERSION << 24);
+        hdr[1] = log->seq;
+        hdr[2] = b->t;
+        s      = FLASH_ErasePage(addr);
+        s      = (s == FLASH_COMPLETE) ? TS_FlashWrite(addr, (const uint8_t *)hdr, sizeof(hdr)) : s;
+        log->off    = TS_PAGE_HDR;
+        log->last_t = b->t;
+        memset(prev, 0, sizeof(prev));
+        n = 1 + TS_Encode(rec + 1, 0, b, prev);
+    }
+
+    rec[0] = n - 1;
+    if (n & 1) rec[n++] = 0xFF;
+    if (s == FLASH_COMPLETE) s = TS_FlashWrite((uint32_t)TS_PageHdr(log, log->page) + log->off, rec, n);
+    FLASH_Lock();
+
+    if (s != FLASH_COMPLETE) {
+        log->off = TS_FLASH_PAGE_SIZE; // 写入失败，下次换页
+        return;
+    }
+    log->off += n;
+    log->last_t = b->t;
+    memcpy(log->last_min, prev, sizeof(prev));
+}
+
+/* ---------------- 汇总 ---------------- */
+
+/**
+ * @brief  关闭到期的桶，逐层存储并汇总到上一层
+ */
+static void TS_Roll(uint32_t now_min)
+{
+    uint8_t tier;
+
+    for (tier = 0; tier < TS_TIER_NUM; tier++) {
+        TS_Bucket_t *b = &ts_open[tier];
+        uint32_t start = now_min - now_min % ts_unit[tier];
+
+        if (b->t == start) break; // 本层未到期，上层也不会到期
+        if (TS_HasData(b)) {
+            if (tier == TS_TIER_MIN) {
+                TS_RingAppend(b);
+            } else {
+                TS_LogAppend(&ts_log[tier], b);
+            }
+            if (tier + 1 < TS_TIER_NUM) TS_Merge(&ts_open[tier + 1], b);
+        }
+        TS_Clear(b, start);
+    }
+}
+
+/**
+ * @brief  初始化
+ * @param  epoch_s 当前时刻（2000-01-01起的秒数）
+ * @return 无
+ */
+void TS_Init(uint32_t epoch_s)
+{
+    uint32_t now_min;
+    uint8_t tier;
+
+    ts_epoch_base = epoch_s - system_runtime_s;
+    now_min       = TS_Now() / 60;
+    for (tier = 0; tier < TS_TIER_NUM; tier++) {
+        TS_Clear(&ts_open[tier], now_min - now_min % ts_unit[tier]);
+    }
+
+    ts_ring_head = ts_ring_tail = 0;
+    ts_head_t = ts_tail_t = now_min;
+    memset(ts_head_min, 0, sizeof(ts_head_min));
+    memset(ts_tail_min, 0, sizeof(ts_tail_min));
+
+    TS_LogRecover(&ts_log[TS_TIER_HOUR]);
+    TS_LogRecover(&ts_log[TS_TIER_DAY]);
+    ts_q.active = 0;
+}
+
+/**
+ * @brief  获取当前时刻
+ * @return 2000-01-01起的秒数
+ */
+uint32_t TS_Now(void)
+{
+    return ts_epoch_base + system_runtime_s;
+}
+
+/**
+ * @brief  加入一个样本
+ * @param  series 序列编号
+ * @param  value  样本值
+ * @return 无
+ */
+void TS_Add(uint8_t series, uint16_t value)
+{
+    TS_Agg_t *a;
+
+    if (series >= TS_SERIES_NUM) return;
+    a = &ts_open[TS_TIER_MIN].agg[series];
+    if (a->count == 0 || value < a->min) a->min = value;
+    if (a->count == 0 || value > a->max) a->max = value;
+    a->count++;
+    a->sum += value;
+}
+
+/* ---------------- 查询 ---------------- */
+
+/**
+ * @brief  取出查询的下一条记录
+ * @return 0：成功，1：已结束
+ */
+static uint8_t TS_QueryNext(TS_Bucket_t *b)
+{
+    uint8_t rec[TS_REC_MAX];
+    uint8_t len;
+
+    if (ts_q.tier == TS_TIER_MIN) {
+        if ((int32_t)(ts_q.pos - ts_ring_tail) < 0) { // 游标处的记录已被覆盖，从最旧的记录继续
+            ts_q.pos = ts_ring_tail;
+            ts_q.t   = ts_tail_t;
+            memcpy(ts_q.prev_min, ts_tail_min, sizeof(ts_q.prev_min));
+        }
+        if (ts_q.pos == ts_ring_head) return 1;
+        len = ts_ring[ts_q.pos % TS_RING_BYTES];
+        TS_RingCopy(ts_q.pos + 1, rec, len);
+        ts_q.pos += 1 + len;
+        return TS_Decode(rec, len, 1, &ts_q.t, ts_q.prev_min, b);
+    }
+
+    for (;;) {
+        const TS_Log_t *log = &ts_log[ts_q.tier];
+
+        if (ts_q.off == 0) { // 读页头
+            const uint32_t *hdr;
+
+            if (ts_q.pages_left == 0) return 1;
+            ts_q.pages_left--;
+            ts_q.page = (ts_q.page + 1) % log->pages;
+            if (!TS_PageValid(log, ts_q.page)) continue;
+            hdr      = TS_PageHdr(log, ts_q.page);
+            ts_q.seq = hdr[1];
+            ts_q.t   = hdr[2];
+            ts_q.off = TS_PAGE_HDR;
+            memset(ts_q.prev_min, 0, sizeof(ts_q.prev_min));
+        }
+        if (TS_PageHdr(log, ts_q.page)[1] != ts_q.seq || // 页已被改写
+            TS_PageNext(log, ts_q.page, &ts_q.off, &ts_q.t, ts_q.prev_min, b)) {
+            ts_q.off = 0;
+            continue;
+        }
+        return 0;
+    }
+}
+
+/**
+ * @brief  开始一次查询
+ * @param  tier     层级
+ * @param  from_min 起始时间（分钟）
+ * @param  to_min   结束时间（分钟）
+ * @return 0：已开始，1：参数错误
+ */
+uint8_t TS_Query(uint8_t tier, uint32_t from_min, uint32_t to_min)
+{
+    if (tier >= TS_TIER_NUM || from_min > to_min) return 1;
+
+    memset(&ts_q, 0, sizeof(ts_q));
+    ts_q.tier   = tier;
+    ts_q.from   = from_min;
+    ts_q.to     = to_min;
+    ts_q.header = 1;
+    if (tier == TS_TIER_MIN) {
+        ts_q.pos = ts_ring_tail;
+        ts_q.t   = ts_tail_t;
+        memcpy(ts_q.prev_min, ts_tail_min, sizeof(ts_q.prev_min));
+    } else {
+        ts_q.page       = ts_log[tier].page; // 从当前页的下一页（最旧）开始，最后是当前页
+        ts_q.pages_left = ts_log[tier].pages;
+    }
+    ts_q.active = 1;
+    return 0;
+}
+
+/**
+ * @brief  推进查询输出，只写发送缓冲区放得下的行
+ */
+static void TS_QueryPoll(void)
+{
+    char line[TS_LINE_MAX];
+    TS_Bucket_t b;
+    uint8_t scanned, s;
+    int n;
+
+    if (!ts_q.active || UART3_TxFree() < TS_LINE_MAX) return;
+
+    if (ts_q.header) {
+        sprintf(line, "# ts tier=%c now=%lu\r\n", ts_tier_name[ts_q.tier], (unsigned long)(TS_Now() / 60));
+        UART3_SendString(line);
+        ts_q.header = 0;
+    }
+
+    for (scanned = 0; scanned < TS_SCAN_PER_POLL && UART3_TxFree() >= TS_LINE_MAX; scanned++) {
+        if (TS_QueryNext(&b)) {
+            sprintf(line, "END %u\r\n", ts_q.lines);
+            UART3_SendString(line);
+            ts_q.active = 0;
+            return;
+        }
+        if (b.t < ts_q.from || b.t > ts_q.to) continue;
+
+        n = sprintf(line, "%lu", (unsigned long)b.t);
+        for (s = 0; s < TS_SERIES_NUM; s++) {
+            n += sprintf(line + n, ",%lu,%u,%u,%lu", (unsigned long)b.agg[s].count, b.agg[s].min, b.agg[s].max,
+                         (unsigned long)b.agg[s].sum);
+        }
+        strcpy(line + n, "\r\n");
+        UART3_SendString(line);
+        ts_q.lines++;
+    }
+}
+
+/**
+ * @brief  周期服务
+ * @param  无
+ * @return 无
+ */
+void TS_Poll(void)
+{
+    uint32_t now_min = TS_Now() / 60;
+
+    if (now_min != ts_open[TS_TIER_MIN].t) TS_Roll(now_min);
+    TS_QueryPoll();
+}
+
+/**
+ * @brief  解析时间参数：绝对分钟数，或"-N"表示N分钟之前
+ */
+static uint32_t TS_ParseTime(const char *s, uint32_t def)
+{
+    uint32_t now_min = TS_Now() / 60;
+    uint32_t v;
+
+    if (s == NULL) return def;
+    if (s[0] == '-') {
+        v = strtoul(s + 1, NULL, 0);
+        return (v < now_min) ? now_min - v : 0;
+    }
+    return strtoul(s, NULL, 0);
+}
+
+/**
+ * @brief  处理串口3命令
+ * @param  cmd  命令
+ * @param  args 参数字符串
+ * @return 0：已处理，1：不是本模块的命令
+ */
+uint8_t TS_Command(char *cmd, char *args)
+{
+    char *tier, *from, *to;
+    uint8_t t;
+
+    if (strcmp(cmd, "ts") != 0) return 1;
+
+    tier = (args != NULL) ? strtok(args, " \t") : NULL;
+    from = (tier != NULL) ? strtok(NULL, " \t") : NULL;
+    to   = (from != NULL) ? strtok(NULL, " \t") : NULL;
+    for (t = 0; t < TS_TIER_NUM && tier != NULL; t++) {
+        if (tier[0] == ts_tier_name[t] && tier[1] == '\0') break;
+    }
+    if (tier == NULL || t >= TS_TIER_NUM ||
+        TS_Query(t, TS_ParseTime(from, 0), TS_ParseTime(to, 0xFFFFFFFFUL))) {
+        UART3_SendString("ERR arg\r\n");
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file     TimeSeries.h
+ * @brief    时间序列存储（多级降采样）头文件
+ * @details  在片上保存满溢、烟雾和开盖次数的长期统计：
+ *          - 三级分辨率：1分钟（RAM环形缓冲）、1小时和1天（Flash日志）
+ *          - 每个桶对每个序列汇总 次数/最小值/最大值/总和，低一级的桶关闭时滚动汇总到高一级
+ *          - 记录为差分+变长整数编码：时间差、最小值差分、极差、总和减去最小值×次数
+ *          - 小时/天记录在桶关闭时追加到Flash，按页循环覆盖最旧的数据
+ *          - 串口3命令按范围流式输出，每次轮询只解码发送缓冲区放得下的记录
+ *          时间为2000-01-01起的分钟数，由DS1302初值和system_runtime_s推算
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __TIMESERIES_H
+#define __TIMESERIES_H
+
+#include <stdint.h>
+
+/**
+ * @brief 序列编号
+ */
+#define TS_SERIES_FILL  0 /**< 满溢千分比 */
+#define TS_SERIES_SMOKE 1 /**< 烟雾浓度（PPM） */
+#define TS_SERIES_LID   2 /**< 开盖，每次开盖记一个值为1的样本，次数即开盖次数 */
+#define TS_SERIES_NUM   3
+
+/**
+ * @brief 分辨率层级
+ */
+#define TS_TIER_MIN  0 /**< 1分钟，RAM */
+#define TS_TIER_HOUR 1 /**< 1小时，Flash */
+#define TS_TIER_DAY  2 /**< 1天，Flash */
+#define TS_TIER_NUM  3
+
+/**
+ * @brief 存储容量
+ * @note  Flash区域位于参数存储（最后两页）之前，共6页，程序不得超过0x0800E000（链接脚本代码区为56KB）
+ */
+#define TS_RING_BYTES       1536         /**< 分钟层RAM环形缓冲（约1.5小时） */
+#define TS_FLASH_PAGE_SIZE  1024         /**< Flash页大小 */
+#define TS_HOUR_FLASH_ADDR  0x0800E000UL /**< 小时层日志起始地址 */
+#define TS_HOUR_FLASH_PAGES 4            /**< 小时层日志页数（约8天） */
+#define TS_DAY_FLASH_ADDR   0x0800F000UL /**< 天层日志起始地址 */
+#define TS_DAY_FLASH_PAGES  2            /**< 天层日志页数（约2个月） */
+#define TS_FLASH_MAGIC      0x7531       /**< 页头标识 */
+#define TS_FLASH_VERSION    1            /**< 记录格式版本 */
+
+/**
+ * @brief 单个序列在一个桶内的汇总
+ */
+typedef struct
+{
+    uint32_t count; /**< 样本数 */
+    uint32_t sum;   /**< 总和 */
+    uint16_t min;   /**< 最小值，count为0时无效 */
+    uint16_t max;   /**< 最大值，count为0时无效 */
+} TS_Agg_t;
+
+/**
+ * @brief 一个时间桶
+ */
+typedef struct
+{
+    uint32_t t;                   /**< 桶起始时间（2000-01-01起的分钟数） */
+    TS_Agg_t agg[TS_SERIES_NUM];  /**< 各序列汇总 */
+} TS_Bucket_t;
+
+/**
+ * @brief  初始化
+ * @details 设定时间基准，从Flash恢复小时/天日志的写入位置
+ * @param  epoch_s 当前时刻（2000-01-01起的秒数），0表示时钟未设置（从0开始计时）
+ * @return 无
+ */
+void TS_Init(uint32_t epoch_s);
+
+/**
+ * @brief  获取当前时刻
+ * @return 2000-01-01起的秒数
+ */
+uint32_t TS_Now(void);
+
+/**
+ * @brief  加入一个样本到当前分钟桶
+ * @param  series 序列编号 TS_SERIES_x
+ * @param  value  样本值；单个天桶内总和不得超过2^32
+ * @return 无
+ */
+void TS_Add(uint8_t series, uint16_t value);
+
+/**
+ * @brief  周期服务
+ * @details 关闭到期的分钟/小时/天桶并滚动汇总、写入Flash，
+ *          推进正在进行的查询输出；在主循环中调用
+ * @param  无
+ * @return 无
+ */
+void TS_Poll(void);
+
+/**
+ * @brief  开始一次查询
+ * @details 结果由TS_Poll逐行输出到串口3：
+ *          "# ts tier=<m|h|d> now=<分钟>"，每个记录一行
+ *          "<分钟>,<次数>,<最小>,<最大>,<总和>,..."（按序列编号依次排列），
+ *          最后一行"END <行数>"；新查询会中止未完成的查询
+ * @param  tier     层级 TS_TIER_x
+ * @param  from_min 起始时间（分钟，含）
+ * @param  to_min   结束时间（分钟，含）
+ * @return 0：已开始，1：参数错误
+ */
+uint8_t TS_Query(uint8_t tier, uint32_t from_min, uint32_t to_min);
+
+/**
+ * @brief  处理串口3命令 "ts <m|h|d> [起始分钟] [结束分钟]"
+ * @details 供Config_SetCmdHook注册
+ * @param  cmd  命令
+ * @param  args 命令之后的参数字符串，可为NULL
+ * @return 0：已处理，1：不是本模块的命令
+ */
+uint8_t TS_Command(char *cmd, char *args);
+
+#endif /* __TIMESERIES_H */
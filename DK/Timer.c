@@ -2,7 +2,9 @@
  * @file     Timer.c
  * @brief    定时器驱动程序
  * @details  实现系统定时功能：
- *          - 1ms基本定时
+ *          - 10us节拍（TIM4，SRAM中运行）：超声波计时、OLED后台刷新、蜂鸣器方波、Modbus帧间隔
+ *          - 1ms基本定时（TIM4每100拍）
+ *          - 1ms后台任务（SysTick，最低优先级）：提示引擎和压缩机状态机
  *          - 系统运行时间计数
  *          - 软件延时功能
  *          - 各种模式的定时控制
@@ -19,16 +21,17 @@
 uint32_t TimingDelay       = 0; /**< 软件延时计数器 */
 uint32_t system_runtime_s  = 0; /**< 系统运行时间（秒） */
 uint32_t system_runtime_ms = 0; /**< 系统运行时间（毫秒） */
-extern u16 time;                /**< 超声波计数 */
+extern volatile u16 time;       /**< 超声波计数 */
 
 /**
  * @brief  定时器初始化
- * @details 配置TIM4为1ms定时中断：
+ * @details 配置TIM4为10us定时中断，SysTick为1ms定时中断：
  *         1. 使能定时器时钟
  *         2. 配置定时器基本参数：
  *            - 72MHz / 72 = 1MHz 计数频率
- *            - 1MHz / 1000 = 1KHz 中断频率
+ *            - 1MHz / 10 = 100KHz 中断频率
  *         3. 配置NVIC中断优先级
+ *         4. SysTick按处理器时钟每1ms中断一次，优先级最低，不推迟TIM4节拍（见stm32f10x_it.c）
  * @param  无
  * @return 无
  */
@@ -64,21 +67,28 @@ void Timer_Init(void)
 
     /*使能定时器*/
     TIM_Cmd(TIM4, ENABLE);
+
+    /*1ms后台任务*/
+    SysTick_Config(SystemCoreClock / 1000); // 同时设为最低优先级
 }
 
 /**
  * @brief  定时器中断服务函数
- * @details 每1ms触发一次中断：
- *         1. 更新系统运行时间
- *         2. 处理软件延时计数
- *         3. 更新各种定时器计数值
- *         4. 设置定时更新标志
- * @note   此函数会被硬件自动调用
+ * @details 每10us触发一次中断：
+ *         1. 更新系统运行时间（每1ms）
+ *         2. 处理软件延时计数（每1ms）
+ *         3. Modbus帧间隔检测（每100us）
+ *         4. OLED后台刷新和无源蜂鸣器方波
+ *         5. 超声波计数
+ *         提示引擎和压缩机状态机每1ms在SysTick中断中推进，不在此处调用
+ * @note   此函数会被硬件自动调用；每10us一次，放在SRAM中运行
  */
-void TIM4_IRQHandler(void)
+RAMFUNC void TIM4_IRQHandler(void)
 {
-    if (TIM_GetITStatus(TIM4, TIM_IT_Update) == SET) {
-        TIM_ClearITPendingBit(TIM4, TIM_IT_Update); // 清除中断标志位
+    /* 直接访问寄存器（同TIM_GetITStatus/TIM_ClearITPendingBit）；
+       调用的UART3_Tick、OLED_Tick、Buzzer_Tick同样放在SRAM中，只直接读写寄存器 */
+    if ((TIM4->SR & TIM_SR_UIF) && (TIM4->DIER & TIM_DIER_UIE)) {
+        TIM4->SR = (uint16_t)~TIM_SR_UIF; // 清除中断标志位
 
         // 更新系统运行时间（每100次10us = 1ms）
         static uint16_t us_count = 0;
@@ -98,6 +108,10 @@ void TIM4_IRQHandler(void)
             }
         }
 
+        if (us_count % 10 == 0) UART3_Tick(); // Modbus帧间隔检测（100us）
+        OLED_Tick();                          // OLED后台刷新，每次一位
+        Buzzer_Tick();                        // 无源蜂鸣器方波
+
         time++; // 超声波计数
     }
 }
@@ -26,7 +26,7 @@ extern uint8_t update_flag;        /**< 定时更新标志 */
 
 /**
  * @brief  定时器初始化
- * @details 配置TIM4为1ms定时中断
+ * @details 配置TIM4为10us定时中断，SysTick为1ms定时中断
  * @param  无
  * @return 无
  */
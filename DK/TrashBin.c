@@ -0,0 +1,398 @@
+/**
+ * @file     TrashBin.c
+ * @brief    垃圾桶控制逻辑（可多实例）
+ * @details  各步骤的判定规则与原主控制程序相同：
+ *          - 接近检测每个新样本更新一次，ACTIVE时开盖，回到IDLE后延迟close_delay_ms关盖
+ *          - 红外：两个都未遮挡为空（同时重置清理计时），都遮挡为满，否则为有垃圾
+ *          - 满溢估计每个新测距样本更新一次，有回波的估计用于学习时段速率
+ *          - 烟雾分析每个新样本更新一次，看门狗阈值跟随基线（不低于smoke_ppm）
+ *          - 指示优先级：烟雾报警 > 清理超时 > 烟雾预警 > 桶满 > 正常
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "TrashBin.h"
+#include "Config.h"
+#include "TimeSeries.h"
+#include <stddef.h>
+
+/**
+ * @brief  记录一个历史样本
+ */
+static void TrashBin_Record(TrashBin_t *b, uint8_t series, uint16_t value)
+{
+    if (b->hw->record != NULL) b->hw->record(b->ctx, series, value);
+}
+
+/**
+ * @brief  烟雾看门狗是否已触发
+ */
+static uint8_t TrashBin_AwdTripped(TrashBin_t *b, uint32_t *trip_ms)
+{
+    return (b->hw->awd_tripped != NULL) ? b->hw->awd_tripped(b->ctx, trip_ms) : 0;
+}
+
+/**
+ * @brief  判断读到的样本是否尚未处理，是则记为已处理
+ * @param  seq 已处理的样本序号
+ * @return 1：新样本，0：没有新样本
+ */
+static uint8_t TrashBin_NewSample(TrashBin_t *b, uint8_t id, uint16_t *seq, const SensorSample_t *sample)
+{
+    if ((sample->quality & SENSOR_Q_NODATA) || ((b->seq_valid & (1 << id)) && sample->seq == *seq)) {
+        return 0;
+    }
+    *seq = sample->seq;
+    b->seq_valid |= (uint8_t)(1 << id);
+    return 1;
+}
+
+/**
+ * @brief  按当前参数生成接近检测参数
+ */
+static void TrashBin_PresenceConfig(const TrashBin_t *b, PresenceConfig_t *cfg)
+{
+    Presence_DefaultConfig(cfg);
+    cfg->near_mm   = (uint16_t)(b->cfg[CFG_CLOSE_CM] * 10); // 开盖距离(厘米换算为毫米)
+    cfg->open_conf = (uint8_t)b->cfg[CFG_OPEN_CONF];
+}
+
+/**
+ * @brief  按当前参数生成满溢估计参数
+ */
+static void TrashBin_FillConfig(const TrashBin_t *b, FillConfig_t *cfg)
+{
+    Fill_DefaultConfig(cfg);
+    cfg->empty_mm = (uint16_t)b->cfg[CFG_BIN_EMPTY_MM];
+    cfg->full_mm  = (uint16_t)b->cfg[CFG_BIN_FULL_MM]; // 不小于empty_mm时Fill_SetConfig保留原参数
+}
+
+/**
+ * @brief  初始化垃圾桶
+ * @param  b            垃圾桶
+ * @param  hw           硬件函数表
+ * @param  ctx          硬件回调上下文
+ * @param  cfg          运行参数数组
+ * @param  now_s        当前时间（秒）
+ * @param  epoch_base_s now_s为0时对应的本地时间（秒）
+ * @return 无
+ */
+void TrashBin_Init(TrashBin_t *b, const TrashBinHw_t *hw, void *ctx, const uint32_t *cfg, uint32_t now_s,
+                   uint32_t epoch_base_s)
+{
+    PresenceConfig_t presence_cfg;
+    FillConfig_t fill_cfg;
+    uint8_t i;
+
+    b->hw           = hw;
+    b->ctx          = ctx;
+    b->cfg          = cfg;
+    b->epoch_base_s = epoch_base_s;
+
+    b->trash_status      = TRASHBIN_EMPTY;
+    b->time_overflow     = 0;
+    b->last_cleanup_time = now_s;
+    b->smoke_alert       = 0;
+    b->smoke_prealert    = 0;
+    b->cleanup_alert     = 0;
+    b->changed           = 1;
+
+    for (i = 0; i < TRASHBIN_WINDOW; i++) {
+        b->distance[i] = 0;
+    }
+    b->distance_idx   = 0;
+    b->lid_is_open    = 0;
+    b->lid_closing    = 0;
+    b->lid_close_time = 0;
+    b->lid_open_count = 0;
+    b->seq_valid      = 0;
+    b->ttf_min        = FORECAST_UNKNOWN;
+    b->ttf_model      = FORECAST_MODEL_NONE;
+    b->awd_ppm        = (uint16_t)cfg[CFG_SMOKE_PPM]; // 与看门狗初始阈值一致
+    b->awd_dirty      = 0;
+
+    TrashBin_PresenceConfig(b, &presence_cfg);
+    Presence_Init(&b->presence, &presence_cfg);
+    Smoke_Init(&b->smoke, NULL); // 烟雾分析从预热开始
+    TrashBin_FillConfig(b, &fill_cfg);
+    Fill_Init(&b->fill, &fill_cfg);
+    Forecast_Init(&b->forecast); // 时段速率从头学习
+}
+
+/**
+ * @brief  运行参数被修改后重新加载
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_ApplyConfig(TrashBin_t *b)
+{
+    PresenceConfig_t presence_cfg;
+    FillConfig_t fill_cfg;
+
+    TrashBin_PresenceConfig(b, &presence_cfg);
+    Presence_SetConfig(&b->presence, &presence_cfg);
+    TrashBin_FillConfig(b, &fill_cfg);
+    Fill_SetConfig(&b->fill, &fill_cfg);
+    b->awd_dirty = 1; // 阈值或R0修改后重新换算看门狗阈值
+}
+
+/**
+ * @brief  处理新的接近检测样本，自动开关盖
+ * @param  b      垃圾桶
+ * @param  now_ms 当前时间（毫秒）
+ * @return 无
+ */
+void TrashBin_HandleLid(TrashBin_t *b, uint32_t now_ms)
+{
+    SensorSample_t sample, top;
+    PresenceInput_t in;
+
+    b->hw->read(b->ctx, SENSOR_ID_SONAR, &sample);
+    if (TrashBin_NewSample(b, SENSOR_ID_SONAR, &b->sonar_seq, &sample)) { // 每个新样本更新一次接近检测
+        in.range_valid = !(sample.quality & SENSOR_Q_TIMEOUT);
+        in.range_mm    = in.range_valid ? (uint16_t)sample.value : 0;
+        in.t_ms        = sample.timestamp;
+
+        // 红外传感器返回值：0-被遮挡，1-未遮挡
+        in.ir_top_blocked = (b->hw->read(b->ctx, SENSOR_ID_IR_TOP, &top) == SENSOR_Q_OK) && (top.value == 0);
+
+        if (in.range_valid) { // 将新的数据存入滑动窗口，用于显示
+            b->distance[b->distance_idx] = in.range_mm;
+            b->distance_idx              = (b->distance_idx + 1) % TRASHBIN_WINDOW;
+        }
+
+        if (Presence_Update(&b->presence, &in) == PRESENCE_ACTIVE) {
+            if (b->hw->lid(b->ctx, 1)) { // 开盖被拒绝时保持关盖状态，下一个样本重试
+                if (!b->lid_is_open) {   // 记录一次开盖
+                    TrashBin_Record(b, TS_SERIES_LID, 1);
+                    b->lid_open_count++;
+                }
+                b->lid_is_open = 1;
+            }
+            b->lid_closing = 0; // 取消已计划的关盖
+        } else if (b->lid_is_open && !b->lid_closing) {
+            b->lid_close_time = now_ms + b->cfg[CFG_CLOSE_DELAY_MS]; // 设置延迟关闭时间
+            b->lid_closing    = 1;
+        }
+    }
+
+    // 检查是否需要关闭垃圾桶盖
+    if (b->lid_closing && now_ms >= b->lid_close_time) {
+        b->hw->lid(b->ctx, 0);
+        b->lid_is_open = 0;
+        b->lid_closing = 0;
+    }
+}
+
+/**
+ * @brief  每个新的满溢测距样本更新一次满溢估计和预测
+ */
+static void TrashBin_UpdateFill(TrashBin_t *b, uint32_t now_s, uint8_t ir_bottom_blocked, uint8_t ir_top_blocked)
+{
+    SensorSample_t sample;
+    FillInput_t in;
+    uint32_t local_s = b->epoch_base_s + now_s;
+
+    b->hw->read(b->ctx, SENSOR_ID_FILL, &sample);
+    if (!TrashBin_NewSample(b, SENSOR_ID_FILL, &b->fill_seq, &sample)) return;
+
+    in.t_ms              = sample.timestamp;
+    in.range_valid       = !(sample.quality & SENSOR_Q_TIMEOUT);
+    in.range_mm          = in.range_valid ? (uint16_t)sample.value : 0;
+    in.ir_bottom_blocked = ir_bottom_blocked;
+    in.ir_top_blocked    = ir_top_blocked;
+    Fill_Update(&b->fill, &in);
+    if (Fill_GetConfidence(&b->fill) > 0) TrashBin_Record(b, TS_SERIES_FILL, Fill_GetPermille(&b->fill));
+
+    // 只用有回波的估计学习时段速率（红外区间中点跳变大）；预测每个样本刷新一次
+    if (in.range_valid) Forecast_Update(&b->forecast, local_s, Fill_GetPermille(&b->fill));
+    b->ttf_min = Forecast_TimeToFull(&b->forecast, local_s, Fill_GetPermille(&b->fill), TRASHBIN_FILL_TARGET_PM,
+                                     Fill_GetRate(&b->fill), &b->ttf_model);
+    b->changed = 1;
+}
+
+/**
+ * @brief  处理红外空满状态和满溢测距
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 无
+ */
+void TrashBin_ProcessSensors(TrashBin_t *b, uint32_t now_s)
+{
+    SensorSample_t bottom, top;
+    uint8_t bottom_sensor, top_sensor, old_status;
+
+    b->hw->read(b->ctx, SENSOR_ID_IR_BOTTOM, &bottom);
+    b->hw->read(b->ctx, SENSOR_ID_IR_TOP, &top);
+    if ((bottom.quality | top.quality) & SENSOR_Q_NODATA) {
+        return; // 尚未采样
+    }
+
+    bottom_sensor = (uint8_t)bottom.value; // 底部传感器
+    top_sensor    = (uint8_t)top.value;    // 顶部传感器
+    old_status    = b->trash_status;
+
+    // 红外传感器返回值：0-被遮挡，1-未遮挡
+    if (bottom_sensor && top_sensor) {
+        b->trash_status      = TRASHBIN_EMPTY; // 两个传感器都未被遮挡，垃圾桶空
+        b->last_cleanup_time = now_s;          // 重置清理计时器
+    } else if (!bottom_sensor && !top_sensor) {
+        b->trash_status = TRASHBIN_FULL; // 两个传感器都被遮挡，垃圾桶已满
+    } else {
+        b->trash_status = TRASHBIN_SOME; // 一个被遮挡，有垃圾
+    }
+
+    if (old_status != b->trash_status) {
+        b->changed = 1;
+    }
+
+    TrashBin_UpdateFill(b, now_s, !bottom_sensor, !top_sensor);
+}
+
+/**
+ * @brief  看门狗阈值跟随烟雾基线（不低于smoke_ppm），环境漂移时不误触发
+ */
+static void TrashBin_UpdateWatchdog(TrashBin_t *b)
+{
+    uint16_t ppm = Smoke_GetBaseline(&b->smoke) + SMOKE_ALARM_EXCESS_PPM;
+
+    if (ppm < b->cfg[CFG_SMOKE_PPM]) ppm = (uint16_t)b->cfg[CFG_SMOKE_PPM];
+    if (b->awd_dirty || ppm >= b->awd_ppm + TRASHBIN_SMOKE_AWD_STEP_PPM ||
+        ppm + TRASHBIN_SMOKE_AWD_STEP_PPM <= b->awd_ppm) {
+        if (b->hw->awd_set != NULL) b->hw->awd_set(b->ctx, ppm);
+        b->awd_ppm   = ppm;
+        b->awd_dirty = 0;
+    }
+}
+
+/**
+ * @brief  处理新的烟雾样本
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_CheckSmoke(TrashBin_t *b)
+{
+    SensorSample_t sample;
+    uint32_t trip_ms = 0;
+    uint8_t level;
+
+    uint8_t tripped = TrashBin_AwdTripped(b, &trip_ms); // 看门狗中断已报警
+    if (b->hw->read(b->ctx, SENSOR_ID_SMOKE, &sample) & SENSOR_Q_NODATA) {
+        if (tripped) b->smoke_alert = 1;
+        return; // 尚未采样
+    }
+
+    if (TrashBin_NewSample(b, SENSOR_ID_SMOKE, &b->smoke_seq, &sample)) { // 每个新样本更新一次烟雾分析
+        // 9999为上限钳位，浓度超量程仍按有效样本处理
+        level = Smoke_Update(&b->smoke, sample.timestamp, (uint16_t)sample.value,
+                             sample.quality == SENSOR_Q_OK || sample.value >= 9999);
+
+        if (level != SMOKE_LEVEL_WARMUP) {
+            TrashBin_Record(b, TS_SERIES_SMOKE, (uint16_t)sample.value); // 预热期读数不入库
+            TrashBin_UpdateWatchdog(b);
+            // 预热结束后使能看门狗；触发后需分析已解除报警、且触发后采集的完整平均样本已到，
+            // 才重新使能，避免报警闪断
+            if (!tripped ||
+                (level != SMOKE_LEVEL_ALARM && (int32_t)(sample.timestamp - trip_ms) > b->hw->awd_settle_ms)) {
+                if (b->hw->awd_rearm != NULL && b->hw->awd_rearm(b->ctx)) tripped = 0;
+            }
+        }
+        b->changed = 1;
+    }
+
+    level             = Smoke_GetLevel(&b->smoke);
+    b->smoke_alert    = tripped || level == SMOKE_LEVEL_ALARM;
+    b->smoke_prealert = level == SMOKE_LEVEL_PRE;
+}
+
+/**
+ * @brief  获取距上次清理的时间
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 秒数
+ */
+uint32_t TrashBin_TimeSinceCleanup(const TrashBin_t *b, uint32_t now_s)
+{
+    if (b->time_overflow) {
+        return (UINT32_MAX - b->last_cleanup_time) + now_s;
+    }
+    return now_s - b->last_cleanup_time;
+}
+
+/**
+ * @brief  检查清理超时
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 无
+ */
+void TrashBin_CheckCleanup(TrashBin_t *b, uint32_t now_s)
+{
+    if (now_s < b->last_cleanup_time) {
+        b->time_overflow = 1;
+    }
+
+    // 仅在垃圾桶非空时检查超时
+    if (b->trash_status != TRASHBIN_EMPTY) {
+        b->cleanup_alert = (TrashBin_TimeSinceCleanup(b, now_s) >= b->cfg[CFG_CLEANUP_S]);
+    } else {
+        b->cleanup_alert = 0;
+    }
+    b->changed = 1; // 需要更新显示时间
+}
+
+/**
+ * @brief  声明当前成立的提示，播放哪个由提示引擎按优先级选择
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_UpdateIndicators(TrashBin_t *b)
+{
+    uint16_t alarms = 0;
+
+    // 看门狗可能在CheckSmoke之后才触发，这里再检查一次，避免把中断设置的报警请求取消
+    if (b->smoke_alert || TrashBin_AwdTripped(b, NULL)) alarms |= ANNUN_BIT(ANNUN_ID_SMOKE);
+    if (b->cleanup_alert) alarms |= ANNUN_BIT(ANNUN_ID_CLEANUP);
+    if (b->smoke_prealert) alarms |= ANNUN_BIT(ANNUN_ID_PREALERT);
+
+    if (b->trash_status == TRASHBIN_EMPTY) {
+        alarms |= ANNUN_BIT(ANNUN_ID_EMPTY);
+    } else if (b->trash_status == TRASHBIN_SOME) {
+        alarms |= ANNUN_BIT(ANNUN_ID_SOME);
+    } else {
+        alarms |= ANNUN_BIT(ANNUN_ID_FULL);
+    }
+    b->hw->indicate(b->ctx, alarms); // 优先级由提示引擎决定
+}
+
+/**
+ * @brief  运行一个控制周期
+ * @param  b      垃圾桶
+ * @param  now_ms 当前时间（毫秒）
+ * @param  now_s  当前时间（秒）
+ * @return 无
+ */
+void TrashBin_Step(TrashBin_t *b, uint32_t now_ms, uint32_t now_s)
+{
+    TrashBin_HandleLid(b, now_ms);
+    TrashBin_ProcessSensors(b, now_s);
+    TrashBin_CheckSmoke(b);
+    TrashBin_CheckCleanup(b, now_s);
+    TrashBin_UpdateIndicators(b);
+}
+
+/**
+ * @brief  获取接近检测的平均距离
+ * @param  b 垃圾桶
+ * @return 距离（毫米）
+ */
+uint16_t TrashBin_GetLidDistance(const TrashBin_t *b)
+{
+    uint32_t sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < TRASHBIN_WINDOW; i++) {
+        sum += b->distance[i];
+    }
+    return (uint16_t)(sum / TRASHBIN_WINDOW);
+}
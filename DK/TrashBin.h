@@ -0,0 +1,209 @@
+/**
+ * @file     TrashBin.h
+ * @brief    垃圾桶控制逻辑（可多实例）头文件
+ * @details  把原主控制程序中的状态和判定逻辑集中到一个垃圾桶上下文TrashBin_t中：
+ *          - 自动开关盖（接近检测）、红外空满状态、满溢估计与预测、
+ *            烟雾分析与报警、清理超时、指示灯/蜂鸣器提示请求
+ *          - 所有状态都在上下文中，函数可重入，同一进程可同时运行任意多个垃圾桶
+ *          - 硬件通过TrashBinHw_t函数表接入：读传感器样本、开关盖、指示灯/蜂鸣器，
+ *            可选的历史记录和烟雾看门狗；多个实例可共用一张函数表，用ctx区分
+ *          - 时间由调用者传入（毫秒、秒两个计数），不读取系统时钟
+ *          固件中为唯一的一个实例（见DK_C8T6.c），主机上可用模拟驱动批量运行；
+ *          每个实例约430字节
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __TRASHBIN_H
+#define __TRASHBIN_H
+
+#include <stdint.h>
+#include "SensorHub.h"
+#include "Presence.h"
+#include "SmokeAnalytics.h"
+#include "FillLevel.h"
+#include "FillForecast.h"
+#include "Annunciator.h"
+
+/**
+ * @brief 垃圾桶状态
+ */
+#define TRASHBIN_EMPTY 0 /**< 空 */
+#define TRASHBIN_SOME  1 /**< 有垃圾 */
+#define TRASHBIN_FULL  2 /**< 已满 */
+
+/**
+ * @brief 参数
+ */
+#define TRASHBIN_WINDOW             5    /**< 接近检测距离滑动平均窗口（用于显示） */
+#define TRASHBIN_FILL_TARGET_PM     1000 /**< 满溢预测目标（千分比），即满溢线 */
+#define TRASHBIN_SMOKE_AWD_STEP_PPM 10   /**< 烟雾看门狗阈值变化达到此值才重新写入 */
+
+/**
+ * @brief 硬件函数表
+ * @details 可选回调为NULL时对应功能不执行
+ */
+typedef struct
+{
+    /**
+     * @brief 读取传感器最新样本（约定同SensorHub_Read）
+     * @param id 传感器编号 SENSOR_ID_x
+     * @return 样本质量标志 SENSOR_Q_x
+     */
+    uint8_t (*read)(void *ctx, uint8_t id, SensorSample_t *out);
+    /**
+     * @brief 开盖/关盖，接近检测保持开盖期间每个样本调用一次
+     * @return 盖子是否处于打开状态；开盖被拒绝（如压板不在原位）时返回0，
+     *         不计开盖次数，下一个有人样本再次请求
+     */
+    uint8_t (*lid)(void *ctx, uint8_t open);
+    /**
+     * @brief 声明当前的提示，每次TrashBin_UpdateIndicators调用一次
+     * @param alarms 成立的提示 ANNUN_BIT(ANNUN_ID_x) 组合，选哪个播放由提示引擎按优先级决定
+     */
+    void (*indicate)(void *ctx, uint16_t alarms);
+    /**
+     * @brief 记录一个历史样本（可选）
+     * @param series 序列编号 TS_SERIES_x
+     */
+    void (*record)(void *ctx, uint8_t series, uint16_t value);
+    /**
+     * @brief 烟雾看门狗是否已触发报警（可选）
+     * @param trip_ms 输出触发时刻，可为NULL
+     */
+    uint8_t (*awd_tripped)(void *ctx, uint32_t *trip_ms);
+    /**
+     * @brief 使能/重新使能烟雾看门狗（可选），返回0表示仍超限未使能
+     */
+    uint8_t (*awd_rearm)(void *ctx);
+    /**
+     * @brief 修改烟雾看门狗阈值（可选）
+     */
+    void (*awd_set)(void *ctx, uint16_t ppm);
+    uint16_t awd_settle_ms; /**< 看门狗触发后，需再等一个完整平均样本才重新使能 */
+} TrashBinHw_t;
+
+/**
+ * @brief 垃圾桶上下文
+ */
+typedef struct
+{
+    const TrashBinHw_t *hw; /**< 硬件函数表 */
+    void *ctx;              /**< 硬件回调上下文 */
+    const uint32_t *cfg;    /**< 运行参数，按CFG_x索引 */
+    uint32_t epoch_base_s;  /**< now_s为0时对应的本地时间（秒），用于满溢时段学习 */
+
+    Presence_t presence; /**< 接近检测 */
+    Smoke_t smoke;       /**< 烟雾分析 */
+    Fill_t fill;         /**< 满溢估计 */
+    Forecast_t forecast; /**< 满溢预测 */
+
+    uint8_t trash_status;       /**< TRASHBIN_EMPTY/SOME/FULL */
+    uint8_t time_overflow;      /**< 秒计数溢出标志 */
+    uint32_t last_cleanup_time; /**< 上次清理时间（秒） */
+    uint8_t smoke_alert;        /**< 烟雾报警 */
+    uint8_t smoke_prealert;     /**< 烟雾预警 */
+    uint8_t cleanup_alert;      /**< 清理超时报警 */
+    uint8_t changed;            /**< 状态有变化，需要刷新显示（由使用者清除） */
+
+    uint16_t distance[TRASHBIN_WINDOW]; /**< 接近检测最近的有效距离（毫米） */
+    uint8_t distance_idx;               /**< 距离窗口写入位置 */
+    uint8_t lid_is_open;                /**< 盖子是否由接近检测打开 */
+    uint8_t lid_closing;                /**< 是否在等待延迟关盖 */
+    uint32_t lid_close_time;            /**< 预定关盖时刻（毫秒） */
+    uint32_t lid_open_count;            /**< 开盖次数 */
+
+    uint16_t sonar_seq; /**< 已处理的接近检测样本序号 */
+    uint16_t fill_seq;  /**< 已处理的满溢测距样本序号 */
+    uint16_t smoke_seq; /**< 已送入烟雾分析的样本序号 */
+    uint8_t seq_valid;  /**< 以上序号是否有效，按传感器编号的位 */
+    uint16_t ttf_min;   /**< 预计装满剩余时间（分钟） */
+    uint8_t ttf_model;  /**< 预测使用的模型 FORECAST_MODEL_x */
+    uint16_t awd_ppm;   /**< 当前烟雾看门狗阈值（PPM） */
+    uint8_t awd_dirty;  /**< 参数已修改，看门狗阈值需要重新写入 */
+} TrashBin_t;
+
+/**
+ * @brief  初始化垃圾桶（空桶、烟雾分析从预热开始、满溢预测从头学习）
+ * @param  b            垃圾桶
+ * @param  hw           硬件函数表
+ * @param  ctx          硬件回调上下文
+ * @param  cfg          运行参数数组（CFG_NUM个，按CFG_x索引），由使用者保持有效
+ * @param  now_s        当前时间（秒）
+ * @param  epoch_base_s now_s为0时对应的本地时间（秒）
+ * @return 无
+ */
+void TrashBin_Init(TrashBin_t *b, const TrashBinHw_t *hw, void *ctx, const uint32_t *cfg, uint32_t now_s,
+                   uint32_t epoch_base_s);
+
+/**
+ * @brief  运行参数被修改后调用，重新加载接近检测、满溢估计和看门狗阈值
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_ApplyConfig(TrashBin_t *b);
+
+/**
+ * @brief  处理新的接近检测样本，自动开关盖
+ * @param  b      垃圾桶
+ * @param  now_ms 当前时间（毫秒）
+ * @return 无
+ */
+void TrashBin_HandleLid(TrashBin_t *b, uint32_t now_ms);
+
+/**
+ * @brief  处理红外空满状态和新的满溢测距样本，更新满溢估计和预测
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 无
+ */
+void TrashBin_ProcessSensors(TrashBin_t *b, uint32_t now_s);
+
+/**
+ * @brief  处理新的烟雾样本，更新报警/预警状态
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_CheckSmoke(TrashBin_t *b);
+
+/**
+ * @brief  检查清理超时
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 无
+ */
+void TrashBin_CheckCleanup(TrashBin_t *b, uint32_t now_s);
+
+/**
+ * @brief  声明当前成立的提示（报警和空满状态）
+ * @param  b 垃圾桶
+ * @return 无
+ */
+void TrashBin_UpdateIndicators(TrashBin_t *b);
+
+/**
+ * @brief  运行一个控制周期（依次执行以上各步骤）
+ * @param  b      垃圾桶
+ * @param  now_ms 当前时间（毫秒）
+ * @param  now_s  当前时间（秒）
+ * @return 无
+ */
+void TrashBin_Step(TrashBin_t *b, uint32_t now_ms, uint32_t now_s);
+
+/**
+ * @brief  获取距上次清理的时间
+ * @param  b     垃圾桶
+ * @param  now_s 当前时间（秒）
+ * @return 秒数
+ */
+uint32_t TrashBin_TimeSinceCleanup(const TrashBin_t *b, uint32_t now_s);
+
+/**
+ * @brief  获取接近检测的平均距离
+ * @param  b 垃圾桶
+ * @return 距离（毫米）
+ */
+uint16_t TrashBin_GetLidDistance(const TrashBin_t *b);
+
+#endif /* __TRASHBIN_H */
@@ -3,8 +3,10 @@
  * @brief    串口3通信模块驱动程序
  * @details  实现基于USART3的串口通信功能，包括：
  *          - 串口初始化（支持可调波特率）
- *          - 数据发送功能
- *          - 数据接收及回显功能
+ *          - 数据发送功能（中断驱动的环形缓冲区）
+ *          - 数据接收及回显功能（按行接收）
+ *          - Modbus RTU模式：DMA收发整帧，3.5字符静默间隔由定时器判定帧结束，
+ *            RS-485收发方向由DE引脚控制，发送完成中断中切回接收
  * @author   DikiFive
  * @date     2025-05-06
  * @version  v1.0
@@ -18,12 +20,54 @@ uint8_t UART3_RxBuffer[UART3_RX_BUFFER_SIZE];
 /** @brief 串口3接收计数器 */
 uint16_t UART3_RxCount = 0;
 
+/** @brief 发送环形缓冲区，head由写入方推进，tail由TXE中断推进 */
+static uint8_t uart3_tx_buf[UART3_TX_BUFFER_SIZE];
+static volatile uint16_t uart3_tx_head = 0;
+static volatile uint16_t uart3_tx_tail = 0;
+/** @brief 已收到完整的一行，取走前不再接收新数据 */
+static volatile uint8_t uart3_line_ready = 0;
+
+/** @brief Modbus模式：DMA交替写入两个帧缓冲区，一帧结束后立即切换，主循环取走另一个 */
+static uint8_t uart3_mb = 0;
+static uint8_t uart3_frame[2][UART3_FRAME_SIZE];
+static uint8_t uart3_frame_tx[UART3_FRAME_SIZE];
+static uint8_t uart3_rx_idx              = 0; /**< DMA正在写入的缓冲区 */
+static volatile uint8_t uart3_frame_idx  = 0; /**< 已完成帧所在缓冲区 */
+static volatile uint16_t uart3_frame_len = 0; /**< 已完成帧长度，0表示没有 */
+static uint16_t uart3_rx_remain          = UART3_FRAME_SIZE; /**< 上次检查时DMA剩余计数 */
+static uint16_t uart3_silence            = 0; /**< 静默时间（100us） */
+static uint16_t uart3_t35                = 0; /**< 3.5字符时间（100us） */
+static volatile uint8_t uart3_tx_busy    = 0;
+
 /**
- * @brief  串口3初始化
- * @param  baudRate 波特率设置
- * @return 无
+ * @brief  向发送缓冲区写入一个字节
+ * @note   主循环和接收中断（回显）都会写入，以短临界区保护head
+ * @param  data 要发送的字节
+ * @return 0：成功，1：缓冲区满
  */
-void UART3_Init(uint32_t baudRate)
+static uint8_t UART3_TxPut(uint8_t data)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint16_t next;
+
+    __disable_irq();
+    next = (uart3_tx_head + 1) & (UART3_TX_BUFFER_SIZE - 1);
+    if (next == uart3_tx_tail) {
+        __set_PRIMASK(primask);
+        return 1;
+    }
+    uart3_tx_buf[uart3_tx_head] = data;
+    uart3_tx_head               = next;
+    __set_PRIMASK(primask);
+
+    USART_ITConfig(USART3, USART_IT_TXE, ENABLE); // 启动发送
+    return 0;
+}
+
+/**
+ * @brief  串口3引脚、USART和中断配置
+ */
+static void UART3_PortInit(uint32_t baudRate, uint16_t wordLength, uint16_t parity)
 {
     /* 开启时钟 */
     RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART3, ENABLE); // USART3在APB1总线
@@ -46,14 +90,12 @@ void UART3_Init(uint32_t baudRate)
     USART_InitStructure.USART_BaudRate            = baudRate;
     USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
     USART_InitStructure.USART_Mode                = USART_Mode_Tx | USART_Mode_Rx;
-    USART_InitStructure.USART_Parity              = USART_Parity_No;
+    USART_InitStructure.USART_Parity              = parity;
     USART_InitStructure.USART_StopBits            = USART_StopBits_1;
-    USART_InitStructure.USART_WordLength          = USART_WordLength_8b;
+    USART_InitStructure.USART_WordLength          = wordLength;
     USART_Init(USART3, &USART_InitStructure);
 
     /* 中断配置 */
-    USART_ITConfig(USART3, USART_IT_RXNE, ENABLE);
-
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
 
     NVIC_InitTypeDef NVIC_InitStructure;
@@ -62,20 +104,182 @@ void UART3_Init(uint32_t baudRate)
     NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
     NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 2;
     NVIC_Init(&NVIC_InitStructure);
+}
 
-    /* USART使能 */
+/**
+ * @brief  串口3初始化（命令行模式）
+ * @param  baudRate 波特率设置
+ * @return 无
+ */
+void UART3_Init(uint32_t baudRate)
+{
+    UART3_PortInit(baudRate, USART_WordLength_8b, USART_Parity_No);
+    USART_ITConfig(USART3, USART_IT_RXNE, ENABLE);
     USART_Cmd(USART3, ENABLE);
 }
 
+/**
+ * @brief  串口3初始化（Modbus RTU模式）
+ * @details 8E1帧格式；DMA1通道3接收、通道2发送；
+ *          3.5字符时间按11位字符计算，波特率高于19200时固定为1.75ms
+ * @param  baudRate 波特率设置
+ * @return 无
+ */
+void UART3_ModbusInit(uint32_t baudRate)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    /* RS-485方向控制，默认接收 */
+    RCC_APB2PeriphClockCmd(UART3_DE_GPIO_CLK, ENABLE);
+    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP;
+    GPIO_InitStructure.GPIO_Pin   = UART3_DE_PIN;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(UART3_DE_GPIO_PORT, &GPIO_InitStructure);
+    GPIO_ResetBits(UART3_DE_GPIO_PORT, UART3_DE_PIN);
+
+    UART3_PortInit(baudRate, USART_WordLength_9b, USART_Parity_Even); // 9位含校验位
+
+    /* DMA：接收为外设到内存，发送通道每帧重新设置长度 */
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&USART3->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)uart3_frame[0];
+    DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize         = UART3_FRAME_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode               = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority           = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;
+    DMA_Init(UART3_DMA_RX, &DMA_InitStructure);
+
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)uart3_frame_tx;
+    DMA_InitStructure.DMA_DIR            = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_BufferSize     = 1;
+    DMA_InitStructure.DMA_Priority       = DMA_Priority_Medium;
+    DMA_Init(UART3_DMA_TX, &DMA_InitStructure);
+
+    uart3_t35 = (baudRate > 19200) ? 18 : (uint16_t)((385000UL + baudRate - 1) / baudRate); // 38.5位，100us单位
+    uart3_rx_idx    = 0;
+    uart3_rx_remain = UART3_FRAME_SIZE;
+    uart3_silence   = 0;
+    uart3_mb        = 1;
+
+    USART_DMACmd(USART3, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE);
+    DMA_Cmd(UART3_DMA_RX, ENABLE);
+    USART_Cmd(USART3, ENABLE);
+}
+
+/**
+ * @brief  Modbus帧间隔检测
+ * @details 比较DMA剩余计数判断是否收到新字节，静默达到3.5字符时间即为帧结束，
+ *          把DMA切换到另一个缓冲区继续接收；已完成但未取走的帧被新帧覆盖
+ * @note   由TIM4中断每100us调用，与中断一起放在SRAM中运行
+ * @param  无
+ * @return 无
+ */
+RAMFUNC void UART3_Tick(void)
+{
+    uint16_t remain;
+
+    if (!uart3_mb) return;
+
+    remain = (uint16_t)UART3_DMA_RX->CNDTR;
+    if (remain != uart3_rx_remain) { // 有新字节
+        uart3_rx_remain = remain;
+        uart3_silence   = 0;
+        return;
+    }
+    if (remain == UART3_FRAME_SIZE || ++uart3_silence < uart3_t35) return;
+
+    UART3_DMA_RX->CCR &= ~DMA_CCR3_EN;
+    uart3_frame_idx = uart3_rx_idx;
+    uart3_frame_len = UART3_FRAME_SIZE - remain;
+    uart3_rx_idx ^= 1;
+    UART3_DMA_RX->CMAR  = (uint32_t)uart3_frame[uart3_rx_idx];
+    UART3_DMA_RX->CNDTR = UART3_FRAME_SIZE;
+    UART3_DMA_RX->CCR |= DMA_CCR3_EN;
+    uart3_rx_remain = UART3_FRAME_SIZE;
+    uart3_silence   = 0;
+}
+
+/**
+ * @brief  读取接收到的一帧（Modbus模式）
+ * @param  buf  输出缓冲区
+ * @param  size 输出缓冲区大小
+ * @return 帧长度，0表示没有新帧
+ */
+uint16_t UART3_ReadFrame(uint8_t *buf, uint16_t size)
+{
+    uint16_t len;
+
+    if (uart3_frame_len == 0) return 0;
+
+    __disable_irq(); // 复制期间不切换缓冲区
+    len = uart3_frame_len;
+    if (len > size) len = size;
+    memcpy(buf, uart3_frame[uart3_frame_idx], len);
+    uart3_frame_len = 0;
+    __enable_irq();
+    return len;
+}
+
+/**
+ * @brief  发送一帧（Modbus模式）
+ * @details 复制到发送缓冲区后由DMA发出，立即返回；最后一个字节移出后在中断中释放总线
+ * @param  buf 帧数据
+ * @param  len 帧长度
+ * @return 0：已开始发送，1：上一帧尚未发完或长度错误
+ */
+uint8_t UART3_SendFrame(const uint8_t *buf, uint16_t len)
+{
+    if (uart3_tx_busy || len == 0 || len > UART3_FRAME_SIZE) return 1;
+
+    memcpy(uart3_frame_tx, buf, len);
+    uart3_tx_busy = 1;
+    GPIO_SetBits(UART3_DE_GPIO_PORT, UART3_DE_PIN); // 切换为发送
+
+    UART3_DMA_TX->CCR &= ~DMA_CCR2_EN;
+    UART3_DMA_TX->CNDTR = len;
+    USART_ClearFlag(USART3, USART_FLAG_TC);
+    UART3_DMA_TX->CCR |= DMA_CCR2_EN;
+    USART_ITConfig(USART3, USART_IT_TC, ENABLE);
+    return 0;
+}
+
+/**
+ * @brief  Modbus帧是否正在发送
+ * @return 1：正在发送（总线被占用），0：空闲
+ */
+uint8_t UART3_FrameSending(void)
+{
+    return uart3_tx_busy;
+}
+
 /**
  * @brief  通过串口3发送一个字节
+ * @details 缓冲区满时等待中断发出数据；在中断中调用时缓冲区满则丢弃，避免死等
  * @param  data 要发送的字节数据
  * @return 无
  */
 void UART3_SendByte(uint8_t data)
 {
-    while (USART_GetFlagStatus(USART3, USART_FLAG_TXE) == RESET);
-    USART_SendData(USART3, data);
+    if (uart3_mb) return; // Modbus模式下总线只发送整帧
+    while (UART3_TxPut(data)) {
+        if (SCB->ICSR & SCB_ICSR_VECTACTIVE) return;
+    }
+}
+
+/**
+ * @brief  发送缓冲区剩余空间
+ * @return 可立即写入的字节数
+ */
+uint16_t UART3_TxFree(void)
+{
+    if (uart3_mb) return 0;
+    return (uart3_tx_tail - uart3_tx_head - 1) & (UART3_TX_BUFFER_SIZE - 1);
 }
 
 /**
@@ -90,28 +294,77 @@ void UART3_SendString(char *str)
     }
 }
 
+/**
+ * @brief  读取接收到的一行
+ * @param  buf  输出缓冲区
+ * @param  size 输出缓冲区大小
+ * @return 行长度，0表示没有完整的新行
+ */
+uint16_t UART3_ReadLine(char *buf, uint16_t size)
+{
+    uint16_t len;
+
+    if (!uart3_line_ready) return 0;
+
+    len = UART3_RxCount;
+    if (len >= size) len = size - 1;
+    memcpy(buf, UART3_RxBuffer, len);
+    buf[len] = '\0';
+
+    UART3_RxCount    = 0;
+    uart3_line_ready = 0; // 释放接收缓冲区
+    return len;
+}
+
 /**
  * @brief  USART3中断服务函数
- * @details 实现接收数据的回显功能
+ * @details 接收：按行存入接收缓冲区并回显，支持退格；
+ *          发送：TXE中断从环形缓冲区取数据，取空后关闭TXE中断；
+ *          Modbus模式：收发由DMA完成，只处理发送完成中断
  * @note   本函数为中断服务函数，由硬件自动调用
  * @param  无
  * @return 无
  */
-void USART3_IRQHandler(void)
+RAMFUNC void USART3_IRQHandler(void)
 {
     if (USART_GetITStatus(USART3, USART_IT_RXNE) == SET) {
-        /* 读取接收到的数据 */
+        /* 读取接收到的数据（读DR同时清除RXNE） */
         uint8_t RxData = USART_ReceiveData(USART3);
 
-        /* 存储到接收缓冲区 */
-        if (UART3_RxCount < UART3_RX_BUFFER_SIZE) {
-            UART3_RxBuffer[UART3_RxCount++] = RxData;
+        if (!uart3_line_ready) {
+            if (RxData == '\r' || RxData == '\n') {
+                if (UART3_RxCount > 0) { // 忽略空行和\r\n中的第二个字符
+                    uart3_line_ready = 1;
+                    UART3_TxPut('\r');
+                    UART3_TxPut('\n');
+                }
+            } else if (RxData == 0x08 || RxData == 0x7F) { // 退格
+                if (UART3_RxCount > 0) {
+                    UART3_RxCount--;
+                    UART3_TxPut(0x08);
+                    UART3_TxPut(' ');
+                    UART3_TxPut(0x08);
+                }
+            } else if (UART3_RxCount < UART3_RX_BUFFER_SIZE) {
+                /* 存储到接收缓冲区并回显 */
+                UART3_RxBuffer[UART3_RxCount++] = RxData;
+                UART3_TxPut(RxData);
+            }
         }
+    }
 
-        /* 回显接收到的数据 */
-        UART3_SendByte(RxData);
+    if (USART_GetITStatus(USART3, USART_IT_TXE) == SET) {
+        if (uart3_tx_tail != uart3_tx_head) {
+            USART_SendData(USART3, uart3_tx_buf[uart3_tx_tail]);
+            uart3_tx_tail = (uart3_tx_tail + 1) & (UART3_TX_BUFFER_SIZE - 1);
+        } else {
+            USART_ITConfig(USART3, USART_IT_TXE, DISABLE); // 发送完毕
+        }
+    }
 
-        /* 清除中断标志 */
-        USART_ClearITPendingBit(USART3, USART_IT_RXNE);
+    if (USART_GetITStatus(USART3, USART_IT_TC) == SET) { // Modbus帧发送完毕
+        USART_ITConfig(USART3, USART_IT_TC, DISABLE);
+        GPIO_ResetBits(UART3_DE_GPIO_PORT, UART3_DE_PIN); // 释放总线，切回接收
+        uart3_tx_busy = 0;
     }
 }
@@ -1,7 +1,10 @@
 /**
  * @file     UART3.h
  * @brief    串口3通信模块驱动程序头文件
- * @details  定义了串口3通信相关的函数接口
+ * @details  定义了串口3通信相关的函数接口：
+ *          - 中断驱动的发送环形缓冲区，发送不阻塞主循环
+ *          - 按行接收（回车或换行结束），供命令解析使用
+ *          - Modbus RTU模式（二选一）：DMA收发整帧，RS-485方向控制
  * @author   DikiFive
  * @date     2025-05-06
  * @version  v1.0
@@ -10,13 +13,27 @@
 #ifndef __UART3_H
 #define __UART3_H
 
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
 #include <stdint.h>
 
-/** @brief 接收缓冲区大小定义 */
+/** @brief 接收缓冲区大小定义（一行的最大长度） */
 #define UART3_RX_BUFFER_SIZE 64
+/** @brief 发送环形缓冲区大小，必须为2的幂 */
+#define UART3_TX_BUFFER_SIZE 256
 
-/** @brief 串口3接收缓冲区 */
+/** @brief Modbus模式帧缓冲区大小 */
+#define UART3_FRAME_SIZE 256
+
+/** @brief RS-485收发方向控制引脚PB12（高电平发送），收发器的RE与DE并联 */
+#define UART3_DE_GPIO_PORT GPIOB
+#define UART3_DE_GPIO_CLK  RCC_APB2Periph_GPIOB
+#define UART3_DE_PIN       GPIO_Pin_12
+
+/** @brief USART3的DMA通道 */
+#define UART3_DMA_RX DMA1_Channel3
+#define UART3_DMA_TX DMA1_Channel2
+
+/** @brief 串口3接收缓冲区（正在接收的一行） */
 extern uint8_t UART3_RxBuffer[UART3_RX_BUFFER_SIZE];
 /** @brief 串口3接收计数器 */
 extern uint16_t UART3_RxCount;
@@ -28,13 +45,66 @@ extern uint16_t UART3_RxCount;
  */
 void UART3_Init(uint32_t baudRate);
 
+/**
+ * @brief  串口3初始化（Modbus RTU模式，8E1）
+ * @details 与UART3_Init二选一，之后命令行相关的收发函数不再工作
+ * @param  baudRate 波特率设置
+ * @return 无
+ */
+void UART3_ModbusInit(uint32_t baudRate);
+
+/**
+ * @brief  Modbus帧间隔检测，由定时器中断每100us调用
+ * @param  无
+ * @return 无
+ */
+void UART3_Tick(void);
+
+/**
+ * @brief  读取接收到的一帧（Modbus模式）
+ * @param  buf  输出缓冲区
+ * @param  size 输出缓冲区大小
+ * @return 帧长度，0表示没有新帧
+ */
+uint16_t UART3_ReadFrame(uint8_t *buf, uint16_t size);
+
+/**
+ * @brief  发送一帧（Modbus模式，DMA，不阻塞）
+ * @param  buf 帧数据
+ * @param  len 帧长度
+ * @return 0：已开始发送，1：上一帧尚未发完或长度错误
+ */
+uint8_t UART3_SendFrame(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  Modbus帧是否正在发送
+ * @return 1：正在发送（总线被占用），0：空闲
+ */
+uint8_t UART3_FrameSending(void);
+
 /**
  * @brief  通过串口3发送一个字节
+ * @details 写入发送环形缓冲区，由TXE中断发出；缓冲区满时等待
  * @param  data 要发送的字节数据
  * @return 无
  */
 void UART3_SendByte(uint8_t data);
 
+/**
+ * @brief  发送缓冲区剩余空间
+ * @return 可立即写入的字节数
+ */
+uint16_t UART3_TxFree(void);
+
+/**
+ * @brief  读取接收到的一行
+ * @details 行以回车或换行结束，返回的字符串不含行结束符
+ * @param  buf  输出缓冲区
+ * @param  size 输出缓冲区大小
+ * @return 行长度，0表示没有完整的新行
+ */
+uint16_t UART3_ReadLine(char *buf, uint16_t size);
+
 /**
  * @brief  通过串口3发送字符串
  * @param  str 要发送的以'\0'结尾的字符串
@@ -0,0 +1,196 @@
+/**
+ * @file     Ventilation.c
+ * @brief    排风扇通风控制
+ * @details  每次调用的处理：
+ *          - 异味需求：P = (超出值 - 设定值) * 100 / 跨度，积分项每ti_ms累加一个P，
+ *            积分限幅在0~100%，浓度低于设定值时P为负，积分逐渐回落到0
+ *          - 需求取异味、温度、湿度三者的最大值，烟雾报警时为100%
+ *          - 静音时段内需求不超过quiet_max
+ *          - 迟滞和最短启停时间决定是否运行，运行时占空比不低于min_duty
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "Ventilation.h"
+#include <stddef.h>
+
+#define VENT_MAX_DT_MS 2000 /**< 单次调用最多计入的时间，避免调用中断后积分跳变 */
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Vent_DefaultConfig(VentConfig_t *cfg)
+{
+    cfg->ti_ms         = VENT_TI_MS;
+    cfg->min_on_ms     = VENT_MIN_ON_MS;
+    cfg->min_off_ms    = VENT_MIN_OFF_MS;
+    cfg->ppm_on        = VENT_PPM_ON;
+    cfg->ppm_span      = VENT_PPM_SPAN;
+    cfg->temp_on_x10   = VENT_TEMP_ON_X10;
+    cfg->temp_span_x10 = VENT_TEMP_SPAN_X10;
+    cfg->humi_on_x10   = VENT_HUMI_ON_X10;
+    cfg->humi_duty     = VENT_HUMI_DUTY;
+    cfg->on_duty       = VENT_ON_DUTY;
+    cfg->off_duty      = VENT_OFF_DUTY;
+    cfg->min_duty      = VENT_MIN_DUTY;
+    cfg->quiet_start   = VENT_QUIET_START;
+    cfg->quiet_end     = VENT_QUIET_END;
+    cfg->quiet_max     = VENT_QUIET_MAX;
+}
+
+/**
+ * @brief  初始化控制器
+ * @param  v   控制器
+ * @param  cfg 控制参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Vent_Init(Vent_t *v, const VentConfig_t *cfg)
+{
+    if (cfg == NULL) {
+        Vent_DefaultConfig(&v->cfg);
+    } else {
+        v->cfg = *cfg;
+    }
+
+    v->started  = 0;
+    v->running  = 0;
+    v->duty     = 0;
+    v->demand   = 0;
+    v->quiet    = 0;
+    v->integ_q8 = 0;
+}
+
+/**
+ * @brief  修改控制参数
+ * @param  v   控制器
+ * @param  cfg 控制参数
+ * @return 无
+ */
+void Vent_SetConfig(Vent_t *v, const VentConfig_t *cfg)
+{
+    v->cfg = *cfg;
+}
+
+/**
+ * @brief  限幅到0~100
+ */
+static int32_t Vent_Clamp(int32_t x)
+{
+    if (x < 0) return 0;
+    if (x > 100) return 100;
+    return x;
+}
+
+/**
+ * @brief  异味PI需求
+ * @param  v 控制器
+ */
+static int32_t Vent_OdourDemand(Vent_t *v, uint16_t excess_ppm, uint32_t dt_ms)
+{
+    int32_t p;
+
+    if (v->cfg.ppm_span == 0 || v->cfg.ti_ms == 0) return 0;
+    p = ((int32_t)excess_ppm - v->cfg.ppm_on) * 100 / v->cfg.ppm_span;
+    if (p < -100) p = -100;
+    if (p > 100) p = 100;
+
+    v->integ_q8 += p * 256 * (int32_t)dt_ms / (int32_t)v->cfg.ti_ms;
+    if (v->integ_q8 < 0) v->integ_q8 = 0;
+    if (v->integ_q8 > 100L * 256) v->integ_q8 = 100L * 256; // 限幅，避免饱和后积分累积
+
+    return Vent_Clamp(p + v->integ_q8 / 256);
+}
+
+/**
+ * @brief  当前时是否在静音时段内（可跨零点）
+ */
+static uint8_t Vent_InQuiet(const VentConfig_t *cfg, uint8_t hour)
+{
+    if (hour == VENT_HOUR_UNKNOWN || cfg->quiet_start == cfg->quiet_end) return 0;
+    if (cfg->quiet_start < cfg->quiet_end) return hour >= cfg->quiet_start && hour < cfg->quiet_end;
+    return hour >= cfg->quiet_start || hour < cfg->quiet_end;
+}
+
+/**
+ * @brief  周期调用，计算占空比
+ * @param  v      控制器
+ * @param  now_ms 当前时间（毫秒）
+ * @param  in     控制输入
+ * @return 风扇占空比（%），0为停止
+ */
+uint8_t Vent_Update(Vent_t *v, uint32_t now_ms, const VentInput_t *in)
+{
+    const VentConfig_t *cfg = &v->cfg;
+    uint32_t dt_ms          = 0;
+    uint32_t held_ms;
+    int32_t demand, d;
+
+    if (v->started) {
+        dt_ms = now_ms - v->last_ms;
+        if (dt_ms > VENT_MAX_DT_MS) dt_ms = VENT_MAX_DT_MS;
+    }
+    v->last_ms = now_ms;
+
+    /* 需求：异味、温度、湿度取最大值 */
+    demand = Vent_OdourDemand(v, in->excess_ppm, dt_ms);
+    if (in->th_valid) {
+        if (in->temp_x10 > cfg->temp_on_x10 && cfg->temp_span_x10) {
+            d = Vent_Clamp(((int32_t)in->temp_x10 - cfg->temp_on_x10) * 100 / cfg->temp_span_x10);
+            if (d > demand) demand = d;
+        }
+        if (in->humi_x10 >= cfg->humi_on_x10 && cfg->humi_duty > demand) demand = cfg->humi_duty;
+    }
+
+    v->quiet = Vent_InQuiet(cfg, in->hour);
+    if (in->alarm) {
+        demand = 100;
+    } else if (v->quiet && demand > cfg->quiet_max) {
+        demand = cfg->quiet_max;
+    }
+    v->demand = (uint8_t)demand;
+
+    /* 迟滞和最短启停时间；第一次调用时视为已停机足够长 */
+    held_ms = now_ms - v->switch_ms;
+    if (!v->running) {
+        if (demand >= cfg->on_duty && (in->alarm || !v->started || held_ms >= cfg->min_off_ms)) {
+            v->running   = 1;
+            v->switch_ms = now_ms;
+        }
+    } else if (demand < cfg->off_duty && held_ms >= cfg->min_on_ms) {
+        v->running   = 0;
+        v->switch_ms = now_ms;
+    }
+    v->started = 1;
+
+    if (!v->running) {
+        v->duty = 0;
+    } else {
+        if (demand < cfg->min_duty) demand = cfg->min_duty;
+        if (!in->alarm && v->quiet && demand > cfg->quiet_max) demand = cfg->quiet_max;
+        v->duty = (uint8_t)demand;
+    }
+    return v->duty;
+}
+
+/**
+ * @brief  获取输出占空比
+ * @param  v 控制器
+ * @return 占空比（%）
+ */
+uint8_t Vent_GetDuty(const Vent_t *v)
+{
+    return v->duty;
+}
+
+/**
+ * @brief  获取通风需求
+ * @param  v 控制器
+ * @return 需求（%）
+ */
+uint8_t Vent_GetDemand(const Vent_t *v)
+{
+    return v->demand;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file     Ventilation.h
+ * @brief    排风扇通风控制头文件
+ * @details  按异味/烟雾浓度和温湿度计算排风扇占空比：
+ *          - 异味：MQ2超出基线的浓度经PI控制得到需求（积分限幅0~100%，防止饱和后积分累积）
+ *          - 温度：超过开启温度后按跨度线性增加需求；湿度超过阈值时保持最低需求
+ *          - 烟雾报警时全速，不受静音时段和最短停机时间限制
+ *          - 迟滞：需求达到on_duty才启动，低于off_duty才停机；启动和停机后分别保持最短时间，保护风扇
+ *          - 静音时段（DS1302时钟的小时）限制最大占空比，烟雾报警除外
+ *          每次调用O(1)，只用整数运算；模块不依赖硬件，可在主机上仿真
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __VENTILATION_H
+#define __VENTILATION_H
+
+#include <stdint.h>
+
+/**
+ * @brief 默认参数
+ */
+#define VENT_PPM_ON        40     /**< 超出基线达到此值开始产生通风需求（PPM，PI设定值） */
+#define VENT_PPM_SPAN      120    /**< 比例项：超出设定值此浓度时需求为100% */
+#define VENT_TI_MS         60000  /**< 积分时间（毫秒） */
+#define VENT_TEMP_ON_X10   300    /**< 开始通风的温度（0.1℃） */
+#define VENT_TEMP_SPAN_X10 100    /**< 温度需求从0增加到100%的跨度（0.1℃） */
+#define VENT_HUMI_ON_X10   800    /**< 湿度达到此值时保持最低需求（0.1%RH） */
+#define VENT_HUMI_DUTY     30     /**< 高湿度时的需求（%） */
+#define VENT_ON_DUTY       30     /**< 需求达到此值启动（%） */
+#define VENT_OFF_DUTY      10     /**< 需求低于此值停机（%） */
+#define VENT_MIN_DUTY      25     /**< 运行时的最低占空比，低于此值风扇可能堵转（%） */
+#define VENT_MIN_ON_MS     60000  /**< 启动后最短运行时间（毫秒） */
+#define VENT_MIN_OFF_MS    30000  /**< 停机后最短停机时间（毫秒） */
+#define VENT_QUIET_START   22     /**< 静音时段开始（时） */
+#define VENT_QUIET_END     7      /**< 静音时段结束（时，不含） */
+#define VENT_QUIET_MAX     40     /**< 静音时段最大占空比（%） */
+
+#define VENT_HOUR_UNKNOWN 0xFF /**< 时钟无效，不判断静音时段 */
+
+/**
+ * @brief 控制参数
+ */
+typedef struct
+{
+    uint32_t ti_ms;         /**< 积分时间（毫秒） */
+    uint32_t min_on_ms;     /**< 最短运行时间（毫秒） */
+    uint32_t min_off_ms;    /**< 最短停机时间（毫秒） */
+    uint16_t ppm_on;        /**< 异味设定值（超出基线PPM） */
+    uint16_t ppm_span;      /**< 比例项跨度（PPM） */
+    int16_t temp_on_x10;    /**< 开始通风的温度（0.1℃） */
+    uint16_t temp_span_x10; /**< 温度跨度（0.1℃） */
+    uint16_t humi_on_x10;   /**< 高湿度阈值（0.1%RH） */
+    uint8_t humi_duty;      /**< 高湿度需求（%） */
+    uint8_t on_duty;        /**< 启动需求（%） */
+    uint8_t off_duty;       /**< 停机需求（%） */
+    uint8_t min_duty;       /**< 运行最低占空比（%） */
+    uint8_t quiet_start;    /**< 静音时段开始（时），与结束相同表示不使用静音时段 */
+    uint8_t quiet_end;      /**< 静音时段结束（时，不含），可跨零点 */
+    uint8_t quiet_max;      /**< 静音时段最大占空比（%） */
+} VentConfig_t;
+
+/**
+ * @brief 控制输入
+ */
+typedef struct
+{
+    uint16_t excess_ppm; /**< 烟雾浓度超出基线的值（PPM），预热期或传感器异常时为0 */
+    uint8_t alarm;       /**< 烟雾报警 */
+    uint8_t th_valid;    /**< 温湿度有效 */
+    int16_t temp_x10;    /**< 温度（0.1℃） */
+    uint16_t humi_x10;   /**< 湿度（0.1%RH） */
+    uint8_t hour;        /**< 当前时（0~23），VENT_HOUR_UNKNOWN表示未知 */
+} VentInput_t;
+
+/**
+ * @brief 控制器状态（每个实例一份）
+ */
+typedef struct
+{
+    VentConfig_t cfg;   /**< 控制参数 */
+    uint8_t started;    /**< 已调用过Vent_Update */
+    uint8_t running;    /**< 风扇运行中 */
+    uint8_t duty;       /**< 输出占空比（%） */
+    uint8_t demand;     /**< 通风需求（%，已按静音时段限制） */
+    uint8_t quiet;      /**< 处于静音时段 */
+    int32_t integ_q8;   /**< PI积分项（%，Q8） */
+    uint32_t last_ms;   /**< 上次调用时间 */
+    uint32_t switch_ms; /**< 上次启停时间 */
+} Vent_t;
+
+/**
+ * @brief  获取默认参数
+ * @param  cfg 输出参数
+ * @return 无
+ */
+void Vent_DefaultConfig(VentConfig_t *cfg);
+
+/**
+ * @brief  初始化控制器（风扇停止，可立即启动）
+ * @param  v   控制器
+ * @param  cfg 控制参数，NULL表示使用默认参数
+ * @return 无
+ */
+void Vent_Init(Vent_t *v, const VentConfig_t *cfg);
+
+/**
+ * @brief  修改控制参数，保留运行状态
+ * @param  v   控制器
+ * @param  cfg 控制参数
+ * @return 无
+ */
+void Vent_SetConfig(Vent_t *v, const VentConfig_t *cfg);
+
+/**
+ * @brief  周期调用，计算占空比
+ * @param  v      控制器
+ * @param  now_ms 当前时间（毫秒）
+ * @param  in     控制输入
+ * @return 风扇占空比（%），0为停止
+ */
+uint8_t Vent_Update(Vent_t *v, uint32_t now_ms, const VentInput_t *in);
+
+/**
+ * @brief  获取输出占空比
+ * @param  v 控制器
+ * @return 占空比（%）
+ */
+uint8_t Vent_GetDuty(const Vent_t *v);
+
+/**
+ * @brief  获取通风需求
+ * @param  v 控制器
+ * @return 需求（%），已按静音时段限制
+ */
+uint8_t Vent_GetDemand(const Vent_t *v);
+
+#endif /* __VENTILATION_H */
@@ -0,0 +1,140 @@
+/**
+ * @file     VoicePrompt.c
+ * @brief    语音提示播放队列实现
+ * @details  队列按优先级从高到低排列，同优先级先到先播；
+ *          入队和去重只操作几个字节的数组，编码和发送都在Voice_Poll中完成；
+ *          发送缓冲区空间不足时提示留在队首，下次再发
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include "VoicePrompt.h"
+#include <stddef.h>
+
+/* 提示表，按编号排列：名称、曲目、优先级、时长、重复间隔 */
+static const VoicePrompt_t voice_prompts[VOICE_ID_NUM] = {
+    [VOICE_ID_LID_OPEN] = {"lid_open", 1, 1, 1500, 5000},
+    [VOICE_ID_FULL]     = {"full", 2, 2, 2000, 60000},
+    [VOICE_ID_CLEANUP]  = {"cleanup", 3, 2, 2500, 60000},
+    [VOICE_ID_SMOKE]    = {"smoke", 4, 3, 3000, 10000},
+};
+
+static const VoiceHw_t *voice_hw;                /**< 硬件函数表，NULL表示未初始化 */
+static uint8_t voice_queue[VOICE_QUEUE_LEN];     /**< 等待播放的提示，按优先级排列 */
+static uint8_t voice_count;                      /**< 队列长度 */
+static uint8_t voice_playing = VOICE_ID_NONE;    /**< 正在播放的提示 */
+static uint8_t voice_preempt;                    /**< 队首需要打断正在播放的提示 */
+static uint32_t voice_start_ms;                  /**< 开始播放的时刻 */
+static uint32_t voice_last_ms[VOICE_ID_NUM];     /**< 各提示上次开始播放的时刻 */
+static uint8_t voice_played[VOICE_ID_NUM];       /**< 各提示是否播放过（voice_last_ms有效） */
+
+// 函数：正在播放的提示是否已结束
+static uint8_t Voice_Finished(uint32_t now_ms)
+{
+    uint32_t elapsed = now_ms - voice_start_ms;
+
+    if (voice_playing == VOICE_ID_NONE) return 1;
+    if (voice_hw->busy == NULL) return elapsed >= voice_prompts[voice_playing].duration_ms;
+    if (elapsed < VOICE_BUSY_START_MS) return 0; // 模块还没来得及拉低BUSY
+    return !voice_hw->busy() || elapsed >= VOICE_BUSY_MAX_MS;
+}
+
+// 函数：移除队首
+static void Voice_Pop(void)
+{
+    uint8_t i;
+
+    voice_count--;
+    for (i = 0; i < voice_count; i++) voice_queue[i] = voice_queue[i + 1];
+}
+
+void Voice_Init(const VoiceHw_t *hw)
+{
+    voice_hw      = hw;
+    voice_count   = 0;
+    voice_playing = VOICE_ID_NONE;
+    voice_preempt = 0;
+}
+
+uint8_t Voice_Play(uint8_t id)
+{
+    uint8_t i, pos, prio;
+
+    if (id >= VOICE_ID_NUM || id == voice_playing) return 0;
+    for (i = 0; i < voice_count; i++) {
+        if (voice_queue[i] == id) return 0; // 已在队列中
+    }
+
+    prio = voice_prompts[id].priority;
+    for (pos = 0; pos < voice_count && voice_prompts[voice_queue[pos]].priority >= prio; pos++);
+    if (pos >= VOICE_QUEUE_LEN) return 0;             // 队列已满且优先级不高于任何一个
+    if (voice_count == VOICE_QUEUE_LEN) voice_count--; // 挤掉队尾（优先级最低）
+
+    for (i = voice_count; i > pos; i--) voice_queue[i] = voice_queue[i - 1];
+    voice_queue[pos] = id;
+    voice_count++;
+
+    if (pos == 0 && voice_playing != VOICE_ID_NONE && prio > voice_prompts[voice_playing].priority) {
+        voice_preempt = 1;
+    }
+    return 1;
+}
+
+void Voice_Poll(uint32_t now_ms)
+{
+    uint8_t frame[VOICE_FRAME_LEN];
+    uint8_t id;
+
+    if (voice_hw == NULL) return;
+    if (voice_playing != VOICE_ID_NONE && Voice_Finished(now_ms)) voice_playing = VOICE_ID_NONE;
+
+    while (voice_count > 0 && (voice_playing == VOICE_ID_NONE || voice_preempt)) {
+        id = voice_queue[0];
+        if (voice_played[id] && now_ms - voice_last_ms[id] < voice_prompts[id].holdoff_ms) {
+            Voice_Pop(); // 刚播放过，丢弃
+            voice_preempt = 0;
+            continue;
+        }
+        Voice_EncodeCmd(frame, VOICE_CMD_PLAY, 0, voice_prompts[id].track);
+        if (voice_hw->send(frame, VOICE_FRAME_LEN)) return; // 缓冲区空间不足，下次再发
+
+        Voice_Pop();
+        voice_playing     = id; // 新的播放命令同时打断模块正在播放的曲目
+        voice_preempt     = 0;
+        voice_start_ms    = now_ms;
+        voice_last_ms[id] = now_ms;
+        voice_played[id]  = 1;
+    }
+}
+
+uint8_t Voice_EncodeCmd(uint8_t *frame, uint8_t cmd, uint8_t feedback, uint16_t dat)
+{
+    uint16_t sum = 0;
+    uint8_t i;
+
+    frame[0] = 0x7E; // 起始
+    frame[1] = 0xFF; // 版本
+    frame[2] = 0x06; // 长度
+    frame[3] = cmd;
+    frame[4] = feedback;
+    frame[5] = (uint8_t)(dat >> 8);
+    frame[6] = (uint8_t)dat;
+    for (i = 1; i < 7; i++) sum += frame[i];
+    sum      = (uint16_t)(0 - sum); // 累加后取负，接收端6个字节加校验为0
+    frame[7] = (uint8_t)(sum >> 8);
+    frame[8] = (uint8_t)sum;
+    frame[9] = 0xEF; // 结束
+    return VOICE_FRAME_LEN;
+}
+
+uint8_t Voice_GetPlaying(void)
+{
+    return voice_playing;
+}
+
+const VoicePrompt_t *Voice_GetPrompt(uint8_t id)
+{
+    if (id >= VOICE_ID_NUM) return NULL;
+    return &voice_prompts[id];
+}
@@ -0,0 +1,121 @@
+/**
+ * @file     VoicePrompt.h
+ * @brief    语音提示播放队列头文件
+ * @details  串口1上的MP3模块播放提示音（开盖、已满、烟雾报警等）：
+ *          - Voice_Play只把提示放入按优先级排序的短队列，立即返回（几微秒），不发送数据
+ *          - Voice_Poll在模块空闲时取出优先级最高的提示，编码成命令帧写入发送缓冲区，由中断发出
+ *          - 去重：已在队列中或正在播放的提示不再入队，同一提示在间隔时间内不重复播放
+ *          - 比正在播放的提示优先级高时立即打断播放
+ *          - 播放结束由模块BUSY引脚判断（可选），没有时按提示表中的时长估计
+ *          命令帧：7E FF 06 命令 应答 参数高 参数低 校验高 校验低 EF，
+ *          校验为FF~参数低6个字节之和取负（16位）
+ *          本模块不依赖硬件，发送和BUSY引脚通过VoiceHw_t函数表接入
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#ifndef __VOICEPROMPT_H
+#define __VOICEPROMPT_H
+
+#include <stdint.h>
+
+/**
+ * @brief 提示编号
+ */
+#define VOICE_ID_LID_OPEN 0 /**< 开盖：请投放垃圾 */
+#define VOICE_ID_FULL     1 /**< 垃圾桶已满 */
+#define VOICE_ID_CLEANUP  2 /**< 超时未清理 */
+#define VOICE_ID_SMOKE    3 /**< 烟雾报警 */
+#define VOICE_ID_NUM      4
+#define VOICE_ID_NONE     0xFF
+
+/**
+ * @brief 队列与时间参数
+ */
+#define VOICE_QUEUE_LEN     4     /**< 等待播放的提示数，满时丢弃优先级最低的 */
+#define VOICE_BUSY_START_MS 200   /**< 发送播放命令后模块拉低BUSY引脚的最长时间，之前视为正在播放 */
+#define VOICE_BUSY_MAX_MS   30000 /**< BUSY引脚一直有效时的最长播放时间（引脚接错时不会卡住队列） */
+
+/**
+ * @brief 命令帧
+ */
+#define VOICE_FRAME_LEN  10   /**< 命令帧长度 */
+#define VOICE_CMD_PLAY   0x03 /**< 播放指定曲目（参数为曲目号） */
+#define VOICE_CMD_VOLUME 0x06 /**< 设置音量（参数0~30） */
+
+/**
+ * @brief 提示
+ */
+typedef struct
+{
+    const char *name;     /**< 名称 */
+    uint16_t track;       /**< 曲目号（存储卡根目录文件顺序） */
+    uint8_t priority;     /**< 优先级，数值大的优先并可打断播放 */
+    uint16_t duration_ms; /**< 播放时长，没有BUSY引脚时用于判断播放结束 */
+    uint16_t holdoff_ms;  /**< 同一提示两次播放的最短间隔 */
+} VoicePrompt_t;
+
+/**
+ * @brief 硬件函数表
+ */
+typedef struct
+{
+    /**
+     * @brief 发送一帧，不等待
+     * @return 0：已写入发送缓冲区，1：缓冲区空间不足（下次再试）
+     */
+    uint8_t (*send)(const uint8_t *frame, uint8_t len);
+    /**
+     * @brief 模块BUSY引脚（可选，NULL时按时长估计）
+     * @return 1：正在播放
+     */
+    uint8_t (*busy)(void);
+} VoiceHw_t;
+
+/**
+ * @brief  初始化
+ * @param  hw 硬件函数表
+ * @return 无
+ */
+void Voice_Init(const VoiceHw_t *hw);
+
+/**
+ * @brief  请求播放一个提示，只入队，不发送
+ * @param  id 提示编号 VOICE_ID_x
+ * @return 1：已入队，0：重复或队列已满且优先级不够被丢弃
+ */
+uint8_t Voice_Play(uint8_t id);
+
+/**
+ * @brief  发送待播放的提示，主循环中调用
+ * @param  now_ms 当前时间（毫秒）
+ * @return 无
+ */
+void Voice_Poll(uint32_t now_ms);
+
+/**
+ * @brief  编码一帧命令（含起始、校验和结束字节）
+ * @param  frame    输出缓冲区，至少VOICE_FRAME_LEN字节
+ * @param  cmd      命令
+ * @param  feedback 是否需要模块应答（0/1）
+ * @param  dat      参数
+ * @return 帧长度VOICE_FRAME_LEN
+ */
+uint8_t Voice_EncodeCmd(uint8_t *frame, uint8_t cmd, uint8_t feedback, uint16_t dat);
+
+/**
+ * @brief  获取正在播放的提示
+ * @param  无
+ * @return 提示编号，没有时为VOICE_ID_NONE
+ */
+uint8_t Voice_GetPlaying(void);
+
+/**
+ * @brief  获取提示信息
+ * @param  id 提示编号
+ * @return 提示，编号无效返回NULL
+ */
+const VoicePrompt_t *Voice_GetPrompt(uint8_t id);
+
+#endif /* __VOICEPROMPT_H */
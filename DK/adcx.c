@@ -1,11 +1,14 @@
 #include "adcx.h"
+#include "Delay.h"
 
 /**
- * @brief  ADC初始化程序
+ * @brief  ADC配置并上电，不校准
  * @param  ADCx_Instance: 选择需要初始化的ADC外设，可以是ADC1, ADC2, 或ADC3
  * @retval 无
+ * @note   上电后需等待ADC稳定时间（ADC_STAB_US）再开始校准，
+ *         启动流程中由Boot调度，校准期间继续初始化其他外设
  */
-void ADCx_Init(ADC_TypeDef *ADCx_Instance)
+void ADCx_Enable(ADC_TypeDef *ADCx_Instance)
 {
     // 开启ADC时钟
     if (ADCx_Instance == ADC1) {
@@ -31,6 +34,17 @@ void ADCx_Init(ADC_TypeDef *ADCx_Instance)
 
     // 开启ADCx
     ADC_Cmd(ADCx_Instance, ENABLE);
+}
+
+/**
+ * @brief  ADC初始化程序（阻塞等待校准完成）
+ * @param  ADCx_Instance: 选择需要初始化的ADC外设，可以是ADC1, ADC2, 或ADC3
+ * @retval 无
+ */
+void ADCx_Init(ADC_TypeDef *ADCx_Instance)
+{
+    ADCx_Enable(ADCx_Instance);
+    Delay_us(ADC_STAB_US);
 
     // 进行ADC校准
     ADC_ResetCalibration(ADCx_Instance);
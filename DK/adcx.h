@@ -2,6 +2,12 @@
 #define _ADCX_H_
 #include "stm32f10x.h" // Device header
 
+// ADC上电后开始校准前的稳定时间（微秒），数据手册tSTAB最大1us
+#define ADC_STAB_US 2
+
+// ADC 配置并上电（不校准），接受 ADC 外设指针作为参数
+void ADCx_Enable(ADC_TypeDef* ADCx_Instance);
+
 // ADC 初始化函数，接受 ADC 外设指针作为参数
 void ADCx_Init(ADC_TypeDef* ADCx_Instance);
 
@@ -3,6 +3,7 @@
 struct TIMEData TimeData;
 struct TIMERAM TimeRAM;
 u8 read_time[7];
+static FGPIO_Dir_t ds1302_data_dir; // DATA方向切换，在DS1302_GPIO_Init中初始化
 
 void DS1302_GPIO_Init(void) // CE,SCLK端口初始化
 {
@@ -19,30 +20,25 @@ void DS1302_GPIO_Init(void) // CE,SCLK端口初始化
     GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP; // 推挽输出
     GPIO_Init(DS1302_CE_PORT, &GPIO_InitStructure);   // 初始化
     GPIO_ResetBits(DS1302_CE_PORT, DS1302_CE_PIN);
+
+    GPIO_InitStructure.GPIO_Pin   = DS1302_DATA_PIN; // DATA，默认为输入，传输时再切换方向
+    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(DS1302_DATA_PORT, &GPIO_InitStructure);
+    FGPIO_DIR_INIT(&ds1302_data_dir, DS1302_DATA, FGPIO_MODE_IN_FLOATING, FGPIO_MODE_OUT_PP);
 }
 
 void DS1302_DATAOUT_init() // 配置双向I/O端口为输出态
 {
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_APB2PeriphClockCmd(DS1302_CLK, ENABLE);
-
-    GPIO_InitStructure.GPIO_Pin   = DS1302_DATA_PIN; // DATA
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP;
-    GPIO_Init(DS1302_DATA_PORT, &GPIO_InitStructure); // 初始化
-    GPIO_ResetBits(DS1302_DATA_PORT, DS1302_DATA_PIN);
+    DATA_L;
+    FGPIO_DirOut(&ds1302_data_dir);
 }
 
 void DS1302_DATAINPUT_init() // 配置双向I/O端口为输入态
 {
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_APB2PeriphClockCmd(DS1302_CLK, ENABLE);
-    GPIO_InitStructure.GPIO_Pin  = DS1302_DATA_PIN; // DATA
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
-    GPIO_Init(DS1302_DATA_PORT, &GPIO_InitStructure); // 初始化
+    FGPIO_DirIn(&ds1302_data_dir);
 }
 
-void DS1302_write_onebyte(u8 data) // 向DS1302发送一字节数据
+RAMFUNC void DS1302_write_onebyte(u8 data) // 向DS1302发送一字节数据
 {
     u8 count = 0;
     SCLK_L;
@@ -55,7 +51,9 @@ void DS1302_write_onebyte(u8 data) // 向DS1302发送一字节数据
         } else {
             DATA_L;
         } // 先准备好数据再发送
+        DS1302_DELAY();
         SCLK_H; // 拉高时钟线，发送数据
+        DS1302_DELAY();
         data >>= 1;
     }
 }
@@ -76,7 +74,7 @@ void DS1302_wirte_rig(u8 address, u8 data) // 向指定寄存器地址发送数
     Delay_us(3);
 }
 
-u8 DS1302_read_rig(u8 address) // 从指定地址读取一字节数据
+RAMFUNC u8 DS1302_read_rig(u8 address) // 从指定地址读取一字节数据
 {
     u8 temp3       = address;
     u8 count       = 0;
@@ -90,13 +88,13 @@ u8 DS1302_read_rig(u8 address) // 从指定地址读取一字节数据
     DS1302_DATAINPUT_init(); // 配置I/O口为输入
     Delay_us(3);
     for (count = 0; count < 8; count++) {
-        Delay_us(3); // 使电平持续一段时间
+        DS1302_DELAY(); // 使电平持续一段时间
         return_data >>= 1;
         SCLK_H;
-        Delay_us(5); // 使高电平持续一段时间
+        DS1302_DELAY(); // 使高电平持续一段时间
         SCLK_L;
-        Delay_us(30); // 延时14us后再去读取电压，更加准确
-        if (GPIO_ReadInputDataBit(DS1302_DATA_PORT, DS1302_DATA_PIN)) { return_data = return_data | 0x80; }
+        DS1302_DELAY(); // 下降沿后数据最迟0.8us有效
+        if (DATA_IN) { return_data = return_data | 0x80; }
     }
     Delay_us(2);
     CE_L;
@@ -181,3 +179,20 @@ void DS1302_SetTime(uint16_t year, uint8_t month, uint8_t day,
     DS1302_wirte_rig(0x8c, DecToBcd(year % 100)); // 设置年(只存储后两位)
     DS1302_wirte_rig(0x8e, 0x80);           // 开启写保护
 }
+
+// 读取当前时间并换算为2000-01-01 00:00:00起的秒数（本地时间，DS1302范围2000~2099年）
+uint32_t DS1302_GetEpoch(void)
+{
+    static const uint16_t month_days[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    uint16_t y;
+    uint32_t days;
+
+    DS1302_read_realTime();
+    if (TimeData.month < 1 || TimeData.month > 12 || TimeData.day < 1) return 0; // 芯片未设置时间
+
+    y    = TimeData.year - 2000;
+    days = y * 365UL + (y + 3) / 4; // 2000年起每4年一个闰年（2100年之前）
+    days += month_days[TimeData.month - 1] + TimeData.day - 1;
+    if (TimeData.month > 2 && (y % 4) == 0) days++;
+    return ((days * 24 + TimeData.hour) * 60 + TimeData.minute) * 60 + TimeData.second;
+}
@@ -1,7 +1,8 @@
 #ifndef __DS1302_H
 #define __DS1302_H
 
-#include "dk_c8t6.h"
+#include "DK_C8T6.h"
+#include "FastGPIO.h"
 
 #define DS1302_CLK       RCC_APB2Periph_GPIOA
 #define DS1302_CE_PORT   GPIOA
@@ -11,14 +12,21 @@
 #define DS1302_SCLK_PORT GPIOA
 #define DS1302_SCLK_PIN  GPIO_Pin_7
 
-#define CE_L             GPIO_ResetBits(DS1302_CE_PORT, DS1302_CE_PIN) // CE
-#define CE_H             GPIO_SetBits(DS1302_CE_PORT, DS1302_CE_PIN)
+#define DS1302_CE        FGPIO(GPIOA, 5) // 快速GPIO引脚描述，与上面的端口/引脚一致
+#define DS1302_DATA      FGPIO(GPIOA, 6)
+#define DS1302_SCLK      FGPIO(GPIOA, 7)
 
-#define DATA_L           GPIO_ResetBits(DS1302_SCLK_PORT, DS1302_DATA_PIN) // DATA
-#define DATA_H           GPIO_SetBits(DS1302_SCLK_PORT, DS1302_DATA_PIN)
+#define CE_L             FGPIO_L(DS1302_CE) // CE
+#define CE_H             FGPIO_H(DS1302_CE)
 
-#define SCLK_L           GPIO_ResetBits(DS1302_DATA_PORT, DS1302_SCLK_PIN) // SCLK
-#define SCLK_H           GPIO_SetBits(DS1302_DATA_PORT, DS1302_SCLK_PIN)
+#define DATA_L           FGPIO_L(DS1302_DATA) // DATA
+#define DATA_H           FGPIO_H(DS1302_DATA)
+#define DATA_IN          FGPIO_BB_IN(DS1302_DATA)
+
+#define SCLK_L           FGPIO_L(DS1302_SCLK) // SCLK
+#define SCLK_H           FGPIO_H(DS1302_SCLK)
+
+#define DS1302_DELAY()   Delay_us(1) // SCLK高/低电平保持时间，数据手册要求3.3V时不小于约0.5us
 
 struct TIMEData {
     u16 year;
@@ -58,4 +66,7 @@ void DS1302_readRAM(void);
 void DS1302_SetTime(uint16_t year, uint8_t month, uint8_t day,
                     uint8_t hour, uint8_t minute, uint8_t second, uint8_t week);
 
+// 读取当前时间，返回2000-01-01 00:00:00起的秒数，芯片未设置时间时返回0
+uint32_t DS1302_GetEpoch(void);
+
 #endif
@@ -4,12 +4,14 @@
  * @details  实现风扇的初始化和基本控制功能：
  *          - GPIO配置
  *          - 开关控制
+ *          - PWM调速
  * @author   DikiFive
  * @date     2025-04-30
  * @version  v1.0
  */
 
 #include "fan.h"
+#include "PWM.h"
 
 /**
  * @brief  风扇初始化
@@ -17,6 +19,7 @@
  *         1. 使能GPIO端口时钟
  *         2. 配置控制引脚为推挽输出
  *         3. 设置默认状态为关闭
+ *         4. 初始化PWM输出（FAN_PWM为1时）
  * @param  无
  * @return 无
  */
@@ -34,6 +37,10 @@ void Fan_Init(void)
 
     // 默认关闭风扇
     GPIO_SetBits(Fan_GPIO_Port, Fan_Pin); // Updated to use Fan_Pin
+
+#if FAN_PWM
+    PWM_InitChannel(2); // PB5，初始占空比为0
+#endif
 }
 
 /**
@@ -59,3 +66,22 @@ void Fan_OFF(void)
 {
     GPIO_SetBits(Fan_GPIO_Port, Fan_Pin); // 高电平关闭
 }
+
+/**
+ * @brief  设置风扇占空比
+ * @details 占空比为0时关闭电源，避免PWM关断后MOS管漏电流使风扇低速转动
+ * @param  pct 占空比 0~100
+ * @return 无
+ */
+void Fan_SetDuty(uint8_t pct)
+{
+    if (pct > 100) pct = 100;
+#if FAN_PWM
+    PWM_SetCompare2(pct);
+#endif
+    if (pct) {
+        Fan_ON();
+    } else {
+        Fan_OFF();
+    }
+}
@@ -12,7 +12,7 @@
 #ifndef __FAN_H
 #define __FAN_H
 
-#include "dk_C8T6.h"
+#include "DK_C8T6.h"
 
 /**
  * @brief 风扇硬件连接定义
@@ -22,6 +22,13 @@
 #define Fan_GPIO_Port GPIOC               /**< 风扇所在的GPIO端口 */
 #define Fan_GPIO_CLK  RCC_APB2Periph_GPIOC /**< 风扇GPIO端口时钟 */
 
+/**
+ * @brief 调速方式
+ * @note  1：PC15低电平接通电源，PB5（TIM3_CH2）输出20KHz PWM驱动MOS管调速；
+ *        0：只有PC15开关，任何非0占空比都全速运行
+ */
+#define FAN_PWM 1
+
 /**
  * @brief  初始化风扇
  * @details 配置GPIO并设置初始状态
@@ -46,4 +53,12 @@ void Fan_ON(void);
  */
 void Fan_OFF(void);
 
+/**
+ * @brief  设置风扇占空比
+ * @details 0关闭电源并把PWM输出置低；非0接通电源并设置PWM占空比
+ * @param  pct 占空比 0~100
+ * @return 无
+ */
+void Fan_SetDuty(uint8_t pct);
+
 #endif /* __FAN_H */
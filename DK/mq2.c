@@ -1,4 +1,5 @@
 #include "mq2.h"
+#include <stddef.h>
 
 void MQ2_Init(void)
 {
@@ -28,49 +29,22 @@ void MQ2_Init(void)
 #if MODE
 uint16_t MQ2_ADC_Read(void)
 {
-    // 设置指定ADC的规则组通道，采样时间
-    return ADC_GetValue(ADC1, ADC_CHANNEL, ADC_SampleTime_55Cycles5);
+    // ADC1由MQ2_AWD_Init设为连续转换MQ2通道（启动流程中完成，主循环采样前已在转换），
+    // 直接取最新结果，不重配通道、不等待转换
+    return (uint16_t)ADC1->DR;
 }
 #endif
 
-uint16_t MQ2_GetData(void)
-{
-
 #if MODE
-    uint32_t tempData = 0;
-    for (uint8_t i = 0; i < MQ2_READ_TIMES; i++) {
-        tempData += MQ2_ADC_Read();
-        Delay_ms(5);
-    }
-
-    tempData /= MQ2_READ_TIMES;
-    return tempData;
-
-#else
-    uint16_t tempData;
-    tempData = !GPIO_ReadInputDataBit(MQ2_DO_GPIO_PORT, MQ2_DO_GPIO_PIN);
-    return tempData;
-#endif
-}
-
-float MQ2_GetData_PPM(void)
+// 函数：ADC平均值按特性曲线换算为PPM，结果钳位在1~9999
+static uint16_t MQ2_RawToPPM(float raw)
 {
-#if MODE
-    float tempData = 0;
-    // char flag=0;
-
-    for (uint8_t i = 0; i < MQ2_READ_TIMES; i++) {
-        tempData += MQ2_ADC_Read();
-        Delay_ms(5);
-    }
-    tempData /= MQ2_READ_TIMES;
-
     // 使用3.3V作为参考电压
-    float Vol = (tempData * 3.3f / 4096);
+    float Vol = (raw * 3.3f / 4096);
     if(Vol < 0.1f) return 1;  // 防止分母接近0导致计算错误
 
     float RS = (3.3f - Vol) / Vol;  // 传感器电阻，不需要0.5系数，因为已在电路中分压
-    float R0 = 9.8f;  // 在洁净空气中测得的电阻值
+    float R0 = CFG(CFG_MQ2_R0_X100) / 100.0f;  // 在洁净空气中测得的电阻值（可在线配置）
 
     // 使用MQ2传感器的特性曲线进行计算
     // PPM = a * (RS/R0)^b
@@ -85,5 +59,151 @@ float MQ2_GetData_PPM(void)
     if(ppm < 1.0f) return 1;
 
     return (uint16_t)ppm;
+}
+
+/**
+ * @brief  非阻塞PPM采样
+ * @details 每次调用最多读一次ADC，两次读取至少间隔MQ2_READ_GAP_MS，
+ *          读满MQ2_READ_TIMES次后取平均换算为PPM并开始下一轮
+ * @param  now_ms 当前时间（毫秒）
+ * @param  ppm    输出PPM（返回1时有效）
+ * @return 1：本轮采样完成，0：采样进行中
+ */
+uint8_t MQ2_PollPPM(uint32_t now_ms, uint16_t *ppm)
+{
+    static uint32_t sum     = 0;
+    static uint32_t last_ms = 0;
+    static uint8_t count    = 0;
+
+    if (count > 0 && now_ms - last_ms < MQ2_READ_GAP_MS) return 0;
+    sum += MQ2_ADC_Read();
+    last_ms = now_ms;
+    if (++count < MQ2_READ_TIMES) return 0;
+
+    *ppm  = MQ2_RawToPPM((float)sum / MQ2_READ_TIMES);
+    sum   = 0;
+    count = 0;
+    return 1;
+}
 #endif
+
+#if MODE
+static volatile uint8_t mq2_awd_tripped  = 0; // 看门狗已触发，中断已关闭
+static volatile uint32_t mq2_awd_trip_ms = 0; // 触发时刻（系统毫秒）
+static uint16_t mq2_awd_high             = 4095; // 当前ADC原始值阈值
+
+/**
+ * @brief  PPM阈值换算为ADC原始值
+ * @details 反算MQ2_RawToPPM的特性曲线：
+ *          RS = R0 * (PPM / 658.9)^(-1 / 2.013)
+ *          RS = (3.3 - V) / V，V = raw * 3.3 / 4096  =>  raw = 4096 / (1 + RS)
+ * @param  ppm PPM阈值
+ * @param  r0  洁净空气电阻R0（kΩ）
+ * @return ADC原始值，浓度越高原始值越大
+ */
+uint16_t MQ2_PPMToRaw(uint16_t ppm, float r0)
+{
+    float rs  = r0 * pow(ppm / 658.9f, -1.0f / 2.013f);
+    float raw = 4096.0f / (1.0f + rs);
+
+    if (raw > 4095.0f) return 4095;
+    return (uint16_t)(raw + 0.5f);
 }
+
+/**
+ * @brief  按PPM阈值和当前R0重新计算看门狗阈值
+ * @param  ppm PPM阈值
+ */
+void MQ2_AWD_SetThreshold(uint16_t ppm)
+{
+    mq2_awd_high = MQ2_PPMToRaw(ppm, CFG(CFG_MQ2_R0_X100) / 100.0f);
+    ADC_AnalogWatchdogThresholdsConfig(ADC1, mq2_awd_high, 0);
+}
+
+/**
+ * @brief  获取当前ADC原始值阈值
+ */
+uint16_t MQ2_AWD_GetThreshold(void)
+{
+    return mq2_awd_high;
+}
+
+/**
+ * @brief  启动连续转换并配置模拟看门狗
+ * @details ADC1改为连续转换MQ2通道（每次约5.7us），MQ2_ADC_Read直接取最新结果；
+ *          看门狗只监视该通道的上限，下限为0；
+ *          中断暂不使能（MQ2预热期读数偏高），由主循环预热结束后调用MQ2_AWD_Rearm使能
+ * @param  ppm PPM阈值
+ */
+void MQ2_AWD_Init(uint16_t ppm)
+{
+    ADC_InitTypeDef ADC_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    ADC_InitStructure.ADC_Mode               = ADC_Mode_Independent;
+    ADC_InitStructure.ADC_DataAlign          = ADC_DataAlign_Right;
+    ADC_InitStructure.ADC_ExternalTrigConv   = ADC_ExternalTrigConv_None;
+    ADC_InitStructure.ADC_ContinuousConvMode = ENABLE; // 连续转换
+    ADC_InitStructure.ADC_ScanConvMode       = DISABLE;
+    ADC_InitStructure.ADC_NbrOfChannel       = 1;
+    ADC_Init(ADC1, &ADC_InitStructure);
+    ADC_RegularChannelConfig(ADC1, ADC_CHANNEL, 1, ADC_SampleTime_55Cycles5);
+
+    MQ2_AWD_SetThreshold(ppm);
+    ADC_AnalogWatchdogSingleChannelConfig(ADC1, ADC_CHANNEL);
+    ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_SingleRegEnable);
+    ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
+    NVIC_InitStructure.NVIC_IRQChannel                   = ADC1_2_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelCmd                = ENABLE;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0; // 报警优先级最高
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0;
+    NVIC_Init(&NVIC_InitStructure);
+
+    ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+}
+
+/**
+ * @brief  是否已触发报警
+ * @param  trip_ms 输出触发时刻，可为NULL
+ * @return 1：已触发，0：未触发
+ */
+uint8_t MQ2_AWD_Tripped(uint32_t *trip_ms)
+{
+    if (trip_ms != NULL) *trip_ms = mq2_awd_trip_ms;
+    return mq2_awd_tripped;
+}
+
+/**
+ * @brief  使能/重新使能看门狗中断
+ * @details 由主循环在预热结束后、或报警后浓度恢复正常时调用；
+ *          最新转换结果仍超限时不使能，已触发的状态保持
+ * @return 1：已使能，0：电平仍超限
+ */
+uint8_t MQ2_AWD_Rearm(void)
+{
+    if (ADC_GetConversionValue(ADC1) > mq2_awd_high) return 0;
+
+    mq2_awd_tripped = 0;
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+    ADC_ITConfig(ADC1, ADC_IT_AWD, ENABLE);
+    return 1;
+}
+
+/**
+ * @brief  ADC1/2中断：模拟看门狗超限
+ * @details 直接请求烟雾报警提示，不等主循环；
+ *          电平持续超限时每次转换都会触发，因此触发后关闭中断，由主循环重新使能
+ */
+void ADC1_2_IRQHandler(void)
+{
+    if (ADC_GetITStatus(ADC1, ADC_IT_AWD) != RESET) {
+        ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+        ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+        mq2_awd_trip_ms = system_runtime_ms;
+        mq2_awd_tripped = 1;
+        Annun_Set(ANNUN_ID_SMOKE, 1); // 请求烟雾报警，下一个1ms节拍开始鸣响
+    }
+}
+#endif
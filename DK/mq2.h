@@ -1,6 +1,8 @@
 #include "DK_C8T6.h"
 
-#define MQ2_READ_TIMES 10 // MQ-2传感器ADC循环读取次数
+#define MQ2_READ_TIMES  10 // MQ-2传感器ADC循环读取次数
+#define MQ2_READ_GAP_MS 5  // 两次ADC读取的间隔（毫秒）
+#define MQ2_SAMPLE_MS   (MQ2_READ_TIMES * MQ2_READ_GAP_MS) // 一次PPM平均采样的时长（毫秒）
 
 // 模式选择
 // 模拟AO:	1
@@ -24,5 +26,17 @@
 /*********************END**********************/
 
 void MQ2_Init(void);
-uint16_t MQ2_GetData(void);
-float MQ2_GetData_PPM(void);
+
+#if MODE
+uint8_t MQ2_PollPPM(uint32_t now_ms, uint16_t *ppm); // 非阻塞PPM采样，每次调用最多读一次ADC，返回1表示一轮平均完成（唯一的采样接口，不提供阻塞读取）
+#endif
+
+#if MODE
+// 模拟看门狗快速报警：ADC1连续转换MQ2通道，超过阈值时在中断中直接请求烟雾报警提示
+void MQ2_AWD_Init(uint16_t ppm);                // 启动连续转换并按PPM阈值配置模拟看门狗（中断由MQ2_AWD_Rearm使能）
+void MQ2_AWD_SetThreshold(uint16_t ppm);        // 按PPM阈值和当前R0重新计算ADC原始值阈值
+uint16_t MQ2_AWD_GetThreshold(void);            // 获取当前ADC原始值阈值
+uint8_t MQ2_AWD_Tripped(uint32_t *trip_ms);     // 是否已触发报警，trip_ms输出触发时刻
+uint8_t MQ2_AWD_Rearm(void);                    // 使能/重新使能看门狗中断，返回0表示电平仍超限未使能
+uint16_t MQ2_PPMToRaw(uint16_t ppm, float r0);  // PPM阈值换算为ADC原始值（特性曲线反算）
+#endif
@@ -16,8 +16,15 @@ void INTX_ENABLE(void)
 }
 // 设置栈顶地址
 // addr:栈顶地址
+#if defined(__CC_ARM)
 __asm void MSR_MSP(u32 addr)
 {
     MSR MSP, r0 // set Main Stack value
                  BX r14
 }
+#else
+void MSR_MSP(u32 addr)
+{
+    __set_MSP(addr); // GCC不支持嵌入式汇编函数，使用CMSIS内联函数
+}
+#endif
@@ -45,7 +45,10 @@
 // }
 // #endif
 
-static int Send_buf[10] = {0};
+/* 发送环形缓冲区：head由写入方推进，tail由TXE中断推进 */
+static uint8_t usart1_tx_buf[USART1_TX_BUFFER_SIZE];
+static volatile uint8_t usart1_tx_head = 0;
+static volatile uint8_t usart1_tx_tail = 0;
 
 u8 USART1_RX_STA = 0; // 接收状态标记
 u8 USART1_RX_CMD;     // 存储接收到的命令
@@ -110,6 +113,14 @@ void usart1_Init(u32 bound)
     NVIC_Init(&NVIC_InitStructure);                                // 根据指定的参数初始化VIC寄存器
 
     USART_Cmd(USART1, ENABLE);
+
+#if USART1_BUSY_EN
+    // MP3模块BUSY引脚，播放时为低电平
+    RCC_APB2PeriphClockCmd(USART1_BUSY_GPIO_CLK, ENABLE);
+    GPIO_InitStructure.GPIO_Pin  = USART1_BUSY_GPIO_PIN;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU; // 上拉输入，未接模块时为空闲
+    GPIO_Init(USART1_BUSY_GPIO_PORT, &GPIO_InitStructure);
+#endif
 }
 
 /******************************************************************************
@@ -152,13 +163,9 @@ void usart1_Init(u32 bound)
 
 
 *******************************************************************************/
-void USART1_SendByte(uint8_t Data) // 串口发送一个字节；字节 (byte)    1byte=8bit
+void USART1_SendByte(uint8_t Data) // 串口发送一个字节；写入发送缓冲区，满时等待（只在主循环中调用）
 {
-
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET); // USART_FLAG_TXE发送寄存器空
-
-    USART_SendData(USART1, Data);                                // 从串口1发送传入的数据
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET); // USART_FLAG_TC发送完成标志
+    while (USART1_Write(&Data, 1));
 }
 
 /******************************************************************************
@@ -196,7 +203,7 @@ void USART1_SendByte(uint8_t Data) // 串口发送一个字节；字节 (byte)
 
 
 *******************************************************************************/
-void USART1_IRQHandler(void) // 串口2中断服务程序
+RAMFUNC void USART1_IRQHandler(void) // 串口2中断服务程序
 {
     u8 Res = 0;
 
@@ -206,59 +213,55 @@ void USART1_IRQHandler(void) // 串口2中断服务程序
         USART1_RX_CMD = Res;                       // 把接收到的数据传递给USART_RX_CMD
         USART1_NewCmd = 1;                         // 设置新命令标志位
     }
-}
-
-/******************************************************************************
-* 函数名称       ： void SendCmd(int len)
-* 创建日期       ：  2022/05/12
-* 创建人         ：  志城
-
-* 函数功能       ：  调用USART2_SendByte();将数据逐个发送出来
 
-* 输入参数类型   ： int len = 8；在for语句处逐个将Send_buf[]数据发送出来
-
-* 输出参数类型   ：
-* 返回信息       ：
-* 内在逻辑       ： 串口2发送数据给PM3模块的内在逻辑应该是：
-                    1、在main函数的while()语句中，根据case值来调用：Uart_SendCMD(0x03,0,0x01);
-                    2、这串数据通过串口2被发送出来，这样一来逻辑就清晰了，按道理我也可以把数据放在串口1来发送， 将LD和MP3集成在一个串口上。
-
-*******************************************************************************/
-void USART1_SendCmd(int len)
-{
-
-    int i = 0;
-    USART1_SendByte(0x7E); // 起始
-
-    for (i = 0; i < len; i++) // 数据
+    if (USART_GetITStatus(USART1, USART_IT_TXE) != RESET) // 发送缓冲区空
     {
-        USART1_SendByte(Send_buf[i]); // len 为8 ；依次将Send_buf[0]、Send_buf[1]　！！！�sSend_buf[8]  发送出来
+        if (usart1_tx_tail != usart1_tx_head) {
+            USART1->DR     = usart1_tx_buf[usart1_tx_tail];
+            usart1_tx_tail = (usart1_tx_tail + 1) & (USART1_TX_BUFFER_SIZE - 1);
+        } else {
+            USART1->CR1 &= ~USART_CR1_TXEIE; // 发完，关闭TXE中断
+        }
     }
-
-    USART1_SendByte(0xEF); // 结束
 }
 
 /********************************************************************************************
- - 功能描述：求和校验
- - 隶属模块：
- - 参数说明：
- - 返回说明：
- - 注：      和校验的思路如下
-             发送的指令，去掉起始和结束。将中间的6个字节进行累加，最后取反码
-             接收端就将接收到的一帧数据，去掉起始和结束。将中间的数据累加，再加上接收到的校验
-             字节。刚好为0.这样就代表接收到的数据完全正确。
+ - 功能描述： 把一段数据写入发送缓冲区，由TXE中断发出，不等待
+ - 参数说明： buf:数据  len:长度
+ - 返回说明： 0:已写入  1:缓冲区剩余空间不足（整段都不写入）
+ - 注：       只在主循环中调用；发送中断只推进tail，写入方独占head，不需要关中断
 ********************************************************************************************/
-void USART1_DoSum(int *Str, int len)
+uint8_t USART1_Write(const uint8_t *buf, uint8_t len)
 {
-    int xorsum = 0;
-    int i;
+    uint8_t head = usart1_tx_head;
+    uint8_t i;
 
+    if (len > USART1_TxFree()) return 1;
     for (i = 0; i < len; i++) {
-        xorsum = xorsum + Str[i];
+        usart1_tx_buf[head] = buf[i];
+        head                = (head + 1) & (USART1_TX_BUFFER_SIZE - 1);
     }
-    xorsum         = 0 - xorsum;
-    *(Str + i)     = (int)(xorsum >> 8);
-    *(Str + i + 1) = (int)(xorsum & 0x00ff);
+    usart1_tx_head = head;
+    USART1->CR1 |= USART_CR1_TXEIE; // 启动发送
+    return 0;
+}
+
+/********************************************************************************************
+ - 功能描述： 发送缓冲区剩余空间
+ - 返回说明： 可立即写入的字节数
+********************************************************************************************/
+uint8_t USART1_TxFree(void)
+{
+    return (uint8_t)((usart1_tx_tail - usart1_tx_head - 1) & (USART1_TX_BUFFER_SIZE - 1));
+}
+
+/********************************************************************************************
+ - 功能描述： MP3模块BUSY引脚
+ - 返回说明： 1:正在播放（引脚低电平）  0:空闲
+********************************************************************************************/
+uint8_t USART1_PlayerBusy(void)
+{
+    return GPIO_ReadInputDataBit(USART1_BUSY_GPIO_PORT, USART1_BUSY_GPIO_PIN) == Bit_RESET;
 }
 
 /********************************************************************************************
@@ -268,18 +271,14 @@ void USART1_DoSum(int *Str, int len)
               feedback:是否需要应答[0:不需要应答，1:需要应答]
               data:传送的参数
  - 返回说明：
- - 注：
+ - 注：       帧编码和校验见Voice_EncodeCmd；写入发送缓冲区后立即返回，缓冲区满时等待
 ********************************************************************************************/
 void Uart1_SendCMD(int CMD, int feedback, int dat)
 {
-    Send_buf[0] = 0xff;            // 保留字节
-    Send_buf[1] = 0x06;            // 长度
-    Send_buf[2] = CMD;             // 控制指令
-    Send_buf[3] = feedback;        // 是否需要反馈
-    Send_buf[4] = (int)(dat >> 8); // datah
-    Send_buf[5] = (int)(dat);      // datal
-    USART1_DoSum(&Send_buf[0], 6); // 校验     &Send_buf[0],6     取Send_buf[0]数组起始地址，长度6位
-    USART1_SendCmd(8);             // 发送此帧数据
+    uint8_t frame[VOICE_FRAME_LEN];
+
+    Voice_EncodeCmd(frame, (uint8_t)CMD, (uint8_t)feedback, (uint16_t)dat);
+    while (USART1_Write(frame, VOICE_FRAME_LEN));
 }
 
 /******************************************************************************
@@ -287,26 +286,16 @@ void Uart1_SendCMD(int CMD, int feedback, int dat)
 * 创建日期       ：  2022/09/25
 * 创建人         ：  志城
 
-* 函数功能       ：  将数据放入buf，等待后面依次发出
+* 函数功能       ：  发送不带校验的一帧：7E FF 06 CMD dat1 dat2 dat3 EF
 
 * 输入参数类型   ： int CMD ,int dat1 , int dat2 ,int dat3   一共四个参数，可根据需要进行加减
 
 * 输出参数类型   ：
 * 返回信息       ：
-* 内在逻辑       ： 串口2发送数据给PM3模块的内在逻辑应该是：
-                    1、在main函数的while()语句中，根据case值来调用：Uart_SendCMD(0x03,0,0x01);
-                    2、这串数据通过  USART1_SendCmd(6);函数里面的for循环，依次执行USART1_SendByte(Send_buf[i]);
-                       依次将Send_buf[0]、Send_buf[1]、Send_buf[8]  发送出来	。
-                    3、可按照需要加减输入参数即可得到自己想要的输出。
 *******************************************************************************/
 void Uart1_SendCMD2(int CMD, int dat1, int dat2, int dat3)
 {
-    Send_buf[0] = 0xff;        // 保留字节
-    Send_buf[1] = 0x06;        // 长度
-    Send_buf[2] = CMD;         // 控制指令
-    Send_buf[3] = (int)(dat1); //
-    Send_buf[4] = (int)(dat2); // datah2
-    Send_buf[5] = (int)(dat3); // datal3
-
-    USART1_SendCmd(6); // 发送此帧数据
+    uint8_t frame[8] = {0x7E, 0xFF, 0x06, (uint8_t)CMD, (uint8_t)dat1, (uint8_t)dat2, (uint8_t)dat3, 0xEF};
+
+    while (USART1_Write(frame, sizeof(frame)));
 }
@@ -1,10 +1,18 @@
 #ifndef __USART1_H
 #define __USART1_H
 
-#include "dk_C8T6.h" // Device header
+#include "DK_C8T6.h" // Device header
 
 #define EN_USART1_RX 1 // 使能（1）/禁止（0）串口1接收
 
+#define USART1_TX_BUFFER_SIZE 64 // 发送环形缓冲区大小，必须为2的幂且不超过256
+
+// MP3模块BUSY引脚（播放时低电平），未接时置0，播放结束按提示时长估计
+#define USART1_BUSY_EN        0
+#define USART1_BUSY_GPIO_PORT GPIOB
+#define USART1_BUSY_GPIO_PIN  GPIO_Pin_13
+#define USART1_BUSY_GPIO_CLK  RCC_APB2Periph_GPIOB
+
 extern u8 USART1_RX_STA; // 接收状态标记
 extern u8 USART1_RX_CMD;
 extern u8 USART1_NewCmd; // 新命令标志位，主循环检查后需要清零
@@ -14,10 +22,10 @@ void usart1_Init(u32 bound);
 void USART1_IRQHandler(void);
 
 void USART1_SendByte(uint8_t Data);
+uint8_t USART1_Write(const uint8_t *buf, uint8_t len); // 写入发送缓冲区，不等待，空间不足返回1
+uint8_t USART1_TxFree(void);                          // 发送缓冲区剩余空间
+uint8_t USART1_PlayerBusy(void);                      // MP3模块BUSY引脚，1为正在播放
 void Uart1_SendCMD(int CMD, int feedback, int dat);
 void Uart1_SendCMD2(int CMD, int dat1, int dat2, int dat3);
 
-void USART1_DoSum(int *Str, int len);
-void USART1_SendCmd(int len);
-
 #endif
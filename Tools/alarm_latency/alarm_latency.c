@@ -0,0 +1,314 @@
+/**
+ * @file     alarm_latency.c
+ * @brief    烟雾报警端到端延迟测量工具（主机端）
+ * @details  用固件的传感器调度（SensorHub.c）、控制逻辑（TrashBin.c、SmokeAnalytics.c）
+ *          和提示引擎（Annunciator.c）在虚拟时钟上运行，测量从烟雾出现到蜂鸣器开始鸣响的时间：
+ *          - 虚拟时钟以纳秒计；系统毫秒计数（TIM4每100个10us节拍）和SysTick（每1ms调用Annun_Tick）
+ *            是两个1ms时钟，相位随机，蜂鸣器音调由提示引擎输出
+ *          - 主循环每次执行 SensorHub_Poll、TrashBin_CheckSmoke、TrashBin_UpdateIndicators，
+ *            一次主循环的耗时在1~L毫秒内随机（模拟OLED刷新、超声波超时等造成的停顿）
+ *          - MQ2采样同固件：每5ms读一次ADC，10次平均为一个样本，每500ms一个样本
+ *          - 看门狗路径：ADC1连续转换（55.5周期采样+12.5周期转换，ADCCLK 12MHz，每次5.67us），
+ *            浓度超过看门狗阈值后的第一次转换结束时进入中断（中断进入12个周期），
+ *            中断中调用Annun_Set，同固件ADC1_2_IRQHandler；阈值按PPM比较（原始值与PPM单调对应）
+ *          - 主循环路径：关闭看门狗（硬件函数表中看门狗回调为NULL），只靠烟雾分析报警
+ *          - 烟雾输入：预热（60s）结束后随机时刻出现，阶跃（明火）或线性上升（阴燃）
+ *          每种组合重复多次（烟雾出现时刻相对采样、节拍和主循环的相位随机），输出延迟的最小/平均/P95/最大值
+ *
+ *          编译：gcc -O2 -I../../DK -o alarm_latency alarm_latency.c ../../DK/SensorHub.c ../../DK/TrashBin.c
+ *                ../../DK/Presence.c ../../DK/SmokeAnalytics.c ../../DK/FillLevel.c ../../DK/FillForecast.c
+ *                ../../DK/Annunciator.c -lm
+ *          用法：alarm_latency [-n 次数] [-s 随机种子]
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Config.h"
+#include "TrashBin.h"
+
+#define NS_PER_MS      1000000ULL
+#define ADC_CONV_NS    5667ULL  /**< 一次转换（68个ADC周期，12MHz） */
+#define ADC_SAMPLE_NS  4625ULL  /**< 采样结束时刻（55.5个ADC周期），之前的电平变化计入本次转换 */
+#define ISR_ENTRY_NS   167ULL   /**< 中断进入（12个72MHz周期） */
+#define BASE_PPM       80       /**< 烟雾出现前的浓度 */
+#define STEP_PPM       800      /**< 阶跃输入的浓度 */
+#define RAMP_PPM_S     30       /**< 线性上升输入的速率（PPM/秒） */
+#define ONSET_MIN_MS   (SMOKE_WARMUP_MS + 5000)
+#define ONSET_SPAN_MS  5000     /**< 烟雾出现时刻在ONSET_MIN_MS之后此范围内随机 */
+#define GIVE_UP_MS     30000    /**< 烟雾出现后超过此时间仍未报警记为未检出 */
+
+/* 与固件默认参数一致（见Config.c config_desc），Config.c依赖Flash驱动，主机端不能链接 */
+static const uint32_t sim_cfg[CFG_NUM] = {
+    [CFG_SMOKE_PPM] = 300, [CFG_CLEANUP_S] = 180, [CFG_CLOSE_CM] = 25, [CFG_CLOSE_DELAY_MS] = 1000,
+    [CFG_OPEN_CONF] = 60, [CFG_MQ2_R0_X100] = 980, [CFG_BIN_EMPTY_MM] = 600, [CFG_BIN_FULL_MM] = 100,
+    [CFG_MB_ADDR] = 0, [CFG_MB_BAUD] = 9600, [CFG_FAN_PPM] = 40, [CFG_FAN_TEMP] = 30,
+    [CFG_FAN_QUIET_PCT] = 40, [CFG_QUIET_START] = 22, [CFG_QUIET_END] = 7, [CFG_COMP_EN] = 0,
+    [CFG_COMP_STALL_MA] = 1500,
+};
+
+static uint64_t sim_ns;      /**< 虚拟时钟 */
+static uint32_t sim_ms;      /**< 系统毫秒计数（TIM4每100拍加1） */
+static uint8_t sim_ramp;     /**< 输入为线性上升 */
+static uint64_t onset_ns;    /**< 烟雾出现时刻 */
+static uint64_t alarm_ns;    /**< 蜂鸣器开始鸣响的时刻，0表示尚未鸣响 */
+static uint64_t adc_phase;   /**< ADC连续转换的相位 */
+static uint32_t rng = 1;     /**< 随机数状态 */
+
+static uint8_t awd_armed;    /**< 看门狗中断已使能 */
+static uint8_t awd_tripped;  /**< 看门狗已触发 */
+static uint32_t awd_trip_ms; /**< 触发时刻（毫秒） */
+static uint16_t awd_ppm;     /**< 看门狗阈值（PPM） */
+
+static uint32_t mq2_sum;     /**< 采样累加，同MQ2_PollPPM */
+static uint32_t mq2_last_ms;
+static uint8_t mq2_count;
+
+// 函数：伪随机数（xorshift32）
+static uint32_t Rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// 函数：t时刻的真实浓度
+static double Ppm(uint64_t t)
+{
+    double s;
+
+    if (t < onset_ns) return BASE_PPM;
+    if (!sim_ramp) return STEP_PPM;
+    s = (double)(t - onset_ns) / 1e9;
+    return BASE_PPM + RAMP_PPM_S * s;
+}
+
+// 函数：浓度超过阈值的时刻（输入单调，超过后不再回落）
+static uint64_t CrossTime(uint16_t thr)
+{
+    if (thr < BASE_PPM) return 0;
+    if (!sim_ramp) return onset_ns;
+    return onset_ns + (uint64_t)((double)(thr - BASE_PPM) / RAMP_PPM_S * 1e9) + 1;
+}
+
+/* MQ2采集：同固件Acquire_Smoke + MQ2_PollPPM，读数带±4PPM噪声 */
+static uint8_t Acquire_Smoke(int32_t *value, uint8_t *quality)
+{
+    if (mq2_count > 0 && sim_ms - mq2_last_ms < 5) return SENSOR_ACQ_BUSY;
+    mq2_sum += (uint32_t)(Ppm(sim_ns) + (int)(Rand() % 9) - 4);
+    mq2_last_ms = sim_ms;
+    if (++mq2_count < 10) return SENSOR_ACQ_BUSY;
+
+    *value    = (int32_t)(mq2_sum / 10);
+    *quality  = SENSOR_Q_OK;
+    mq2_sum   = 0;
+    mq2_count = 0;
+    return SENSOR_ACQ_DONE;
+}
+
+static const SensorDesc_t smoke_desc = {"smoke", 500, SENSOR_BUS_ADC, Acquire_Smoke};
+
+/* 垃圾桶硬件函数表 */
+static uint8_t Hw_Read(void *ctx, uint8_t id, SensorSample_t *out)
+{
+    (void)ctx;
+    return SensorHub_Read(id, out);
+}
+
+static uint8_t Hw_Lid(void *ctx, uint8_t open)
+{
+    (void)ctx;
+    return open;
+}
+
+static void Hw_Indicate(void *ctx, uint16_t alarms)
+{
+    (void)ctx;
+    Annun_SetAll(alarms);
+}
+
+static uint8_t Hw_AwdTripped(void *ctx, uint32_t *trip_ms)
+{
+    (void)ctx;
+    if (trip_ms != NULL) *trip_ms = awd_trip_ms;
+    return awd_tripped;
+}
+
+static uint8_t Hw_AwdRearm(void *ctx) // 同MQ2_AWD_Rearm：最新转换仍超限时不使能
+{
+    (void)ctx;
+    if (Ppm(sim_ns) > awd_ppm) return 0;
+    awd_tripped = 0;
+    awd_armed   = 1;
+    return 1;
+}
+
+static void Hw_AwdSet(void *ctx, uint16_t ppm)
+{
+    (void)ctx;
+    awd_ppm = ppm;
+}
+
+static const TrashBinHw_t hw_awd  = {Hw_Read, Hw_Lid, Hw_Indicate, NULL, Hw_AwdTripped, Hw_AwdRearm, Hw_AwdSet, 50};
+static const TrashBinHw_t hw_loop = {Hw_Read, Hw_Lid, Hw_Indicate, NULL, NULL, NULL, NULL, 50};
+
+/* 提示引擎输出 */
+static void Ind_Leds(uint8_t changed, uint8_t leds)
+{
+    (void)changed;
+    (void)leds;
+}
+
+static void Ind_Tone(uint16_t hz)
+{
+    if (hz && alarm_ns == 0 && sim_ns >= onset_ns) alarm_ns = sim_ns;
+}
+
+static const AnnunHw_t ind_hw = {Ind_Leds, Ind_Tone};
+
+// 函数：看门狗中断，同固件ADC1_2_IRQHandler
+static void Awd_Isr(void)
+{
+    awd_armed   = 0;
+    awd_trip_ms = sim_ms;
+    awd_tripped = 1;
+    Annun_Set(ANNUN_ID_SMOKE, 1);
+}
+
+// 函数：[from, to)内看门狗是否触发，触发时返回中断时刻
+static uint64_t Awd_Check(uint64_t from, uint64_t to)
+{
+    uint64_t t = CrossTime(awd_ppm), k, eoc;
+
+    if (!awd_armed || awd_tripped) return 0;
+    if (t < from) t = from; // 使能时已超限：下一次转换即触发
+    // 第一个采样结束时刻不早于t的转换
+    k   = (t + ADC_CONV_NS - adc_phase - ADC_SAMPLE_NS - 1) / ADC_CONV_NS;
+    eoc = adc_phase + k * ADC_CONV_NS + ADC_CONV_NS;
+    if (eoc + ISR_ENTRY_NS >= to) return 0;
+    return eoc + ISR_ENTRY_NS;
+}
+
+/**
+ * @brief  运行一次：返回烟雾出现到鸣响的延迟（纳秒），未检出返回0
+ */
+static uint64_t Trial(uint8_t use_awd, uint8_t ramp, uint32_t loop_max_ms)
+{
+    static TrashBin_t bin;
+    uint64_t next_loop, next_systick, tick_end, isr_ns, end_ns, t;
+
+    sim_ramp     = ramp;
+    sim_ns       = 0;
+    sim_ms       = 0;
+    alarm_ns     = 0;
+    awd_armed    = 0;
+    awd_tripped  = 0;
+    awd_ppm      = (uint16_t)sim_cfg[CFG_SMOKE_PPM];
+    mq2_sum      = 0;
+    mq2_count    = 0;
+    onset_ns     = (ONSET_MIN_MS + Rand() % ONSET_SPAN_MS) * NS_PER_MS + Rand() % NS_PER_MS;
+    adc_phase    = Rand() % ADC_CONV_NS;
+    end_ns       = onset_ns + GIVE_UP_MS * NS_PER_MS;
+    next_loop    = Rand() % NS_PER_MS;
+    next_systick = Rand() % NS_PER_MS;
+
+    SensorHub_Init();
+    SensorHub_Register(SENSOR_ID_SMOKE, &smoke_desc);
+    Annun_SetAll(0);
+    Annun_Init(&ind_hw);
+    TrashBin_Init(&bin, use_awd ? &hw_awd : &hw_loop, NULL, sim_cfg, 0, 0);
+
+    while (alarm_ns == 0 && sim_ns < end_ns) {
+        tick_end = (uint64_t)(sim_ms + 1) * NS_PER_MS; // 下一次系统毫秒计数加1
+
+        /* 本毫秒内的看门狗中断、SysTick和主循环按时间顺序执行 */
+        isr_ns = Awd_Check(sim_ns, tick_end);
+        for (;;) {
+            t = (next_loop < next_systick) ? next_loop : next_systick;
+            if (isr_ns && isr_ns <= t) {
+                sim_ns = isr_ns;
+                Awd_Isr();
+                isr_ns = 0;
+                continue;
+            }
+            if (t >= tick_end) break;
+            sim_ns = t;
+            if (t == next_systick) { // SysTick 1ms：推进提示引擎
+                Annun_Tick();
+                next_systick += NS_PER_MS;
+                continue;
+            }
+            SensorHub_Poll(sim_ms);
+            TrashBin_CheckSmoke(&bin);
+            TrashBin_UpdateIndicators(&bin);
+            next_loop += NS_PER_MS + Rand() % (loop_max_ms * NS_PER_MS - NS_PER_MS + 1);
+            if (!isr_ns) isr_ns = Awd_Check(sim_ns, tick_end); // 主循环可能刚使能看门狗
+        }
+
+        sim_ns = tick_end;
+        sim_ms++;
+    }
+    return alarm_ns ? alarm_ns - onset_ns : 0;
+}
+
+static int Cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t loops[] = {3, 40, 120};
+    unsigned n = 200, i, j, k, hit;
+    uint64_t *lat, sum;
+    uint8_t ramp, awd;
+    int c;
+
+    for (c = 1; c < argc; c++) {
+        if (strcmp(argv[c], "-n") == 0 && c + 1 < argc) {
+            n = (unsigned)atoi(argv[++c]);
+        } else if (strcmp(argv[c], "-s") == 0 && c + 1 < argc) {
+            rng = (uint32_t)strtoul(argv[++c], NULL, 0);
+            if (rng == 0) rng = 1;
+        } else {
+            fprintf(stderr, "usage: %s [-n trials] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (n == 0) n = 1;
+    lat = malloc(n * sizeof(*lat));
+    if (lat == NULL) return 1;
+
+    printf("%-6s %-5s %8s %6s %12s %12s %12s %12s\n", "input", "path", "loop_ms", "hits", "min_ms", "avg_ms", "p95_ms",
+           "max_ms");
+    for (ramp = 0; ramp < 2; ramp++) {
+        for (awd = 0; awd < 2; awd++) {
+            for (j = 0; j < sizeof(loops) / sizeof(loops[0]); j++) {
+                hit = 0;
+                sum = 0;
+                for (i = 0; i < n; i++) {
+                    uint64_t t = Trial(awd, ramp, loops[j]);
+                    if (t) {
+                        lat[hit++] = t;
+                        sum += t;
+                    }
+                }
+                qsort(lat, hit, sizeof(*lat), Cmp);
+                k = hit ? (hit * 95 + 99) / 100 - 1 : 0;
+                printf("%-6s %-5s %5s1-%-3u %3u/%-3u", ramp ? "ramp" : "step", awd ? "awd" : "loop", "", loops[j], hit, n);
+                if (hit) {
+                    printf(" %12.3f %12.3f %12.3f %12.3f\n", lat[0] / 1e6, sum / 1e6 / hit, lat[k] / 1e6, lat[hit - 1] / 1e6);
+                } else {
+                    printf(" %12s %12s %12s %12s\n", "-", "-", "-", "-");
+                }
+            }
+        }
+    }
+    free(lat);
+    return 0;
+}
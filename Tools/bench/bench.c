@@ -0,0 +1,635 @@
+/**
+ * @file     bench.c
+ * @brief    驱动热路径基准测试固件（目标板/QEMU）
+ * @details  独立的固件镜像，循环运行各驱动和算法模块的热路径并统计每次调用的周期数，
+ *          用于在没有开发板的CI中跟踪周期级的性能回退：
+ *          - OLED整屏刷新和一行区域刷新（软件I2C）、后台刷新每个节拍、OLED格式化输出、字符串格式化
+ *          - MQ2 PPM特性曲线换算、超声波回波时间换算距离
+ *          - 烟雾分析、满溢估计、接近检测的单样本更新
+ *          - Modbus CRC16（软件）、CRC32（硬件CRC单元）、Modbus 04请求处理
+ *          - RAMFUNC函数：OLED/DS1302总线收发一个字节；
+ *          - 软件总线改用快速GPIO前后的对比（_ref项为改动前的StdPeriph写法，复制在本文件中）：
+ *            OLED I2C发送一个字节、DS1302写一个字节/读一个寄存器、超声波触发边沿和回波查询、键盘无按键时扫描一遍；
+ *            键盘列线（PB12~PB15，上拉）读到低电平时跳过键盘项（QEMU不模拟GPIO，读数为0），
+ *            行线PA8~PA11不初始化（PA9为输出串口），只写ODR；
+ *            _ref项放在flash，与RAMFUNC=0的镜像比较时两者放置方式相同
+ *            中断往返（挂起到返回）：空中断（中断进入/退出延迟）、TIM4、USART1、USART3中断服务函数
+ *          放在SRAM与放在flash的对比：分别运行make bench和make bench RAMFUNC=0的镜像
+ *          每项先预热一次，再运行BENCH_REPEAT轮取最小值，输出为每次调用的周期数
+ *
+ *          计时：DWT周期计数器在运行时使用DWT（目标板，精确周期数）；
+ *          计数器不走时（QEMU不模拟DWT）改用SysTick（处理器时钟，24位，中断计溢出），
+ *          同时跳过软件I2C的总线保持延时，此时结果为QEMU虚拟时钟周期，
+ *          配合-icount运行结果可重复，只与QEMU下的结果比较；
+ *          QEMU不模拟flash等待周期，RAMFUNC的效果只能在目标板上测量
+ *
+ *          输出：默认USART1（PA9，115200 8N1）；定义BENCH_SEMIHOST时使用半主机输出，
+ *          结束时通过半主机退出（QEMU返回），目标板需连接调试器
+ *          每项一行，格式为"BENCH <名称> <周期数> <轮次>"，便于脚本提取；
+ *          总线项在末尾追加每秒字节数（按SystemCoreClock换算，QEMU下只用于相对比较），
+ *          跳过的项输出"BENCH <名称> skip"
+ *
+ *          编译：make bench（USART1输出）或 make bench-qemu（半主机输出并在QEMU中运行）
+ *          运行：qemu-system-arm -M stm32vldiscovery -display none -semihosting-config enable=on,target=native
+ *                -icount shift=5 -kernel build/gcc/bench-qemu/bench.elf
+ *          镜像按8KB SRAM链接（bench.ld），可同时运行在STM32F103C8和QEMU的STM32F100上
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "stm32f10x.h"
+#include "Delay.h"
+#include "OLED.h"
+#include "mq2.h"
+#include "RangeCal.h"
+#include "SmokeAnalytics.h"
+#include "FillLevel.h"
+#include "Presence.h"
+#include "Modbus.h"
+#include "ds1302.h"
+#include "HC_SR04.h"
+#include "Key.h"
+#include "FastGPIO.h"
+#include "RamFunc.h"
+
+#define BENCH_REPEAT    5        /**< 每项运行轮数，取最小值 */
+#define BENCH_BAUD      115200   /**< USART1波特率 */
+#define BENCH_CRC_BYTES 256      /**< CRC测试数据长度 */
+#define BENCH_SYSTICK   0xFFFFFF /**< SysTick重装值 */
+#define BENCH_KEY_COLS  (GPIO_Pin_12 | GPIO_Pin_13 | GPIO_Pin_14 | GPIO_Pin_15) /**< 键盘列线 */
+#define BENCH_KEY_ROWS  (GPIO_Pin_8 | GPIO_Pin_9 | GPIO_Pin_10 | GPIO_Pin_11)   /**< 键盘行线 */
+
+/**
+ * @brief 测试项
+ */
+typedef struct
+{
+    const char *name;        /**< 名称 */
+    void (*run)(uint32_t n); /**< 运行n次 */
+    uint32_t iters;          /**< 每轮次数 */
+    uint32_t bytes;          /**< 每次调用在总线上传输的字节数，非0时输出每秒字节数 */
+    uint8_t (*ready)(void);  /**< 运行条件，NULL为总是运行 */
+} Bench_t;
+
+static uint8_t bench_dwt;                       /**< DWT周期计数器可用 */
+static volatile uint32_t bench_wraps;           /**< SysTick溢出次数 */
+static volatile uint32_t bench_sink;            /**< 防止结果被优化掉 */
+static uint32_t bench_buf[BENCH_CRC_BYTES / 4]; /**< CRC测试数据（按字对齐） */
+static char bench_line[64];                     /**< 格式化缓冲 */
+static Smoke_t bench_smoke;                     /**< 烟雾分析实例 */
+static Fill_t bench_fill;                       /**< 满溢估计实例 */
+static Presence_t bench_presence;               /**< 接近检测实例 */
+static uint32_t bench_t_ms;                     /**< 各算法模块的样本时间 */
+
+void OLED_I2C_SendByte(uint8_t Byte); // OLED.c内部函数
+
+/* ---------------- 计时 ---------------- */
+
+/**
+ * @brief SysTick溢出计数（仅DWT不可用时使能）
+ */
+void SysTick_Handler(void)
+{
+    bench_wraps++;
+}
+
+/**
+ * @brief  读取周期计数
+ * @return 32位周期数，按无符号差值使用
+ */
+static uint32_t Bench_Cycles(void)
+{
+    uint32_t hi, lo;
+
+    if (bench_dwt) return DELAY_DWT_CYCCNT;
+    do {
+        hi = bench_wraps;
+        lo = SysTick->VAL;
+    } while (hi != bench_wraps); // 读取期间溢出则重读
+    return (hi << 24) + (BENCH_SYSTICK - lo);
+}
+
+/**
+ * @brief  选择计时源
+ * @details Delay_Init已使能DWT，计数器不走时改用SysTick，
+ *          并把Delay_Cycles的开销设为最大，使总线保持延时直接返回
+ */
+static void Bench_TimerInit(void)
+{
+    uint32_t t0;
+    volatile uint32_t i;
+
+    Delay_Init();
+    t0 = DELAY_DWT_CYCCNT;
+    for (i = 0; i < 100; i++);
+    bench_dwt = (DELAY_DWT_CYCCNT != t0);
+    if (bench_dwt) return;
+
+    Delay_Overhead = 0xFFFFFFFF;
+    SysTick->LOAD  = BENCH_SYSTICK;
+    SysTick->VAL   = 0;
+    SysTick->CTRL  = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/* ---------------- 输出 ---------------- */
+
+#ifdef BENCH_SEMIHOST
+/**
+ * @brief  半主机调用
+ * @param  op  操作号
+ * @param  arg 参数
+ * @return 返回值
+ */
+static int Bench_Semihost(int op, void *arg)
+{
+    register int r0 __asm("r0")   = op;
+    register void *r1 __asm("r1") = arg;
+
+    __ASM volatile("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+static void Bench_OutInit(void)
+{
+}
+
+static void Bench_Puts(const char *s)
+{
+    Bench_Semihost(0x04, (void *)s); // SYS_WRITE0
+}
+
+static void Bench_Exit(void)
+{
+    Bench_Semihost(0x18, (void *)0x20026); // SYS_EXIT，ADP_Stopped_ApplicationExit
+    while (1);
+}
+#else
+static void Bench_OutInit(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    USART_InitTypeDef USART_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1 | RCC_APB2Periph_GPIOA, ENABLE);
+
+    GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_9; // TX
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_AF_PP;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    USART_InitStructure.USART_BaudRate            = BENCH_BAUD;
+    USART_InitStructure.USART_WordLength          = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits            = USART_StopBits_1;
+    USART_InitStructure.USART_Parity              = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode                = USART_Mode_Tx;
+    USART_Init(USART1, &USART_InitStructure);
+    USART_Cmd(USART1, ENABLE);
+}
+
+static void Bench_Puts(const char *s)
+{
+    while (*s) {
+        if (*s == '\n') {
+            while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+            USART_SendData(USART1, '\r');
+        }
+        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+        USART_SendData(USART1, *s++);
+    }
+}
+
+static void Bench_Exit(void)
+{
+    while (1);
+}
+#endif
+
+/* ---------------- 测试项 ---------------- */
+
+static void Run_OledFlush(uint32_t n)
+{
+    while (n--) OLED_Update();
+}
+
+static void Run_OledArea(uint32_t n)
+{
+    while (n--) OLED_UpdateArea(0, 16, 128, 16); // 一行8x16文字
+}
+
+static void Run_OledTick(uint32_t n) // 后台刷新中每个TIM4节拍的耗时
+{
+    while (n--) {
+        if (!OLED_IsBusy()) OLED_Present();
+        OLED_Tick();
+    }
+}
+
+static void Run_OledPrintf(uint32_t n)
+{
+    while (n--) OLED_Printf(0, 16, OLED_8X16, "PPM:%4d T:%2d", (int)(n & 1023), 25);
+}
+
+static void Run_Sprintf(uint32_t n)
+{
+    while (n--) {
+        sprintf(bench_line, "%lu,%u,%u,%d", (unsigned long)n, 512u, 37u, -12);
+        bench_sink += (uint8_t)bench_line[0];
+    }
+}
+
+static void Run_Mq2Ppm(uint32_t n)
+{
+    while (n--) bench_sink += MQ2_PPMToRaw((uint16_t)(100 + (n & 1023)), 9.8f);
+}
+
+static void Run_SonarMm(uint32_t n)
+{
+    while (n--) bench_sink += RangeCal_TicksToMm(500 + (n & 4095));
+}
+
+static void Run_Smoke(uint32_t n)
+{
+    while (n--) {
+        bench_t_ms += 500;
+        bench_sink += Smoke_Update(&bench_smoke, bench_t_ms, (uint16_t)(40 + (n & 7)), 1);
+    }
+}
+
+static void Run_Fill(uint32_t n)
+{
+    FillInput_t in;
+
+    memset(&in, 0, sizeof(in));
+    in.range_valid = 1;
+    while (n--) {
+        bench_t_ms += 1000;
+        in.t_ms     = bench_t_ms;
+        in.range_mm = (uint16_t)(400 + (n & 15));
+        bench_sink += Fill_Update(&bench_fill, &in);
+    }
+}
+
+static void Run_Presence(uint32_t n)
+{
+    PresenceInput_t in;
+
+    memset(&in, 0, sizeof(in));
+    in.range_valid = 1;
+    while (n--) {
+        bench_t_ms += 60;
+        in.t_ms     = bench_t_ms;
+        in.range_mm = (uint16_t)(300 + (n & 511)); // 远近往复
+        bench_sink += Presence_Update(&bench_presence, &in);
+    }
+}
+
+static void Run_Crc16(uint32_t n)
+{
+    while (n--) bench_sink += Modbus_CRC16((const uint8_t *)bench_buf, BENCH_CRC_BYTES);
+}
+
+static void Run_Crc32Hw(uint32_t n)
+{
+    while (n--) {
+        CRC_ResetDR();
+        bench_sink += CRC_CalcBlockCRC(bench_buf, BENCH_CRC_BYTES / 4);
+    }
+}
+
+static uint8_t Bench_MbRead(void *ctx, uint8_t table, uint16_t reg, uint16_t *value)
+{
+    (void)ctx;
+    (void)table;
+    *value = reg * 3;
+    return MODBUS_EX_NONE;
+}
+
+static uint8_t Bench_MbWrite(void *ctx, uint16_t reg, const uint8_t *data, uint16_t count)
+{
+    (void)ctx;
+    (void)reg;
+    (void)data;
+    (void)count;
+    return MODBUS_EX_NONE;
+}
+
+static void Run_ModbusFc04(uint32_t n)
+{
+    static Modbus_Slave_t slave = {1, NULL, Bench_MbRead, Bench_MbWrite, 0, 0, 0};
+    static uint8_t rsp[MODBUS_FRAME_MAX];
+    uint8_t req[8] = {1, MODBUS_FC_READ_INPUT, 0, 0, 0, 21};
+    uint16_t crc   = Modbus_CRC16(req, 6);
+
+    req[6] = (uint8_t)crc;
+    req[7] = (uint8_t)(crc >> 8);
+    while (n--) bench_sink += Modbus_Process(&slave, req, sizeof(req), rsp);
+}
+
+static void Run_OledByte(uint32_t n)
+{
+    while (n--) OLED_I2C_SendByte(0xA5);
+}
+
+static void Run_DsWrite(uint32_t n)
+{
+    while (n--) DS1302_write_onebyte(0x55);
+}
+
+static void Run_DsRead(uint32_t n)
+{
+    while (n--) bench_sink += DS1302_read_rig(0x81);
+}
+
+static void Run_SonarIo(uint32_t n) // 一对触发边沿和一次回波查询，查询开销决定回波计时的分辨率
+{
+    while (n--) {
+        FGPIO_H(HC_SR04_TRIG);
+        FGPIO_L(HC_SR04_TRIG);
+        bench_sink += !!FGPIO_IN(HC_SR04_ECHO);
+    }
+}
+
+static void Run_KeyScan(uint32_t n)
+{
+    while (n--) bench_sink += Key_GetNum();
+}
+
+/* ---------------- 改动前的总线写法（对比用） ---------------- */
+
+// 函数：OLED I2C发送一个字节，每个边沿调用一次GPIO_WriteBit
+static void Ref_OledSendByte(uint8_t Byte)
+{
+    uint8_t i;
+
+    for (i = 0; i < 8; i++) {
+        GPIO_WriteBit(GPIOB, GPIO_Pin_9, (BitAction)!!(Byte & (0x80 >> i)));
+        GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_SET);
+        GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_RESET);
+    }
+    GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_SET);
+    GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_RESET);
+}
+
+// 函数：DS1302数据线方向切换，每次调用GPIO_Init
+static void Ref_DsData(GPIOMode_TypeDef mode)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    RCC_APB2PeriphClockCmd(DS1302_CLK, ENABLE);
+    GPIO_InitStructure.GPIO_Pin   = DS1302_DATA_PIN;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_Mode  = mode;
+    GPIO_Init(DS1302_DATA_PORT, &GPIO_InitStructure);
+}
+
+// 函数：DS1302写一个字节
+static void Ref_DsWriteByte(uint8_t data)
+{
+    uint8_t i;
+
+    GPIO_ResetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+    Ref_DsData(GPIO_Mode_Out_PP);
+    GPIO_ResetBits(DS1302_DATA_PORT, DS1302_DATA_PIN);
+    for (i = 0; i < 8; i++) {
+        GPIO_ResetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+        if (data & 0x01) {
+            GPIO_SetBits(DS1302_DATA_PORT, DS1302_DATA_PIN);
+        } else {
+            GPIO_ResetBits(DS1302_DATA_PORT, DS1302_DATA_PIN);
+        }
+        GPIO_SetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+        data >>= 1;
+    }
+}
+
+// 函数：DS1302读一个寄存器，保留原来的3/5/30us延时
+static uint8_t Ref_DsReadRig(uint8_t address)
+{
+    uint8_t i, data = 0;
+
+    GPIO_ResetBits(DS1302_CE_PORT, DS1302_CE_PIN);
+    GPIO_ResetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+    Delay_us(3);
+    GPIO_SetBits(DS1302_CE_PORT, DS1302_CE_PIN);
+    Delay_us(3);
+    Ref_DsWriteByte(address);
+    Ref_DsData(GPIO_Mode_IN_FLOATING);
+    Delay_us(3);
+    for (i = 0; i < 8; i++) {
+        Delay_us(3);
+        data >>= 1;
+        GPIO_SetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+        Delay_us(5);
+        GPIO_ResetBits(DS1302_SCLK_PORT, DS1302_SCLK_PIN);
+        Delay_us(30);
+        if (GPIO_ReadInputDataBit(DS1302_DATA_PORT, DS1302_DATA_PIN)) data |= 0x80;
+    }
+    Delay_us(2);
+    GPIO_ResetBits(DS1302_CE_PORT, DS1302_CE_PIN);
+    GPIO_ResetBits(DS1302_DATA_PORT, DS1302_DATA_PIN);
+    return data;
+}
+
+// 函数：键盘扫描一遍，逐行GPIO_WriteBit，逐列GPIO_ReadInputDataBit
+static uint8_t Ref_KeyScan(void)
+{
+    static const uint16_t rowPins[4] = {GPIO_Pin_11, GPIO_Pin_10, GPIO_Pin_9, GPIO_Pin_8};
+    static const uint16_t colPins[4] = {GPIO_Pin_15, GPIO_Pin_14, GPIO_Pin_13, GPIO_Pin_12};
+    uint8_t row, col, key = 0;
+
+    for (row = 0; row < 4 && !key; row++) {
+        GPIO_WriteBit(GPIOA, rowPins[0], (row == 0) ? Bit_RESET : Bit_SET);
+        GPIO_WriteBit(GPIOA, rowPins[1], (row == 1) ? Bit_RESET : Bit_SET);
+        GPIO_WriteBit(GPIOA, rowPins[2], (row == 2) ? Bit_RESET : Bit_SET);
+        GPIO_WriteBit(GPIOA, rowPins[3], (row == 3) ? Bit_RESET : Bit_SET);
+        for (col = 0; col < 4; col++) {
+            if (GPIO_ReadInputDataBit(GPIOB, colPins[col]) == 0) {
+                key = (3 - col) * 4 + (3 - row) + 1; // 不等待释放，列线空闲时不会走到这里
+                break;
+            }
+        }
+        GPIO_SetBits(GPIOA, BENCH_KEY_ROWS);
+    }
+    return key;
+}
+
+static void Run_OledByteRef(uint32_t n)
+{
+    while (n--) Ref_OledSendByte(0xA5);
+}
+
+static void Run_DsWriteRef(uint32_t n)
+{
+    while (n--) Ref_DsWriteByte(0x55);
+}
+
+static void Run_DsReadRef(uint32_t n)
+{
+    while (n--) bench_sink += Ref_DsReadRig(0x81);
+}
+
+static void Run_SonarIoRef(uint32_t n)
+{
+    while (n--) {
+        GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_SET);
+        GPIO_WriteBit(ULTRASONIC_GPIO_PORT, TRIG_GPIO_PIN, Bit_RESET);
+        bench_sink += GPIO_ReadInputDataBit(ULTRASONIC_GPIO_PORT, ECHO_GPIO_PIN);
+    }
+}
+
+static void Run_KeyScanRef(uint32_t n)
+{
+    while (n--) bench_sink += Ref_KeyScan();
+}
+
+/**
+ * @brief  键盘项的运行条件：列线全部为高（没有按键，也没有被其他电路拉低）
+ * @return 1可以运行，0跳过
+ */
+static uint8_t Bench_KeyIdle(void)
+{
+    return (GPIOB->IDR & BENCH_KEY_COLS) == BENCH_KEY_COLS;
+}
+
+/**
+ * @brief 空中断，测量中断进入/退出本身的延迟（与被测函数放置方式相同）
+ */
+RAMFUNC void TAMPER_IRQHandler(void)
+{
+}
+
+/**
+ * @brief  挂起一个中断n次，每次等中断返回后再挂起下一次
+ * @param  irq 中断号
+ * @param  n   次数
+ */
+static void Bench_Irq(IRQn_Type irq, uint32_t n)
+{
+    NVIC_EnableIRQ(irq);
+    while (n--) {
+        NVIC_SetPendingIRQ(irq);
+        __DSB();
+        __ISB(); // 中断在此之前进入并返回
+    }
+    NVIC_DisableIRQ(irq);
+}
+
+static void Run_IrqEmpty(uint32_t n)
+{
+    Bench_Irq(TAMPER_IRQn, n);
+}
+
+/* 目标板上UG事件置位更新标志，中断服务函数完整运行一次；QEMU下只有挂起，标志为0 */
+static void Run_IrqTim4(uint32_t n)
+{
+    NVIC_EnableIRQ(TIM4_IRQn);
+    while (n--) {
+        TIM4->EGR = TIM_EGR_UG;
+        NVIC_SetPendingIRQ(TIM4_IRQn);
+        __DSB();
+        __ISB();
+    }
+    NVIC_DisableIRQ(TIM4_IRQn);
+}
+
+static void Run_IrqUsart1(uint32_t n)
+{
+    Bench_Irq(USART1_IRQn, n);
+}
+
+static void Run_IrqUsart3(uint32_t n)
+{
+    Bench_Irq(USART3_IRQn, n);
+}
+
+static const Bench_t bench_list[] = {
+    {"oled_flush", Run_OledFlush, 2, 1024}, // 只计显存字节
+    {"oled_area", Run_OledArea, 10},
+    {"oled_tick", Run_OledTick, 9310}, // 整屏一帧的节拍数，每轮结束时后台刷新恰好空闲
+    {"oled_printf", Run_OledPrintf, 20},
+    {"sprintf", Run_Sprintf, 50},
+    {"mq2_ppm", Run_Mq2Ppm, 50},
+    {"sonar_mm", Run_SonarMm, 200},
+    {"smoke_update", Run_Smoke, 200},
+    {"fill_update", Run_Fill, 200},
+    {"presence_update", Run_Presence, 200},
+    {"crc16_256", Run_Crc16, 20},
+    {"crc32_hw_256", Run_Crc32Hw, 50},
+    {"modbus_fc04", Run_ModbusFc04, 50},
+    {"oled_sendbyte", Run_OledByte, 50, 1},
+    {"oled_sendbyte_ref", Run_OledByteRef, 50, 1},
+    {"ds1302_write", Run_DsWrite, 50, 1},
+    {"ds1302_write_ref", Run_DsWriteRef, 50, 1},
+    {"ds1302_read", Run_DsRead, 20, 2}, // 地址字节和数据字节
+    {"ds1302_read_ref", Run_DsReadRef, 20, 2},
+    {"sonar_io", Run_SonarIo, 200},
+    {"sonar_io_ref", Run_SonarIoRef, 200},
+    {"key_scan", Run_KeyScan, 50, 0, Bench_KeyIdle},
+    {"key_scan_ref", Run_KeyScanRef, 50, 0, Bench_KeyIdle},
+    {"irq_empty", Run_IrqEmpty, 100},
+    {"irq_tim4", Run_IrqTim4, 100},
+    {"irq_usart1", Run_IrqUsart1, 100},
+    {"irq_usart3", Run_IrqUsart3, 100},
+};
+
+int main(void)
+{
+    uint32_t i, k, t0, best, cycles;
+    GPIO_InitTypeDef GPIO_InitStructure;
+
+    Bench_OutInit();
+    Bench_TimerInit();
+    OLED_Init();
+    RangeCal_Init();
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    DS1302_GPIO_Init();
+    HC_SR04_Init();
+    GPIO_InitStructure.GPIO_Pin  = BENCH_KEY_COLS; // 键盘只初始化列线，Key_Init会把PA9改为推挽输出
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_Init(GPIOB, &GPIO_InitStructure);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM4 | RCC_APB1Periph_USART3, ENABLE);
+    TIM4->DIER = TIM_DIER_UIE; // 计数器不启动，只由UG事件产生更新中断
+    Smoke_Init(&bench_smoke, NULL);
+    Fill_Init(&bench_fill, NULL);
+    Presence_Init(&bench_presence, NULL);
+    for (i = 0; i < BENCH_CRC_BYTES; i++) ((uint8_t *)bench_buf)[i] = (uint8_t)(i * 7 + 1);
+
+#ifdef RAMFUNC_DISABLE
+    sprintf(bench_line, "bench: timer=%s clk=%luHz ramfunc=off\n", bench_dwt ? "dwt" : "systick", (unsigned long)SystemCoreClock);
+#else
+    sprintf(bench_line, "bench: timer=%s clk=%luHz ramfunc=on\n", bench_dwt ? "dwt" : "systick", (unsigned long)SystemCoreClock);
+#endif
+    Bench_Puts(bench_line);
+
+    for (i = 0; i < sizeof(bench_list) / sizeof(bench_list[0]); i++) {
+        const Bench_t *b = &bench_list[i];
+
+        if (b->ready != NULL && !b->ready()) {
+            sprintf(bench_line, "BENCH %s skip\n", b->name);
+            Bench_Puts(bench_line);
+            continue;
+        }
+        b->run(1); // 预热
+        best = 0xFFFFFFFF;
+        for (k = 0; k < BENCH_REPEAT; k++) {
+            t0     = Bench_Cycles();
+            b->run(b->iters);
+            cycles = Bench_Cycles() - t0;
+            if (cycles < best) best = cycles;
+        }
+        if (b->bytes) {
+            sprintf(bench_line, "BENCH %s %lu %lu %lu\n", b->name, (unsigned long)(best / b->iters), (unsigned long)b->iters,
+                    (unsigned long)((uint64_t)SystemCoreClock * b->bytes * b->iters / best));
+        } else {
+            sprintf(bench_line, "BENCH %s %lu %lu\n", b->name, (unsigned long)(best / b->iters), (unsigned long)b->iters);
+        }
+        Bench_Puts(bench_line);
+    }
+
+    Bench_Puts("bench: done\n");
+    Bench_Exit();
+    return 0;
+}
@@ -0,0 +1,752 @@
+/**
+ * @file     fleet_sim.c
+ * @brief    垃圾桶群仿真工具（主机端，多线程）
+ * @details  用固件的控制逻辑（TrashBin.c及其算法模块）仿真整个城市的垃圾桶，
+ *          用于评估网关和后台的容量：
+ *          - 每个桶是一个TrashBin_t实例，硬件函数表接到模拟驱动：
+ *            按合成的使用轨迹生成接近测距、满溢测距、双红外和MQ2样本，记录开关盖和指示灯
+ *          - 使用轨迹：每个桶有自己的基础来访率，按24小时日曲线调制，泊松到达；
+ *            每次来访走近、停留投放、离开；满溢度超过收运线后数小时内被清空；
+ *            烟雾基线带噪声，极少数桶出现烟雾事件
+ *          - 所有桶按虚拟时间以固定步长运行固件主循环的各步骤；
+ *            每个上报周期为一个时间片，时间片内各桶互不依赖，分块后交给工作窃取线程池：
+ *            每个线程有自己的任务队列，从队尾取任务，队列空时随机从其他线程队首窃取
+ *          - 每个上报周期结束时，对每个桶用Modbus 04功能码读全部输入寄存器，
+ *            应答由固件协议模块（Modbus.c）生成，寄存器映射与固件一致，解析后汇总；
+ *            每247个桶为一条RS-485总线，按轮询字节数估算总线占用
+ *          - 每个桶的随机数独立播种，结果与线程数无关（输出遥测校验和用于核对）
+ *          - 统计每墙钟秒仿真的桶·秒数；-S 依次用1、2、4…N个线程运行，输出加速比
+ *
+ *          抓包文件（-w）：每条记录为 时间(秒,4字节小端) + 总线号(2字节小端) + 长度(1字节) + 应答帧（原样RTU字节，含CRC）
+ *
+ *          编译：gcc -O2 -pthread -I../../DK -o fleet_sim fleet_sim.c ../../DK/TrashBin.c ../../DK/Presence.c
+ *                ../../DK/SmokeAnalytics.c ../../DK/FillLevel.c ../../DK/FillForecast.c ../../DK/Modbus.c -lm
+ *          用法：fleet_sim [-n 桶数] [-d 仿真小时] [-j 线程数] [-p 步长ms] [-t 上报周期s] [-r 报告周期s]
+ *                          [-b 波特率] [-w 抓包文件] [-S]
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Config.h"
+#include "Modbus.h"
+#include "TrashBin.h"
+
+#define FLEET_SENSORS     6    /**< 传感器编号数量 SENSOR_ID_x */
+#define FLEET_CHUNK       64   /**< 每个任务包含的桶数 */
+#define FLEET_THREADS_MAX 64   /**< 最多线程数 */
+#define FLEET_BUS_SLAVES  247  /**< 每条总线的从站数 */
+#define FLEET_IR_NUM      24   /**< 输入寄存器数量，与固件MB_IR_NUM一致 */
+#define FLEET_TURN_MS     5.0  /**< 从站处理延迟，与modbus_sim默认值一致 */
+#define FLEET_VISIT_MS    7000 /**< 一次来访的时长 */
+#define FLEET_COLLECT_PM  800  /**< 满溢度超过此值后安排收运 */
+#define FLEET_FAR_MM      0    /**< 无人时接近测距无回波 */
+
+/**
+ * @brief 输入寄存器，与固件DK_C8T6.c的MB_IR_x一致
+ */
+#define FLEET_IR_STATUS     0
+#define FLEET_IR_TRASH      1
+#define FLEET_IR_FILL_PM    2
+#define FLEET_IR_FILL_CONF  3
+#define FLEET_IR_FILL_RATE  4
+#define FLEET_IR_FILL_TTF   5
+#define FLEET_IR_SMOKE_PPM  6
+#define FLEET_IR_SMOKE_LVL  7
+#define FLEET_IR_LID_MM     8
+#define FLEET_IR_FILL_MM    9
+#define FLEET_IR_TEMP       10
+#define FLEET_IR_HUMI       11
+#define FLEET_IR_LID_OPENS  12
+#define FLEET_IR_UPTIME     14
+#define FLEET_IR_SINCE      16
+#define FLEET_IR_MB_FRAMES  18
+#define FLEET_IR_MB_CRC_ERR 19
+#define FLEET_IR_MB_EXCEPT  20
+#define FLEET_IR_FAN_DUTY   21
+#define FLEET_IR_COMP_STATE 22
+#define FLEET_IR_COMP_CYC   23
+
+/**
+ * @brief 仿真的垃圾桶：固件实例 + 模拟驱动状态
+ */
+typedef struct
+{
+    TrashBin_t bin;
+    Modbus_Slave_t slave;
+    SensorSample_t sample[FLEET_SENSORS]; /**< 模拟驱动发布的最新样本 */
+    uint32_t due[FLEET_SENSORS];          /**< 各传感器下次采样时刻 */
+    uint32_t now_ms;                      /**< 虚拟时间 */
+    uint32_t rng;                         /**< xorshift32状态 */
+    float rate_h;                         /**< 基础来访率（次/小时） */
+    uint32_t visit_ms;                    /**< 当前来访开始时刻 */
+    uint32_t next_visit_ms;               /**< 下次来访时刻 */
+    uint8_t visiting;                     /**< 正在来访 */
+    uint8_t deposited;                    /**< 本次来访已投放 */
+    uint16_t level_pm;                    /**< 实际满溢度 */
+    uint32_t collect_ms;                  /**< 收运时刻，0表示未安排 */
+    uint32_t smoke_ms;                    /**< 烟雾事件开始时刻，0表示无 */
+    uint8_t lid_open;                     /**< 舵机状态 */
+    uint16_t alarms;                      /**< 提示请求 ANNUN_BIT(ANNUN_ID_x) 组合 */
+    uint32_t collections;                 /**< 收运次数 */
+} SimBin_t;
+
+/**
+ * @brief 一个上报周期的汇总
+ */
+typedef struct
+{
+    unsigned long bins;       /**< 应答的桶数 */
+    unsigned long full;       /**< 已满 */
+    unsigned long alarm;      /**< 烟雾报警 */
+    unsigned long prealert;   /**< 烟雾预警 */
+    unsigned long cleanup;    /**< 清理超时 */
+    unsigned long lid_open;   /**< 盖子打开 */
+    unsigned long ttf_known;  /**< 有满溢预测 */
+    unsigned long due_1h;     /**< 预计1小时内装满 */
+    unsigned long bad;        /**< 应答错误 */
+    unsigned long long fill;  /**< 满溢千分比之和 */
+    unsigned long long opens; /**< 开盖次数之和 */
+    unsigned long long bytes; /**< 总线字节数（请求+应答） */
+    uint32_t crc_sum;         /**< 遥测校验和（应答CRC累加） */
+} FleetStats_t;
+
+/**
+ * @brief 工作线程的任务队列（互斥锁保护的双端队列）
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    unsigned *task; /**< 任务：桶块编号 */
+    unsigned head;  /**< 窃取端 */
+    unsigned tail;  /**< 所有者端 */
+} Deque_t;
+
+/**
+ * @brief 工作线程
+ */
+typedef struct
+{
+    pthread_t thread;
+    unsigned id;
+    Deque_t q;
+    FleetStats_t st;      /**< 本周期汇总 */
+    uint8_t *cap;         /**< 本周期抓包数据 */
+    size_t cap_len;
+    size_t cap_size;
+    unsigned long steals; /**< 窃取成功次数 */
+    uint32_t rng;         /**< 选择窃取对象 */
+} Worker_t;
+
+/* 城市场景参数，其余与Config.c默认值一致 */
+static const uint32_t fleet_cfg[CFG_NUM] = {300, 86400, 25, 1000, 60, 980, 600, 100, 1, 9600, 40, 30, 40, 22, 7, 0, 1500};
+
+/* 每小时来访率系数（%），早晚高峰 */
+static const uint8_t fleet_diurnal[24] = {10, 5,   5,   5,   10,  20,  60,  140, 180, 120, 90,  100,
+                                          150, 120, 90, 80, 100, 150, 200, 180, 120, 80, 40, 20};
+
+static SimBin_t *fleet_bins;
+static unsigned fleet_n       = 1000;
+static unsigned fleet_chunks  = 0;
+static uint32_t fleet_step_ms = 100;
+static uint32_t fleet_epoch_ms;         /**< 当前时间片起点 */
+static uint32_t fleet_epoch_len = 60000; /**< 时间片长度=上报周期 */
+static uint8_t fleet_capture    = 0;
+
+static Worker_t fleet_workers[FLEET_THREADS_MAX];
+static unsigned fleet_threads = 1;
+static pthread_barrier_t fleet_start, fleet_done;
+static atomic_uint fleet_remaining;
+static atomic_int fleet_quit;
+
+static uint32_t Rand(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+/* 0~1均匀分布 */
+static float RandF(uint32_t *s)
+{
+    return (Rand(s) >> 8) * (1.0f / 16777216.0f);
+}
+
+/* ---------------- 模拟驱动 ---------------- */
+
+static uint8_t Hw_Read(void *ctx, uint8_t id, SensorSample_t *out)
+{
+    SimBin_t *b = ctx;
+    *out        = b->sample[id];
+    return out->quality;
+}
+
+static uint8_t Hw_Lid(void *ctx, uint8_t open)
+{
+    SimBin_t *b = ctx;
+    b->lid_open = open;
+    return open;
+}
+
+static void Hw_Indicate(void *ctx, uint16_t alarms)
+{
+    SimBin_t *b = ctx;
+    b->alarms   = alarms;
+}
+
+/* 没有历史存储和烟雾看门狗 */
+static const TrashBinHw_t fleet_hw = {Hw_Read, Hw_Lid, Hw_Indicate, NULL, NULL, NULL, NULL, 0};
+
+static void Publish(SimBin_t *b, uint8_t id, int32_t value, uint8_t quality)
+{
+    SensorSample_t *s = &b->sample[id];
+    s->value          = value;
+    s->quality        = quality;
+    s->timestamp      = b->now_ms;
+    s->seq++;
+}
+
+/* 安排下一次来访：按当前小时的来访率泊松到达 */
+static void ScheduleVisit(SimBin_t *b)
+{
+    uint32_t hour = (b->now_ms / 3600000) % 24;
+    float rate    = b->rate_h * fleet_diurnal[hour] / 100.0f; // 次/小时
+    float wait_h;
+
+    if (rate < 0.05f) rate = 0.05f;
+    wait_h           = -logf(1.0f - RandF(&b->rng)) / rate;
+    b->next_visit_ms = b->now_ms + (uint32_t)(wait_h * 3600000.0f) + FLEET_VISIT_MS;
+}
+
+/* 接近测距：走近2秒，停留投放4秒，离开1秒 */
+static uint16_t VisitRange(SimBin_t *b)
+{
+    uint32_t t = b->now_ms - b->visit_ms;
+
+    if (t < 2000) return (uint16_t)(1500 - t * 1320 / 2000);
+    if (t < 6000) {
+        if (!b->deposited && t >= 3000 && b->lid_open) { // 盖子打开才能投放
+            b->level_pm += (uint16_t)(5 + Rand(&b->rng) % 30);
+            if (b->level_pm > 1000) b->level_pm = 1000;
+            b->deposited = 1;
+        }
+        return (uint16_t)(170 + Rand(&b->rng) % 20);
+    }
+    return (uint16_t)(180 + (t - 6000) * 1320 / 1000);
+}
+
+/* 推进使用轨迹并按采样周期发布样本 */
+static void Drive(SimBin_t *b)
+{
+    uint32_t now = b->now_ms;
+    uint16_t mm;
+
+    if (!b->visiting && now >= b->next_visit_ms) {
+        b->visiting  = 1;
+        b->deposited = 0;
+        b->visit_ms  = now;
+    } else if (b->visiting && now - b->visit_ms >= FLEET_VISIT_MS) {
+        b->visiting = 0;
+        ScheduleVisit(b);
+    }
+
+    if (b->level_pm >= FLEET_COLLECT_PM && b->collect_ms == 0) { // 1~6小时后收运
+        b->collect_ms = now + 3600000 + Rand(&b->rng) % (5 * 3600000);
+    }
+    if (b->collect_ms != 0 && now >= b->collect_ms) {
+        b->level_pm   = 0;
+        b->collect_ms = 0;
+        b->collections++;
+    }
+    if (b->smoke_ms == 0 && Rand(&b->rng) < 50) { // 每步长约1e-8，100ms步长时约每桶每天0.01次
+        b->smoke_ms = now;
+    } else if (b->smoke_ms != 0 && now - b->smoke_ms > 600000) {
+        b->smoke_ms = 0;
+    }
+
+    if (now >= b->due[SENSOR_ID_SONAR]) {
+        b->due[SENSOR_ID_SONAR] = now + 60;
+        if (b->visiting) {
+            Publish(b, SENSOR_ID_SONAR, VisitRange(b), SENSOR_Q_OK);
+        } else {
+            Publish(b, SENSOR_ID_SONAR, FLEET_FAR_MM, SENSOR_Q_TIMEOUT);
+        }
+    }
+    if (now >= b->due[SENSOR_ID_IR_BOTTOM]) { // 红外：0-被遮挡，1-未遮挡
+        b->due[SENSOR_ID_IR_BOTTOM] = now + 20;
+        Publish(b, SENSOR_ID_IR_BOTTOM, b->level_pm < FILL_IR_BOTTOM_PM, SENSOR_Q_OK);
+        Publish(b, SENSOR_ID_IR_TOP, b->level_pm < FILL_IR_TOP_PM, SENSOR_Q_OK);
+    }
+    if (now >= b->due[SENSOR_ID_FILL] && !b->lid_open) { // 开盖时与接近测距冲突，推迟
+        b->due[SENSOR_ID_FILL] = now + 1000;
+        mm = (uint16_t)(fleet_cfg[CFG_BIN_EMPTY_MM] -
+                        (uint32_t)b->level_pm * (fleet_cfg[CFG_BIN_EMPTY_MM] - fleet_cfg[CFG_BIN_FULL_MM]) / 1000);
+        Publish(b, SENSOR_ID_FILL, mm + Rand(&b->rng) % 9 - 4, SENSOR_Q_OK);
+    }
+    if (now >= b->due[SENSOR_ID_SMOKE]) {
+        int32_t ppm = 40 + (int32_t)(Rand(&b->rng) % 7) - 3;
+        b->due[SENSOR_ID_SMOKE] = now + 500;
+        if (b->smoke_ms != 0) {
+            uint32_t t = now - b->smoke_ms;
+            ppm += (t < 60000) ? (int32_t)(t / 100) : 600; // 1分钟内升到600PPM以上
+        }
+        Publish(b, SENSOR_ID_SMOKE, ppm, SENSOR_Q_OK);
+    }
+}
+
+/* ---------------- Modbus从站（寄存器映射与固件一致） ---------------- */
+
+static uint16_t InputReg(const SimBin_t *b, uint16_t reg)
+{
+    const TrashBin_t *t = &b->bin;
+    uint32_t v32;
+
+    switch (reg) {
+        case FLEET_IR_STATUS:
+            return (t->lid_is_open ? 0x01 : 0) | (t->trash_status == TRASHBIN_FULL ? 0x02 : 0) |
+                   (t->smoke_alert ? 0x04 : 0) | (t->smoke_prealert ? 0x08 : 0) | (t->cleanup_alert ? 0x10 : 0) |
+                   (Smoke_GetLevel(&t->smoke) == SMOKE_LEVEL_WARMUP ? 0x20 : 0);
+        case FLEET_IR_TRASH: return t->trash_status;
+        case FLEET_IR_FILL_PM: return Fill_GetPermille(&t->fill);
+        case FLEET_IR_FILL_CONF: return Fill_GetConfidence(&t->fill);
+        case FLEET_IR_FILL_RATE: return (uint16_t)Fill_GetRate(&t->fill);
+        case FLEET_IR_FILL_TTF: return t->ttf_min;
+        case FLEET_IR_SMOKE_PPM: return (uint16_t)b->sample[SENSOR_ID_SMOKE].value;
+        case FLEET_IR_SMOKE_LVL: return Smoke_GetLevel(&t->smoke);
+        case FLEET_IR_LID_MM: return TrashBin_GetLidDistance(t);
+        case FLEET_IR_FILL_MM: return (uint16_t)b->sample[SENSOR_ID_FILL].value;
+        case FLEET_IR_TEMP: return 250;
+        case FLEET_IR_HUMI: return 500;
+        case FLEET_IR_MB_FRAMES: return (uint16_t)b->slave.frames;
+        case FLEET_IR_MB_CRC_ERR: return (uint16_t)b->slave.crc_errors;
+        case FLEET_IR_MB_EXCEPT: return (uint16_t)b->slave.exceptions;
+        case FLEET_IR_FAN_DUTY: return 0; // 仿真不含排风扇
+        case FLEET_IR_COMP_STATE:
+        case FLEET_IR_COMP_CYC: return 0; // 仿真不含压缩机
+        default: break;
+    }
+
+    if (reg < FLEET_IR_UPTIME) {
+        v32 = t->lid_open_count;
+    } else if (reg < FLEET_IR_SINCE) {
+        v32 = b->now_ms / 1000;
+    } else {
+        v32 = TrashBin_TimeSinceCleanup(t, b->now_ms / 1000);
+    }
+    return (reg & 1) ? (uint16_t)v32 : (uint16_t)(v32 >> 16);
+}
+
+static uint8_t Slave_Read(void *ctx, uint8_t table, uint16_t reg, uint16_t *value)
+{
+    const SimBin_t *b = ctx;
+
+    if (table == MODBUS_TABLE_INPUT) {
+        if (reg >= FLEET_IR_NUM) return MODBUS_EX_ILLEGAL_ADDR;
+        *value = InputReg(b, reg);
+    } else if (reg < CFG_NUM * 2) {
+        *value = (reg & 1) ? (uint16_t)b->bin.cfg[reg / 2] : (uint16_t)(b->bin.cfg[reg / 2] >> 16);
+    } else {
+        return MODBUS_EX_ILLEGAL_ADDR;
+    }
+    return MODBUS_EX_NONE;
+}
+
+/* 参数由仿真统一设置，不接受写入 */
+static uint8_t Slave_Write(void *ctx, uint16_t reg, const uint8_t *data, uint16_t count)
+{
+    (void)ctx;
+    (void)reg;
+    (void)data;
+    (void)count;
+    return MODBUS_EX_ILLEGAL_FUNC;
+}
+
+/* ---------------- 仿真 ---------------- */
+
+static void Bin_Init(SimBin_t *b, unsigned i)
+{
+    unsigned k;
+
+    memset(b, 0, sizeof(*b));
+    b->rng = 2463534242UL ^ (i * 2654435761UL);
+    if (b->rng == 0) b->rng = 1;
+    for (k = 0; k < 8; k++) Rand(&b->rng);
+    for (k = 0; k < FLEET_SENSORS; k++) b->sample[k].quality = SENSOR_Q_NODATA;
+
+    b->rate_h      = 1.0f + RandF(&b->rng) * 7.0f; // 每小时1~8次（乘以日曲线系数）
+    b->level_pm    = (uint16_t)(Rand(&b->rng) % 600);
+    b->slave.addr  = (uint8_t)(i % FLEET_BUS_SLAVES + 1);
+    b->slave.ctx   = b;
+    b->slave.read  = Slave_Read;
+    b->slave.write = Slave_Write;
+    ScheduleVisit(b);
+    TrashBin_Init(&b->bin, &fleet_hw, b, fleet_cfg, 0, 0); // 仿真从0点开始
+}
+
+/* 网关轮询：读全部输入寄存器，解析应答并汇总 */
+static void Poll(Worker_t *w, SimBin_t *b, unsigned i)
+{
+    uint8_t req[8], rsp[MODBUS_FRAME_MAX];
+    FleetStats_t *st = &w->st;
+    uint16_t crc, len, status;
+
+    req[0] = b->slave.addr;
+    req[1] = MODBUS_FC_READ_INPUT;
+    req[2] = 0;
+    req[3] = 0;
+    req[4] = 0;
+    req[5] = FLEET_IR_NUM;
+    crc    = Modbus_CRC16(req, 6);
+    req[6] = (uint8_t)crc;
+    req[7] = (uint8_t)(crc >> 8);
+
+    len = Modbus_Process(&b->slave, req, sizeof(req), rsp);
+    st->bytes += sizeof(req) + len;
+    if (len != 5 + FLEET_IR_NUM * 2 || Modbus_CRC16(rsp, len) != 0) { // 含CRC整体校验为0
+        st->bad++;
+        return;
+    }
+    st->crc_sum += (uint32_t)rsp[len - 2] | (uint32_t)rsp[len - 1] << 8;
+
+    status = MODBUS_GET16(&rsp[3 + FLEET_IR_STATUS * 2]);
+    st->bins++;
+    st->lid_open += status & 0x01;
+    st->full += (status >> 1) & 1;
+    st->alarm += (status >> 2) & 1;
+    st->prealert += (status >> 3) & 1;
+    st->cleanup += (status >> 4) & 1;
+    st->fill += MODBUS_GET16(&rsp[3 + FLEET_IR_FILL_PM * 2]);
+    st->opens += (uint32_t)MODBUS_GET16(&rsp[3 + FLEET_IR_LID_OPENS * 2]) << 16 |
+                 MODBUS_GET16(&rsp[3 + (FLEET_IR_LID_OPENS + 1) * 2]);
+    if (MODBUS_GET16(&rsp[3 + FLEET_IR_FILL_TTF * 2]) != FORECAST_UNKNOWN) {
+        st->ttf_known++;
+        if (MODBUS_GET16(&rsp[3 + FLEET_IR_FILL_TTF * 2]) <= 60) st->due_1h++;
+    }
+
+    if (fleet_capture) {
+        uint32_t t_s = (fleet_epoch_ms + fleet_epoch_len) / 1000;
+        unsigned bus = i / FLEET_BUS_SLAVES;
+        if (w->cap_len + 7 + len > w->cap_size) {
+            w->cap_size = (w->cap_size + 7 + len) * 2;
+            w->cap      = realloc(w->cap, w->cap_size);
+            if (w->cap == NULL) {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+            }
+        }
+        w->cap[w->cap_len++] = (uint8_t)t_s;
+        w->cap[w->cap_len++] = (uint8_t)(t_s >> 8);
+        w->cap[w->cap_len++] = (uint8_t)(t_s >> 16);
+        w->cap[w->cap_len++] = (uint8_t)(t_s >> 24);
+        w->cap[w->cap_len++] = (uint8_t)bus;
+        w->cap[w->cap_len++] = (uint8_t)(bus >> 8);
+        w->cap[w->cap_len++] = (uint8_t)len;
+        memcpy(&w->cap[w->cap_len], rsp, len);
+        w->cap_len += len;
+    }
+}
+
+/* 任务：一块桶运行一个时间片，结束时上报 */
+static void RunChunk(Worker_t *w, unsigned chunk)
+{
+    unsigned i, end = (chunk + 1) * FLEET_CHUNK;
+    uint32_t t, t1 = fleet_epoch_ms + fleet_epoch_len;
+
+    if (end > fleet_n) end = fleet_n;
+    for (i = chunk * FLEET_CHUNK; i < end; i++) {
+        SimBin_t *b = &fleet_bins[i];
+        for (t = fleet_epoch_ms; t < t1; t += fleet_step_ms) {
+            b->now_ms = t;
+            Drive(b);
+            TrashBin_Step(&b->bin, t, t / 1000);
+        }
+        b->now_ms = t1;
+        Poll(w, b, i);
+    }
+}
+
+static uint8_t PopOwn(Worker_t *w, unsigned *task)
+{
+    uint8_t ok = 0;
+
+    pthread_mutex_lock(&w->q.lock);
+    if (w->q.tail > w->q.head) {
+        *task = w->q.task[--w->q.tail];
+        ok    = 1;
+    }
+    pthread_mutex_unlock(&w->q.lock);
+    return ok;
+}
+
+static uint8_t Steal(Worker_t *w, unsigned *task)
+{
+    unsigned k, start = Rand(&w->rng) % fleet_threads;
+
+    for (k = 0; k < fleet_threads; k++) {
+        Worker_t *v = &fleet_workers[(start + k) % fleet_threads];
+        uint8_t ok  = 0;
+        if (v == w) continue;
+        pthread_mutex_lock(&v->q.lock);
+        if (v->q.tail > v->q.head) {
+            *task = v->q.task[v->q.head++];
+            ok    = 1;
+        }
+        pthread_mutex_unlock(&v->q.lock);
+        if (ok) {
+            w->steals++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void *WorkerMain(void *arg)
+{
+    Worker_t *w = arg;
+    unsigned task;
+
+    for (;;) {
+        pthread_barrier_wait(&fleet_start);
+        if (atomic_load(&fleet_quit)) break;
+        while (atomic_load(&fleet_remaining) > 0) {
+            if (PopOwn(w, &task) || Steal(w, &task)) {
+                RunChunk(w, task);
+                atomic_fetch_sub(&fleet_remaining, 1);
+            } else {
+                sched_yield(); // 其他线程还在执行最后的任务
+            }
+        }
+        pthread_barrier_wait(&fleet_done);
+    }
+    return NULL;
+}
+
+static double WallNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void Stats_Add(FleetStats_t *dst, const FleetStats_t *src)
+{
+    dst->bins += src->bins;
+    dst->full += src->full;
+    dst->alarm += src->alarm;
+    dst->prealert += src->prealert;
+    dst->cleanup += src->cleanup;
+    dst->lid_open += src->lid_open;
+    dst->ttf_known += src->ttf_known;
+    dst->due_1h += src->due_1h;
+    dst->bad += src->bad;
+    dst->fill += src->fill;
+    dst->opens += src->opens;
+    dst->bytes += src->bytes;
+    dst->crc_sum += src->crc_sum;
+}
+
+/**
+ * @brief  运行一次完整仿真
+ * @return 墙钟时间（秒）
+ */
+static double Fleet_Run(unsigned threads, uint32_t hours, uint32_t report_s, FILE *cap, int verbose,
+                        FleetStats_t *total)
+{
+    uint32_t epochs = (uint32_t)((uint64_t)hours * 3600000 / fleet_epoch_len), e;
+    unsigned i, c;
+    double t0;
+    unsigned long steals = 0;
+
+    fleet_threads  = threads;
+    fleet_chunks   = (fleet_n + FLEET_CHUNK - 1) / FLEET_CHUNK;
+    fleet_epoch_ms = 0;
+    for (i = 0; i < fleet_n; i++) Bin_Init(&fleet_bins[i], i);
+
+    pthread_barrier_init(&fleet_start, NULL, threads + 1);
+    pthread_barrier_init(&fleet_done, NULL, threads + 1);
+    atomic_store(&fleet_quit, 0);
+    for (i = 0; i < threads; i++) {
+        Worker_t *w = &fleet_workers[i];
+        memset(w, 0, sizeof(*w));
+        w->id  = i;
+        w->rng = 0x9E3779B9u + i;
+        w->q.task = malloc(sizeof(unsigned) * fleet_chunks);
+        pthread_mutex_init(&w->q.lock, NULL);
+        pthread_create(&w->thread, NULL, WorkerMain, w);
+    }
+
+    memset(total, 0, sizeof(*total));
+    t0 = WallNow();
+    for (e = 0; e < epochs; e++) {
+        FleetStats_t st = {0};
+
+        /* 按块连续分给各线程，负载不均时由窃取平衡 */
+        for (i = 0; i < threads; i++) fleet_workers[i].q.head = fleet_workers[i].q.tail = 0;
+        for (c = 0; c < fleet_chunks; c++) {
+            Worker_t *w             = &fleet_workers[(uint64_t)c * threads / fleet_chunks];
+            w->q.task[w->q.tail++] = c;
+        }
+        atomic_store(&fleet_remaining, fleet_chunks);
+        pthread_barrier_wait(&fleet_start);
+        pthread_barrier_wait(&fleet_done);
+
+        for (i = 0; i < threads; i++) {
+            Worker_t *w = &fleet_workers[i];
+            Stats_Add(&st, &w->st);
+            memset(&w->st, 0, sizeof(w->st));
+            if (cap != NULL && w->cap_len > 0) fwrite(w->cap, 1, w->cap_len, cap);
+            w->cap_len = 0;
+        }
+        Stats_Add(total, &st);
+        fleet_epoch_ms += fleet_epoch_len;
+
+        if (verbose && fleet_epoch_ms % (report_s * 1000) == 0) {
+            uint32_t m = fleet_epoch_ms / 60000;
+            printf("day%-3lu %02lu:%02lu  full=%-6lu alarm=%-4lu pre=%-4lu cleanup=%-6lu lid=%-5lu fill=%5.1f%%"
+                   "  ttf=%-6lu due1h=%lu\n",
+                   (unsigned long)(m / 1440), (unsigned long)(m / 60 % 24), (unsigned long)(m % 60), st.full,
+                   st.alarm, st.prealert, st.cleanup, st.lid_open, st.bins ? st.fill / 10.0 / st.bins : 0.0,
+                   st.ttf_known, st.due_1h);
+        }
+    }
+    t0 = WallNow() - t0;
+
+    atomic_store(&fleet_quit, 1);
+    pthread_barrier_wait(&fleet_start);
+    for (i = 0; i < threads; i++) {
+        pthread_join(fleet_workers[i].thread, NULL);
+        steals += fleet_workers[i].steals;
+        pthread_mutex_destroy(&fleet_workers[i].q.lock);
+        free(fleet_workers[i].q.task);
+        free(fleet_workers[i].cap);
+    }
+    pthread_barrier_destroy(&fleet_start);
+    pthread_barrier_destroy(&fleet_done);
+    if (verbose) printf("steals=%lu (%.2f per epoch)\n", steals, epochs ? (double)steals / epochs : 0.0);
+    return t0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t hours = 24, report_s = 3600, baud = 9600;
+    unsigned threads = 1, i;
+    int sweep = 0;
+    const char *cap_path = NULL;
+    FILE *cap = NULL;
+    FleetStats_t total;
+    double wall, bin_s, char_s, poll_s, collections = 0;
+    unsigned long long opens = 0;
+
+    for (i = 1; i < (unsigned)argc; i++) {
+        if (strcmp(argv[i], "-S") == 0) {
+            sweep = 1;
+            continue;
+        }
+        if (i + 1 >= (unsigned)argc) break;
+        if (strcmp(argv[i], "-n") == 0) {
+            fleet_n = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0) {
+            hours = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0) {
+            threads = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0) {
+            fleet_step_ms = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            fleet_epoch_len = (uint32_t)atoi(argv[++i]) * 1000;
+        } else if (strcmp(argv[i], "-r") == 0) {
+            report_s = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0) {
+            baud = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0) {
+            cap_path = argv[++i];
+        } else {
+            break;
+        }
+    }
+    if (i < (unsigned)argc || fleet_n == 0 || hours == 0 || threads == 0 || threads > FLEET_THREADS_MAX ||
+        fleet_step_ms == 0 || fleet_step_ms > 1000 || fleet_epoch_len == 0 || fleet_epoch_len % fleet_step_ms != 0 ||
+        report_s * 1000 % fleet_epoch_len != 0 || baud < 1200) {
+        fprintf(stderr,
+                "usage: %s [-n bins] [-d hours] [-j threads] [-p step_ms] [-t telemetry_s] [-r report_s] [-b baud]"
+                " [-w capture] [-S]\n",
+                argv[0]);
+        return 1;
+    }
+
+    fleet_bins = malloc(sizeof(SimBin_t) * fleet_n);
+    if (fleet_bins == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    if (sweep) { // 加速比：结果必须与单线程一致
+        double base = 0;
+        uint32_t crc0 = 0;
+        unsigned j;
+
+        printf("bins=%u sim=%luh step=%lums chunk=%u\n", fleet_n, (unsigned long)hours, (unsigned long)fleet_step_ms,
+               FLEET_CHUNK);
+        for (j = 1; j <= threads; j *= 2) {
+            wall = Fleet_Run(j, hours, report_s, NULL, 0, &total);
+            if (j == 1) {
+                base = wall;
+                crc0 = total.crc_sum;
+            }
+            printf("threads=%-3u wall=%7.2fs  %10.0f bin-s/s  speedup=%5.2f  efficiency=%3.0f%%  %s\n", j, wall,
+                   (double)fleet_n * hours * 3600 / wall, base / wall, 100.0 * base / wall / j,
+                   total.crc_sum == crc0 ? "match" : "MISMATCH");
+            if (j * 2 > threads && j != threads) j = threads / 2; // 最后一次用满线程数
+        }
+        free(fleet_bins);
+        return 0;
+    }
+
+    if (cap_path != NULL) {
+        cap = fopen(cap_path, "wb");
+        if (cap == NULL) {
+            fprintf(stderr, "cannot write %s\n", cap_path);
+            return 1;
+        }
+        fleet_capture = 1;
+    }
+
+    printf("bins=%u sim=%luh threads=%u step=%lums telemetry=%lus\n", fleet_n, (unsigned long)hours, threads,
+           (unsigned long)fleet_step_ms, (unsigned long)(fleet_epoch_len / 1000));
+    wall = Fleet_Run(threads, hours, report_s, cap, 1, &total);
+    if (cap != NULL) fclose(cap);
+
+    for (i = 0; i < fleet_n; i++) {
+        collections += fleet_bins[i].collections;
+        opens += fleet_bins[i].bin.lid_open_count;
+    }
+    bin_s  = (double)fleet_n * hours * 3600;
+    char_s = 11.0 / baud; // 8E1
+    /* 一次轮询：请求 + 3.5字符断帧 + 处理延迟 + 应答 + 3.5字符间隔 */
+    poll_s = (8 + 5 + FLEET_IR_NUM * 2 + 7) * char_s + FLEET_TURN_MS / 1000;
+
+    printf("telemetry: frames=%lu bad=%lu bytes=%llu checksum=%08lx\n", total.bins, total.bad, total.bytes,
+           (unsigned long)total.crc_sum);
+    printf("usage: lid_opens=%llu (%.1f per bin-day) collections=%.0f\n", opens, opens / (bin_s / 86400),
+           collections);
+    printf("gateway: %u bus(es) of %u, poll=%.1fms, bus load=%.1f%% at %lu baud every %lus\n",
+           (fleet_n + FLEET_BUS_SLAVES - 1) / FLEET_BUS_SLAVES, FLEET_BUS_SLAVES, poll_s * 1000,
+           100.0 * poll_s * (fleet_n < FLEET_BUS_SLAVES ? fleet_n : FLEET_BUS_SLAVES) / (fleet_epoch_len / 1000.0),
+           (unsigned long)baud, (unsigned long)(fleet_epoch_len / 1000));
+    printf("backend: %.1f frames/s %.1f kB/s\n", fleet_n / (fleet_epoch_len / 1000.0),
+           fleet_n * (5.0 + FLEET_IR_NUM * 2) / (fleet_epoch_len / 1000.0) / 1000);
+    printf("speed: wall=%.2fs  %.0f bin-s/s  (%.0f per thread)  %.2e steps/s\n", wall, bin_s / wall,
+           bin_s / wall / threads, bin_s * 1000 / fleet_step_ms / wall);
+
+    free(fleet_bins);
+    return total.bad ? 2 : 0;
+}
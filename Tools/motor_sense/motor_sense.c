@@ -0,0 +1,71 @@
+/**
+ * @file     motor_sense.c
+ * @brief    电机电流换算检查工具（主机端）
+ * @details  用固件的换算宏（Motor.h MOTOR_RAW_TO_MA）检查ADC原始值到电流的换算：
+ *          - 固定点：原始值1302（旧算式在此开始溢出）、1862、4095的期望电流
+ *          - 全量程0~4095：比浮点换算小不超过两次取整的误差、单调不减、结果不超过Motor_GetCurrent的16位返回值
+ *          任一检查失败时打印原始值并返回1，修改MOTOR_SENSE_MV_PER_A后运行确认
+ *
+ *          编译：gcc -O2 -Wall -I../../DK -o motor_sense motor_sense.c
+ *          用法：motor_sense
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include "Motor.h"
+
+/**
+ * @brief 固定检查点（MOTOR_SENSE_MV_PER_A为1000时的期望值）
+ */
+static const struct {
+    uint16_t raw; /**< ADC原始值 */
+    uint32_t ma;  /**< 期望电流（毫安） */
+} points[] = {
+    {0, 0},
+    {1301, 1048}, // 旧算式最后一个不溢出的值
+    {1302, 1048}, // 旧算式raw * 3300000超过32位
+    {1862, 1500}, // 默认堵转阈值附近
+    {4095, 3299}, // 满量程
+};
+
+int main(void)
+{
+    uint32_t raw, ma, prev = 0;
+    double exact;
+    unsigned i;
+    int fail = 0;
+
+    printf("MOTOR_SENSE_MV_PER_A = %u\n", (unsigned)MOTOR_SENSE_MV_PER_A);
+#if MOTOR_SENSE_MV_PER_A == 1000
+    for (i = 0; i < sizeof(points) / sizeof(points[0]); i++) {
+        ma = MOTOR_RAW_TO_MA(points[i].raw);
+        printf("raw %4u -> %5u mA (expect %u)\n", points[i].raw, (unsigned)ma, (unsigned)points[i].ma);
+        if (ma != points[i].ma) fail = 1;
+    }
+#else
+    printf("fixed points skipped (expected values are for 1000 mV/A)\n");
+#endif
+
+    for (raw = 0; raw < 4096; raw++) {
+        ma    = MOTOR_RAW_TO_MA(raw);
+        exact = raw * 3300.0 / 4096.0 * 1000.0 / MOTOR_SENSE_MV_PER_A;
+        if (exact - ma >= 1.0 + 1000.0 / MOTOR_SENSE_MV_PER_A || ma > exact + 1e-9) { // 先取整到mV，再取整到mA
+            printf("raw %4u: %u mA, exact %.2f mA\n", (unsigned)raw, (unsigned)ma, exact);
+            fail = 1;
+        }
+        if (ma < prev) {
+            printf("raw %4u: %u mA < %u mA at raw %u\n", (unsigned)raw, (unsigned)ma, (unsigned)prev, (unsigned)raw - 1);
+            fail = 1;
+        }
+        if (ma > 0xFFFF) {
+            printf("raw %4u: %u mA exceeds uint16_t\n", (unsigned)raw, (unsigned)ma);
+            fail = 1;
+        }
+        prev = ma;
+    }
+
+    printf("%s\n", fail ? "FAIL" : "OK");
+    return fail;
+}
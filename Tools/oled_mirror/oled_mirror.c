@@ -0,0 +1,610 @@
+/**
+ * @file     oled_mirror.c
+ * @brief    OLED显示镜像查看与编码基准工具（主机端）
+ * @details  两种用法：
+ *          - 查看：打开串口3（或读取录制的字节流），解析镜像帧（格式见DK/OledMirror.h），
+ *            在终端中用半高方块字符实时显示128x64屏幕；启动时发送 "mirror on"，
+ *            发现丢帧或CRC错误时发送 "mirror key" 请求完整画面，期间过期的页以阴影显示；
+ *            帧之间的普通文本（命令应答）显示在屏幕下方
+ *          - 基准（-b）：按固件界面布局（UpdateOLEDDisplay）合成几段真实的界面序列，
+ *            用固件中的编码模块（OledMirror.c）和同样的速率控制（发送缓冲区256字节，为命令保留64字节）
+ *            在给定波特率的串口上仿真发送，接收端用本工具的解码器重建，统计：
+ *              原始/线路字节数和压缩比、每帧平均字节数、完整画面页的RLE大小、
+ *              接收端完整到达的帧率和延迟、按平均帧大小估算的最大帧率，以及主机上的编码速度；
+ *            每段结束时接收端画面必须与屏幕一致
+ *          界面字模来自DK/OLED_Data.c，文字只在整页位置绘制（与固件界面一致）
+ *
+ *          编译：gcc -O2 -I../../DK -o oled_mirror oled_mirror.c ../../DK/OledMirror.c ../../DK/Modbus.c ../../DK/OLED_Data.c
+ *          用法：oled_mirror [-B 波特率] 串口设备|录制文件|-
+ *                oled_mirror -b [-B 波特率] [-r 保留字节数]
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "OledMirror.h"
+#include "Modbus.h"
+#include "OLED_Data.h"
+
+#define TX_BUFFER_SIZE 256 /**< 串口3发送环形缓冲区大小，与UART3_TX_BUFFER_SIZE一致 */
+#define TX_RESERVE     64  /**< 为命令输出保留的字节数，与固件MIRROR_TX_RESERVE一致 */
+
+/* ---------------- 接收端 ---------------- */
+
+/**
+ * @brief 镜像接收端
+ */
+typedef struct
+{
+    uint8_t buf[MIRROR_FRAME_MAX];           /**< 正在接收的帧 */
+    uint16_t pos;                            /**< 已接收字节数 */
+    uint8_t fb[MIRROR_PAGES][MIRROR_WIDTH];  /**< 重建的屏幕 */
+    uint8_t valid;                           /**< 内容已知的页（按位） */
+    int last_seq;                            /**< 上一帧序号，-1表示尚未收到 */
+    unsigned long frames;                    /**< 正确的帧数 */
+    unsigned long crc_err;                   /**< CRC或格式错误的帧数 */
+    unsigned long lost;                      /**< 按序号判断丢失的帧数 */
+    char text[128];                          /**< 帧之间的文本（当前行） */
+    char last_line[128];                     /**< 最近一行完整文本 */
+    uint16_t text_len;
+} Rx_t;
+
+static void Rx_Init(Rx_t *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->last_seq = -1;
+}
+
+// 文本字节（命令应答），按行保存
+static void Rx_Text(Rx_t *r, uint8_t b)
+{
+    if (b == '\r') return;
+    if (b == '\n') {
+        r->text[r->text_len] = '\0';
+        if (r->text_len > 0) strcpy(r->last_line, r->text);
+        r->text_len = 0;
+    } else if (r->text_len < sizeof(r->text) - 1) {
+        r->text[r->text_len++] = (char)b;
+    }
+}
+
+// 解码一页的游程编码，必须恰好展开为128字节，返回使用的字节数，出错返回0
+static uint16_t Rx_DecodePage(const uint8_t *in, uint16_t len, uint8_t *out)
+{
+    uint16_t i = 0, n = 0, cnt;
+
+    while (n < MIRROR_WIDTH) {
+        if (i >= len) return 0;
+        if (in[i] & 0x80) {
+            cnt = (in[i] & 0x7F) + 1;
+            if (i + 1 >= len || n + cnt > MIRROR_WIDTH) return 0;
+            memset(out + n, in[i + 1], cnt);
+            i += 2;
+        } else {
+            cnt = in[i] + 1;
+            if (i + 1 + cnt > len || n + cnt > MIRROR_WIDTH) return 0;
+            memcpy(out + n, in + i + 1, cnt);
+            i += 1 + cnt;
+        }
+        n += cnt;
+    }
+    return i;
+}
+
+// 应用一帧数据，格式错误返回1
+static int Rx_Apply(Rx_t *r, const uint8_t *data, uint16_t len)
+{
+    uint8_t page[MIRROR_WIDTH];
+    uint16_t i = 0, used, k;
+    uint8_t p, bit;
+
+    while (i < len) {
+        p   = data[i] & 0x07;
+        bit = (uint8_t)(1 << p);
+        used = Rx_DecodePage(data + i + 1, len - i - 1, page);
+        if (used == 0) return 1;
+        if (data[i] & MIRROR_PAGE_XOR) {
+            if (r->valid & bit) { // 没有基准内容的页忽略，等待完整页
+                for (k = 0; k < MIRROR_WIDTH; k++) r->fb[p][k] ^= page[k];
+            }
+        } else {
+            memcpy(r->fb[p], page, MIRROR_WIDTH);
+            r->valid |= bit;
+        }
+        i += 1 + used;
+    }
+    return 0;
+}
+
+/**
+ * @brief  接收一个字节
+ * @return 0：无事件，1：应用了一帧，2：丢帧或错误（接收端需要完整画面）
+ */
+static int Rx_Byte(Rx_t *r, uint8_t b)
+{
+    uint16_t crc, len;
+    uint8_t seq;
+    int ret = 1;
+
+    if (r->pos == 0) {
+        if (b == MIRROR_SYNC0) {
+            r->buf[r->pos++] = b;
+        } else {
+            Rx_Text(r, b);
+        }
+        return 0;
+    }
+    if (r->pos == 1 && b != MIRROR_SYNC1) { // 不是帧头，前一个字节按文本处理
+        r->pos = 0;
+        Rx_Text(r, MIRROR_SYNC0);
+        return Rx_Byte(r, b);
+    }
+    r->buf[r->pos++] = b;
+    if (r->pos < 4) return 0;
+    len = r->buf[3];
+    if (len > MIRROR_PAYLOAD_MAX) { // 长度错误，丢弃
+        r->pos = 0;
+        r->crc_err++;
+        r->valid = 0;
+        return 2;
+    }
+    if (r->pos < len + MIRROR_OVERHEAD) return 0;
+
+    r->pos = 0;
+    crc    = (uint16_t)(r->buf[4 + len] | r->buf[5 + len] << 8);
+    if (crc != Modbus_CRC16(r->buf + 2, len + 2)) {
+        r->crc_err++;
+        r->valid = 0; // 这一帧的内容未知，异或链已断开
+        return 2;
+    }
+    seq = r->buf[2];
+    if (r->last_seq >= 0 && seq != (uint8_t)(r->last_seq + 1)) {
+        r->lost += (uint8_t)(seq - r->last_seq - 1);
+        r->valid = 0;
+        ret      = 2;
+    }
+    r->last_seq = seq;
+    if (Rx_Apply(r, r->buf + 4, len) != 0) {
+        r->crc_err++;
+        r->valid = 0;
+        return 2;
+    }
+    r->frames++;
+    return ret;
+}
+
+/* ---------------- 终端显示 ---------------- */
+
+static int Pixel(const uint8_t (*fb)[MIRROR_WIDTH], int x, int y)
+{
+    return (fb[y / 8][x] >> (y % 8)) & 1;
+}
+
+// 半高方块字符：每个字符显示上下两个像素，内容未知的页显示阴影
+static void Render(const Rx_t *r, unsigned long bytes, double secs)
+{
+    static const char *const cell[4] = {" ", "\xe2\x96\x80", "\xe2\x96\x84", "\xe2\x96\x88"}; // 空 上半 下半 全
+    int x, y;
+
+    printf("\x1b[H");
+    for (y = 0; y < 64; y += 2) {
+        for (x = 0; x < 128; x++) {
+            if (!(r->valid & (1 << (y / 8)))) {
+                fputs("\xe2\x96\x91", stdout); // 阴影
+            } else {
+                fputs(cell[Pixel(r->fb, x, y) | Pixel(r->fb, x, y + 1) << 1], stdout);
+            }
+        }
+        fputc('\n', stdout);
+    }
+    printf("\x1b[Kframes %lu  crc_err %lu  lost %lu  %.0f B/s\n", r->frames, r->crc_err, r->lost,
+           secs > 0 ? bytes / secs : 0.0);
+    printf("\x1b[K%s\n", r->last_line);
+    fflush(stdout);
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static speed_t Baud(long baud)
+{
+    switch (baud) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        default: return 0;
+    }
+}
+
+static int View(const char *path, long baud)
+{
+    Rx_t rx;
+    uint8_t buf[256];
+    struct termios tio;
+    int fd, is_tty = 0;
+    ssize_t n, i;
+    unsigned long bytes = 0;
+    double t0 = Now(), last_draw = 0, last_key = 0;
+
+    fd = (strcmp(path, "-") == 0) ? STDIN_FILENO : open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+    if (isatty(fd) && fd != STDIN_FILENO) {
+        if (Baud(baud) == 0) {
+            fprintf(stderr, "unsupported baud %ld\n", baud);
+            return 1;
+        }
+        tcgetattr(fd, &tio);
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, Baud(baud));
+        cfsetospeed(&tio, Baud(baud));
+        tcsetattr(fd, TCSANOW, &tio);
+        is_tty = 1;
+        write(fd, "mirror on\r\n", 11);
+    }
+
+    Rx_Init(&rx);
+    printf("\x1b[2J");
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        bytes += n;
+        for (i = 0; i < n; i++) {
+            if (Rx_Byte(&rx, buf[i]) == 2 && is_tty && Now() - last_key > 1.0) {
+                write(fd, "mirror key\r\n", 12); // 丢帧后请求完整画面
+                last_key = Now();
+            }
+        }
+        if (Now() - last_draw > 0.05) {
+            Render(&rx, bytes, Now() - t0);
+            last_draw = Now();
+        }
+    }
+    Render(&rx, bytes, Now() - t0);
+    return 0;
+}
+
+/* ---------------- 界面合成 ---------------- */
+
+static uint8_t screen[MIRROR_PAGES][MIRROR_WIDTH];
+
+// 在整页位置绘制图像（宽w，高16），与OLED_ShowImage相同先清空区域
+static void DrawImage16(int x, int y, int w, const uint8_t *img)
+{
+    int i, j;
+
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < w && x + i < MIRROR_WIDTH; i++) {
+            screen[y / 8 + j][x + i] = img[j * w + i];
+        }
+    }
+}
+
+// GB2312字符串，ASCII为8x16，汉字为16x16
+static void DrawString(int x, int y, const char *s)
+{
+    const unsigned char *p = (const unsigned char *)s;
+    int k;
+
+    while (*p) {
+        if (*p < 0x80) {
+            DrawImage16(x, y, 8, OLED_F8x16[*p - ' ']);
+            x += 8;
+            p++;
+            continue;
+        }
+        for (k = 0; OLED_CF16x16[k].Index[0] != '\0'; k++) {
+            if ((unsigned char)OLED_CF16x16[k].Index[0] == p[0] && (unsigned char)OLED_CF16x16[k].Index[1] == p[1]) {
+                break;
+            }
+        }
+        DrawImage16(x, y, 16, OLED_CF16x16[k].Data); // 未找到时为表尾的默认字模，同固件
+        x += 16;
+        p += p[1] ? 2 : 1;
+    }
+}
+
+static void DrawNum(int x, int y, unsigned long v, int len)
+{
+    char s[12];
+    int i;
+
+    for (i = len - 1; i >= 0; i--) {
+        s[i] = (char)('0' + v % 10);
+        v /= 10;
+    }
+    s[len] = '\0';
+    DrawString(x, y, s);
+}
+
+/**
+ * @brief 界面状态（UpdateOLEDDisplay的输入）
+ */
+typedef struct
+{
+    unsigned t_s;     /**< 时刻（秒） */
+    int status;       /**< 0空 1有 2满 */
+    unsigned dist_mm; /**< 接近检测距离 */
+    unsigned since_s; /**< 距上次清理 */
+    int ttf_min;      /**< 预计装满（分钟），-1未知 */
+    int fill_pct;     /**< 满溢百分比，-1未知 */
+    int smoke;        /**< 0正常 1预热 2预警 3报警 */
+    unsigned ppm;     /**< 烟雾浓度 */
+    int invert;       /**< 整屏反色（最坏情况） */
+} Ui_t;
+
+// 按固件UpdateOLEDDisplay的布局绘制一帧（GB2312：垃圾 空 有 满）
+static void DrawUi(const Ui_t *u)
+{
+    static const char *const status[] = {"\xbf\xd5", "\xd3\xd0", "\xc2\xfa"};
+    unsigned t = u->t_s + 20 * 3600 + 25 * 60; // 从20:25开始
+    int i, j;
+
+    memset(screen, 0, sizeof(screen));
+    DrawString(0, 0, "\xc0\xac\xbb\xf8:");
+    DrawString(40, 0, status[u->status]);
+    DrawString(80, 0, "D:");
+    DrawNum(96, 0, u->dist_mm / 10, 3);
+
+    if (u->ttf_min >= 0 && (u->t_s / 3) % 2) {
+        DrawString(0, 16, "ETA:");
+        DrawNum(40, 16, u->ttf_min / 60, 3);
+        DrawString(64, 16, "h");
+        DrawNum(72, 16, u->ttf_min % 60, 2);
+    } else {
+        DrawString(0, 16, "Time:");
+        DrawNum(40, 16, u->since_s / 60 % 100, 2);
+        DrawString(56, 16, ":");
+        DrawNum(64, 16, u->since_s % 60, 2);
+    }
+    if (u->fill_pct >= 0) {
+        DrawNum(96, 16, u->fill_pct, 3);
+        DrawString(120, 16, "%");
+    }
+
+    DrawNum(0, 32, 2025, 4);
+    DrawString(32, 32, "/");
+    DrawNum(40, 32, 5, 2);
+    DrawString(56, 32, "/");
+    DrawNum(64, 32, 6, 2);
+    if (u->smoke == 1) DrawString(96, 32, "WU");
+    if (u->smoke == 2) DrawString(96, 32, "PRE");
+    if (u->smoke == 3) DrawString(96, 32, "ALM");
+
+    DrawNum(0, 48, t / 3600 % 24, 2);
+    DrawString(16, 48, ":");
+    DrawNum(24, 48, t / 60 % 60, 2);
+    DrawString(40, 48, ":");
+    DrawNum(48, 48, t % 60, 2);
+    DrawString(72, 48, "P:");
+    DrawNum(88, 48, u->ppm, 4);
+
+    if (u->invert) {
+        for (j = 0; j < MIRROR_PAGES; j++)
+            for (i = 0; i < MIRROR_WIDTH; i++) screen[j][i] ^= 0xFF;
+    }
+}
+
+/* ---------------- 基准 ---------------- */
+
+static uint32_t rng = 12345;
+
+static int Rand(int n)
+{
+    rng = rng * 1103515245u + 12345u;
+    return (int)((rng >> 16) % (uint32_t)n);
+}
+
+/**
+ * @brief 界面序列
+ */
+typedef struct
+{
+    const char *name;
+    const char *desc;
+    unsigned period_ms; /**< 界面刷新周期 */
+    unsigned frames;    /**< 帧数 */
+} Seq_t;
+
+static const Seq_t seqs[] = {
+    {"idle", "standby: clock + cleanup timer, 1 fps", 1000, 600},
+    {"approach", "user at lid: distance/ppm change, 10 fps", 100, 1200},
+    {"alarm", "smoke alarm: ppm ramp, PRE/ALM, 4 fps", 250, 480},
+    {"invert", "worst case: full-screen invert, 1 fps", 1000, 60},
+};
+
+// 第k帧的界面状态
+static void SeqState(int s, unsigned k, Ui_t *u)
+{
+    unsigned t_ms = k * seqs[s].period_ms;
+
+    memset(u, 0, sizeof(*u));
+    u->t_s      = t_ms / 1000;
+    u->status   = 1;
+    u->dist_mm  = 1500;
+    u->since_s  = 95 + u->t_s;
+    u->ttf_min  = 754;
+    u->fill_pct = 63;
+    u->ppm      = 40 + Rand(3);
+    switch (s) {
+        case 1: // 有人走近再离开，距离每帧变化
+            u->dist_mm = 200 + (unsigned)abs((int)(t_ms % 8000) - 4000) / 4 + Rand(20);
+            u->ppm     = 40 + Rand(8);
+            if (t_ms % 8000 == 4000) u->fill_pct = 64;
+            break;
+        case 2: // 烟雾从预警升到报警
+            u->ppm   = 250 + (t_ms / 100) % 700 + Rand(15);
+            u->smoke = (u->ppm >= 600) ? 3 : (u->ppm >= 300 ? 2 : 0);
+            break;
+        case 3:
+            u->invert = (k & 1);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 串口发送仿真：环形缓冲区按波特率逐字节发出，送入接收端
+ */
+typedef struct
+{
+    uint8_t q[TX_BUFFER_SIZE];
+    unsigned head, tail;
+    double credit; /**< 已积累的可发送字节数 */
+} Uart_t;
+
+static unsigned Uart_Free(const Uart_t *u)
+{
+    return TX_BUFFER_SIZE - 1 - ((u->head - u->tail) % TX_BUFFER_SIZE);
+}
+
+static void Uart_Put(Uart_t *u, const uint8_t *p, unsigned n)
+{
+    while (n--) {
+        u->q[u->head] = *p++;
+        u->head       = (u->head + 1) % TX_BUFFER_SIZE;
+    }
+}
+
+static unsigned Budget(const Uart_t *u, unsigned reserve)
+{
+    unsigned f = Uart_Free(u);
+    return f > reserve ? f - reserve : 0;
+}
+
+static int Bench(long baud, unsigned reserve)
+{
+    static uint8_t prev[MIRROR_PAGES][MIRROR_WIDTH];
+    uint8_t out[MIRROR_FRAME_MAX];
+    double bytes_per_ms = baud / 10.0 / 1000.0; // 8N1
+    unsigned s, k, t, n, p;
+    int fail = 0;
+
+    printf("baud %ld, tx buffer %u, reserve %u (raw frame = 1024 bytes)\n\n", baud, TX_BUFFER_SIZE, reserve);
+    printf("%-9s %6s %9s %8s %7s %8s %8s %9s %8s %7s %8s %s\n", "seq", "frames", "raw_B", "wire_B", "ratio", "B/frame",
+           "rle_key", "delivered", "fps", "lat_ms", "max_fps", "final");
+
+    for (s = 0; s < sizeof(seqs) / sizeof(seqs[0]); s++) {
+        const Seq_t *q = &seqs[s];
+        Mirror_t m;
+        Rx_t rx;
+        Uart_t uart;
+        Ui_t ui;
+        unsigned long delivered = 0, lat_sum = 0, key_sum = 0;
+        unsigned frame_t = 0, matched = 1, total_ms = q->period_ms * q->frames;
+
+        Mirror_Init(&m);
+        Rx_Init(&rx);
+        memset(&uart, 0, sizeof(uart));
+        memset(screen, 0, sizeof(screen));
+        memcpy(prev, screen, sizeof(prev));
+        rng = 12345 + s;
+
+        // 每1ms：主循环补发过期页，串口按波特率发出；每period_ms显示新的一帧
+        for (t = 0, k = 0; t < total_ms + 5000; t++) {
+            if (k < q->frames && t == k * q->period_ms) {
+                SeqState(s, k, &ui);
+                DrawUi(&ui);
+                for (p = 0; p < MIRROR_PAGES; p++) key_sum += Mirror_EncodePage(out, sizeof(out), screen[p], NULL) + 1;
+                n = Mirror_Present(&m, screen[0], prev[0], out, Budget(&uart, reserve));
+                Uart_Put(&uart, out, n);
+                memcpy(prev, screen, sizeof(prev));
+                matched = 0;
+                frame_t = t;
+                k++;
+            }
+            n = Mirror_Poll(&m, screen[0], out, Budget(&uart, reserve));
+            Uart_Put(&uart, out, n);
+
+            for (uart.credit += bytes_per_ms; uart.credit >= 1.0 && uart.tail != uart.head; uart.credit -= 1.0) {
+                Rx_Byte(&rx, uart.q[uart.tail]);
+                uart.tail = (uart.tail + 1) % TX_BUFFER_SIZE;
+            }
+            if (uart.tail == uart.head && uart.credit > 1.0) uart.credit = 1.0; // 线路空闲不积累
+
+            if (!matched && rx.valid == 0xFF && memcmp(rx.fb, screen, sizeof(screen)) == 0) {
+                matched = 1;
+                delivered++;
+                lat_sum += t - frame_t;
+            }
+        }
+
+        {
+            int ok = (rx.valid == 0xFF && memcmp(rx.fb, screen, sizeof(screen)) == 0 && rx.crc_err == 0 && rx.lost == 0);
+            double secs = total_ms / 1000.0;
+            double bpf  = (double)m.bytes / q->frames;
+
+            printf("%-9s %6u %9lu %8lu %6.1fx %8.1f %8.1f %9lu %8.2f %7.0f %8.1f %s\n", q->name, q->frames,
+                   (unsigned long)q->frames * 1024, (unsigned long)m.bytes, q->frames * 1024.0 / m.bytes, bpf,
+                   (double)key_sum / q->frames, delivered, delivered / secs,
+                   delivered ? (double)lat_sum / delivered : 0.0, baud / 10.0 / bpf, ok ? "OK" : "MISMATCH");
+            if (!ok) fail = 1;
+        }
+    }
+    printf("\n  ratio     raw bytes / bytes on the wire (frame overhead included)\n"
+           "  rle_key   bytes per frame if every page were sent as a full RLE page\n"
+           "  delivered frames the viewer showed exactly before the next frame replaced them\n"
+           "  max_fps   line rate / B/frame\n");
+
+    {   // 主机编码速度：空闲界面，预算不限
+        Mirror_t m;
+        Ui_t ui;
+        unsigned long bytes = 0;
+        clock_t c0;
+        double secs;
+        unsigned iters = 20000;
+
+        Mirror_Init(&m);
+        memset(prev, 0, sizeof(prev));
+        c0 = clock();
+        for (k = 0; k < iters; k++) {
+            SeqState(1, k, &ui);
+            DrawUi(&ui);
+            bytes += Mirror_Present(&m, screen[0], prev[0], out, MIRROR_FRAME_MAX);
+            bytes += Mirror_Poll(&m, screen[0], out, MIRROR_FRAME_MAX);
+            memcpy(prev, screen, sizeof(prev));
+        }
+        secs = (double)(clock() - c0) / CLOCKS_PER_SEC;
+        printf("\nhost encode (approach sequence, incl. UI drawing): %.0f frames/s, %lu bytes\n", iters / secs, bytes);
+    }
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    long baud = 9600;
+    unsigned reserve = TX_RESERVE;
+    int bench = 0, opt;
+
+    while ((opt = getopt(argc, argv, "bB:r:")) != -1) {
+        switch (opt) {
+            case 'b': bench = 1; break;
+            case 'B': baud = atol(optarg); break;
+            case 'r': reserve = (unsigned)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-B baud] device|file|-\n       %s -b [-B baud] [-r reserve]\n", argv[0],
+                        argv[0]);
+                return 2;
+        }
+    }
+    if (bench) return Bench(baud, reserve);
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-B baud] device|file|-\n", argv[0]);
+        return 2;
+    }
+    return View(argv[optind], baud);
+}
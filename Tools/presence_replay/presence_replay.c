@@ -0,0 +1,303 @@
+/**
+ * @file     presence_replay.c
+ * @brief    接近检测离线回放评分工具（主机端）
+ * @details  读取记录的传感器数据，分别用接近检测引擎（Presence.c）和
+ *          原滑动平均算法驱动开关盖逻辑，统计误开盖和漏开盖：
+ *          - 数据格式（CSV，每行一个超声波样本，#开头为注释）：
+ *              t_ms,range_mm,range_valid,ir_top_blocked,label
+ *            label为人工标注，1表示该时刻确实有人要投放
+ *          - 连续label=1的样本构成一次"使用"，
+ *            使用开始前PRE_GRACE_MS到结束之间出现开盖记为命中
+ *          - 不落在任何使用区间内的开盖记为误开盖，没有命中的使用记为漏开盖
+ *
+ *          编译：gcc -O2 -I../../DK -o presence_replay presence_replay.c ../../DK/Presence.c
+ *          用法：presence_replay [-n near_mm] trace1.csv [trace2.csv ...]
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Presence.h"
+
+#define PRE_GRACE_MS   500  /**< 使用开始前多久内的开盖也算命中 */
+#define CLOSE_DELAY_MS 1000 /**< 与固件一致的延迟关盖时间 */
+#define LEGACY_WINDOW  5    /**< 原算法滑动平均窗口 */
+#define LEGACY_TRIGGER 3    /**< 原算法连续触发次数 */
+#define LEGACY_FAR_MM  4000 /**< 原算法中无回波样本按此距离计入窗口 */
+
+typedef struct
+{
+    PresenceInput_t in;
+    uint8_t label;
+} Sample_t;
+
+typedef struct
+{
+    Sample_t *s;
+    size_t n;
+} Trace_t;
+
+typedef struct
+{
+    unsigned opens;       /**< 开盖次数 */
+    unsigned false_opens; /**< 误开盖次数 */
+    unsigned uses;        /**< 标注的使用次数 */
+    unsigned missed;      /**< 漏开盖次数 */
+    unsigned long lat_ms; /**< 命中时开盖延迟之和（相对使用开始） */
+    unsigned hits;        /**< 命中次数 */
+    unsigned long dur_ms; /**< 数据总时长 */
+} Score_t;
+
+typedef uint8_t (*DecideFn)(const PresenceInput_t *in);
+
+/* 原算法：5点滑动平均小于开盖距离，连续3次触发 */
+static uint16_t legacy_near_mm;
+static uint16_t legacy_win[LEGACY_WINDOW];
+static uint8_t legacy_idx;
+static uint8_t legacy_count;
+
+static void Legacy_Init(uint16_t near_mm)
+{
+    int i;
+
+    legacy_near_mm = near_mm;
+    for (i = 0; i < LEGACY_WINDOW; i++) legacy_win[i] = LEGACY_FAR_MM;
+    legacy_idx   = 0;
+    legacy_count = 0;
+}
+
+static uint8_t Legacy_Decide(const PresenceInput_t *in)
+{
+    uint32_t sum = 0;
+    int i;
+
+    legacy_win[legacy_idx] = in->range_valid ? in->range_mm : LEGACY_FAR_MM; // 无回波按远处计
+    legacy_idx             = (legacy_idx + 1) % LEGACY_WINDOW;
+    for (i = 0; i < LEGACY_WINDOW; i++) sum += legacy_win[i];
+
+    if (sum / LEGACY_WINDOW < legacy_near_mm) {
+        if (legacy_count < LEGACY_TRIGGER) legacy_count++;
+    } else {
+        legacy_count = 0;
+    }
+    return legacy_count >= LEGACY_TRIGGER;
+}
+
+static Presence_t detector;
+
+static uint8_t Engine_Decide(const PresenceInput_t *in)
+{
+    return Presence_Update(&detector, in) == PRESENCE_ACTIVE;
+}
+
+/**
+ * @brief  读取一个CSV文件
+ */
+static int Trace_Load(const char *path, Trace_t *t)
+{
+    FILE *fp = fopen(path, "r");
+    char line[128];
+    size_t cap = 0;
+
+    if (fp == NULL) return -1;
+    t->s = NULL;
+    t->n = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long ts;
+        unsigned range, valid, top, label;
+
+        if (line[0] == '#' || sscanf(line, "%lu,%u,%u,%u,%u", &ts, &range, &valid, &top, &label) != 5) {
+            continue;
+        }
+        if (t->n == cap) {
+            cap  = cap ? cap * 2 : 1024;
+            t->s = realloc(t->s, cap * sizeof(Sample_t));
+            if (t->s == NULL) {
+                fclose(fp);
+                return -1;
+            }
+        }
+        t->s[t->n].in.t_ms           = (uint32_t)ts;
+        t->s[t->n].in.range_mm       = (uint16_t)range;
+        t->s[t->n].in.range_valid    = (uint8_t)valid;
+        t->s[t->n].in.ir_top_blocked = (uint8_t)top;
+        t->s[t->n].label             = (uint8_t)(label != 0);
+        t->n++;
+    }
+    fclose(fp);
+    return 0;
+}
+
+/**
+ * @brief  用指定算法回放一条数据，开关盖逻辑与固件一致：
+ *         判定有人即开盖，判定无人后延迟CLOSE_DELAY_MS关盖
+ * @param  open_at  输出每个样本时刻是否发生了开盖
+ * @param  lid_open 输出每个样本时刻处理前盖子是否开着
+ */
+static void Trace_Replay(const Trace_t *t, DecideFn decide, uint8_t *open_at, uint8_t *lid_open)
+{
+    uint8_t open = 0, close_pending = 0;
+    uint32_t close_at = 0;
+    size_t i;
+
+    for (i = 0; i < t->n; i++) {
+        uint32_t now = t->s[i].in.t_ms;
+
+        if (close_pending && now >= close_at) {
+            open          = 0;
+            close_pending = 0;
+        }
+        lid_open[i] = open;
+        open_at[i]  = 0;
+
+        if (decide(&t->s[i].in)) {
+            close_pending = 0;
+            if (!open) {
+                open       = 1;
+                open_at[i] = 1;
+            }
+        } else if (open && !close_pending) {
+            close_pending = 1;
+            close_at      = now + CLOSE_DELAY_MS;
+        }
+    }
+}
+
+/**
+ * @brief  按标注对回放结果评分
+ * @details 连续label=1的样本为一次使用，区间向前扩展PRE_GRACE_MS：
+ *          区间内的开盖为命中，区间外的开盖为误开盖；
+ *          区间内没有开盖、且开始时盖子也没开着的使用为漏开盖
+ */
+static void Trace_Score(const Trace_t *t, const uint8_t *open_at, const uint8_t *lid_open, Score_t *sc)
+{
+    uint8_t *matched = calloc(t->n ? t->n : 1, 1);
+    size_t i = 0, j, k;
+
+    if (t->n == 0 || matched == NULL) {
+        free(matched);
+        return;
+    }
+    sc->dur_ms += t->s[t->n - 1].in.t_ms - t->s[0].in.t_ms;
+
+    while (i < t->n) {
+        uint32_t start, from;
+        uint8_t hit;
+
+        if (!t->s[i].label) {
+            i++;
+            continue;
+        }
+
+        /* 一次使用：[i, j) */
+        for (j = i; j < t->n && t->s[j].label; j++);
+        start = t->s[i].in.t_ms;
+        from  = start > PRE_GRACE_MS ? start - PRE_GRACE_MS : 0;
+        for (k = i; k > 0 && t->s[k - 1].in.t_ms >= from; k--);
+
+        sc->uses++;
+        hit = lid_open[i]; // 使用开始时盖子已开着
+        if (hit) sc->hits++;
+        for (; k < j; k++) {
+            if (!open_at[k]) continue;
+            matched[k] = 1;
+            if (!hit) {
+                hit = 1;
+                sc->hits++;
+                sc->lat_ms += (t->s[k].in.t_ms > start) ? t->s[k].in.t_ms - start : 0;
+            }
+        }
+        if (!hit) sc->missed++;
+        i = j;
+    }
+
+    for (i = 0; i < t->n; i++) {
+        if (!open_at[i]) continue;
+        sc->opens++;
+        if (!matched[i]) sc->false_opens++;
+    }
+    free(matched);
+}
+
+static PresenceConfig_t engine_cfg;
+static uint16_t near_mm = PRESENCE_NEAR_MM;
+
+/**
+ * @brief  复位两种算法后分别回放评分
+ */
+static int Trace_Run(const Trace_t *t, Score_t *engine, Score_t *legacy)
+{
+    uint8_t *open_at  = malloc(t->n ? t->n : 1);
+    uint8_t *lid_open = malloc(t->n ? t->n : 1);
+
+    if (open_at == NULL || lid_open == NULL) {
+        free(open_at);
+        free(lid_open);
+        return -1;
+    }
+
+    Presence_Init(&detector, &engine_cfg);
+    Trace_Replay(t, Engine_Decide, open_at, lid_open);
+    Trace_Score(t, open_at, lid_open, engine);
+
+    Legacy_Init(near_mm);
+    Trace_Replay(t, Legacy_Decide, open_at, lid_open);
+    Trace_Score(t, open_at, lid_open, legacy);
+
+    free(open_at);
+    free(lid_open);
+    return 0;
+}
+
+static void Score_Print(const char *name, const Score_t *sc)
+{
+    double hours = sc->dur_ms / 3600000.0;
+
+    printf("%-8s opens=%-5u false=%-5u (%.1f/h)  uses=%-5u missed=%-5u (%.1f%%)  latency=%lums\n", name, sc->opens,
+           sc->false_opens, hours > 0 ? sc->false_opens / hours : 0.0, sc->uses, sc->missed,
+           sc->uses ? 100.0 * sc->missed / sc->uses : 0.0, sc->hits ? sc->lat_ms / sc->hits : 0UL);
+}
+
+int main(int argc, char **argv)
+{
+    Score_t engine = {0}, legacy = {0};
+    int i, files = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            near_mm = (uint16_t)atoi(argv[++i]);
+        }
+    }
+    Presence_DefaultConfig(&engine_cfg);
+    engine_cfg.near_mm = near_mm;
+
+    for (i = 1; i < argc; i++) {
+        Trace_t t;
+
+        if (strcmp(argv[i], "-n") == 0) {
+            i++;
+            continue;
+        }
+        if (Trace_Load(argv[i], &t) != 0) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        files++;
+        if (Trace_Run(&t, &engine, &legacy) != 0) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        free(t.s);
+    }
+
+    if (files == 0) {
+        fprintf(stderr, "usage: %s [-n near_mm] trace.csv ...\n", argv[0]);
+        return 1;
+    }
+    Score_Print("engine", &engine);
+    Score_Print("legacy", &legacy);
+    return 0;
+}
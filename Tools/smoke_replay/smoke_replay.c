@@ -0,0 +1,205 @@
+/**
+ * @file     smoke_replay.c
+ * @brief    烟雾分析离线回放评分工具（主机端）
+ * @details  读取MQ2样本数据，分别用烟雾分析模块（SmokeAnalytics.c）和
+ *          原固定阈值比较判定，统计误报和漏报：
+ *          - 数据格式（CSV，每行一个样本，#开头为注释）：
+ *              t_ms,ppm,valid,label
+ *            label为人工标注：0-无烟，1-应预警，2-应报警
+ *          - 连续label>0的样本构成一次"烟雾事件"，
+ *            事件内达到所需等级记为命中，并统计从事件开始的延迟
+ *          - label=0时进入预警/报警记为误报
+ *          traces/目录下为按MQ2实测特征（冷启动回落、温湿度漂移、噪声）合成的样本数据
+ *
+ *          编译：gcc -O2 -I../../DK -o smoke_replay smoke_replay.c ../../DK/SmokeAnalytics.c
+ *          用法：smoke_replay [-t legacy_ppm] trace1.csv [trace2.csv ...]
+ * @author   DikiFive
+ * @date     2026-10-19
+ * @version  v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SmokeAnalytics.h"
+
+typedef struct
+{
+    uint32_t t_ms;
+    uint16_t ppm;
+    uint8_t valid;
+    uint8_t label;
+} Sample_t;
+
+typedef struct
+{
+    unsigned false_pre;   /**< 误预警次数 */
+    unsigned false_alarm; /**< 误报警次数 */
+    unsigned events;      /**< 烟雾事件数 */
+    unsigned missed;      /**< 未达到所需等级的事件数 */
+    unsigned long lat_ms; /**< 命中时达到所需等级的延迟之和 */
+    unsigned hits;        /**< 命中次数 */
+    unsigned long pre_ms; /**< 事件中首次达到预警及以上等级的延迟之和 */
+    unsigned pres;        /**< 达到预警及以上等级的事件数 */
+} Score_t;
+
+static Smoke_t smoke;
+static uint16_t legacy_ppm = 300; /**< 原算法固定阈值，与smoke_ppm默认值一致 */
+
+/**
+ * @brief  读取一个CSV文件
+ */
+static Sample_t *Trace_Load(const char *path, size_t *n)
+{
+    FILE *fp = fopen(path, "r");
+    char line[128];
+    size_t cap = 0;
+    Sample_t *s = NULL;
+
+    *n = 0;
+    if (fp == NULL) return NULL;
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long ts;
+        unsigned ppm, valid, label;
+
+        if (line[0] == '#' || sscanf(line, "%lu,%u,%u,%u", &ts, &ppm, &valid, &label) != 4) continue;
+        if (*n == cap) {
+            cap = cap ? cap * 2 : 1024;
+            s   = realloc(s, cap * sizeof(Sample_t));
+            if (s == NULL) break;
+        }
+        s[*n].t_ms  = (uint32_t)ts;
+        s[*n].ppm   = (uint16_t)ppm;
+        s[*n].valid = (uint8_t)valid;
+        s[*n].label = (uint8_t)label;
+        (*n)++;
+    }
+    fclose(fp);
+    return s;
+}
+
+/**
+ * @brief  按标注评分
+ * @param  level 每个样本处理后的等级（SMOKE_LEVEL_x，预热按NONE计）
+ */
+static void Trace_Score(const Sample_t *s, size_t n, const uint8_t *level, Score_t *sc)
+{
+    size_t i = 0, j, k;
+    uint8_t prev = SMOKE_LEVEL_NONE;
+
+    for (i = 0; i < n; i++) {
+        if (s[i].label == 0 && level[i] != prev) {
+            if (level[i] == SMOKE_LEVEL_PRE && prev == SMOKE_LEVEL_NONE) sc->false_pre++;
+            if (level[i] == SMOKE_LEVEL_ALARM) sc->false_alarm++;
+        }
+        prev = level[i];
+    }
+
+    i = 0;
+    while (i < n) {
+        uint8_t need = 0, hit = 0;
+
+        if (s[i].label == 0) {
+            i++;
+            continue;
+        }
+        for (j = i; j < n && s[j].label; j++) {
+            if (s[j].label > need) need = s[j].label;
+        }
+        sc->events++;
+        for (k = i; k < j; k++) {
+            if (level[k] >= SMOKE_LEVEL_PRE && level[k] != SMOKE_LEVEL_WARMUP) {
+                sc->pres++;
+                sc->pre_ms += s[k].t_ms - s[i].t_ms;
+                break;
+            }
+        }
+        for (k = i; k < j; k++) {
+            if (level[k] >= need && level[k] != SMOKE_LEVEL_WARMUP) {
+                hit = 1;
+                sc->hits++;
+                sc->lat_ms += s[k].t_ms - s[i].t_ms;
+                break;
+            }
+        }
+        if (!hit) sc->missed++;
+        i = j;
+    }
+}
+
+static void Score_Print(const char *name, const Score_t *sc)
+{
+    printf("  %-8s false_pre=%-3u false_alarm=%-3u events=%-3u missed=%-3u first_alert=%lums latency=%lums\n", name,
+           sc->false_pre, sc->false_alarm, sc->events, sc->missed, sc->pres ? sc->pre_ms / sc->pres : 0UL,
+           sc->hits ? sc->lat_ms / sc->hits : 0UL);
+}
+
+static void Score_Add(Score_t *dst, const Score_t *src)
+{
+    dst->false_pre += src->false_pre;
+    dst->false_alarm += src->false_alarm;
+    dst->events += src->events;
+    dst->missed += src->missed;
+    dst->lat_ms += src->lat_ms;
+    dst->hits += src->hits;
+    dst->pre_ms += src->pre_ms;
+    dst->pres += src->pres;
+}
+
+int main(int argc, char **argv)
+{
+    Score_t engine_all = {0}, legacy_all = {0};
+    int i, files = 0;
+
+    for (i = 1; i < argc; i++) {
+        Score_t engine = {0}, legacy = {0};
+        Sample_t *s;
+        uint8_t *level;
+        size_t n, k;
+
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            legacy_ppm = (uint16_t)atoi(argv[++i]);
+            continue;
+        }
+        s = Trace_Load(argv[i], &n);
+        if (s == NULL) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        level = malloc(n ? n : 1);
+        if (level == NULL) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        files++;
+
+        Smoke_Init(&smoke, NULL);
+        for (k = 0; k < n; k++) {
+            level[k] = Smoke_Update(&smoke, s[k].t_ms, s[k].ppm, s[k].valid);
+        }
+        Trace_Score(s, n, level, &engine);
+
+        /* 原算法：瞬时浓度达到固定阈值即报警，无预警等级 */
+        for (k = 0; k < n; k++) {
+            level[k] = (s[k].valid && s[k].ppm >= legacy_ppm) ? SMOKE_LEVEL_ALARM : SMOKE_LEVEL_NONE;
+        }
+        Trace_Score(s, n, level, &legacy);
+
+        printf("%s\n", argv[i]);
+        Score_Print("engine", &engine);
+        Score_Print("legacy", &legacy);
+        Score_Add(&engine_all, &engine);
+        Score_Add(&legacy_all, &legacy);
+        free(level);
+        free(s);
+    }
+
+    if (files == 0) {
+        fprintf(stderr, "usage: %s [-t legacy_ppm] trace.csv ...\n", argv[0]);
+        return 1;
+    }
+    printf("total\n");
+    Score_Print("engine", &engine_all);
+    Score_Print("legacy", &legacy_all);
+    return 0;
+}
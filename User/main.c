@@ -8,6 +8,7 @@
  *          4. ƿظ
  *          5. ⱨ
  *          6. OLEDʾϵͳ״̬
+ *          7. ŷԶͨ
  */
 
 #include "DK_C8T6.h"
@@ -20,12 +21,15 @@ int main(void)
     // DS1302_SetTime(2025, 5, 6, 20, 25, 0, 2); // ,,,ʱ,,,
     // У׼ʱʹãУ׼ע͵±
     while (1) {
+        PollSensors();            // ȴɼ
         ProcessSerialCommands();  // ƣ
         HandleUltrasonicSensor(); // Զظ
         ProcessSensorData();      // ⴫
         CheckSmoke();             // 
         CheckCleanupTimeout();    // ʱ
         UpdateStatusIndicators(); // LEDͷ״̬
+        HandleVentilation();      // ŨȺʪȵŷ
         UpdateOLEDDisplay();      // OLEDʾֵ;룩
+        TS_Poll();                // ʷݻܴ洢Ͳѯ
     }
 }
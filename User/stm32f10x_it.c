@@ -23,6 +23,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f10x_it.h"
+#include "DK_C8T6.h"
 
 /** @addtogroup STM32F10x_StdPeriph_Template
   * @{
@@ -129,11 +130,15 @@ void PendSV_Handler(void)
 
 /**
   * @brief  This function handles SysTick Handler.
+  * @note   1ms, lowest priority (Timer_Init). Runs from flash and may call
+  *         library functions; keep the 10us work in TIM4_IRQHandler.
   * @param  None
   * @retval None
   */
 void SysTick_Handler(void)
 {
+  Annun_Tick();     /* LED/buzzer patterns */
+  Compactor_Tick(); /* compactor soft start, stall and end-stop checks */
 }
 
 /******************************************************************************/